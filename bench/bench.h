@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace d2r::bench {
+
+// Keeps the compiler from discarding a result.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+  static volatile const void* sink;
+  sink = &value;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+struct BenchResult {
+  std::string name;
+  uint64_t iterations;
+  double ns_per_op;
+  double items_per_op;
+};
+
+// Runs |body(iterations)| with an iteration count calibrated to about |min_time_ms| per batch and reports the
+// median of five batches. |body| returns the number of items processed per iteration (units, tiles, ...) so the
+// table can show per-item cost next to per-call cost.
+template <typename Body>
+BenchResult Run(const std::string& name, uint64_t min_time_ms, Body&& body) {
+  using Clock = std::chrono::steady_clock;
+  auto time = [&body](uint64_t iterations, double* items) {
+    auto start = Clock::now();
+    *items = static_cast<double>(body(iterations));
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  };
+
+  double items = 0;
+  double target_ns = static_cast<double>(min_time_ms) * 1e6;
+  uint64_t iterations = 1;
+  for (;;) {
+    double elapsed = time(iterations, &items);
+    if (elapsed >= target_ns / 4 || iterations >= (uint64_t{1} << 32)) {
+      iterations = std::max<uint64_t>(1, static_cast<uint64_t>(iterations * target_ns / std::max(elapsed, 1.0)));
+      break;
+    }
+    iterations *= 4;
+  }
+
+  std::vector<double> samples;
+  for (int batch = 0; batch < 5; ++batch) {
+    samples.push_back(time(iterations, &items) / static_cast<double>(iterations));
+  }
+  std::nth_element(samples.begin(), samples.begin() + 2, samples.end());
+  return {name, iterations, samples[2], items};
+}
+
+inline void PrintHeader() {
+  std::printf("%-44s %12s %14s %12s\n", "benchmark", "iterations", "ns/op", "ns/item");
+}
+
+inline void Print(const BenchResult& result) {
+  double per_item = result.items_per_op > 0 ? result.ns_per_op / result.items_per_op : result.ns_per_op;
+  std::printf("%-44s %12llu %14.1f %12.2f\n", result.name.c_str(), static_cast<unsigned long long>(result.iterations),
+              result.ns_per_op, per_item);
+}
+
+}  // namespace d2r::bench
@@ -0,0 +1,11 @@
+#pragma once
+
+// Subset of dolos/offset_types.h needed to expand D2R_OFFSET_LIST.
+
+namespace dolos {
+
+enum class OffsetType {
+  Relative32Add,
+};
+
+}  // namespace dolos
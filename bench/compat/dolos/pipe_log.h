@@ -0,0 +1,10 @@
+#pragma once
+
+// The benchmarks do not log, the PIPE_LOG family compiles to nothing.
+
+#define PIPE_LOG(...) ((void)0)
+#define PIPE_LOG_TRACE(...) ((void)0)
+#define PIPE_LOG_DEBUG(...) ((void)0)
+#define PIPE_LOG_INFO(...) ((void)0)
+#define PIPE_LOG_WARN(...) ((void)0)
+#define PIPE_LOG_ERROR(...) ((void)0)
@@ -0,0 +1,9 @@
+#pragma once
+
+// Subset of nyx/util.h needed by the game headers.
+
+#if defined(_MSC_VER)
+#define NYX_NOINLINE __declspec(noinline)
+#else
+#define NYX_NOINLINE __attribute__((noinline))
+#endif
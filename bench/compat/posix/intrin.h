@@ -0,0 +1,3 @@
+#pragma once
+
+#define _ReturnAddress() __builtin_return_address(0)
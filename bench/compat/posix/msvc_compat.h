@@ -0,0 +1,10 @@
+#pragma once
+
+// MSVC-only names used by d2r_structs.h.
+
+#include <strings.h>
+
+#include <cstdint>
+
+#define __int64 long long
+#define _stricmp strcasecmp
@@ -0,0 +1,407 @@
+#include "fixtures.h"
+
+#include "offsets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+
+namespace d2r {
+
+namespace {
+
+// read by SafeReader's refresh thread
+std::mutex s_regions_mutex;
+std::vector<RegionMap::Region> s_arena_regions;
+std::size_t s_dummy_regions = 0;
+
+}  // namespace
+
+// Replaces safe_read_win.cc: only the fixture arenas are readable, padded with unrelated 64 KiB regions below and
+// above them.
+std::vector<RegionMap::Region> QueryReadableRegions() {
+  std::lock_guard lock(s_regions_mutex);
+  std::vector<RegionMap::Region> regions = s_arena_regions;
+  for (std::size_t i = 0; i < s_dummy_regions; ++i) {
+    uintptr_t low = 0x10000 + i * 0x20000;
+    regions.push_back({low, low + 0x10000});
+    uintptr_t high = (uintptr_t{1} << 46) + i * 0x20000;
+    regions.push_back({high, high + 0x10000});
+  }
+  std::sort(regions.begin(), regions.end(),
+            [](const RegionMap::Region& a, const RegionMap::Region& b) { return a.begin < b.begin; });
+  return regions;
+}
+
+// Replaces the VirtualQuery in safe_read_win.cc: the fixture region containing |address|, or the gap around it.
+bool QueryRegionAt(uintptr_t address, RegionMap::Region* region) {
+  uintptr_t gap_begin = 0;
+  for (const RegionMap::Region& readable : QueryReadableRegions()) {
+    if (address < readable.begin) {
+      *region = {gap_begin, readable.begin};
+      return false;
+    }
+    if (address < readable.end) {
+      *region = readable;
+      return true;
+    }
+    gap_begin = readable.end;
+  }
+  *region = {gap_begin, UINTPTR_MAX};
+  return false;
+}
+
+}  // namespace d2r
+
+namespace d2r::bench {
+
+namespace {
+
+// players, monsters, objects, missiles, items, tiles - per mille of the fixture
+constexpr uint32_t kTypeShare[kUnitTypeCount] = {10, 450, 80, 60, 370, 30};
+
+// share of the items lying on the ground, the rest is in inventories and not linked into a room
+constexpr uint32_t kGroundItemPercent = 10;
+
+}  // namespace
+
+uint32_t NextRandom(uint32_t* state) {
+  // xorshift32, deterministic across hosts
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+void SetDummyRegionCount(std::size_t count) {
+  std::lock_guard lock(s_regions_mutex);
+  s_dummy_regions = count;
+}
+
+Arena::Arena(std::size_t size) : size_((size + 63) & ~std::size_t{63}) {
+  data_ = static_cast<uint8_t*>(std::aligned_alloc(64, size_));
+  std::memset(data_, 0, size_);
+  uintptr_t begin = reinterpret_cast<uintptr_t>(data_);
+  std::lock_guard lock(s_regions_mutex);
+  s_arena_regions.push_back({begin, begin + size_});
+}
+
+Arena::~Arena() {
+  uintptr_t begin = reinterpret_cast<uintptr_t>(data_);
+  std::lock_guard lock(s_regions_mutex);
+  std::erase_if(s_arena_regions, [begin](const RegionMap::Region& region) { return region.begin == begin; });
+  std::free(data_);
+}
+
+UnitFixture::UnitFixture(const UnitFixtureOptions& options) : rng_(options.seed) {
+  // two copies of every unit plus one dynamic path each, the tables and some slack for alignment
+  std::size_t room_count = kRoomColumns * kRoomColumns;
+  std::size_t size = 2 * options.units * (sizeof(D2UnitStrc) + sizeof(D2DynamicPathStrc)) +
+                     2 * kUnitTypeCount * sizeof(EntityHashTable) +
+                     room_count * (sizeof(D2ActiveRoomStrc) + 9 * sizeof(D2ActiveRoomStrc*)) + 4096;
+  arena_ = std::make_unique<Arena>(size);
+  client_tables_ = arena_->Allocate<EntityHashTable>(kUnitTypeCount);
+  server_tables_ = arena_->Allocate<EntityHashTable>(kUnitTypeCount);
+
+  BuildRooms();
+  Build(client_tables_, options);
+  Build(server_tables_, options);
+}
+
+void UnitFixture::BuildRooms() {
+  rooms_.resize(kRoomColumns * kRoomColumns);
+  for (auto& room : rooms_) {
+    room = arena_->Allocate<D2ActiveRoomStrc>();
+  }
+  // like the game, the near-room list of a room holds the room itself and its up to 8 neighbors
+  for (std::size_t y = 0; y < kRoomColumns; ++y) {
+    for (std::size_t x = 0; x < kRoomColumns; ++x) {
+      D2ActiveRoomStrc* room = rooms_[y * kRoomColumns + x];
+      room->ptRoomList = arena_->Allocate<D2ActiveRoomStrc*>(9);
+      for (std::size_t ny = y > 0 ? y - 1 : 0; ny <= std::min(y + 1, kRoomColumns - 1); ++ny) {
+        for (std::size_t nx = x > 0 ? x - 1 : 0; nx <= std::min(x + 1, kRoomColumns - 1); ++nx) {
+          room->ptRoomList[room->dwNumRooms++] = rooms_[ny * kRoomColumns + nx];
+        }
+      }
+    }
+  }
+}
+
+void UnitFixture::Build(EntityHashTable* tables, const UnitFixtureOptions& options) {
+  bool client = tables == client_tables_;
+  std::vector<D2UnitStrc*> units(options.units);
+  for (auto& unit : units) {
+    unit = arena_->Allocate<D2UnitStrc>();
+  }
+  if (options.shuffle) {
+    for (std::size_t i = units.size(); i > 1; --i) {
+      std::swap(units[i - 1], units[NextRandom(&rng_) % i]);
+    }
+  }
+
+  uint32_t next_id[kUnitTypeCount] = {1, 1, 1, 1, 1, 1};
+  std::size_t index = 0;
+  for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+    std::size_t count = type + 1 == kUnitTypeCount ? units.size() - index : options.units * kTypeShare[type] / 1000;
+    for (std::size_t i = 0; i < count; ++i, ++index) {
+      D2UnitStrc* unit = units[index];
+      unit->dwUnitType = type;
+      unit->dwClassId = NextRandom(&rng_) % 700;
+      unit->dwId = next_id[type]++;
+      unit->dwMode = NextRandom(&rng_) % 16;
+      unit->wPosX = static_cast<uint16_t>(5000 + NextRandom(&rng_) % 200);
+      unit->wPosY = static_cast<uint16_t>(5000 + NextRandom(&rng_) % 200);
+      if (HasDynamicPath(type)) {
+        D2DynamicPathStrc* path = arena_->Allocate<D2DynamicPathStrc>();
+        path->ptUnit = unit;
+        unit->pDynamicPath = path;
+      }
+
+      // the game prepends to the bucket of id & 0x7F
+      D2UnitStrc*& head = tables[type][unit->dwId & 0x7F];
+      unit->pUnitNext = head;
+      head = unit;
+
+      if (client) {
+        client_units_.push_back(unit);
+        ids_.emplace_back(type, unit->dwId);
+        if (type != 4 || NextRandom(&rng_) % 100 < kGroundItemPercent) {
+          D2ActiveRoomStrc* room = rooms_[NextRandom(&rng_) % rooms_.size()];
+          unit->pRoomUnitNext = room->ptUnitFirst;
+          room->ptUnitFirst = unit;
+          ++room->dwNumUnits;
+        }
+      }
+    }
+  }
+}
+
+void UnitFixture::Step(uint32_t percent) {
+  for (D2UnitStrc* unit : client_units_) {
+    if (NextRandom(&rng_) % 100 < percent) {
+      unit->wPosX += 1;
+    }
+  }
+}
+
+StatFixture::StatFixture(std::size_t units) {
+  std::size_t size = units * (sizeof(D2UnitStrc) + sizeof(D2StatListExStrc) +
+                              (kBaseStats + kFullStats) * sizeof(D2StatStrc)) +
+                     4096;
+  arena_ = std::make_unique<Arena>(size);
+  for (std::size_t i = 0; i < units; ++i) {
+    D2UnitStrc* unit = arena_->Allocate<D2UnitStrc>();
+    unit->dwUnitType = 1;
+    unit->dwId = static_cast<uint32_t>(i + 1);
+    D2StatListExStrc* list = arena_->Allocate<D2StatListExStrc>();
+    list->dwOwnerType = unit->dwUnitType;
+    list->dwOwnerId = unit->dwId;
+    unit->pStatListEx = list;
+
+    for (auto [stats, count] : {std::pair{&list->tBaseStats, kBaseStats}, std::pair{&list->tFullStats, kFullStats}}) {
+      stats->pStat = arena_->Allocate<D2StatStrc>(count);
+      stats->nStatCount = count;
+      for (std::size_t s = 0; s < count; ++s) {
+        stats->pStat[s].wStatId = static_cast<uint16_t>(s * 4);
+        stats->pStat[s].nValue = static_cast<int32_t>(NextRandom(&rng_) % 1000);
+      }
+    }
+    units_.push_back(unit);
+  }
+}
+
+void StatFixture::Step(uint32_t percent) {
+  for (D2UnitStrc* unit : units_) {
+    if (NextRandom(&rng_) % 100 < percent) {
+      unit->pStatListEx->tFullStats.pStat[0].nValue -= 1 << 8;
+    }
+  }
+}
+
+CollisionFixture::CollisionFixture(std::size_t rooms) {
+  constexpr std::size_t kRoomCells = kRoomSubtiles * kRoomSubtiles;
+  auto columns = static_cast<int32_t>(std::ceil(std::sqrt(static_cast<double>(rooms))));
+  std::size_t size = sizeof(D2DrlgStrc) + sizeof(D2DrlgLevelStrc) +
+                     rooms * (sizeof(D2ActiveRoomStrc) + sizeof(D2DrlgRoomStrc) + sizeof(D2RoomCollisionGridStrc) +
+                              kRoomCells * sizeof(uint16_t)) +
+                     4096;
+  arena_ = std::make_unique<Arena>(size);
+
+  auto* drlg = arena_->Allocate<D2DrlgStrc>();
+  drlg->dwStartSeed = 0x1234ABCD;
+  drlg->nDifficulty = 2;
+  level_ = arena_->Allocate<D2DrlgLevelStrc>();
+  level_->ptDrlg = drlg;
+  level_->eLevelId = 8;
+  level_->tCoords.nBackCornerTileX = 200;
+  level_->tCoords.nBackCornerTileY = 400;
+  level_->tCoords.nSizeTileX = columns * 8;
+  level_->tCoords.nSizeTileY = static_cast<int32_t>((rooms + columns - 1) / columns) * 8;
+
+  for (std::size_t i = 0; i < rooms; ++i) {
+    auto* drlg_room = arena_->Allocate<D2DrlgRoomStrc>();
+    drlg_room->ptLevel = level_;
+    auto* grid = arena_->Allocate<D2RoomCollisionGridStrc>();
+    grid->tRoomCoords.nSubtileX = (level_->tCoords.nBackCornerTileX + static_cast<int32_t>(i) % columns * 8) * 5;
+    grid->tRoomCoords.nSubtileY = (level_->tCoords.nBackCornerTileY + static_cast<int32_t>(i) / columns * 8) * 5;
+    grid->tRoomCoords.nSubtileWidth = kRoomSubtiles;
+    grid->tRoomCoords.nSubtileHeight = kRoomSubtiles;
+    grid->pCollisionMask = arena_->Allocate<uint16_t>(kRoomCells);
+    // walls along the back edges and a few 5x5 pillars (one tile each)
+    uint32_t pillars[4];
+    for (uint32_t& pillar : pillars) {
+      pillar = NextRandom(&rng_) % 64;
+    }
+    for (int32_t y = 0; y < kRoomSubtiles; ++y) {
+      for (int32_t x = 0; x < kRoomSubtiles; ++x) {
+        auto tile = static_cast<uint32_t>(y / 5 * 8 + x / 5);
+        bool wall = x < 2 || y < 2 || std::ranges::find(pillars, tile) != std::end(pillars);
+        grid->pCollisionMask[y * kRoomSubtiles + x] = wall ? 0x1C09 : 0;
+      }
+    }
+
+    auto* room = arena_->Allocate<D2ActiveRoomStrc>();
+    room->ptDrlgRoom = drlg_room;
+    room->ptCollisionGrid = grid;
+    room->tCoords = grid->tRoomCoords;
+    if (!rooms_.empty()) {
+      rooms_.back()->ptRoomNext = room;
+    }
+    rooms_.push_back(room);
+  }
+}
+
+CollisionMapKey CollisionFixture::key() const {
+  return {level_->ptDrlg->dwStartSeed, static_cast<uint32_t>(level_->eLevelId), level_->ptDrlg->nDifficulty};
+}
+
+WidgetFixture::WidgetFixture(std::size_t widgets) {
+  constexpr std::size_t kChildren = 32;
+  std::size_t size = sizeof(FocusManager) + widgets * (sizeof(Widget) + 16 + 2 * sizeof(Widget*)) +
+                     2 * kChildren * sizeof(Widget*) + 4096;
+  arena_ = std::make_unique<Arena>(size);
+  focus_ = arena_->Allocate<FocusManager>();
+
+  // breadth-first so every widget gets up to kChildren children before the next level starts
+  NewWidget(nullptr);
+  for (std::size_t parent = 0; widgets_.size() < widgets; ++parent) {
+    std::size_t count = std::min(kChildren, widgets - widgets_.size());
+    auto** children = arena_->Allocate<Widget*>(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      children[i] = NewWidget(widgets_[parent]);
+    }
+    widgets_[parent]->ptChildren.m_elements = children;
+    widgets_[parent]->ptChildren.m_size = count;
+    widgets_[parent]->ptChildren.m_capacity = count;
+  }
+
+  // the last parent gets a second buffer with the same children for SwapChildren
+  for (auto it = widgets_.rbegin(); it != widgets_.rend(); ++it) {
+    vector<Widget*>& children = (*it)->ptChildren;
+    if (children.m_size) {
+      auto** spare = arena_->Allocate<Widget*>(children.m_size);
+      std::copy_n(children.m_elements, children.m_size, spare);
+      spare_children_ = spare;
+      break;
+    }
+  }
+  focus_->ptHoverPanel = widgets_.size() > 1 ? widgets_[1] : nullptr;
+}
+
+Widget* WidgetFixture::NewWidget(Widget* parent) {
+  auto* widget = arena_->Allocate<Widget>();
+  auto* name = arena_->Allocate<char>(16);
+  int length = std::snprintf(name, 16, "Widget%zu", widgets_.size());
+  widget->szName.m_elements = name;
+  widget->szName.m_size = static_cast<uint64_t>(length);
+  widget->ptParent = parent;
+  widget->bVisible = NextRandom(&rng_) % 4 != 0;
+  widget->bEnabled = true;
+  widget->tAbsolute = RectInt(static_cast<int>(NextRandom(&rng_) % 1920), static_cast<int>(NextRandom(&rng_) % 1080),
+                              64, 32);
+  widgets_.push_back(widget);
+  return widget;
+}
+
+void WidgetFixture::Move() {
+  widgets_[NextRandom(&rng_) % widgets_.size()]->tAbsolute.left += 1;
+}
+
+void WidgetFixture::SwapChildren() {
+  for (auto it = widgets_.rbegin(); it != widgets_.rend(); ++it) {
+    vector<Widget*>& children = (*it)->ptChildren;
+    if (children.m_size) {
+      Widget** current = children.m_elements;
+      children.m_elements = const_cast<Widget**>(spare_children_);
+      spare_children_ = current;
+      return;
+    }
+  }
+}
+
+RoomFixture::RoomFixture(std::size_t tiles) {
+  constexpr int32_t kRoomSize = 8;
+  constexpr std::size_t kTilesPerRoom = kRoomSize * kRoomSize;
+  std::size_t room_count = (tiles + kTilesPerRoom - 1) / kTilesPerRoom;
+  std::size_t columns = 1;
+  while (columns * columns < room_count) {
+    ++columns;
+  }
+
+  rooms_.resize(room_count);
+  tile_data_.resize(tiles);
+  tiles_.reserve(tiles);
+  for (std::size_t i = 0; i < tiles; ++i) {
+    std::size_t room_index = i / kTilesPerRoom;
+    D2DrlgRoomStrc& room = rooms_[room_index];
+    room.tRoomCoords.nBackCornerTileX = static_cast<int32_t>(room_index % columns) * kRoomSize;
+    room.tRoomCoords.nBackCornerTileY = static_cast<int32_t>(room_index / columns) * kRoomSize;
+    room.tRoomCoords.nSizeTileX = kRoomSize;
+    room.tRoomCoords.nSizeTileY = kRoomSize;
+
+    D2DrlgTileDataStrc& tile = tile_data_[i];
+    tile.nPosX = static_cast<int32_t>(i % kTilesPerRoom) % kRoomSize;
+    tile.nPosY = static_cast<int32_t>(i % kTilesPerRoom) / kRoomSize;
+    tile.nTileCount = i % 5 == 0 ? 16 : 1;
+    tiles_.push_back({&room, &tile});
+  }
+}
+
+ImageFixture::ImageFixture(std::size_t size) : bytes_(size) {
+  // code-like filler: random bytes with a bias towards common opcodes so the anchor byte of a pattern shows up
+  // about as often as in a real .text section
+  static constexpr uint8_t kCommon[] = {0x48, 0x8B, 0x89, 0xE8, 0x0F, 0x41, 0x4C, 0x85, 0xC0, 0x33};
+  uint32_t rng = 0x2545F491;
+  for (auto& byte : bytes_) {
+    uint32_t r = NextRandom(&rng);
+    byte = (r & 3) == 0 ? kCommon[(r >> 8) % std::size(kCommon)] : static_cast<uint8_t>(r >> 16);
+  }
+
+  static constexpr const char* kPatterns[] = {
+#define DEFINE_PATTERN(...) D2R_GET_PATTERN(__VA_ARGS__),
+      D2R_OFFSET_LIST(DEFINE_PATTERN)
+#undef DEFINE_PATTERN
+  };
+  std::size_t position = size - size / 16;
+  for (const char* text : kPatterns) {
+    for (const char* c = text; *c && position < size; ++c) {
+      if (*c == ' ') {
+        continue;
+      }
+      if (*c == '?' || *c == '^') {
+        bytes_[position++] = 0xCC;
+        continue;
+      }
+      bytes_[position++] = static_cast<uint8_t>(std::strtoul(std::string(c, 2).c_str(), nullptr, 16));
+      ++c;
+    }
+    position += 64;
+  }
+}
+
+}  // namespace d2r::bench
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "collision_map.h"
+#include "d2r_structs.h"
+#include "unit_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace d2r::bench {
+
+// Zeroed, 64-byte aligned block that stands in for game heap memory. Every arena registers itself as a readable
+// region, QueryReadableRegions() (see fixtures.cc) reports them to SafeReader.
+class Arena {
+ public:
+  explicit Arena(std::size_t size);
+  ~Arena();
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  template <typename T>
+  T* Allocate(std::size_t count = 1) {
+    std::size_t offset = (used_ + alignof(T) - 1) & ~(alignof(T) - 1);
+    used_ = offset + sizeof(T) * count;
+    return reinterpret_cast<T*>(data_ + offset);
+  }
+
+ private:
+  uint8_t* data_;
+  std::size_t size_;
+  std::size_t used_ = 0;
+};
+
+struct UnitFixtureOptions {
+  std::size_t units = 1000;  // per side, the server tables hold a copy of every unit
+  bool shuffle = true;       // scatter units over the arena like a long-running heap
+  uint32_t seed = 1;
+};
+
+// Client and server EntityHashTables for kUnitTypeCount types with |units| D2UnitStrc each. Type mix roughly
+// follows a busy area: mostly monsters and items, a few players. Players, monsters and missiles own a path.
+// The client units are also linked into a grid of kRoomColumns x kRoomColumns active rooms, except for most items
+// which sit in inventories.
+class UnitFixture {
+ public:
+  explicit UnitFixture(const UnitFixtureOptions& options);
+
+  const EntityHashTable* client_tables() const { return client_tables_; }
+  const EntityHashTable* server_tables() const { return server_tables_; }
+  std::size_t units() const { return ids_.size(); }
+  const std::vector<std::pair<uint32_t, uint32_t>>& ids() const { return ids_; }  // (type, id)
+  const D2ActiveRoomStrc* center_room() const { return rooms_[kRoomColumns / 2 * kRoomColumns + kRoomColumns / 2]; }
+
+  static constexpr std::size_t kRoomColumns = 8;
+
+  // moves |percent| of the client units, used to produce change masks
+  void Step(uint32_t percent);
+
+ private:
+  void Build(EntityHashTable* tables, const UnitFixtureOptions& options);
+  void BuildRooms();
+
+  std::unique_ptr<Arena> arena_;
+  std::vector<D2ActiveRoomStrc*> rooms_;
+  EntityHashTable* client_tables_;
+  EntityHashTable* server_tables_;
+  std::vector<D2UnitStrc*> client_units_;
+  std::vector<std::pair<uint32_t, uint32_t>> ids_;
+  uint32_t rng_;
+};
+
+// |tiles| floor tiles spread over rooms of 8x8 tiles, laid out like a level.
+class RoomFixture {
+ public:
+  explicit RoomFixture(std::size_t tiles);
+
+  struct TileRef {
+    const D2DrlgRoomStrc* room;
+    const D2DrlgTileDataStrc* tile;
+  };
+  const std::vector<TileRef>& tiles() const { return tiles_; }
+
+ private:
+  std::vector<D2DrlgRoomStrc> rooms_;
+  std::vector<D2DrlgTileDataStrc> tile_data_;
+  std::vector<TileRef> tiles_;
+};
+
+// |units| units with a stat list each, kBaseStats base and kFullStats full stats sorted like the game keeps them.
+class StatFixture {
+ public:
+  explicit StatFixture(std::size_t units);
+
+  const std::vector<D2UnitStrc*>& units() const { return units_; }
+
+  static constexpr std::size_t kBaseStats = 24;
+  static constexpr std::size_t kFullStats = 48;
+
+  // changes one full stat of |percent| of the units, like life does during a fight
+  void Step(uint32_t percent);
+
+ private:
+  std::unique_ptr<Arena> arena_;
+  std::vector<D2UnitStrc*> units_;
+  uint32_t rng_ = 7;
+};
+
+// One level of |rooms| active rooms of 8x8 tiles (40x40 subtiles) chained like an act's room list, each with a
+// collision grid of walls along its edges and scattered obstacles.
+class CollisionFixture {
+ public:
+  explicit CollisionFixture(std::size_t rooms);
+
+  const D2ActiveRoomStrc* first_room() const { return rooms_.front(); }
+  std::size_t rooms() const { return rooms_.size(); }
+  CollisionMapKey key() const;
+
+  static constexpr int32_t kRoomSubtiles = 40;
+
+ private:
+  std::unique_ptr<Arena> arena_;
+  std::vector<D2ActiveRoomStrc*> rooms_;
+  D2DrlgLevelStrc* level_ = nullptr;
+  uint32_t rng_ = 11;
+};
+
+// A UI tree of |widgets| widgets: a root with panels of up to 32 children each, nested two levels deep like the
+// game's PanelManager. The widgets are raw struct memory, their vtables are never called.
+class WidgetFixture {
+ public:
+  explicit WidgetFixture(std::size_t widgets);
+
+  const Widget* root() const { return widgets_.front(); }
+  const FocusManager* focus() const { return focus_; }
+  std::size_t widgets() const { return widgets_.size(); }
+
+  // moves the rect of one widget
+  void Move();
+  // points the last panel's child vector at a copy of it, a structure change with the same children
+  void SwapChildren();
+
+ private:
+  Widget* NewWidget(Widget* parent);
+
+  std::unique_ptr<Arena> arena_;
+  std::vector<Widget*> widgets_;
+  FocusManager* focus_ = nullptr;
+  Widget* const* spare_children_ = nullptr;
+  uint32_t rng_ = 13;
+};
+
+// Synthetic module image with every D2R_OFFSET_LIST pattern planted close to the end, the worst case for a
+// front-to-back scan.
+class ImageFixture {
+ public:
+  explicit ImageFixture(std::size_t size);
+
+  const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+uint32_t NextRandom(uint32_t* state);
+
+// Adds |count| unrelated regions around the arenas so RegionMap lookups search a map the size of a real process.
+void SetDummyRegionCount(std::size_t count);
+
+}  // namespace d2r::bench
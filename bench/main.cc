@@ -0,0 +1,754 @@
+// Benchmarks for the parts of nyx.d2r that do not need the game: unit table capture and lookup, change tracking,
+// the snapshot worker, stat list reads, collision map merging, widget tree snapshots, automap cell packing, path
+// extrapolation, offset cache application, signature scanning and simple_injector's log sink. Everything runs over
+// synthetic fixtures laid out with the real structs from d2r_structs.h.
+
+#include "automap_cells.h"
+#include "bench.h"
+#include "collision_map.h"
+#include "fixtures.h"
+#include "log_sink.h"
+#include "offset_cache_apply.h"
+#include "offsets.h"
+#include "path_motion.h"
+#include "pattern_scan.h"
+#include "safe_read.h"
+#include "session_reader.h"
+#include "session_recorder.h"
+#include "snapshot_pipeline.h"
+#include "stat_list.h"
+#include "unit_snapshot.h"
+#include "widget_tree.h"
+
+#if !defined(_WIN32)
+#include "unix_socket_transport.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace d2r::bench {
+
+namespace {
+
+struct Options {
+  std::vector<std::size_t> units = {10, 100, 1000, 10000};
+  std::size_t tiles = 4096;
+  std::size_t image_mb = 16;
+  std::size_t regions = 2000;
+  uint64_t min_time_ms = 200;
+  bool shuffle = true;
+  std::string filter;
+  std::string session;  // a recorded session to replay as well
+};
+
+std::vector<std::size_t> ParseList(std::string_view text) {
+  std::vector<std::size_t> values;
+  while (!text.empty()) {
+    std::size_t comma = text.find(',');
+    values.push_back(std::strtoull(std::string(text.substr(0, comma)).c_str(), nullptr, 10));
+    text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+  }
+  return values;
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    auto value = [&arg](std::string_view flag) -> const char* {
+      return arg.starts_with(flag) && arg.size() > flag.size() && arg[flag.size()] == '=' ? arg.data() + flag.size() + 1
+                                                                                          : nullptr;
+    };
+    if (const char* v = value("--units")) {
+      options->units = ParseList(v);
+    } else if (const char* v = value("--tiles")) {
+      options->tiles = std::strtoull(v, nullptr, 10);
+    } else if (const char* v = value("--image-mb")) {
+      options->image_mb = std::strtoull(v, nullptr, 10);
+    } else if (const char* v = value("--regions")) {
+      options->regions = std::strtoull(v, nullptr, 10);
+    } else if (const char* v = value("--min-time-ms")) {
+      options->min_time_ms = std::strtoull(v, nullptr, 10);
+    } else if (const char* v = value("--filter")) {
+      options->filter = v;
+    } else if (arg == "--no-shuffle") {
+      options->shuffle = false;
+    } else if (const char* v = value("--session")) {
+      options->session = v;
+    } else {
+      std::fprintf(stderr,
+                   "usage: d2r_bench [--units=10,100,...] [--tiles=N] [--image-mb=N] [--regions=N] [--min-time-ms=N]\n"
+                   "                 [--filter=substring] [--no-shuffle] [--session=FILE]\n");
+      return false;
+    }
+  }
+  return true;
+}
+
+class Runner {
+ public:
+  explicit Runner(const Options& options) : options_(options) {}
+
+  template <typename Body>
+  void operator()(const std::string& name, Body&& body) {
+    if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+      return;
+    }
+    Print(Run(name, options_.min_time_ms, std::forward<Body>(body)));
+  }
+
+ private:
+  const Options& options_;
+};
+
+bool BenchUnits(Runner& run, const Options& options) {
+  for (std::size_t count : options.units) {
+    UnitFixture fixture({.units = count, .shuffle = options.shuffle});
+    std::string suffix = "/" + std::to_string(count);
+
+    // fixtures are registered, the region map must be rebuilt for the next reader
+    std::this_thread::sleep_for(std::chrono::milliseconds(SafeReader::kRefreshIntervalMs + 10));
+
+    std::size_t capacity = 2 * count;
+    std::vector<UnitSnapshotRecord> records(capacity);
+    SafeReader reader;
+    ChainWalkStats stats;
+    std::size_t captured = CaptureUnitTable(fixture.client_tables(), SnapshotSource::kClient, records.data(), 0,
+                                            capacity, reader, &stats);
+    captured = CaptureUnitTable(fixture.server_tables(), SnapshotSource::kServer, records.data(), captured, capacity,
+                                reader, &stats);
+    if (captured != capacity || stats.bad_pointers || stats.type_mismatches || stats.cycles || stats.truncated) {
+      std::fprintf(stderr, "capture of %zu units returned %zu records (bad %u, mismatch %u, cycles %u)\n", count,
+                   captured, stats.bad_pointers, stats.type_mismatches, stats.cycles);
+      return false;
+    }
+
+    run("CaptureUnitTable" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        SafeReader reader;
+        ChainWalkStats stats;
+        std::size_t n = CaptureUnitTable(fixture.client_tables(), SnapshotSource::kClient, records.data(), 0,
+                                         capacity, reader, &stats);
+        n = CaptureUnitTable(fixture.server_tables(), SnapshotSource::kServer, records.data(), n, capacity, reader,
+                             &stats);
+        DoNotOptimize(n);
+      }
+      return capacity;
+    });
+
+    // units of the center room and its neighbors, what a proximity overlay asks for instead of the full tables
+    run("CaptureRoomUnits/radius1" + suffix, [&](uint64_t iterations) {
+      RoomUnitLists lists;
+      std::size_t n = 0;
+      for (uint64_t i = 0; i < iterations; ++i) {
+        SafeReader reader;
+        ChainWalkStats stats;
+        CollectRoomUnits(fixture.center_room(), 1, &lists, reader, &stats);
+        n = 0;
+        for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+          n = CaptureUnitList(lists[type], type, SnapshotSource::kClient, records.data(), n, capacity, reader, &stats);
+        }
+        DoNotOptimize(n);
+      }
+      return n;
+    });
+
+    run("FindUnit/hit" + suffix, [&](uint64_t iterations) {
+      const auto& ids = fixture.ids();
+      SafeReader reader;
+      for (uint64_t i = 0; i < iterations; ++i) {
+        auto [type, id] = ids[i % ids.size()];
+        DoNotOptimize(FindUnit(fixture.client_tables()[type], id, reader));
+      }
+      return 1;
+    });
+
+    run("FindUnit/miss" + suffix, [&](uint64_t iterations) {
+      SafeReader reader;
+      for (uint64_t i = 0; i < iterations; ++i) {
+        DoNotOptimize(FindUnit(fixture.client_tables()[i % kUnitTypeCount], 0x80000000u | (i & 0x7F), reader));
+      }
+      return 1;
+    });
+
+    UnitChangeTracker tracker;
+    tracker.Update(records.data(), captured);
+    run("UnitChangeTracker::Update" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        tracker.Update(records.data(), captured);
+      }
+      return captured;
+    });
+
+    // submit to swap of an unchanged capture, the script thread would not wait for the worker like this
+    SnapshotPipeline pipeline;
+    run("SnapshotPipeline::Swap/roundtrip" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        // jobs go back to the free list before their result is published
+        SnapshotJob* job = pipeline.AcquireJob();
+        if (job->count != captured) {
+          job->records.assign(records.begin(), records.begin() + captured);
+          job->count = captured;
+          job->walked_mask = kAllUnitTypes;
+          // one group, so the worker diffs the whole capture with a single tracker
+          job->firsts.fill(static_cast<uint32_t>(captured));
+          job->firsts[0] = 0;
+        }
+        pipeline.Submit(job);
+        const SnapshotResult* result;
+        while ((result = pipeline.Swap()) == nullptr) {
+          std::this_thread::yield();
+        }
+        DoNotOptimize(result);
+      }
+      return captured;
+    });
+  }
+  return true;
+}
+
+// Hands |count| records grouped at |firsts| to |pipeline| and waits for the result, the script thread would not wait
+// like this.
+const SnapshotResult* RunPipeline(SnapshotPipeline& pipeline,
+                                  const UnitSnapshotRecord* records,
+                                  std::size_t count,
+                                  const std::array<uint32_t, kUnitTypeCount + 1>& firsts,
+                                  uint32_t diffed_mask) {
+  SnapshotJob* job;
+  while ((job = pipeline.AcquireJob()) == nullptr) {
+    std::this_thread::yield();
+  }
+  job->records.assign(records, records + count);
+  job->count = count;
+  job->firsts = firsts;
+  job->walked_mask = kAllUnitTypes;
+  job->diffed_mask = diffed_mask;
+  pipeline.Submit(job);
+  const SnapshotResult* result;
+  while ((result = pipeline.Swap()) == nullptr) {
+    std::this_thread::yield();
+  }
+  return result;
+}
+
+uint64_t HashRecords(const UnitSnapshotRecord* records, std::size_t count) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(records);
+  uint64_t hash = 0xCBF29CE484222325ull;
+  for (std::size_t i = 0; i < count * sizeof(UnitSnapshotRecord); ++i) {
+    hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+  }
+  return hash;
+}
+
+// Decoding a session and replaying it through the worker, one frame per tick, from |session|.
+void BenchReplay(Runner& run, SessionReader& session, const std::string& suffix) {
+  auto next = [&session] {
+    const SessionFrame* frame = session.Next();
+    if (frame == nullptr) {
+      session.Rewind();
+      frame = session.Next();
+    }
+    return frame;
+  };
+  run("SessionReader::Next" + suffix, [&](uint64_t iterations) {
+    std::size_t records = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+      records += next()->records.size();
+    }
+    return std::max<std::size_t>(records / iterations, 1);
+  });
+  SnapshotPipeline pipeline;
+  run("SessionReplay/pipeline" + suffix, [&](uint64_t iterations) {
+    std::size_t records = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+      const SessionFrame* frame = next();
+      DoNotOptimize(RunPipeline(pipeline, frame->records.data(), frame->records.size(), frame->firsts, 0));
+      records += frame->records.size();
+    }
+    return std::max<std::size_t>(records / iterations, 1);
+  });
+  session.Rewind();
+}
+
+// Records the client tables while the fixture moves, replays the session and checks that it decodes to the captured
+// records and that the worker, diffing the replayed records itself, reports the same events as it did for the live
+// captures diffed under the lock.
+bool BenchSessionReplay(Runner& run, const Options& options) {
+  constexpr uint32_t kFrames = 16;
+  for (std::size_t count : options.units) {
+    UnitFixture fixture({.units = count, .shuffle = options.shuffle});
+    std::string suffix = "/" + std::to_string(count);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SafeReader::kRefreshIntervalMs + 10));
+
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("d2r_bench_session_" + std::to_string(count) + ".d2rs");
+    if (!SessionRecorder::Start(path.string())) {
+      std::fprintf(stderr, "SessionRecorder: could not write %s\n", path.string().c_str());
+      return false;
+    }
+    std::vector<UnitSnapshotRecord> records(count);
+    std::array<UnitChangeTracker, kUnitTypeCount> trackers;
+    std::vector<uint64_t> hashes;
+    std::vector<std::vector<uint32_t>> events;
+    SnapshotPipeline live;
+    for (uint32_t f = 0; f < kFrames; ++f) {
+      fixture.Step(f == 0 ? 0 : 5);
+      SafeReader reader;
+      ChainWalkStats stats;
+      std::array<uint32_t, kUnitTypeCount + 1> firsts{};
+      std::array<std::span<const UnitSnapshotRecord>, kUnitTypeCount> groups;
+      std::size_t n = 0;
+      for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+        firsts[type] = static_cast<uint32_t>(n);
+        n = CaptureUnitType(fixture.client_tables(), type, SnapshotSource::kClient, records.data(), n, count, reader,
+                            &stats);
+        trackers[type].Update(records.data() + firsts[type], n - firsts[type]);
+        groups[type] = std::span<const UnitSnapshotRecord>(records.data() + firsts[type], n - firsts[type]);
+      }
+      firsts[kUnitTypeCount] = static_cast<uint32_t>(n);
+      SessionRecorder::CaptureFrame(groups, kAllUnitTypes, 0, {}, reader);
+      hashes.push_back(HashRecords(records.data(), n));
+      events.push_back(RunPipeline(live, records.data(), n, firsts, kAllUnitTypes)->events);
+    }
+    SessionRecorder::Stop();
+
+    SessionReader session;
+    std::string error;
+    if (!session.OpenFile(path.string(), &error)) {
+      std::fprintf(stderr, "SessionReader: %s\n", error.c_str());
+      return false;
+    }
+    SnapshotPipeline replayed;
+    for (uint32_t f = 0; f < kFrames; ++f) {
+      const SessionFrame* frame = session.Next();
+      if (frame == nullptr) {
+        std::fprintf(stderr, "SessionReader: %zu units, frame %u of %u missing %s\n", count, f, kFrames,
+                     session.error().c_str());
+        return false;
+      }
+      if (HashRecords(frame->records.data(), frame->records.size()) != hashes[f]) {
+        std::fprintf(stderr, "SessionReader: %zu units, frame %u decodes to other records\n", count, f);
+        return false;
+      }
+      if (RunPipeline(replayed, frame->records.data(), frame->records.size(), frame->firsts, 0)->events != events[f]) {
+        std::fprintf(stderr, "SnapshotPipeline: %zu units, frame %u replays to other events\n", count, f);
+        return false;
+      }
+    }
+    if (session.Next() != nullptr || !session.error().empty()) {
+      std::fprintf(stderr, "SessionReader: %zu units, trailing frames %s\n", count, session.error().c_str());
+      return false;
+    }
+    session.Rewind();
+    BenchReplay(run, session, suffix);
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+  }
+
+  // a session recorded in the game
+  if (!options.session.empty()) {
+    SessionReader session;
+    std::string error;
+    if (!session.OpenFile(options.session, &error)) {
+      std::fprintf(stderr, "SessionReader: %s: %s\n", options.session.c_str(), error.c_str());
+      return false;
+    }
+    BenchReplay(run, session, "/" + std::filesystem::path(options.session).filename().string());
+  }
+  return true;
+}
+
+void BenchStats(Runner& run, const Options& options) {
+  for (std::size_t count : options.units) {
+    StatFixture fixture(count);
+    std::string suffix = "/" + std::to_string(count);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SafeReader::kRefreshIntervalMs + 10));
+
+    StatListCache cache;
+    auto read_all = [&] {
+      SafeReader reader;
+      StatListCopy copy;
+      uint64_t versions = 0;
+      for (const D2UnitStrc* unit : fixture.units()) {
+        cache.Read(unit, reader, &copy);
+        versions += copy.version;
+      }
+      DoNotOptimize(versions);
+    };
+
+    read_all();
+    run("StatListCache::Read/unchanged" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        read_all();
+      }
+      return count;
+    });
+
+    run("StatListCache::Read/changed10" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        fixture.Step(10);
+        read_all();
+      }
+      return count;
+    });
+  }
+}
+
+void BenchCollision(Runner& run, const Options& options) {
+  std::size_t rooms = std::max<std::size_t>(options.tiles / 64, 1);
+  CollisionFixture fixture(rooms);
+  std::string suffix = "/" + std::to_string(rooms);
+  std::this_thread::sleep_for(std::chrono::milliseconds(SafeReader::kRefreshIntervalMs + 10));
+
+  run("CollisionMapCache::Update/new" + suffix, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      CollisionMapCache cache;
+      SafeReader reader;
+      DoNotOptimize(cache.Update(fixture.first_room(), reader));
+    }
+    return rooms;
+  });
+
+  // the per-tick cost once every active room was merged
+  CollisionMapCache cache;
+  {
+    SafeReader reader;
+    cache.Update(fixture.first_room(), reader);
+  }
+  run("CollisionMapCache::Update/merged" + suffix, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      SafeReader reader;
+      DoNotOptimize(cache.Update(fixture.first_room(), reader));
+    }
+    return rooms;
+  });
+
+  const WalkableMap* map = cache.Find(fixture.key());
+  std::vector<uint8_t> runs = map->Compress();
+  std::fprintf(stderr,
+               "collision map of %ux%u subtiles: %zu bytes expanded, %zu bytes compressed\n",
+               map->width(),
+               map->height(),
+               map->words().size_bytes(),
+               runs.size());
+  run("WalkableMap::Compress" + suffix, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      DoNotOptimize(map->Compress().size());
+    }
+    return rooms;
+  });
+
+  WalkableMap copy(map->origin_x(), map->origin_y(), map->width(), map->height());
+  run("WalkableMap::Decompress" + suffix, [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      DoNotOptimize(copy.Decompress(runs));
+    }
+    return rooms;
+  });
+}
+
+void BenchWidgets(Runner& run, const Options&) {
+  for (std::size_t count : {std::size_t{256}, std::size_t{4096}}) {
+    WidgetFixture fixture(count);
+    std::string suffix = "/" + std::to_string(count);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SafeReader::kRefreshIntervalMs + 10));
+
+    WidgetTree tree;
+    auto update = [&] {
+      SafeReader reader;
+      tree.Update(fixture.root(), fixture.focus(), reader);
+      DoNotOptimize(tree.version());
+    };
+
+    update();
+    run("WidgetTree::Update/unchanged" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        update();
+      }
+      return count;
+    });
+
+    run("WidgetTree::Update/moved" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        fixture.Move();
+        update();
+      }
+      return count;
+    });
+
+    run("WidgetTree::Update/rebuild" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        fixture.SwapChildren();
+        update();
+      }
+      return count;
+    });
+  }
+}
+
+void BenchAutomap(Runner& run, const Options& options) {
+  RoomFixture rooms(options.tiles);
+  run("PackAutomapCellCoords/" + std::to_string(options.tiles), [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      for (const auto& [room, tile] : rooms.tiles()) {
+        int64_t packed = 0;
+        auto result = PackAutomapCellCoords(tile->nPosX + room->tRoomCoords.nBackCornerTileX,
+                                            tile->nPosY + room->tRoomCoords.nBackCornerTileY, tile->nTileCount >= 16,
+                                            &packed);
+        DoNotOptimize(result);
+        DoNotOptimize(packed);
+      }
+    }
+    return rooms.tiles().size();
+  });
+}
+
+bool BenchPathMotion(Runner& run, const Options& options) {
+  for (std::size_t count : options.units) {
+    // every unit walking towards a target a few subtiles away, in all directions
+    std::vector<UnitSnapshotRecord> records(count);
+    std::vector<uint32_t> indices(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      D2DynamicPathStrc path{};
+      auto x = static_cast<uint16_t>(5000 + i % 200);
+      auto y = static_cast<uint16_t>(5000 + i / 200);
+      int32_t dx = static_cast<int32_t>(i % 7) - 3;
+      int32_t dy = static_cast<int32_t>(i % 5) - 2;
+      path.dwClientCoordX = static_cast<uint32_t>(x) << 16;
+      path.dwClientCoordY = static_cast<uint32_t>(y) << 16;
+      path.tTargetCoord.wX = static_cast<uint16_t>(x + dx * 4);
+      path.tTargetCoord.wY = static_cast<uint16_t>(y + dy * 4);
+      path.tVelocityVector.nX = dx * 0x4000;
+      path.tVelocityVector.nY = dy * 0x4000;
+      records[i].path_address = 1;
+      std::memcpy(records[i].path, &path, sizeof(path));
+      indices[i] = static_cast<uint32_t>(i);
+    }
+    std::string suffix = "/" + std::to_string(count);
+
+    PathMotion motion;
+    motion.Load(records.data(), indices);
+
+    // a single unit always takes the scalar tail, the full set the SSE2 loop where it is built in: both must land
+    // every unit on the same coordinate, also for fractional frames
+    std::vector<int32_t> positions(count * 2);
+    PathMotion single;
+    for (float frames : {0.0f, 0.3f, 1.7f, 5.55f, 12.5f}) {
+      motion.Extrapolate(frames, 12.5f, positions.data());
+      for (std::size_t i = 0; i < count; ++i) {
+        int32_t expected[2];
+        single.Load(records.data(), std::span(&indices[i], 1));
+        single.Extrapolate(frames, 12.5f, expected);
+        if (positions[i * 2] != expected[0] || positions[i * 2 + 1] != expected[1]) {
+          std::fprintf(stderr, "PathMotion: unit %zu of %zu at %.2f frames is at %d, %d instead of %d, %d\n", i, count,
+                       frames, positions[i * 2], positions[i * 2 + 1], expected[0], expected[1]);
+          return false;
+        }
+      }
+    }
+
+    run("PathMotion::Load" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        motion.Load(records.data(), indices);
+        DoNotOptimize(motion.size());
+      }
+      return count;
+    });
+
+    // one call per displayed frame between two ticks
+    run("PathMotion::Extrapolate" + suffix, [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        motion.Extrapolate(static_cast<float>(i % 16) * 0.25f, 12.5f, positions.data());
+        DoNotOptimize(positions.data());
+      }
+      return count;
+    });
+  }
+  return true;
+}
+
+void BenchOffsets(Runner& run, const Options& options) {
+  struct Entry {
+    std::string name;
+    uint64_t offset;
+  };
+  struct Signature {
+    std::string name;
+    void** target;
+  };
+
+  static void* targets[kOffsetCount];
+  std::vector<Signature> signatures;
+  std::vector<Entry> entries;
+  const char* names[] = {
+#define DEFINE_NAME(...) D2R_GET_NAME(__VA_ARGS__),
+      D2R_OFFSET_LIST(DEFINE_NAME)
+#undef DEFINE_NAME
+  };
+  for (std::size_t i = 0; i < kOffsetCount; ++i) {
+    signatures.push_back({names[i], &targets[i]});
+    // reverse order: the cache is written in discovery order, which rarely matches the list
+    entries.push_back({names[kOffsetCount - 1 - i], 0x1000 + i * 0x10});
+  }
+  run("ApplyOffsetEntries/" + std::to_string(kOffsetCount), [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      ApplyOffsetEntries(entries, signatures, 0x140000000ull);
+      DoNotOptimize(targets[0]);
+    }
+    return kOffsetCount;
+  });
+
+  if (options.image_mb == 0) {
+    return;
+  }
+  ImageFixture image(options.image_mb << 20);
+  std::vector<Pattern> patterns;
+  const char* texts[] = {
+#define DEFINE_PATTERN(...) D2R_GET_PATTERN(__VA_ARGS__),
+      D2R_OFFSET_LIST(DEFINE_PATTERN)
+#undef DEFINE_PATTERN
+  };
+  for (const char* text : texts) {
+    patterns.push_back(ParsePattern(text));
+  }
+  run("PatternScan/" + std::to_string(options.image_mb) + "MiB", [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      for (const Pattern& pattern : patterns) {
+        DoNotOptimize(FindPattern(image.bytes().data(), image.bytes().size(), pattern));
+      }
+    }
+    return patterns.size();
+  });
+}
+
+#if !defined(_WIN32)
+// Lines sent through a Unix socket into a LogSink writing a rotating file, the way the injected module's log pipe
+// feeds simple_injector. Per-item cost is per line end to end, the socket write included.
+void BenchLogSink(Runner& run, const Options&) {
+  std::string lines;
+  std::vector<std::size_t> line_ends;
+  for (int i = 0; i < 1024; ++i) {
+    lines += "[12:00:00." + std::to_string(100 + i % 900) + "] [trace] [nyx.d2r] UnitSnapshot: unit " +
+             std::to_string(i * 7919 % 4096) + " moved to (" + std::to_string(5000 + i % 97) + ", " +
+             std::to_string(4400 + i % 89) + ")\n";
+    line_ends.push_back(lines.size());
+  }
+  const std::string marker = "[12:00:01.000] [error] [nyx.d2r] end of batch\n";
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "d2r_bench_log";
+  std::filesystem::create_directories(directory);
+
+  struct Case {
+    const char* name;
+    bool compress;
+    LogLevel file_level;
+  };
+  for (const Case& c : {Case{"text", false, LogLevel::kTrace}, Case{"gzip", true, LogLevel::kTrace},
+                        Case{"filtered", false, LogLevel::kWarn}}) {
+    const std::string socket_path = (directory / "sink.sock").string();
+    LogSinkOptions sink_options;
+    sink_options.path = (directory / "sink.log").string();
+    sink_options.max_file_bytes = std::size_t{16} << 20;
+    sink_options.max_files = 1;
+    sink_options.compress = c.compress;
+    sink_options.file_level = c.file_level;
+    sink_options.console_level = LogLevel::kOff;
+    sink_options.drop_when_full = false;  // the writer's sustained rate, not how fast lines can be dropped
+    auto transport = std::make_unique<UnixSocketTransport>(socket_path);
+    if (!transport->valid()) {
+      std::fprintf(stderr, "LogSink: could not listen on %s\n", socket_path.c_str());
+      return;
+    }
+    LogSink sink(sink_options, std::move(transport));
+    sink.Start();
+    int client = UnixSocketTransport::Connect(socket_path);
+    if (client < 0) {
+      std::fprintf(stderr, "LogSink: could not connect to %s\n", socket_path.c_str());
+      return;
+    }
+
+    // the trace lines never reach the writer when filtered, only the marker does
+    auto send = [client](const char* data, std::size_t size) {
+      while (size > 0) {
+        ssize_t sent = ::write(client, data, size);
+        if (sent <= 0) {
+          return;
+        }
+        data += sent;
+        size -= static_cast<std::size_t>(sent);
+      }
+    };
+    run(std::string("LogSink/unix-socket/") + c.name, [&](uint64_t iterations) {
+      uint64_t target = sink.lines_processed() + sink.lines_dropped() + 1 +
+                        (c.file_level == LogLevel::kTrace ? iterations : 0);
+      for (uint64_t sent = 0; sent < iterations;) {
+        std::size_t count = static_cast<std::size_t>(std::min<uint64_t>(1024, iterations - sent));
+        send(lines.data(), line_ends[count - 1]);
+        sent += count;
+      }
+      send(marker.data(), marker.size());
+      while (sink.lines_processed() + sink.lines_dropped() < target) {
+        std::this_thread::yield();
+      }
+      return 1;
+    });
+    ::close(client);
+    sink.Stop();
+    if (sink.lines_dropped() > 0) {
+      std::fprintf(stderr, "LogSink/%s: %llu lines dropped\n", c.name,
+                   static_cast<unsigned long long>(sink.lines_dropped()));
+    }
+  }
+  std::error_code error;
+  std::filesystem::remove_all(directory, error);
+}
+#endif
+
+}  // namespace
+
+}  // namespace d2r::bench
+
+int main(int argc, char** argv) {
+  using namespace d2r::bench;
+
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    return 2;
+  }
+  SetDummyRegionCount(options.regions);
+
+  Runner run(options);
+  PrintHeader();
+  if (!BenchUnits(run, options)) {
+    d2r::SafeReader::Shutdown();
+    return 1;
+  }
+  if (!BenchSessionReplay(run, options)) {
+    d2r::SafeReader::Shutdown();
+    return 1;
+  }
+  BenchStats(run, options);
+  BenchCollision(run, options);
+  BenchWidgets(run, options);
+  BenchAutomap(run, options);
+  if (!BenchPathMotion(run, options)) {
+    d2r::SafeReader::Shutdown();
+    return 1;
+  }
+  BenchOffsets(run, options);
+#if !defined(_WIN32)
+  BenchLogSink(run, options);
+#endif
+  d2r::SafeReader::Shutdown();
+  return 0;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace d2r::bench {
+
+// Reference implementation of the D2R_OFFSET_LIST pattern format (see src/offsets.h). The production scanner lives
+// in dolos, this one gives a baseline for the signature set itself.
+struct Pattern {
+  std::vector<uint8_t> bytes;
+  std::vector<uint8_t> mask;  // 0xFF for literal bytes, 0 for wildcards
+  std::size_t offset_index = 0;  // position of ^
+};
+
+inline Pattern ParsePattern(std::string_view text) {
+  Pattern pattern;
+  auto hex = [](char c) -> uint8_t { return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10; };
+  for (std::size_t i = 0; i < text.size();) {
+    char c = text[i];
+    if (c == ' ') {
+      ++i;
+    } else if (c == '?' || c == '^') {
+      if (c == '^') {
+        pattern.offset_index = pattern.bytes.size();
+      }
+      pattern.bytes.push_back(0);
+      pattern.mask.push_back(0);
+      ++i;
+    } else {
+      pattern.bytes.push_back(static_cast<uint8_t>(hex(text[i]) << 4 | hex(text[i + 1])));
+      pattern.mask.push_back(0xFF);
+      i += 2;
+    }
+  }
+  return pattern;
+}
+
+// First match of |pattern| in |data|, anchored on the first literal byte.
+inline std::optional<std::size_t> FindPattern(const uint8_t* data, std::size_t size, const Pattern& pattern) {
+  std::size_t length = pattern.bytes.size();
+  if (length == 0 || length > size) {
+    return std::nullopt;
+  }
+  std::size_t anchor = 0;
+  while (anchor < length && pattern.mask[anchor] == 0) {
+    ++anchor;
+  }
+  if (anchor == length) {
+    return 0;
+  }
+  uint8_t first = pattern.bytes[anchor];
+  for (std::size_t i = anchor; i + length - anchor <= size; ++i) {
+    if (data[i] != first) {
+      continue;
+    }
+    const uint8_t* candidate = data + i - anchor;
+    std::size_t j = 0;
+    while (j < length && (candidate[j] & pattern.mask[j]) == pattern.bytes[j]) {
+      ++j;
+    }
+    if (j == length) {
+      return i - anchor;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace d2r::bench
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "log_sink.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace d2r::bench {
+
+// Stand-in for simple_injector's named pipe: a Unix stream socket, like the byte-mode binary log pipe. Lets the
+// log sink be driven at full speed on Linux.
+class UnixSocketTransport : public LogTransport {
+ public:
+  explicit UnixSocketTransport(std::string path) : path_(std::move(path)) {
+    ::unlink(path_.c_str());
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = Address(path_);
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd_, 1) != 0) {
+      ::close(listen_fd_);
+      listen_fd_ = -1;
+    }
+  }
+
+  ~UnixSocketTransport() override {
+    Disconnect();
+    if (listen_fd_ >= 0) {
+      ::close(listen_fd_);
+    }
+    ::unlink(path_.c_str());
+  }
+
+  bool valid() const { return listen_fd_ >= 0; }
+
+  bool Accept(int timeout_ms) override {
+    pollfd fd = {listen_fd_, POLLIN, 0};
+    if (::poll(&fd, 1, timeout_ms) <= 0) {
+      return false;
+    }
+    client_fd_ = ::accept(listen_fd_, nullptr, nullptr);
+    return client_fd_ >= 0;
+  }
+
+  int Read(char* buffer, std::size_t size, int timeout_ms) override {
+    pollfd fd = {client_fd_, POLLIN, 0};
+    int ready = ::poll(&fd, 1, timeout_ms);
+    if (ready <= 0) {
+      return ready < 0 && errno != EINTR ? -1 : 0;
+    }
+    ssize_t read = ::read(client_fd_, buffer, size);
+    return read > 0 ? static_cast<int>(read) : -1;
+  }
+
+  void Disconnect() override {
+    if (client_fd_ >= 0) {
+      ::close(client_fd_);
+      client_fd_ = -1;
+    }
+  }
+
+  // client side, returns the connected socket or -1
+  static int Connect(const std::string& path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = Address(path);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+      ::close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+ private:
+  static sockaddr_un Address(const std::string& path) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+  }
+
+  std::string path_;
+  int listen_fd_ = -1;
+  int client_fd_ = -1;
+};
+
+}  // namespace d2r::bench
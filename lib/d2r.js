@@ -1,10 +1,24 @@
 'use strict';
 
-const { UnitTypes, PlayerModes, MonsterModes, ItemModes } = require('d2r/types');
+const {
+  UnitTypes,
+  PlayerModes,
+  MonsterModes,
+  ItemModes,
+  ItemQuality,
+  ItemFlags,
+  UnitFields,
+  InventoryChanges,
+  Stats,
+} = require('d2r/types');
 const { UnitModel, SeedModel, DrlgActModel } = require('d2r/models');
+const { UnitLayout, SeedLayout, DrlgActLayout } = require('d2r/layouts');
 const { Seed } = require('d2r/seed');
 const { DrlgAct } = require('d2r/drlg-act');
+const { DynamicPath } = require('d2r/dynamic-path');
 const { Unit } = require('d2r/unit');
+const { UnitStore, UnitCollection } = require('d2r/unit-store');
+const { UnitBatch } = require('d2r/unit-batch');
 const { WorldObject } = require('d2r/world-object');
 const { Player, LocalPlayer } = require('d2r/player');
 const { Monster } = require('d2r/monster');
@@ -12,7 +26,15 @@ const { Item } = require('d2r/item');
 const { GameObject } = require('d2r/game-object');
 const { Missile } = require('d2r/missile');
 const { RoomTile } = require('d2r/room-tile');
+const { Inventory } = require('d2r/inventory');
+const { StatList } = require('d2r/stat-list');
+const { compileItemRules } = require('d2r/item-rules');
+const { DataTable, DataTableIds, getDataTables } = require('d2r/data-tables');
+const { CollisionMap } = require('d2r/collision-map');
+const { WidgetTree, WidgetFlags } = require('d2r/widget-tree');
+const { FrameTicker, onFrame } = require('d2r/frame-ticker');
 const { ObjectManager } = require('d2r/object-manager');
+const { SessionReplay } = require('d2r/session-replay');
 const { DebugPanel } = require('d2r/debug-panel');
 
 const binding = internalBinding('d2r');
@@ -22,15 +44,28 @@ module.exports = {
   PlayerModes,
   MonsterModes,
   ItemModes,
+  ItemQuality,
+  ItemFlags,
+  UnitFields,
+  InventoryChanges,
+  Stats,
 
   UnitModel,
   SeedModel,
   DrlgActModel,
 
+  UnitLayout,
+  SeedLayout,
+  DrlgActLayout,
+
   Seed,
   DrlgAct,
+  DynamicPath,
 
   Unit,
+  UnitStore,
+  UnitBatch,
+  UnitCollection,
   WorldObject,
   Player,
   LocalPlayer,
@@ -39,12 +74,33 @@ module.exports = {
   GameObject,
   Missile,
   RoomTile,
+  Inventory,
+  StatList,
+  compileItemRules,
+  DataTable,
+  DataTableIds,
+  getDataTables,
+  CollisionMap,
+  WidgetTree,
+  WidgetFlags,
+  FrameTicker,
+  onFrame,
 
   ObjectManager,
+  SessionReplay,
 
   DebugPanel,
 
   automapGetMode: binding.automapGetMode,
   worldToAutomap: binding.worldToAutomap,
+  worldToAutomapMany: binding.worldToAutomapMany,
   revealLevel: binding.revealLevel,
+
+  traceEnable: binding.traceEnable,
+  traceBegin: binding.traceBegin,
+  traceEnd: binding.traceEnd,
+  traceDump: binding.traceDump,
+
+  sessionRecordStart: binding.sessionRecordStart,
+  sessionRecordStop: binding.sessionRecordStop,
 };
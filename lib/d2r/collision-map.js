@@ -0,0 +1,54 @@
+'use strict';
+
+const { getMemorySource } = require('d2r/model-cache');
+
+// Mirrors the getCollisionMap() result in src/d2r_binding.cc.
+const HEADER_SIZE = 32;
+
+// Walkable subtiles of one level, merged natively from the collision grids of every room seen so far (see
+// src/collision_map.h) and kept across games of the same seed. Subtiles of rooms that were not loaded yet read as
+// blocked. Coordinates are absolute subtiles, like Unit.x / Unit.y.
+class CollisionMap {
+  constructor(levelId) {
+    this.levelId = levelId;
+    this.version = 0;
+    this.originX = 0;
+    this.originY = 0;
+    this.width = 0;
+    this.height = 0;
+    this._bytesPerRow = 0;
+    this._bits = new Uint8Array(0);
+  }
+
+  isWalkable(x, y) {
+    const column = x - this.originX;
+    const row = y - this.originY;
+    if (column < 0 || row < 0 || column >= this.width || row >= this.height) return false;
+    return (this._bits[row * this._bytesPerRow + (column >> 3)] & (1 << (column & 7))) !== 0;
+  }
+
+  // |buffer| is a getCollisionMap() result with a new version.
+  _apply(buffer) {
+    const header = new DataView(buffer, 0, HEADER_SIZE);
+    this.originX = header.getInt32(0, true);
+    this.originY = header.getInt32(4, true);
+    this.width = header.getUint32(8, true);
+    this.height = header.getUint32(12, true);
+    this.version = header.getUint32(16, true);
+    this._bytesPerRow = header.getUint32(20, true);
+    this._bits = new Uint8Array(buffer, HEADER_SIZE);
+  }
+}
+
+// Map of |levelId| in the local player's seed and difficulty, decoded into |target| (or a new CollisionMap). The
+// native side only copies the map when rooms were merged since |target|'s version. Null if the level was not seen.
+function loadCollisionMap(levelId, target) {
+  const result = getMemorySource().getCollisionMap(levelId, target && target.levelId === levelId ? target.version : 0);
+  if (result === undefined) return null;
+  if (typeof result === 'number') return target;
+  if (!target || target.levelId !== levelId) target = new CollisionMap(levelId);
+  target._apply(result);
+  return target;
+}
+
+module.exports = { CollisionMap, loadCollisionMap };
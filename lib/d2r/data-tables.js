@@ -0,0 +1,66 @@
+'use strict';
+
+const { getMemorySource } = require('d2r/model-cache');
+
+// Mirrors DataTableId in src/data_tables.h.
+const DataTableIds = {
+  LevelDefs: 0,
+  MonStats: 1,
+  Objects: 2,
+  Items: 3,
+};
+
+// Rows of one game data table. |view| covers the game's own memory (no copy), rows are |stride| bytes apart.
+class DataTable {
+  constructor(buffer, stride, count, address) {
+    this.view = new DataView(buffer);
+    this.stride = stride;
+    this.count = count;
+    this.address = address;
+  }
+
+  // Byte offset of row |index| in |view|, -1 if out of range.
+  offsetOf(index) {
+    return index >= 0 && index < this.count ? index * this.stride : -1;
+  }
+
+  // DataView over row |index|, null if out of range.
+  row(index) {
+    const offset = this.offsetOf(index);
+    return offset < 0 ? null : new DataView(this.view.buffer, offset, this.stride);
+  }
+
+  // Row index of a record pointer such as MonsterData.txtRecord, -1 if it is not a row of this table.
+  indexOf(address) {
+    if (!address || address < this.address) return -1;
+    const offset = Number(address - this.address);
+    if (offset >= this.count * this.stride || offset % this.stride !== 0) return -1;
+    return offset / this.stride;
+  }
+}
+
+// nDataTblsIndex -> { levelDefs, monStats, objects, items }, tables are resolved once and never move
+const cache = new Map();
+
+function loadTable(index, id) {
+  const result = getMemorySource().getDataTable(index, id);
+  return result ? new DataTable(result[0], result[1], result[2], result[3]) : null;
+}
+
+// Data tables of |index| (Unit.dataTblsIndex), null while the game has not loaded them. A table the native side
+// did not resolve is null: the monstats and objects tables until units confirmed their row size, items always.
+function getDataTables(index) {
+  let tables = cache.get(index);
+  if (tables === undefined) {
+    const levelDefs = loadTable(index, DataTableIds.LevelDefs);
+    if (!levelDefs) return null;
+    tables = { levelDefs, monStats: null, objects: null, items: null };
+    cache.set(index, tables);
+  }
+  // asked again until resolved, the native side rate-limits its checks
+  tables.monStats ??= loadTable(index, DataTableIds.MonStats);
+  tables.objects ??= loadTable(index, DataTableIds.Objects);
+  return tables;
+}
+
+module.exports = { DataTable, DataTableIds, getDataTables };
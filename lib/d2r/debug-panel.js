@@ -60,28 +60,46 @@ class DebugPanel {
       this._panel.add(this._headers[i]);
     }
 
-    objectManager.on('unitAdded', (unit, type) => this._onUnitAdded(unit, type));
-    objectManager.on('unitRemoved', (unit, type) => this._onUnitRemoved(unit, type));
+    // a level change adds and removes hundreds of units in one tick, relabel each header once per batch
+    this._onUnitsAdded = batch => this._addUnits(batch);
+    this._onUnitsRemoved = batch => this._removeUnits(batch);
+    objectManager.on('unitsAdded', this._onUnitsAdded);
+    objectManager.on('unitsRemoved', this._onUnitsRemoved);
   }
 
-  _onUnitAdded(unit, type) {
-    const node = new gui.TreeNode(this._unitLabel(unit));
-    const detail = new gui.Text(this._unitDetail(unit, type));
-    node.add(detail);
-    node._detail = detail;
-    node._unit = unit;
-
-    this._nodes[type].set(unit.id, node);
-    this._headers[type].add(node);
-    this._updateHeaderLabel(type);
+  _addUnits(batch) {
+    for (let type = 0; type < TYPE_COUNT; type++) {
+      const units = batch.units(type);
+      if (units.length === 0) continue;
+      const nodes = this._nodes[type];
+      const header = this._headers[type];
+      for (let i = 0; i < units.length; i++) {
+        const unit = units[i];
+        const node = new gui.TreeNode(this._unitLabel(unit));
+        const detail = new gui.Text(this._unitDetail(unit, type));
+        node.add(detail);
+        node._detail = detail;
+        node._unit = unit;
+        nodes.set(unit.id, node);
+        header.add(node);
+      }
+      this._updateHeaderLabel(type);
+    }
   }
 
-  _onUnitRemoved(unit, type) {
-    const node = this._nodes[type].get(unit.id);
-    if (node) {
-      node.destroy();
-      this._nodes[type].delete(unit.id);
-      this._updateHeaderLabel(type);
+  _removeUnits(batch) {
+    for (let type = 0; type < TYPE_COUNT; type++) {
+      const ids = batch.ids(type);
+      const nodes = this._nodes[type];
+      const size = nodes.size;
+      for (let i = 0; i < ids.length; i++) {
+        const node = nodes.get(ids[i]);
+        if (node) {
+          node.destroy();
+          nodes.delete(ids[i]);
+        }
+      }
+      if (nodes.size !== size) this._updateHeaderLabel(type);
     }
   }
 
@@ -154,8 +172,8 @@ class DebugPanel {
   }
 
   destroy() {
-    this._objMgr.off('unitAdded');
-    this._objMgr.off('unitRemoved');
+    this._objMgr.off('unitsAdded', this._onUnitsAdded);
+    this._objMgr.off('unitsRemoved', this._onUnitsRemoved);
     this._panel.destroy();
   }
 }
@@ -0,0 +1,28 @@
+'use strict';
+
+const { ActiveRoomLayout } = require('d2r/layouts');
+const { loadShared } = require('d2r/model-cache');
+
+// Decoded D2DynamicPathStrc. Scalar fields come from the tick snapshot, the room is read on access and shared with
+// every other path in the same room.
+class DynamicPath {
+  constructor() {
+    this._address = 0n;
+    this.gameCoords = {
+      fp16: { xOff: 0, x: 0, yOff: 0, y: 0 },
+      fp32: { x: 0, y: 0 },
+    };
+    this.clientCoordX = 0;
+    this.clientCoordY = 0;
+    this.targetCoord = { x: 0, y: 0 };
+    this.prevTargetCoord = { x: 0, y: 0 };
+    this.finalTargetCoord = { x: 0, y: 0 };
+    this._roomAddress = 0n;
+  }
+
+  get room() {
+    return loadShared(ActiveRoomLayout, this._roomAddress);
+  }
+}
+
+module.exports = { DynamicPath };
@@ -0,0 +1,70 @@
+'use strict';
+
+const binding = internalBinding('d2r');
+
+// frames are presented well within this, it only bounds the timer while the game is minimized or loading
+const MAX_WAIT_MS = 50;
+// pace without the frame hook (replays, hook failed to install)
+const FALLBACK_INTERVAL_MS = 16;
+
+// Runs callbacks on the frames the game presents (see src/frame_hook.h) instead of a fixed timer, so every tick sees
+// a new frame and none is skipped while the script keeps up. The timer is armed for the next expected present and
+// re-armed if it fires early, the script thread never blocks on the render thread.
+class FrameTicker {
+  constructor() {
+    this._subscribers = new Set();
+    this._frame = -1;
+    this._fallbackFrame = 0;
+    this._scheduled = false;
+  }
+
+  // Calls callback(frame, elapsed) every |every| frames, elapsed being the frames since its previous call (more
+  // than |every| if the script fell behind). Returns a handle whose stop() unsubscribes.
+  add(callback, every = 1) {
+    if (!Number.isInteger(every) || every < 1) throw new RangeError(`every must be a positive integer, got ${every}`);
+    const subscriber = { callback, every, next: 0, last: -1 };
+    this._subscribers.add(subscriber);
+    this._schedule(0);
+    return { stop: () => this._subscribers.delete(subscriber) };
+  }
+
+  _schedule(delay) {
+    if (this._scheduled || this._subscribers.size === 0) return;
+    this._scheduled = true;
+    setTimeout(() => this._step(), delay);
+  }
+
+  _step() {
+    this._scheduled = false;
+    if (this._subscribers.size === 0) return;
+
+    // rescheduled before the callbacks run, a throwing callback must not stop the ticks
+    let frame = binding.getFrame();
+    if (frame < 0) {
+      frame = this._fallbackFrame++;
+      this._schedule(FALLBACK_INTERVAL_MS);
+    } else {
+      // the next present is expected right after the one just seen, an early timer finds the frame unchanged
+      this._schedule(Math.max(binding.msUntilNextFrame(MAX_WAIT_MS), 1));
+      if (frame === this._frame) return;
+    }
+    this._frame = frame;
+
+    for (const subscriber of this._subscribers) {
+      if (frame < subscriber.next) continue;
+      const elapsed = subscriber.last < 0 ? 1 : frame - subscriber.last;
+      subscriber.last = frame;
+      subscriber.next = frame + subscriber.every;
+      subscriber.callback(frame, elapsed);
+    }
+  }
+}
+
+const ticker = new FrameTicker();
+
+// Calls callback(frame, elapsed) once per presented frame, or every |every| frames.
+function onFrame(callback, { every = 1 } = {}) {
+  return ticker.add(callback, every);
+}
+
+module.exports = { FrameTicker, onFrame };
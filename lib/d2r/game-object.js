@@ -1,13 +1,20 @@
 'use strict';
 
 const { Unit } = require('d2r/unit');
+const { GameObjectDataLayout } = require('d2r/layouts');
+const { loadModel } = require('d2r/model-cache');
+const { getDataTables } = require('d2r/data-tables');
+
+function readGameObjectData(data) { return loadModel(GameObjectDataLayout, this.data, data); }
 
 class GameObject extends Unit {
-  constructor() {
-    super();
-    this.on('update', (cursor) => {
-      this.gameObjectData = cursor.gameObjectData?.$toObject(this.gameObjectData) ?? null;
-    });
+  get gameObjectData() { return this._cached('gameObjectData', readGameObjectData); }
+
+  // Row of the object's txt record in the objects table, -1 if the table is not resolved.
+  get objectsIndex() {
+    const table = getDataTables(this.dataTblsIndex)?.objects;
+    const record = this.gameObjectData?.txtRecord;
+    return table && record ? table.indexOf(record) : -1;
   }
 }
 
@@ -0,0 +1,111 @@
+'use strict';
+
+const { ItemModes } = require('d2r/types');
+
+// Mirrors InventoryEntry in src/inventory_snapshot.h.
+const HEADER_SIZE = 8;
+const ENTRY_SIZE = 32;
+
+function cellKey(page, x, y) {
+  return page * 0x10000 + y * 0x100 + x;
+}
+
+function createItem(id) {
+  return {
+    id,
+    classId: 0,
+    mode: 0,
+    flags: 0,
+    quality: 0,
+    page: 0,
+    bodyLocation: 0,
+    nodePos: 0,
+    x: 0,
+    y: 0,
+    changed: 0,
+  };
+}
+
+// Items of one owner's inventory, refreshed by the ObjectManager from the native inventory reader while the owner is
+// watched (see ObjectManager.watchInventory). Items keep their object across updates.
+class Inventory {
+  constructor(owner) {
+    this.owner = owner;
+    this.items = new Map();  // item id -> entry
+    this.changed = [];       // entries added or changed by the last update
+    this.removed = [];       // ids of items that left the inventory in the last update
+    this._cells = new Map();
+    this._equipped = new Map();
+    this._synced = false;  // the native side reports every item as added until the first update
+  }
+
+  // Item whose top-left cell is (x, y) on |page|, null if none. Only the anchor cell is known, item sizes live in
+  // the item txt tables.
+  at(page, x, y) {
+    return this._cells.get(cellKey(page, x, y)) ?? null;
+  }
+
+  // Item equipped in |bodyLocation|, null if none.
+  equipped(bodyLocation) {
+    return this._equipped.get(bodyLocation) ?? null;
+  }
+
+  *onPage(page) {
+    for (const item of this.items.values()) {
+      if (item.mode === ItemModes.Stored && item.page === page) yield item;
+    }
+  }
+
+  // |buffer| is the result of snapshotInventory(). Returns true if anything changed.
+  _apply(buffer) {
+    const view = new DataView(buffer);
+    const count = view.getUint32(0, true);
+    const removedCount = view.getUint32(4, true);
+    this._synced = true;
+    this.changed = [];
+    this.removed = [];
+
+    for (let i = 0; i < removedCount; i++) {
+      const id = view.getUint32(HEADER_SIZE + count * ENTRY_SIZE + i * 4, true);
+      this.removed.push(id);
+      this.items.delete(id);
+    }
+    if (this.removed.length === 0 && !this._anyChanged(view, count)) return false;
+
+    this._cells.clear();
+    this._equipped.clear();
+    for (let i = 0; i < count; i++) {
+      const p = HEADER_SIZE + i * ENTRY_SIZE;
+      const id = view.getUint32(p, true);
+      let item = this.items.get(id);
+      if (!item) {
+        item = createItem(id);
+        this.items.set(id, item);
+      }
+      item.classId = view.getUint32(p + 4, true);
+      item.mode = view.getUint32(p + 8, true);
+      item.flags = view.getUint32(p + 12, true);
+      item.quality = view.getUint32(p + 16, true);
+      item.page = view.getUint8(p + 20);
+      item.bodyLocation = view.getUint8(p + 21);
+      item.nodePos = view.getUint8(p + 22);
+      item.x = view.getUint16(p + 24, true);
+      item.y = view.getUint16(p + 26, true);
+      item.changed = view.getUint32(p + 28, true);
+      if (item.changed !== 0) this.changed.push(item);
+
+      if (item.mode === ItemModes.Equipped) this._equipped.set(item.bodyLocation, item);
+      else if (item.mode === ItemModes.Stored) this._cells.set(cellKey(item.page, item.x, item.y), item);
+    }
+    return true;
+  }
+
+  _anyChanged(view, count) {
+    for (let i = 0; i < count; i++) {
+      if (view.getUint32(HEADER_SIZE + i * ENTRY_SIZE + 28, true) !== 0) return true;
+    }
+    return false;
+  }
+}
+
+module.exports = { Inventory };
@@ -0,0 +1,94 @@
+'use strict';
+
+// Compiles loot-filter style rules into the program src/item_rules.h evaluates natively whenever an item is first
+// seen or changes. A rule is an object of field conditions that must all hold, e.g.
+//
+//   { name: 'unique rings', classId: 522, quality: ItemQuality.Unique }
+//   { name: 'runes', classId: { min: 610, max: 642 } }
+//   { name: 'eth bases', classId: [255, 256, 300], flags: { all: ItemFlags.Ethereal, none: ItemFlags.Runeword } }
+//
+// A condition is a value (equal), an array (any of the values), { min, max } (inclusive range) or bit tests
+// { any, all, none }. magicPrefix and magicSuffix hold if any of the item's three affixes matches.
+
+const MAX_RULES = 32;
+
+// Mirrors ItemRuleOp in src/item_rules.h.
+const Op = {
+  Equal: 0,
+  Range: 1,
+  AnyBits: 2,
+  AllBits: 3,
+  NoBits: 4,
+  InSet: 5,
+  OneOf: 6,
+};
+
+// Mirrors ItemRuleField in src/item_rules.h.
+const ItemRuleFields = {
+  classId: 0,
+  mode: 1,
+  quality: 2,
+  flags: 3,
+  itemFormat: 4,
+  itemLevel: 5,
+  rarePrefix: 6,
+  rareSuffix: 7,
+  autoAffix: 8,
+  magicPrefix: 9,
+  magicSuffix: 10,
+};
+
+function emit(words, op, field, operands) {
+  words.push((op | (field << 8) | (operands.length << 16)) >>> 0, ...operands.map(value => value >>> 0));
+}
+
+function compileCondition(words, name, field, condition) {
+  if (typeof condition === 'number') {
+    emit(words, Op.Equal, field, [condition]);
+  } else if (Array.isArray(condition)) {
+    if (condition.length === 0) throw new TypeError(`item rule '${name}': empty value list`);
+    const base = Math.min(...condition);
+    const spread = Math.max(...condition) - base + 1;
+    // a bitmap while it is not longer than the list itself
+    if (Math.ceil(spread / 32) > condition.length) {
+      emit(words, Op.OneOf, field, condition);
+      return;
+    }
+    const bitmap = new Array(Math.ceil(spread / 32)).fill(0);
+    for (const value of condition) bitmap[(value - base) >> 5] |= 1 << ((value - base) & 31);
+    emit(words, Op.InSet, field, [base, ...bitmap]);
+  } else if (condition && typeof condition === 'object') {
+    const { min, max, any, all, none } = condition;
+    if (min === undefined && max === undefined && any === undefined && all === undefined && none === undefined) {
+      throw new TypeError(`item rule '${name}': condition needs one of min, max, any, all or none`);
+    }
+    if (min !== undefined || max !== undefined) emit(words, Op.Range, field, [min ?? 0, max ?? 0xFFFFFFFF]);
+    if (any !== undefined) emit(words, Op.AnyBits, field, [any]);
+    if (all !== undefined) emit(words, Op.AllBits, field, [all]);
+    if (none !== undefined) emit(words, Op.NoBits, field, [none]);
+  } else {
+    throw new TypeError(`item rule '${name}': unsupported condition ${condition}`);
+  }
+}
+
+// Returns { program, names }: the Uint32Array for setItemRules() and the rule names by match bit.
+function compileItemRules(rules) {
+  if (rules.length > MAX_RULES) throw new RangeError(`at most ${MAX_RULES} item rules are supported`);
+  const words = [rules.length];
+  const names = [];
+  for (const [index, rule] of rules.entries()) {
+    const name = rule.name ?? `rule ${index}`;
+    const conditions = [];
+    for (const [key, condition] of Object.entries(rule)) {
+      if (key === 'name') continue;
+      const field = ItemRuleFields[key];
+      if (field === undefined) throw new TypeError(`item rule '${name}': unknown field '${key}'`);
+      compileCondition(conditions, name, field, condition);
+    }
+    words.push(conditions.length, ...conditions);
+    names.push(name);
+  }
+  return { program: Uint32Array.from(words), names };
+}
+
+module.exports = { compileItemRules, ItemRuleFields };
@@ -2,13 +2,24 @@
 
 const { Unit } = require('d2r/unit');
 const { ItemModes } = require('d2r/types');
+const { ItemDataLayout } = require('d2r/layouts');
+const { loadModel } = require('d2r/model-cache');
+const { recordItemRules } = require('d2r/unit-snapshot');
+
+function readItemData(data) { return loadModel(ItemDataLayout, this.data, data); }
 
 class Item extends Unit {
-  constructor() {
-    super();
-    this.on('update', (cursor) => {
-      this.itemData = cursor.itemData?.$toObject(this.itemData) ?? null;
-    });
+  get itemData() { return this._cached('itemData', readItemData); }
+
+  // Bitmask of the rules set with ObjectManager.setItemRules() this item matches, evaluated natively when the item
+  // was added or changed.
+  get ruleMask() {
+    const record = this._record();
+    return record < 0 ? 0 : recordItemRules(this._store.view, record);
+  }
+
+  matchesRule(index) {
+    return (this.ruleMask & (1 << index)) !== 0;
   }
 
   get isOnGround() {
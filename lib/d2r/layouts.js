@@ -0,0 +1,1071 @@
+'use strict';
+
+// Generated by tools/structgen/generate.js from tools/structgen/schema.js, do not edit.
+//
+// Fixed-offset decoders for the structs in d2r/models. Every layout has
+//   size                          struct size in bytes
+//   offsets                       field name -> byte offset
+//   create()                      a zeroed object, always the same shape
+//   decode(view, offset, target)  fills |target| (or a new object) from the DataView at |offset|
+// Pointers and 64-bit fields decode to BigInt. Pointers to another scripted struct decode to a getter that
+// returns the pointed-to struct, decoded at most once per tick and shared by everything that points at it (see
+// loadShared() in d2r/model-cache).
+
+const { loadShared } = require('d2r/model-cache');
+
+function readString(view, offset, length) {
+  let value = '';
+  for (let i = 0; i < length; i++) {
+    const c = view.getUint8(offset + i);
+    if (c === 0) break;
+    value += String.fromCharCode(c);
+  }
+  return value;
+}
+
+const SeedLayout = {
+  size: 0x0008,
+  offsets: {
+    low: 0x0000,
+    high: 0x0004,
+  },
+  create() {
+    return {
+      low: 0,
+      high: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= SeedLayout.create();
+    target.low = view.getUint32(offset + 0x0000, true);
+    target.high = view.getUint32(offset + 0x0004, true);
+    return target;
+  },
+};
+
+const D2FP16Layout = {
+  size: 0x0008,
+  offsets: {
+    xOff: 0x0000,
+    x: 0x0002,
+    yOff: 0x0004,
+    y: 0x0006,
+  },
+  create() {
+    return {
+      xOff: 0,
+      x: 0,
+      yOff: 0,
+      y: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= D2FP16Layout.create();
+    target.xOff = view.getUint16(offset + 0x0000, true);
+    target.x = view.getUint16(offset + 0x0002, true);
+    target.yOff = view.getUint16(offset + 0x0004, true);
+    target.y = view.getUint16(offset + 0x0006, true);
+    return target;
+  },
+};
+
+const D2FP32Layout = {
+  size: 0x0008,
+  offsets: {
+    x: 0x0000,
+    y: 0x0004,
+  },
+  create() {
+    return {
+      x: 0,
+      y: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= D2FP32Layout.create();
+    target.x = view.getUint32(offset + 0x0000, true);
+    target.y = view.getUint32(offset + 0x0004, true);
+    return target;
+  },
+};
+
+const D2FP32_16Layout = {
+  size: 0x0008,
+  offsets: {
+    fp16: 0x0000,
+    fp32: 0x0000,
+  },
+  create() {
+    return {
+      fp16: D2FP16Layout.create(),
+      fp32: D2FP32Layout.create(),
+    };
+  },
+  decode(view, offset, target) {
+    target ??= D2FP32_16Layout.create();
+    D2FP16Layout.decode(view, offset + 0x0000, target.fp16);
+    D2FP32Layout.decode(view, offset + 0x0000, target.fp32);
+    return target;
+  },
+};
+
+const PathPointLayout = {
+  size: 0x0004,
+  offsets: {
+    x: 0x0000,
+    y: 0x0002,
+  },
+  create() {
+    return {
+      x: 0,
+      y: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= PathPointLayout.create();
+    target.x = view.getUint16(offset + 0x0000, true);
+    target.y = view.getUint16(offset + 0x0002, true);
+    return target;
+  },
+};
+
+const DrlgCoordsLayout = {
+  size: 0x0020,
+  offsets: {
+    subtileX: 0x0000,
+    subtileY: 0x0004,
+    subtileWidth: 0x0008,
+    subtileHeight: 0x000C,
+    tileX: 0x0010,
+    tileY: 0x0014,
+    tileWidth: 0x0018,
+    tileHeight: 0x001C,
+  },
+  create() {
+    return {
+      subtileX: 0,
+      subtileY: 0,
+      subtileWidth: 0,
+      subtileHeight: 0,
+      tileX: 0,
+      tileY: 0,
+      tileWidth: 0,
+      tileHeight: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= DrlgCoordsLayout.create();
+    target.subtileX = view.getUint32(offset + 0x0000, true);
+    target.subtileY = view.getUint32(offset + 0x0004, true);
+    target.subtileWidth = view.getUint32(offset + 0x0008, true);
+    target.subtileHeight = view.getUint32(offset + 0x000C, true);
+    target.tileX = view.getUint32(offset + 0x0010, true);
+    target.tileY = view.getUint32(offset + 0x0014, true);
+    target.tileWidth = view.getUint32(offset + 0x0018, true);
+    target.tileHeight = view.getUint32(offset + 0x001C, true);
+    return target;
+  },
+};
+
+const DrlgCoordLayout = {
+  size: 0x0010,
+  offsets: {
+    backCornerTileX: 0x0000,
+    backCornerTileY: 0x0004,
+    sizeTileX: 0x0008,
+    sizeTileY: 0x000C,
+  },
+  create() {
+    return {
+      backCornerTileX: 0,
+      backCornerTileY: 0,
+      sizeTileX: 0,
+      sizeTileY: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= DrlgCoordLayout.create();
+    target.backCornerTileX = view.getUint32(offset + 0x0000, true);
+    target.backCornerTileY = view.getUint32(offset + 0x0004, true);
+    target.sizeTileX = view.getUint32(offset + 0x0008, true);
+    target.sizeTileY = view.getUint32(offset + 0x000C, true);
+    return target;
+  },
+};
+
+class DrlgRoomStruct {
+  constructor() {
+    this.initSeed = 0;
+    this.seed = SeedLayout.create();
+    this.statusNext = 0n;
+    this.maze = 0n;
+    this.drlgRoomNext = 0n;
+    this.flags = 0;
+    this.handleRoom = 0n;
+    this.roomCoords = DrlgCoordLayout.create();
+    this.roomStatus = 0;
+    this.type = 0;
+    this.roomTiles = 0n;
+    this.dt1Mask = 0;
+    this._levelAddress = 0n;
+    this.presetUnits = 0n;
+    this.statusPrev = 0n;
+    this.uniqueID = 0n;
+  }
+
+  get level() { return loadShared(DrlgLevelLayout, this._levelAddress); }
+}
+
+const DrlgRoomLayout = {
+  size: 0x01C0,
+  offsets: {
+    initSeed: 0x0008,
+    seed: 0x0030,
+    statusNext: 0x0038,
+    maze: 0x0040,
+    drlgRoomNext: 0x0048,
+    flags: 0x0050,
+    handleRoom: 0x0058,
+    roomCoords: 0x0060,
+    roomStatus: 0x0070,
+    type: 0x0074,
+    roomTiles: 0x0078,
+    dt1Mask: 0x0080,
+    level: 0x0090,
+    presetUnits: 0x0098,
+    statusPrev: 0x01B0,
+    uniqueID: 0x01B8,
+  },
+  create() {
+    return new DrlgRoomStruct();
+  },
+  decode(view, offset, target) {
+    target ??= DrlgRoomLayout.create();
+    target.initSeed = view.getUint32(offset + 0x0008, true);
+    SeedLayout.decode(view, offset + 0x0030, target.seed);
+    target.statusNext = view.getBigUint64(offset + 0x0038, true);
+    target.maze = view.getBigUint64(offset + 0x0040, true);
+    target.drlgRoomNext = view.getBigUint64(offset + 0x0048, true);
+    target.flags = view.getUint32(offset + 0x0050, true);
+    target.handleRoom = view.getBigUint64(offset + 0x0058, true);
+    DrlgCoordLayout.decode(view, offset + 0x0060, target.roomCoords);
+    target.roomStatus = view.getUint8(offset + 0x0070);
+    target.type = view.getUint32(offset + 0x0074, true);
+    target.roomTiles = view.getBigUint64(offset + 0x0078, true);
+    target.dt1Mask = view.getUint32(offset + 0x0080, true);
+    target._levelAddress = view.getBigUint64(offset + 0x0090, true);
+    target.presetUnits = view.getBigUint64(offset + 0x0098, true);
+    target.statusPrev = view.getBigUint64(offset + 0x01B0, true);
+    target.uniqueID = view.getBigUint64(offset + 0x01B8, true);
+    return target;
+  },
+};
+
+class ActiveRoomStruct {
+  constructor() {
+    this.roomList = 0n;
+    this.roomTiles = 0n;
+    this._drlgRoomAddress = 0n;
+    this.collisionGrid = 0n;
+    this.roomCount = 0;
+    this.unitCount = 0;
+    this.drlgAct = 0n;
+    this.flags = 0;
+    this.coords = DrlgCoordsLayout.create();
+    this.seed = SeedLayout.create();
+    this.unitFirst = 0n;
+    this.roomNext = 0n;
+  }
+
+  get drlgRoom() { return loadShared(DrlgRoomLayout, this._drlgRoomAddress); }
+}
+
+const ActiveRoomLayout = {
+  size: 0x00C0,
+  offsets: {
+    roomList: 0x0000,
+    roomTiles: 0x0008,
+    drlgRoom: 0x0018,
+    collisionGrid: 0x0038,
+    roomCount: 0x0040,
+    unitCount: 0x0044,
+    drlgAct: 0x0048,
+    flags: 0x0054,
+    coords: 0x0080,
+    seed: 0x00A0,
+    unitFirst: 0x00A8,
+    roomNext: 0x00B0,
+  },
+  create() {
+    return new ActiveRoomStruct();
+  },
+  decode(view, offset, target) {
+    target ??= ActiveRoomLayout.create();
+    target.roomList = view.getBigUint64(offset + 0x0000, true);
+    target.roomTiles = view.getBigUint64(offset + 0x0008, true);
+    target._drlgRoomAddress = view.getBigUint64(offset + 0x0018, true);
+    target.collisionGrid = view.getBigUint64(offset + 0x0038, true);
+    target.roomCount = view.getUint32(offset + 0x0040, true);
+    target.unitCount = view.getUint32(offset + 0x0044, true);
+    target.drlgAct = view.getBigUint64(offset + 0x0048, true);
+    target.flags = view.getUint32(offset + 0x0054, true);
+    DrlgCoordsLayout.decode(view, offset + 0x0080, target.coords);
+    SeedLayout.decode(view, offset + 0x00A0, target.seed);
+    target.unitFirst = view.getBigUint64(offset + 0x00A8, true);
+    target.roomNext = view.getBigUint64(offset + 0x00B0, true);
+    return target;
+  },
+};
+
+const DrlgLevelLayout = {
+  size: 0x0280,
+  offsets: {
+    drlgType: 0x0000,
+    flags: 0x0004,
+    roomCount: 0x0008,
+    roomFirst: 0x0010,
+    maze: 0x0018,
+    coords: 0x0028,
+    nextLevel: 0x01B8,
+    currentMap: 0x01C0,
+    drlg: 0x01C8,
+    levelType: 0x01E0,
+    seed: 0x01E4,
+    id: 0x01F8,
+    roomCenterWarpX: 0x0208,
+    roomCenterWarpY: 0x022C,
+    centerWarpCount: 0x0250,
+  },
+  create() {
+    return {
+      drlgType: 0,
+      flags: 0,
+      roomCount: 0,
+      roomFirst: 0n,
+      maze: 0n,
+      coords: DrlgCoordLayout.create(),
+      nextLevel: 0n,
+      currentMap: 0n,
+      drlg: 0n,
+      levelType: 0,
+      seed: SeedLayout.create(),
+      id: 0,
+      roomCenterWarpX: [0, 0, 0, 0, 0, 0, 0, 0, 0],
+      roomCenterWarpY: [0, 0, 0, 0, 0, 0, 0, 0, 0],
+      centerWarpCount: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= DrlgLevelLayout.create();
+    target.drlgType = view.getUint32(offset + 0x0000, true);
+    target.flags = view.getUint32(offset + 0x0004, true);
+    target.roomCount = view.getInt32(offset + 0x0008, true);
+    target.roomFirst = view.getBigUint64(offset + 0x0010, true);
+    target.maze = view.getBigUint64(offset + 0x0018, true);
+    DrlgCoordLayout.decode(view, offset + 0x0028, target.coords);
+    target.nextLevel = view.getBigUint64(offset + 0x01B8, true);
+    target.currentMap = view.getBigUint64(offset + 0x01C0, true);
+    target.drlg = view.getBigUint64(offset + 0x01C8, true);
+    target.levelType = view.getUint32(offset + 0x01E0, true);
+    SeedLayout.decode(view, offset + 0x01E4, target.seed);
+    target.id = view.getUint32(offset + 0x01F8, true);
+    target.roomCenterWarpX[0] = view.getInt32(offset + 0x0208, true);
+    target.roomCenterWarpX[1] = view.getInt32(offset + 0x020C, true);
+    target.roomCenterWarpX[2] = view.getInt32(offset + 0x0210, true);
+    target.roomCenterWarpX[3] = view.getInt32(offset + 0x0214, true);
+    target.roomCenterWarpX[4] = view.getInt32(offset + 0x0218, true);
+    target.roomCenterWarpX[5] = view.getInt32(offset + 0x021C, true);
+    target.roomCenterWarpX[6] = view.getInt32(offset + 0x0220, true);
+    target.roomCenterWarpX[7] = view.getInt32(offset + 0x0224, true);
+    target.roomCenterWarpX[8] = view.getInt32(offset + 0x0228, true);
+    target.roomCenterWarpY[0] = view.getInt32(offset + 0x022C, true);
+    target.roomCenterWarpY[1] = view.getInt32(offset + 0x0230, true);
+    target.roomCenterWarpY[2] = view.getInt32(offset + 0x0234, true);
+    target.roomCenterWarpY[3] = view.getInt32(offset + 0x0238, true);
+    target.roomCenterWarpY[4] = view.getInt32(offset + 0x023C, true);
+    target.roomCenterWarpY[5] = view.getInt32(offset + 0x0240, true);
+    target.roomCenterWarpY[6] = view.getInt32(offset + 0x0244, true);
+    target.roomCenterWarpY[7] = view.getInt32(offset + 0x0248, true);
+    target.roomCenterWarpY[8] = view.getInt32(offset + 0x024C, true);
+    target.centerWarpCount = view.getUint32(offset + 0x0250, true);
+    return target;
+  },
+};
+
+const DrlgLayout = {
+  size: 0x0880,
+  offsets: {
+    seed: 0x0000,
+    allocatedRooms: 0x0008,
+    flags: 0x0110,
+    warp: 0x0118,
+    staffLevelOffset: 0x0120,
+    game: 0x0128,
+    statusRoomsList: 0x0130,
+    difficulty: 0x0830,
+    pfnAutomap: 0x0838,
+    initSeed: 0x0840,
+    jungleInterlink: 0x0844,
+    drlgRoom: 0x0848,
+    act: 0x0858,
+    startSeed: 0x0860,
+    level: 0x0868,
+    actNo: 0x0870,
+    bossLevelOffset: 0x0874,
+    pfnTownAutomap: 0x0878,
+  },
+  create() {
+    return {
+      seed: SeedLayout.create(),
+      allocatedRooms: 0,
+      flags: 0,
+      warp: 0n,
+      staffLevelOffset: 0,
+      game: 0n,
+      statusRoomsList: Array.from({ length: 4 }, () => DrlgRoomLayout.create()),
+      difficulty: 0,
+      pfnAutomap: 0n,
+      initSeed: 0,
+      jungleInterlink: 0,
+      drlgRoom: 0n,
+      act: 0n,
+      startSeed: 0,
+      level: 0n,
+      actNo: 0,
+      bossLevelOffset: 0,
+      pfnTownAutomap: 0n,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= DrlgLayout.create();
+    SeedLayout.decode(view, offset + 0x0000, target.seed);
+    target.allocatedRooms = view.getUint32(offset + 0x0008, true);
+    target.flags = view.getUint32(offset + 0x0110, true);
+    target.warp = view.getBigUint64(offset + 0x0118, true);
+    target.staffLevelOffset = view.getUint32(offset + 0x0120, true);
+    target.game = view.getBigUint64(offset + 0x0128, true);
+    DrlgRoomLayout.decode(view, offset + 0x0130, target.statusRoomsList[0]);
+    DrlgRoomLayout.decode(view, offset + 0x02F0, target.statusRoomsList[1]);
+    DrlgRoomLayout.decode(view, offset + 0x04B0, target.statusRoomsList[2]);
+    DrlgRoomLayout.decode(view, offset + 0x0670, target.statusRoomsList[3]);
+    target.difficulty = view.getUint8(offset + 0x0830);
+    target.pfnAutomap = view.getBigUint64(offset + 0x0838, true);
+    target.initSeed = view.getUint32(offset + 0x0840, true);
+    target.jungleInterlink = view.getUint32(offset + 0x0844, true);
+    target.drlgRoom = view.getBigUint64(offset + 0x0848, true);
+    target.act = view.getBigUint64(offset + 0x0858, true);
+    target.startSeed = view.getUint32(offset + 0x0860, true);
+    target.level = view.getBigUint64(offset + 0x0868, true);
+    target.actNo = view.getUint8(offset + 0x0870);
+    target.bossLevelOffset = view.getUint32(offset + 0x0874, true);
+    target.pfnTownAutomap = view.getBigUint64(offset + 0x0878, true);
+    return target;
+  },
+};
+
+class DrlgActStruct {
+  constructor() {
+    this.update = 0;
+    this.environment = 0n;
+    this.initSeed = SeedLayout.create();
+    this._roomAddress = 0n;
+    this.actId = 0;
+    this.tileData = 0n;
+    this._drlgAddress = 0n;
+    this.actCallback = 0n;
+  }
+
+  get room() { return loadShared(ActiveRoomLayout, this._roomAddress); }
+  get drlg() { return loadShared(DrlgLayout, this._drlgAddress); }
+}
+
+const DrlgActLayout = {
+  size: 0x0090,
+  offsets: {
+    update: 0x0000,
+    environment: 0x0008,
+    initSeed: 0x0010,
+    room: 0x0018,
+    actId: 0x0020,
+    tileData: 0x0048,
+    drlg: 0x0070,
+    actCallback: 0x0078,
+  },
+  create() {
+    return new DrlgActStruct();
+  },
+  decode(view, offset, target) {
+    target ??= DrlgActLayout.create();
+    target.update = view.getUint32(offset + 0x0000, true);
+    target.environment = view.getBigUint64(offset + 0x0008, true);
+    SeedLayout.decode(view, offset + 0x0010, target.initSeed);
+    target._roomAddress = view.getBigUint64(offset + 0x0018, true);
+    target.actId = view.getUint32(offset + 0x0020, true);
+    target.tileData = view.getBigUint64(offset + 0x0048, true);
+    target._drlgAddress = view.getBigUint64(offset + 0x0070, true);
+    target.actCallback = view.getBigUint64(offset + 0x0078, true);
+    return target;
+  },
+};
+
+class DynamicPathStruct {
+  constructor() {
+    this.gameCoords = D2FP32_16Layout.create();
+    this.clientCoordX = 0;
+    this.clientCoordY = 0;
+    this.targetCoord = PathPointLayout.create();
+    this.prevTargetCoord = PathPointLayout.create();
+    this.finalTargetCoord = PathPointLayout.create();
+    this._roomAddress = 0n;
+    this.previousRoom = 0n;
+    this.currentPointIndex = 0;
+    this.pathPointCount = 0;
+    this.unit = 0n;
+    this.flags = 0;
+    this.pathType = 0;
+    this.prevPathType = 0;
+    this.unitSize = 0;
+    this.collisionPattern = 0;
+    this.footprintCollisionMask = 0;
+    this.moveTestCollisionMask = 0;
+    this.targetUnit = 0n;
+    this.targetType = 0;
+    this.targetId = 0;
+    this.velocity = 0;
+    this.previousVelocity = 0;
+    this.maxVelocity = 0;
+    this.pathPoints = Array.from({ length: 78 }, () => PathPointLayout.create());
+    this.savedStepCount = 0;
+    this.savedSteps = Array.from({ length: 10 }, () => PathPointLayout.create());
+  }
+
+  get room() { return loadShared(ActiveRoomLayout, this._roomAddress); }
+}
+
+const DynamicPathLayout = {
+  size: 0x0230,
+  offsets: {
+    gameCoords: 0x0000,
+    clientCoordX: 0x0008,
+    clientCoordY: 0x000C,
+    targetCoord: 0x0010,
+    prevTargetCoord: 0x0014,
+    finalTargetCoord: 0x0018,
+    room: 0x0020,
+    previousRoom: 0x0028,
+    currentPointIndex: 0x0030,
+    pathPointCount: 0x0034,
+    unit: 0x0040,
+    flags: 0x0048,
+    pathType: 0x0050,
+    prevPathType: 0x0054,
+    unitSize: 0x0058,
+    collisionPattern: 0x005C,
+    footprintCollisionMask: 0x0060,
+    moveTestCollisionMask: 0x0064,
+    targetUnit: 0x0070,
+    targetType: 0x0078,
+    targetId: 0x007C,
+    velocity: 0x00A0,
+    previousVelocity: 0x00A4,
+    maxVelocity: 0x00A8,
+    pathPoints: 0x00C8,
+    savedStepCount: 0x0200,
+    savedSteps: 0x0204,
+  },
+  create() {
+    return new DynamicPathStruct();
+  },
+  decode(view, offset, target) {
+    target ??= DynamicPathLayout.create();
+    D2FP32_16Layout.decode(view, offset + 0x0000, target.gameCoords);
+    target.clientCoordX = view.getInt32(offset + 0x0008, true);
+    target.clientCoordY = view.getInt32(offset + 0x000C, true);
+    PathPointLayout.decode(view, offset + 0x0010, target.targetCoord);
+    PathPointLayout.decode(view, offset + 0x0014, target.prevTargetCoord);
+    PathPointLayout.decode(view, offset + 0x0018, target.finalTargetCoord);
+    target._roomAddress = view.getBigUint64(offset + 0x0020, true);
+    target.previousRoom = view.getBigUint64(offset + 0x0028, true);
+    target.currentPointIndex = view.getUint32(offset + 0x0030, true);
+    target.pathPointCount = view.getUint32(offset + 0x0034, true);
+    target.unit = view.getBigUint64(offset + 0x0040, true);
+    target.flags = view.getUint32(offset + 0x0048, true);
+    target.pathType = view.getUint32(offset + 0x0050, true);
+    target.prevPathType = view.getUint32(offset + 0x0054, true);
+    target.unitSize = view.getUint32(offset + 0x0058, true);
+    target.collisionPattern = view.getUint32(offset + 0x005C, true);
+    target.footprintCollisionMask = view.getUint32(offset + 0x0060, true);
+    target.moveTestCollisionMask = view.getUint32(offset + 0x0064, true);
+    target.targetUnit = view.getBigUint64(offset + 0x0070, true);
+    target.targetType = view.getUint32(offset + 0x0078, true);
+    target.targetId = view.getUint32(offset + 0x007C, true);
+    target.velocity = view.getInt32(offset + 0x00A0, true);
+    target.previousVelocity = view.getInt32(offset + 0x00A4, true);
+    target.maxVelocity = view.getInt32(offset + 0x00A8, true);
+    for (let i = 0; i < 78; i++) {
+      PathPointLayout.decode(view, offset + 0x00C8 + i * 0x0004, target.pathPoints[i]);
+    }
+    target.savedStepCount = view.getUint32(offset + 0x0200, true);
+    PathPointLayout.decode(view, offset + 0x0204, target.savedSteps[0]);
+    PathPointLayout.decode(view, offset + 0x0208, target.savedSteps[1]);
+    PathPointLayout.decode(view, offset + 0x020C, target.savedSteps[2]);
+    PathPointLayout.decode(view, offset + 0x0210, target.savedSteps[3]);
+    PathPointLayout.decode(view, offset + 0x0214, target.savedSteps[4]);
+    PathPointLayout.decode(view, offset + 0x0218, target.savedSteps[5]);
+    PathPointLayout.decode(view, offset + 0x021C, target.savedSteps[6]);
+    PathPointLayout.decode(view, offset + 0x0220, target.savedSteps[7]);
+    PathPointLayout.decode(view, offset + 0x0224, target.savedSteps[8]);
+    PathPointLayout.decode(view, offset + 0x0228, target.savedSteps[9]);
+    return target;
+  },
+};
+
+class SkillStruct {
+  constructor() {
+    this.skillsTxt = 0n;
+    this._nextAddress = 0n;
+    this.mode = 0;
+    this.flags = 0;
+    this.baseLevel = 0;
+    this.quantity = 0;
+    this.ownerId = 0;
+    this.charges = 0;
+  }
+
+  get next() { return loadShared(SkillLayout, this._nextAddress); }
+}
+
+const SkillLayout = {
+  size: 0x0050,
+  offsets: {
+    skillsTxt: 0x0000,
+    next: 0x0008,
+    mode: 0x0010,
+    flags: 0x0014,
+    baseLevel: 0x0038,
+    quantity: 0x0040,
+    ownerId: 0x0044,
+    charges: 0x0048,
+  },
+  create() {
+    return new SkillStruct();
+  },
+  decode(view, offset, target) {
+    target ??= SkillLayout.create();
+    target.skillsTxt = view.getBigUint64(offset + 0x0000, true);
+    target._nextAddress = view.getBigUint64(offset + 0x0008, true);
+    target.mode = view.getUint32(offset + 0x0010, true);
+    target.flags = view.getUint32(offset + 0x0014, true);
+    target.baseLevel = view.getUint32(offset + 0x0038, true);
+    target.quantity = view.getInt32(offset + 0x0040, true);
+    target.ownerId = view.getInt32(offset + 0x0044, true);
+    target.charges = view.getInt32(offset + 0x0048, true);
+    return target;
+  },
+};
+
+class SkillListStruct {
+  constructor() {
+    this._firstAddress = 0n;
+    this._leftAddress = 0n;
+    this._rightAddress = 0n;
+    this._usedAddress = 0n;
+  }
+
+  get first() { return loadShared(SkillLayout, this._firstAddress); }
+  get left() { return loadShared(SkillLayout, this._leftAddress); }
+  get right() { return loadShared(SkillLayout, this._rightAddress); }
+  get used() { return loadShared(SkillLayout, this._usedAddress); }
+}
+
+const SkillListLayout = {
+  size: 0x0020,
+  offsets: {
+    first: 0x0000,
+    left: 0x0008,
+    right: 0x0010,
+    used: 0x0018,
+  },
+  create() {
+    return new SkillListStruct();
+  },
+  decode(view, offset, target) {
+    target ??= SkillListLayout.create();
+    target._firstAddress = view.getBigUint64(offset + 0x0000, true);
+    target._leftAddress = view.getBigUint64(offset + 0x0008, true);
+    target._rightAddress = view.getBigUint64(offset + 0x0010, true);
+    target._usedAddress = view.getBigUint64(offset + 0x0018, true);
+    return target;
+  },
+};
+
+const PlayerDataLayout = {
+  size: 0x0080,
+  offsets: {
+    name: 0x0000,
+    questBuffers: 0x0040,
+    waypointBuffers: 0x0058,
+    portalFlags: 0x0078,
+  },
+  create() {
+    return {
+      name: '',
+      questBuffers: [0n, 0n, 0n],
+      waypointBuffers: [0n, 0n, 0n],
+      portalFlags: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= PlayerDataLayout.create();
+    target.name = readString(view, offset + 0x0000, 16);
+    target.questBuffers[0] = view.getBigUint64(offset + 0x0040, true);
+    target.questBuffers[1] = view.getBigUint64(offset + 0x0048, true);
+    target.questBuffers[2] = view.getBigUint64(offset + 0x0050, true);
+    target.waypointBuffers[0] = view.getBigUint64(offset + 0x0058, true);
+    target.waypointBuffers[1] = view.getBigUint64(offset + 0x0060, true);
+    target.waypointBuffers[2] = view.getBigUint64(offset + 0x0068, true);
+    target.portalFlags = view.getUint32(offset + 0x0078, true);
+    return target;
+  },
+};
+
+const MonsterDataLayout = {
+  size: 0x0058,
+  offsets: {
+    txtRecord: 0x0000,
+    nameSeed: 0x0018,
+    typeFlag: 0x001A,
+    lastAnimMode: 0x001B,
+    durielFlag: 0x001C,
+    monUMod: 0x0020,
+    uniqueId: 0x002A,
+    ownerType: 0x0050,
+    ownerId: 0x0054,
+  },
+  create() {
+    return {
+      txtRecord: 0n,
+      nameSeed: 0,
+      typeFlag: 0,
+      lastAnimMode: 0,
+      durielFlag: 0,
+      monUMod: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+      uniqueId: 0,
+      ownerType: 0,
+      ownerId: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= MonsterDataLayout.create();
+    target.txtRecord = view.getBigUint64(offset + 0x0000, true);
+    target.nameSeed = view.getUint16(offset + 0x0018, true);
+    target.typeFlag = view.getUint8(offset + 0x001A);
+    target.lastAnimMode = view.getUint8(offset + 0x001B);
+    target.durielFlag = view.getUint32(offset + 0x001C, true);
+    target.monUMod[0] = view.getUint8(offset + 0x0020);
+    target.monUMod[1] = view.getUint8(offset + 0x0021);
+    target.monUMod[2] = view.getUint8(offset + 0x0022);
+    target.monUMod[3] = view.getUint8(offset + 0x0023);
+    target.monUMod[4] = view.getUint8(offset + 0x0024);
+    target.monUMod[5] = view.getUint8(offset + 0x0025);
+    target.monUMod[6] = view.getUint8(offset + 0x0026);
+    target.monUMod[7] = view.getUint8(offset + 0x0027);
+    target.monUMod[8] = view.getUint8(offset + 0x0028);
+    target.monUMod[9] = view.getUint8(offset + 0x0029);
+    target.uniqueId = view.getUint16(offset + 0x002A, true);
+    target.ownerType = view.getUint32(offset + 0x0050, true);
+    target.ownerId = view.getUint32(offset + 0x0054, true);
+    return target;
+  },
+};
+
+const GameObjectDataLayout = {
+  size: 0x0010,
+  offsets: {
+    txtRecord: 0x0000,
+    type: 0x0008,
+  },
+  create() {
+    return {
+      txtRecord: 0n,
+      type: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= GameObjectDataLayout.create();
+    target.txtRecord = view.getBigUint64(offset + 0x0000, true);
+    target.type = view.getUint8(offset + 0x0008);
+    return target;
+  },
+};
+
+const InventoryLayout = {
+  size: 0x0048,
+  offsets: {
+    signature: 0x0000,
+    owner: 0x0010,
+    firstItem: 0x0018,
+    lastItem: 0x0020,
+    grids: 0x0028,
+    gridCount: 0x0030,
+    weaponId: 0x0034,
+    cursorItem: 0x0038,
+    ownerId: 0x0040,
+    itemCount: 0x0044,
+  },
+  create() {
+    return {
+      signature: 0,
+      owner: 0n,
+      firstItem: 0n,
+      lastItem: 0n,
+      grids: 0n,
+      gridCount: 0,
+      weaponId: 0,
+      cursorItem: 0n,
+      ownerId: 0,
+      itemCount: 0,
+    };
+  },
+  decode(view, offset, target) {
+    target ??= InventoryLayout.create();
+    target.signature = view.getUint32(offset + 0x0000, true);
+    target.owner = view.getBigUint64(offset + 0x0010, true);
+    target.firstItem = view.getBigUint64(offset + 0x0018, true);
+    target.lastItem = view.getBigUint64(offset + 0x0020, true);
+    target.grids = view.getBigUint64(offset + 0x0028, true);
+    target.gridCount = view.getInt32(offset + 0x0030, true);
+    target.weaponId = view.getUint32(offset + 0x0034, true);
+    target.cursorItem = view.getBigUint64(offset + 0x0038, true);
+    target.ownerId = view.getUint32(offset + 0x0040, true);
+    target.itemCount = view.getUint32(offset + 0x0044, true);
+    return target;
+  },
+};
+
+class ItemDataStruct {
+  constructor() {
+    this.quality = 0;
+    this.seed = SeedLayout.create();
+    this.ownerId = 0;
+    this.flags = 0;
+    this.itemLevel = 0;
+    this.itemFormat = 0;
+    this.rarePrefix = 0;
+    this.rareSuffix = 0;
+    this.autoAffix = 0;
+    this.magicPrefix = [0, 0, 0];
+    this.magicSuffix = [0, 0, 0];
+    this.bodyLocation = 0;
+    this.inventoryPage = 0;
+    this.ownerInventory = 0n;
+    this._itemPrevAddress = 0n;
+    this._itemNextAddress = 0n;
+    this.nodePos = 0;
+    this.nodePosEx = 0;
+  }
+
+  get itemPrev() { return loadShared(UnitLayout, this._itemPrevAddress); }
+  get itemNext() { return loadShared(UnitLayout, this._itemNextAddress); }
+}
+
+const ItemDataLayout = {
+  size: 0x00C0,
+  offsets: {
+    quality: 0x0000,
+    seed: 0x0004,
+    ownerId: 0x000C,
+    flags: 0x0018,
+    itemLevel: 0x0038,
+    itemFormat: 0x0040,
+    rarePrefix: 0x0042,
+    rareSuffix: 0x0044,
+    autoAffix: 0x0046,
+    magicPrefix: 0x0048,
+    magicSuffix: 0x004E,
+    bodyLocation: 0x0054,
+    inventoryPage: 0x0055,
+    ownerInventory: 0x00A0,
+    itemPrev: 0x00A8,
+    itemNext: 0x00B0,
+    nodePos: 0x00B8,
+    nodePosEx: 0x00B9,
+  },
+  create() {
+    return new ItemDataStruct();
+  },
+  decode(view, offset, target) {
+    target ??= ItemDataLayout.create();
+    target.quality = view.getUint32(offset + 0x0000, true);
+    SeedLayout.decode(view, offset + 0x0004, target.seed);
+    target.ownerId = view.getUint32(offset + 0x000C, true);
+    target.flags = view.getUint32(offset + 0x0018, true);
+    target.itemLevel = view.getUint32(offset + 0x0038, true);
+    target.itemFormat = view.getUint16(offset + 0x0040, true);
+    target.rarePrefix = view.getUint16(offset + 0x0042, true);
+    target.rareSuffix = view.getUint16(offset + 0x0044, true);
+    target.autoAffix = view.getUint16(offset + 0x0046, true);
+    target.magicPrefix[0] = view.getUint16(offset + 0x0048, true);
+    target.magicPrefix[1] = view.getUint16(offset + 0x004A, true);
+    target.magicPrefix[2] = view.getUint16(offset + 0x004C, true);
+    target.magicSuffix[0] = view.getUint16(offset + 0x004E, true);
+    target.magicSuffix[1] = view.getUint16(offset + 0x0050, true);
+    target.magicSuffix[2] = view.getUint16(offset + 0x0052, true);
+    target.bodyLocation = view.getUint8(offset + 0x0054);
+    target.inventoryPage = view.getUint8(offset + 0x0055);
+    target.ownerInventory = view.getBigUint64(offset + 0x00A0, true);
+    target._itemPrevAddress = view.getBigUint64(offset + 0x00A8, true);
+    target._itemNextAddress = view.getBigUint64(offset + 0x00B0, true);
+    target.nodePos = view.getUint8(offset + 0x00B8);
+    target.nodePosEx = view.getUint8(offset + 0x00B9);
+    return target;
+  },
+};
+
+class UnitStruct {
+  constructor() {
+    this.type = 0;
+    this.classId = 0;
+    this.id = 0;
+    this.mode = 0;
+    this.data = { playerData: 0n, monsterData: 0n, itemData: 0n, gameObjectData: 0n };
+    this.actId = 0n;
+    this._drlgActAddress = 0n;
+    this.seed = SeedLayout.create();
+    this.initSeed = SeedLayout.create();
+    this._pathAddress = 0n;
+    this.animSeqFrame = 0;
+    this.animSeqFrame2 = 0;
+    this.animSeqFrameCount = 0;
+    this.animSpeed = 0;
+    this.animData = 0n;
+    this.gfxData = 0n;
+    this.statListEx = 0n;
+    this.inventory = 0n;
+    this.packetList = 0n;
+    this.posX = 0;
+    this.posY = 0;
+    this.resourceId = 0n;
+    this._skillsAddress = 0n;
+    this.flags = 0;
+    this.flagsEx = 0;
+    this.changeNextUnit = 0n;
+    this.unitNext = 0n;
+    this.roomUnitNext = 0n;
+    this.collisionUnitType = 0;
+    this.collisionUnitClassId = 0;
+    this.collisionUnitSizeX = 0;
+    this.collisionUnitSizeY = 0;
+    this.dataTblsIndex = 0;
+  }
+
+  get drlgAct() { return loadShared(DrlgActLayout, this._drlgActAddress); }
+  get path() { return loadShared(DynamicPathLayout, this._pathAddress); }
+  get skills() { return loadShared(SkillListLayout, this._skillsAddress); }
+}
+
+const UnitLayout = {
+  size: 0x01C0,
+  offsets: {
+    type: 0x0000,
+    classId: 0x0004,
+    id: 0x0008,
+    mode: 0x000C,
+    data: 0x0010,
+    actId: 0x0018,
+    drlgAct: 0x0020,
+    seed: 0x0028,
+    initSeed: 0x0030,
+    path: 0x0038,
+    animSeqFrame: 0x005C,
+    animSeqFrame2: 0x0060,
+    animSeqFrameCount: 0x0064,
+    animSpeed: 0x0068,
+    animData: 0x0070,
+    gfxData: 0x0078,
+    statListEx: 0x0088,
+    inventory: 0x0090,
+    packetList: 0x00C0,
+    posX: 0x00D4,
+    posY: 0x00D6,
+    resourceId: 0x00D8,
+    skills: 0x0100,
+    flags: 0x0124,
+    flagsEx: 0x0128,
+    changeNextUnit: 0x0150,
+    unitNext: 0x0158,
+    roomUnitNext: 0x0160,
+    collisionUnitType: 0x0178,
+    collisionUnitClassId: 0x017C,
+    collisionUnitSizeX: 0x0180,
+    collisionUnitSizeY: 0x0184,
+    dataTblsIndex: 0x01BD,
+  },
+  create() {
+    return new UnitStruct();
+  },
+  decode(view, offset, target) {
+    target ??= UnitLayout.create();
+    target.type = view.getUint32(offset + 0x0000, true);
+    target.classId = view.getUint32(offset + 0x0004, true);
+    target.id = view.getUint32(offset + 0x0008, true);
+    target.mode = view.getUint32(offset + 0x000C, true);
+    target.data.playerData = view.getBigUint64(offset + 0x0010, true);
+    target.data.monsterData = target.data.playerData;
+    target.data.itemData = target.data.playerData;
+    target.data.gameObjectData = target.data.playerData;
+    target.actId = view.getBigUint64(offset + 0x0018, true);
+    target._drlgActAddress = view.getBigUint64(offset + 0x0020, true);
+    SeedLayout.decode(view, offset + 0x0028, target.seed);
+    SeedLayout.decode(view, offset + 0x0030, target.initSeed);
+    target._pathAddress = view.getBigUint64(offset + 0x0038, true);
+    target.animSeqFrame = view.getUint32(offset + 0x005C, true);
+    target.animSeqFrame2 = view.getUint32(offset + 0x0060, true);
+    target.animSeqFrameCount = view.getUint32(offset + 0x0064, true);
+    target.animSpeed = view.getUint32(offset + 0x0068, true);
+    target.animData = view.getBigUint64(offset + 0x0070, true);
+    target.gfxData = view.getBigUint64(offset + 0x0078, true);
+    target.statListEx = view.getBigUint64(offset + 0x0088, true);
+    target.inventory = view.getBigUint64(offset + 0x0090, true);
+    target.packetList = view.getBigUint64(offset + 0x00C0, true);
+    target.posX = view.getInt16(offset + 0x00D4, true);
+    target.posY = view.getInt16(offset + 0x00D6, true);
+    target.resourceId = view.getBigUint64(offset + 0x00D8, true);
+    target._skillsAddress = view.getBigUint64(offset + 0x0100, true);
+    target.flags = view.getUint32(offset + 0x0124, true);
+    target.flagsEx = view.getUint32(offset + 0x0128, true);
+    target.changeNextUnit = view.getBigUint64(offset + 0x0150, true);
+    target.unitNext = view.getBigUint64(offset + 0x0158, true);
+    target.roomUnitNext = view.getBigUint64(offset + 0x0160, true);
+    target.collisionUnitType = view.getUint32(offset + 0x0178, true);
+    target.collisionUnitClassId = view.getUint32(offset + 0x017C, true);
+    target.collisionUnitSizeX = view.getUint32(offset + 0x0180, true);
+    target.collisionUnitSizeY = view.getUint32(offset + 0x0184, true);
+    target.dataTblsIndex = view.getUint8(offset + 0x01BD);
+    return target;
+  },
+};
+
+module.exports = {
+  SeedLayout,
+  D2FP16Layout,
+  D2FP32Layout,
+  D2FP32_16Layout,
+  PathPointLayout,
+  DrlgCoordsLayout,
+  DrlgCoordLayout,
+  DrlgRoomLayout,
+  ActiveRoomLayout,
+  DrlgLevelLayout,
+  DrlgLayout,
+  DrlgActLayout,
+  DynamicPathLayout,
+  SkillLayout,
+  SkillListLayout,
+  PlayerDataLayout,
+  MonsterDataLayout,
+  GameObjectDataLayout,
+  InventoryLayout,
+  ItemDataLayout,
+  UnitLayout,
+};
@@ -0,0 +1,65 @@
+'use strict';
+
+const { tryWithGameLock } = require('memory');
+
+// Where loadModel() reads from: internalBinding('d2r') for the live game, the ObjectManager swaps in its source
+// (e.g. a SessionReplay). |lock| stalls the game around reads that must not race its threads.
+let source = internalBinding('d2r');
+let lock = tryWithGameLock;
+
+function setMemorySource(binding, withLock = tryWithGameLock) {
+  source = binding;
+  lock = withLock;
+}
+
+function getMemorySource() {
+  return source;
+}
+
+// Runs |fn| with the game stalled, undefined if the lock timed out.
+function withGameLock(fn) {
+  return lock(fn);
+}
+
+// Decode the struct at |address| through |layout| (see d2r/layouts) into |target| (or a new object).
+// Reads live memory, only used for structs that are not part of the tick snapshot.
+function loadModel(layout, address, target) {
+  if (!address) return null;
+  const view = source.readMemory(address, layout.size);
+  if (!view) return null;
+  return layout.decode(view, 0, target);
+}
+
+// Per-layout address -> decoded struct memo for structs many units point at (rooms, levels, acts). |current| holds
+// what was decoded this tick, |previous| last tick's objects, which are decoded into again so a struct keeps its
+// object for as long as something reads it every tick.
+const memos = new Map();
+
+// Like loadModel(), but decodes the struct at |address| at most once per tick and hands every caller the same
+// object. Followed pointers of the layouts resolve through here.
+function loadShared(layout, address) {
+  if (!address) return null;
+  let memo = memos.get(layout);
+  if (!memo) {
+    memo = { current: new Map(), previous: new Map() };
+    memos.set(layout, memo);
+  }
+  let value = memo.current.get(address);
+  if (value === undefined) {
+    value = loadModel(layout, address, memo.previous.get(address));
+    memo.current.set(address, value);
+  }
+  return value;
+}
+
+// Called by the ObjectManager at the start of every tick, everything loadShared() returned so far is stale.
+function invalidateSharedModels() {
+  for (const memo of memos.values()) {
+    const stale = memo.previous;
+    memo.previous = memo.current;
+    memo.current = stale;
+    stale.clear();
+  }
+}
+
+module.exports = { loadModel, loadShared, invalidateSharedModels, setMemorySource, getMemorySource, withGameLock };
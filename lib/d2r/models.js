@@ -1,300 +1,369 @@
 'use strict';
 
+// Generated by tools/structgen/generate.js from tools/structgen/schema.js, do not edit.
+
 const { MemoryModel, DataTypes } = require('memory');
 
 const SeedModel = MemoryModel.define('SeedModel', [
-  { name: 'low', type: DataTypes.Uint32 },
-  { name: 'high', type: DataTypes.Uint32 },
-]);
+  { name: 'low', type: DataTypes.Uint32 },   // 0x0000
+  { name: 'high', type: DataTypes.Uint32 },  // 0x0004
+], null, { expectedSize: 0x0008 });
 
-const DrlgCoordModel = MemoryModel.define('DrlgCoordModel', [
-  { name: 'backCornerTileX', type: DataTypes.Uint32 },
-  { name: 'backCornerTileY', type: DataTypes.Uint32 },
-  { name: 'sizeTileX', type: DataTypes.Uint32 },
-  { name: 'sizeTileY', type: DataTypes.Uint32 },
-]);
+const D2FP16Model = MemoryModel.define('D2FP16Model', [
+  { name: 'xOff', type: DataTypes.Uint16 },  // 0x0000
+  { name: 'x', type: DataTypes.Uint16 },     // 0x0002
+  { name: 'yOff', type: DataTypes.Uint16 },  // 0x0004
+  { name: 'y', type: DataTypes.Uint16 },     // 0x0006
+], null, { expectedSize: 0x0008 });
+
+const D2FP32Model = MemoryModel.define('D2FP32Model', [
+  { name: 'x', type: DataTypes.Uint32 },  // 0x0000
+  { name: 'y', type: DataTypes.Uint32 },  // 0x0004
+], null, { expectedSize: 0x0008 });
+
+const D2FP32_16Model = MemoryModel.define('D2FP32_16Model', [
+  { type: DataTypes.Union, fields: [  // 0x0000
+    { name: 'fp16', model: D2FP16Model },
+    { name: 'fp32', model: D2FP32Model },
+  ] },
+], null, { expectedSize: 0x0008 });
+
+const PathPointModel = MemoryModel.define('PathPointModel', [
+  { name: 'x', type: DataTypes.Uint16 },  // 0x0000
+  { name: 'y', type: DataTypes.Uint16 },  // 0x0002
+], null, { packed: true, expectedSize: 0x0004 });
 
 const DrlgCoordsModel = MemoryModel.define('DrlgCoordsModel', [
-  { name: 'subtileX', type: DataTypes.Uint32 }, // backCornerTileX
-  { name: 'subtileY', type: DataTypes.Uint32 }, // backCornerTileY
-  { name: 'subtileWidth', type: DataTypes.Uint32 }, // sizeGameX
-  { name: 'subtileHeight', type: DataTypes.Uint32 }, // sizeGameY
-  { name: 'tileX', type: DataTypes.Uint32 }, // sizeTileX
-  { name: 'tileY', type: DataTypes.Uint32 }, // sizeTileY
-  { name: 'tileWidth', type: DataTypes.Uint32 },
-  { name: 'tileHeight', type: DataTypes.Uint32 },
-]);
+  { name: 'subtileX', type: DataTypes.Uint32 },       // 0x0000
+  { name: 'subtileY', type: DataTypes.Uint32 },       // 0x0004
+  { name: 'subtileWidth', type: DataTypes.Uint32 },   // 0x0008
+  { name: 'subtileHeight', type: DataTypes.Uint32 },  // 0x000C
+  { name: 'tileX', type: DataTypes.Uint32 },          // 0x0010
+  { name: 'tileY', type: DataTypes.Uint32 },          // 0x0014
+  { name: 'tileWidth', type: DataTypes.Uint32 },      // 0x0018
+  { name: 'tileHeight', type: DataTypes.Uint32 },     // 0x001C
+], null, { expectedSize: 0x0020 });
 
-const DrlgLevelModel = MemoryModel.define('DrlgLevelModel', [
-  { type: DataTypes.Padding, length: 504 }, // todo: add whatever is here
-  { name: 'id', type: DataTypes.Uint32 },
-]);
+const DrlgCoordModel = MemoryModel.define('DrlgCoordModel', [
+  { name: 'backCornerTileX', type: DataTypes.Uint32 },  // 0x0000
+  { name: 'backCornerTileY', type: DataTypes.Uint32 },  // 0x0004
+  { name: 'sizeTileX', type: DataTypes.Uint32 },        // 0x0008
+  { name: 'sizeTileY', type: DataTypes.Uint32 },        // 0x000C
+], null, { expectedSize: 0x0010 });
 
 const DrlgRoomModel = MemoryModel.define('DrlgRoomModel', [
-  { type: DataTypes.Padding, length: 8 },
-  { name: 'initSeed', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { type: DataTypes.Padding, length: 28 }, // contains vector<DrlgRoom>
-  { name: 'seed', model: SeedModel },
-  { name: 'statusNext', type: DataTypes.Pointer },
-  { name: 'maze', type: DataTypes.Pointer },
-  { name: 'drlgRoomNext', type: DataTypes.Pointer },
-  { name: 'flags', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'handleRoom', type: DataTypes.Pointer },
-  { name: 'roomCoords', model: DrlgCoordModel },
-  { name: 'roomStatus', type: DataTypes.Uint8 },
-  { type: DataTypes.Padding, length: 3 },
-  { name: 'type', type: DataTypes.Uint32 },
-  { name: 'roomTiles', type: DataTypes.Pointer },
-  { name: 'dt1Mask', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { type: DataTypes.Padding, length: 8 }, // a pointer
-  { name: 'level', type: DataTypes.Pointer, model: DrlgLevelModel },
-  { name: 'presetUnits', type: DataTypes.Pointer },
-  { type: DataTypes.Padding, length: 16 },
-  { type: DataTypes.Padding, length: 8 * 32 }, // tile pointers
-  { name: 'statusPrev', type: DataTypes.Pointer },
-  { name: 'uniqueID', type: DataTypes.Uint64 },
+  { type: DataTypes.Padding, length: 8 },                                   // 0x0000
+  { name: 'initSeed', type: DataTypes.Uint32 },                             // 0x0008
+  { type: DataTypes.Padding, length: 36 },                                  // 0x000C
+  { name: 'seed', model: SeedModel },                                       // 0x0030
+  { name: 'statusNext', type: DataTypes.Pointer },                          // 0x0038
+  { name: 'maze', type: DataTypes.Pointer },                                // 0x0040
+  { name: 'drlgRoomNext', type: DataTypes.Pointer },                        // 0x0048
+  { name: 'flags', type: DataTypes.Uint32 },                                // 0x0050
+  { type: DataTypes.Padding, length: 4 },                                   // 0x0054
+  { name: 'handleRoom', type: DataTypes.Pointer },                          // 0x0058
+  { name: 'roomCoords', model: DrlgCoordModel },                            // 0x0060
+  { name: 'roomStatus', type: DataTypes.Uint8 },                            // 0x0070
+  { type: DataTypes.Padding, length: 3 },                                   // 0x0071
+  { name: 'type', type: DataTypes.Uint32 },                                 // 0x0074
+  { name: 'roomTiles', type: DataTypes.Pointer },                           // 0x0078
+  { name: 'dt1Mask', type: DataTypes.Uint32 },                              // 0x0080
+  { type: DataTypes.Padding, length: 12 },                                  // 0x0084
+  { name: 'level', type: DataTypes.Pointer, model: () => DrlgLevelModel },  // 0x0090
+  { name: 'presetUnits', type: DataTypes.Pointer },                         // 0x0098
+  { type: DataTypes.Padding, length: 272 },                                 // 0x00A0
+  { name: 'statusPrev', type: DataTypes.Pointer },                          // 0x01B0
+  { name: 'uniqueID', type: DataTypes.Uint64 },                             // 0x01B8
 ], null, { expectedSize: 0x01C0 });
 
-const DrlgModel = MemoryModel.define('DrlgModel', [
-  { name: 'seed', model: SeedModel },
-  { name: 'allocatedRooms', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { type: DataTypes.Padding, length: 8 * 32 }, // tile pointers
-  { name: 'flags', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'warp', type: DataTypes.Pointer },
-  { name: 'staffLevelOffset', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'game', type: DataTypes.Pointer },
-  { name: 'statusRoomsList', model: DrlgRoomModel, count: 4 },
-  { name: 'difficulty', type: DataTypes.Uint8 },
-  { type: DataTypes.Padding, length: 7 },
-  { name: 'pfnAutomap', type: DataTypes.Pointer },
-  { name: 'initSeed', type: DataTypes.Uint32 },
-  { name: 'jungleInterlink', type: DataTypes.Uint32 },
-  { name: 'drlgRoom', type: DataTypes.Pointer }, // DrlgRoomModel*
-  { type: DataTypes.Padding, length: 8 },
-  { name: 'act', type: DataTypes.Pointer }, // DrlgActModel*
-  { name: 'startSeed', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'level', type: DataTypes.Pointer }, // DrlgLevelModel*
-  { name: 'actNo', type: DataTypes.Uint8 },
-  { type: DataTypes.Padding, length: 3 },
-  { name: 'bossLevelOffset', type: DataTypes.Uint32 },
-  { name: 'pfnTownAutomap', type: DataTypes.Pointer },
-]);
-
 const ActiveRoomModel = MemoryModel.define('ActiveRoomModel', [
-  { name: 'roomList', type: DataTypes.Pointer }, // ActiveRoomModel*[8]
-  { name: 'roomTiles', type: DataTypes.Pointer },
-  { type: DataTypes.Padding, length: 8 },
-  { name: 'drlgRoom', type: DataTypes.Pointer, model: DrlgRoomModel },
-  { type: DataTypes.Padding, length: 24 },
-  { name: 'collisionGrid', type: DataTypes.Pointer },
-  { name: 'roomCount', type: DataTypes.Uint32 },
-  { name: 'unitCount', type: DataTypes.Uint32 },
-  { name: 'drlgAct', type: DataTypes.Pointer },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'flags', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 40 },
-  { name: 'coords', model: DrlgCoordsModel },
-  { name: 'seed', model: SeedModel },
-  { name: 'unitFirst', type: DataTypes.Pointer },
-  { name: 'roomNext', type: DataTypes.Pointer },
-  { type: DataTypes.Padding, length: 8 },
-]);
-
-const DrlgActModel = MemoryModel.define('DrlgActModel', [
-  { name: 'update', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'environment', type: DataTypes.Pointer },
-  { name: 'initSeed', model: SeedModel },
-  { name: 'room', type: DataTypes.Pointer, model: ActiveRoomModel },
-  { name: 'actId', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 36 },
-  { name: 'tileData', type: DataTypes.Pointer },
-  { type: DataTypes.Padding, length: 32 },
-  { name: 'drlg', type: DataTypes.Pointer, model: DrlgModel },
-  { name: 'actCallback', type: DataTypes.Pointer },
-  { type: DataTypes.Padding, length: 16 },
-]);
-
-const PathPointModel = MemoryModel.define('PathPointModel', [
-  { name: 'x', type: DataTypes.Uint16 },
-  { name: 'y', type: DataTypes.Uint16 },
-], null, { packed: true });
+  { name: 'roomList', type: DataTypes.Pointer },                        // 0x0000
+  { name: 'roomTiles', type: DataTypes.Pointer },                       // 0x0008
+  { type: DataTypes.Padding, length: 8 },                               // 0x0010
+  { name: 'drlgRoom', type: DataTypes.Pointer, model: DrlgRoomModel },  // 0x0018
+  { type: DataTypes.Padding, length: 24 },                              // 0x0020
+  { name: 'collisionGrid', type: DataTypes.Pointer },                   // 0x0038
+  { name: 'roomCount', type: DataTypes.Uint32 },                        // 0x0040
+  { name: 'unitCount', type: DataTypes.Uint32 },                        // 0x0044
+  { name: 'drlgAct', type: DataTypes.Pointer },                         // 0x0048
+  { type: DataTypes.Padding, length: 4 },                               // 0x0050
+  { name: 'flags', type: DataTypes.Uint32 },                            // 0x0054
+  { type: DataTypes.Padding, length: 40 },                              // 0x0058
+  { name: 'coords', model: DrlgCoordsModel },                           // 0x0080
+  { name: 'seed', model: SeedModel },                                   // 0x00A0
+  { name: 'unitFirst', type: DataTypes.Pointer },                       // 0x00A8
+  { name: 'roomNext', type: DataTypes.Pointer },                        // 0x00B0
+  { type: DataTypes.Padding, length: 8 },                               // 0x00B8
+], null, { expectedSize: 0x00C0 });
 
-const D2FP16Model = MemoryModel.define('D2FP16Model', [
-  { name: "xOff", type: DataTypes.Uint16 },
-  { name: "x", type: DataTypes.Uint16 },
-  { name: "yOff", type: DataTypes.Uint16 },
-  { name: "y", type: DataTypes.Uint16 },
-]);
+const DrlgLevelModel = MemoryModel.define('DrlgLevelModel', [
+  { name: 'drlgType', type: DataTypes.Uint32 },                  // 0x0000
+  { name: 'flags', type: DataTypes.Uint32 },                     // 0x0004
+  { name: 'roomCount', type: DataTypes.Int32 },                  // 0x0008
+  { type: DataTypes.Padding, length: 4 },                        // 0x000C
+  { name: 'roomFirst', type: DataTypes.Pointer },                // 0x0010
+  { name: 'maze', type: DataTypes.Pointer },                     // 0x0018
+  { type: DataTypes.Padding, length: 8 },                        // 0x0020
+  { name: 'coords', model: DrlgCoordModel },                     // 0x0028
+  { type: DataTypes.Padding, length: 384 },                      // 0x0038
+  { name: 'nextLevel', type: DataTypes.Pointer },                // 0x01B8
+  { name: 'currentMap', type: DataTypes.Pointer },               // 0x01C0
+  { name: 'drlg', type: DataTypes.Pointer },                     // 0x01C8
+  { type: DataTypes.Padding, length: 16 },                       // 0x01D0
+  { name: 'levelType', type: DataTypes.Uint32 },                 // 0x01E0
+  { name: 'seed', model: SeedModel },                            // 0x01E4
+  { type: DataTypes.Padding, length: 12 },                       // 0x01EC
+  { name: 'id', type: DataTypes.Uint32 },                        // 0x01F8
+  { type: DataTypes.Padding, length: 12 },                       // 0x01FC
+  { name: 'roomCenterWarpX', type: DataTypes.Int32, count: 9 },  // 0x0208
+  { name: 'roomCenterWarpY', type: DataTypes.Int32, count: 9 },  // 0x022C
+  { name: 'centerWarpCount', type: DataTypes.Uint32 },           // 0x0250
+  { type: DataTypes.Padding, length: 44 },                       // 0x0254
+], null, { expectedSize: 0x0280 });
 
-const D2FP32Model = MemoryModel.define('D2FP32Model', [
-  { name: "x", type: DataTypes.Uint32 },
-  { name: "y", type: DataTypes.Uint32 },
-]);
+const DrlgModel = MemoryModel.define('DrlgModel', [
+  { name: 'seed', model: SeedModel },                           // 0x0000
+  { name: 'allocatedRooms', type: DataTypes.Uint32 },           // 0x0008
+  { type: DataTypes.Padding, length: 260 },                     // 0x000C
+  { name: 'flags', type: DataTypes.Uint32 },                    // 0x0110
+  { type: DataTypes.Padding, length: 4 },                       // 0x0114
+  { name: 'warp', type: DataTypes.Pointer },                    // 0x0118
+  { name: 'staffLevelOffset', type: DataTypes.Uint32 },         // 0x0120
+  { type: DataTypes.Padding, length: 4 },                       // 0x0124
+  { name: 'game', type: DataTypes.Pointer },                    // 0x0128
+  { name: 'statusRoomsList', model: DrlgRoomModel, count: 4 },  // 0x0130
+  { name: 'difficulty', type: DataTypes.Uint8 },                // 0x0830
+  { type: DataTypes.Padding, length: 7 },                       // 0x0831
+  { name: 'pfnAutomap', type: DataTypes.Pointer },              // 0x0838
+  { name: 'initSeed', type: DataTypes.Uint32 },                 // 0x0840
+  { name: 'jungleInterlink', type: DataTypes.Uint32 },          // 0x0844
+  { name: 'drlgRoom', type: DataTypes.Pointer },                // 0x0848
+  { type: DataTypes.Padding, length: 8 },                       // 0x0850
+  { name: 'act', type: DataTypes.Pointer },                     // 0x0858
+  { name: 'startSeed', type: DataTypes.Uint32 },                // 0x0860
+  { type: DataTypes.Padding, length: 4 },                       // 0x0864
+  { name: 'level', type: DataTypes.Pointer },                   // 0x0868
+  { name: 'actNo', type: DataTypes.Uint8 },                     // 0x0870
+  { type: DataTypes.Padding, length: 3 },                       // 0x0871
+  { name: 'bossLevelOffset', type: DataTypes.Uint32 },          // 0x0874
+  { name: 'pfnTownAutomap', type: DataTypes.Pointer },          // 0x0878
+], null, { expectedSize: 0x0880 });
 
-const D2FP32_16Model = MemoryModel.define('D2FP32_16Model', [
-  {
-    type: DataTypes.Union,
-    fields: [
-      { name: "fp16", model: D2FP16Model },
-      { name: "fp32", model: D2FP32Model },
-    ]
-  },
-]);
+const DrlgActModel = MemoryModel.define('DrlgActModel', [
+  { name: 'update', type: DataTypes.Uint32 },                         // 0x0000
+  { type: DataTypes.Padding, length: 4 },                             // 0x0004
+  { name: 'environment', type: DataTypes.Pointer },                   // 0x0008
+  { name: 'initSeed', model: SeedModel },                             // 0x0010
+  { name: 'room', type: DataTypes.Pointer, model: ActiveRoomModel },  // 0x0018
+  { name: 'actId', type: DataTypes.Uint32 },                          // 0x0020
+  { type: DataTypes.Padding, length: 36 },                            // 0x0024
+  { name: 'tileData', type: DataTypes.Pointer },                      // 0x0048
+  { type: DataTypes.Padding, length: 32 },                            // 0x0050
+  { name: 'drlg', type: DataTypes.Pointer, model: DrlgModel },        // 0x0070
+  { name: 'actCallback', type: DataTypes.Pointer },                   // 0x0078
+  { type: DataTypes.Padding, length: 16 },                            // 0x0080
+], null, { expectedSize: 0x0090 });
 
 const DynamicPathModel = MemoryModel.define('DynamicPathModel', [
-  { name: "gameCoords", model: D2FP32_16Model },
-  { name: 'clientCoordX', type: DataTypes.Int32 },
-  { name: 'clientCoordY', type: DataTypes.Int32 },
-  { name: 'targetCoord', model: PathPointModel },
-  { name: 'prevTargetCoord', model: PathPointModel },
-  { name: 'finalTargetCoord', model: PathPointModel },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'room', type: DataTypes.Pointer, model: ActiveRoomModel },
-], null, { packed: true });
+  { name: 'gameCoords', model: D2FP32_16Model },                      // 0x0000
+  { name: 'clientCoordX', type: DataTypes.Int32 },                    // 0x0008
+  { name: 'clientCoordY', type: DataTypes.Int32 },                    // 0x000C
+  { name: 'targetCoord', model: PathPointModel },                     // 0x0010
+  { name: 'prevTargetCoord', model: PathPointModel },                 // 0x0014
+  { name: 'finalTargetCoord', model: PathPointModel },                // 0x0018
+  { type: DataTypes.Padding, length: 4 },                             // 0x001C
+  { name: 'room', type: DataTypes.Pointer, model: ActiveRoomModel },  // 0x0020
+  { name: 'previousRoom', type: DataTypes.Pointer },                  // 0x0028
+  { name: 'currentPointIndex', type: DataTypes.Uint32 },              // 0x0030
+  { name: 'pathPointCount', type: DataTypes.Uint32 },                 // 0x0034
+  { type: DataTypes.Padding, length: 8 },                             // 0x0038
+  { name: 'unit', type: DataTypes.Pointer },                          // 0x0040
+  { name: 'flags', type: DataTypes.Uint32 },                          // 0x0048
+  { type: DataTypes.Padding, length: 4 },                             // 0x004C
+  { name: 'pathType', type: DataTypes.Uint32 },                       // 0x0050
+  { name: 'prevPathType', type: DataTypes.Uint32 },                   // 0x0054
+  { name: 'unitSize', type: DataTypes.Uint32 },                       // 0x0058
+  { name: 'collisionPattern', type: DataTypes.Uint32 },               // 0x005C
+  { name: 'footprintCollisionMask', type: DataTypes.Uint32 },         // 0x0060
+  { name: 'moveTestCollisionMask', type: DataTypes.Uint32 },          // 0x0064
+  { type: DataTypes.Padding, length: 8 },                             // 0x0068
+  { name: 'targetUnit', type: DataTypes.Pointer },                    // 0x0070
+  { name: 'targetType', type: DataTypes.Uint32 },                     // 0x0078
+  { name: 'targetId', type: DataTypes.Uint32 },                       // 0x007C
+  { type: DataTypes.Padding, length: 32 },                            // 0x0080
+  { name: 'velocity', type: DataTypes.Int32 },                        // 0x00A0
+  { name: 'previousVelocity', type: DataTypes.Int32 },                // 0x00A4
+  { name: 'maxVelocity', type: DataTypes.Int32 },                     // 0x00A8
+  { type: DataTypes.Padding, length: 28 },                            // 0x00AC
+  { name: 'pathPoints', model: PathPointModel, count: 78 },           // 0x00C8
+  { name: 'savedStepCount', type: DataTypes.Uint32 },                 // 0x0200
+  { name: 'savedSteps', model: PathPointModel, count: 10 },           // 0x0204
+  { type: DataTypes.Padding, length: 4 },                             // 0x022C
+], null, { packed: true, expectedSize: 0x0230 });
 
 const SkillModel = MemoryModel.define('SkillModel', [
-  { name: 'skillsTxt', type: DataTypes.Pointer },
-  { name: 'next', type: DataTypes.Pointer, model: () => SkillModel },
-  { name: 'mode', type: DataTypes.Uint32 },
-  { name: 'flags', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 32 },
-  { name: 'baseLevel', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'quantity', type: DataTypes.Int32 },
-  { name: 'ownerId', type: DataTypes.Int32 },
-  { name: 'charges', type: DataTypes.Int32 },
-  { type: DataTypes.Padding, length: 4 },
-]);
+  { name: 'skillsTxt', type: DataTypes.Pointer },                      // 0x0000
+  { name: 'next', type: DataTypes.Pointer, model: () => SkillModel },  // 0x0008
+  { name: 'mode', type: DataTypes.Uint32 },                            // 0x0010
+  { name: 'flags', type: DataTypes.Uint32 },                           // 0x0014
+  { type: DataTypes.Padding, length: 32 },                             // 0x0018
+  { name: 'baseLevel', type: DataTypes.Uint32 },                       // 0x0038
+  { type: DataTypes.Padding, length: 4 },                              // 0x003C
+  { name: 'quantity', type: DataTypes.Int32 },                         // 0x0040
+  { name: 'ownerId', type: DataTypes.Int32 },                          // 0x0044
+  { name: 'charges', type: DataTypes.Int32 },                          // 0x0048
+  { type: DataTypes.Padding, length: 4 },                              // 0x004C
+], null, { expectedSize: 0x0050 });
 
 const SkillListModel = MemoryModel.define('SkillListModel', [
-  { name: 'first', type: DataTypes.Pointer, model: SkillModel },
-  { name: 'left', type: DataTypes.Pointer, model: SkillModel },
-  { name: 'right', type: DataTypes.Pointer, model: SkillModel },
-  { name: 'used', type: DataTypes.Pointer, model: SkillModel },
-]);
+  { name: 'first', type: DataTypes.Pointer, model: SkillModel },  // 0x0000
+  { name: 'left', type: DataTypes.Pointer, model: SkillModel },   // 0x0008
+  { name: 'right', type: DataTypes.Pointer, model: SkillModel },  // 0x0010
+  { name: 'used', type: DataTypes.Pointer, model: SkillModel },   // 0x0018
+], null, { expectedSize: 0x0020 });
 
 const PlayerDataModel = MemoryModel.define('PlayerDataModel', [
-  { name: 'name', type: DataTypes.String, length: 16 },
-  { type: DataTypes.Padding, length: 48 },
-  { name: 'questBuffers', type: DataTypes.Pointer, count: 3 },
-  { name: 'waypointBuffers', type: DataTypes.Pointer, count: 3 },
-  { type: DataTypes.Padding, length: 8 },
-  { name: 'portalFlags', type: DataTypes.Uint32 },
-]);
+  { name: 'name', type: DataTypes.String, length: 16 },            // 0x0000
+  { type: DataTypes.Padding, length: 48 },                         // 0x0010
+  { name: 'questBuffers', type: DataTypes.Pointer, count: 3 },     // 0x0040
+  { name: 'waypointBuffers', type: DataTypes.Pointer, count: 3 },  // 0x0058
+  { type: DataTypes.Padding, length: 8 },                          // 0x0070
+  { name: 'portalFlags', type: DataTypes.Uint32 },                 // 0x0078
+  { type: DataTypes.Padding, length: 4 },                          // 0x007C
+], null, { expectedSize: 0x0080 });
 
 const MonsterDataModel = MemoryModel.define('MonsterDataModel', [
-  { name: 'txtRecord', type: DataTypes.Pointer },
-  { type: DataTypes.Padding, length: 16 },
-  { name: 'nameSeed', type: DataTypes.Uint16 },
-  { name: 'typeFlag', type: DataTypes.Uint8 },
-  { name: 'lastAnimMode', type: DataTypes.Uint8 },
-  { name: 'durielFlag', type: DataTypes.Uint32 },
-  { name: 'monUMod', type: DataTypes.Uint8, count: 10 },
-  { name: 'uniqueId', type: DataTypes.Uint16 },
-  { type: DataTypes.Padding, length: 36 },
-  { name: 'ownerType', type: DataTypes.Uint32 },
-  { name: 'ownerId', type: DataTypes.Uint32 },
-]);
+  { name: 'txtRecord', type: DataTypes.Pointer },         // 0x0000
+  { type: DataTypes.Padding, length: 16 },                // 0x0008
+  { name: 'nameSeed', type: DataTypes.Uint16 },           // 0x0018
+  { name: 'typeFlag', type: DataTypes.Uint8 },            // 0x001A
+  { name: 'lastAnimMode', type: DataTypes.Uint8 },        // 0x001B
+  { name: 'durielFlag', type: DataTypes.Uint32 },         // 0x001C
+  { name: 'monUMod', type: DataTypes.Uint8, count: 10 },  // 0x0020
+  { name: 'uniqueId', type: DataTypes.Uint16 },           // 0x002A
+  { type: DataTypes.Padding, length: 36 },                // 0x002C
+  { name: 'ownerType', type: DataTypes.Uint32 },          // 0x0050
+  { name: 'ownerId', type: DataTypes.Uint32 },            // 0x0054
+], null, { expectedSize: 0x0058 });
 
 const GameObjectDataModel = MemoryModel.define('GameObjectDataModel', [
-  { name: 'txtRecord', type: DataTypes.Pointer },
-  { name: 'type', type: DataTypes.Uint8 },
-]);
+  { name: 'txtRecord', type: DataTypes.Pointer },  // 0x0000
+  { name: 'type', type: DataTypes.Uint8 },         // 0x0008
+  { type: DataTypes.Padding, length: 7 },          // 0x0009
+], null, { expectedSize: 0x0010 });
+
+const InventoryModel = MemoryModel.define('InventoryModel', [
+  { name: 'signature', type: DataTypes.Uint32 },    // 0x0000
+  { type: DataTypes.Padding, length: 12 },          // 0x0004
+  { name: 'owner', type: DataTypes.Pointer },       // 0x0010
+  { name: 'firstItem', type: DataTypes.Pointer },   // 0x0018
+  { name: 'lastItem', type: DataTypes.Pointer },    // 0x0020
+  { name: 'grids', type: DataTypes.Pointer },       // 0x0028
+  { name: 'gridCount', type: DataTypes.Int32 },     // 0x0030
+  { name: 'weaponId', type: DataTypes.Uint32 },     // 0x0034
+  { name: 'cursorItem', type: DataTypes.Pointer },  // 0x0038
+  { name: 'ownerId', type: DataTypes.Uint32 },      // 0x0040
+  { name: 'itemCount', type: DataTypes.Uint32 },    // 0x0044
+], null, { expectedSize: 0x0048 });
 
 const ItemDataModel = MemoryModel.define('ItemDataModel', [
-  { name: 'quality', type: DataTypes.Uint32 },
-  { name: 'seed', model: SeedModel },
-  { name: 'ownerId', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 8 },
-  { name: 'flags', type: DataTypes.Uint32 },
-  { type: DataTypes.Padding, length: 28 },
-  { name: 'itemLevel', type: DataTypes.Uint32 }, // always 1 for online
-  { type: DataTypes.Padding, length: 4 },
-  { name: 'itemFormat', type: DataTypes.Uint16 },
-  { name: 'rarePrefix', type: DataTypes.Uint16 },
-  { name: 'rareSuffix', type: DataTypes.Uint16 },
-  { name: 'autoAffix', type: DataTypes.Uint16 },
-  { name: 'magicPrefix', type: DataTypes.Uint16, count: 3 },
-  { name: 'magicSuffix', type: DataTypes.Uint16, count: 3 },
-  { name: 'bodyLocation', type: DataTypes.Uint8 },
-  { name: 'inventoryPage', type: DataTypes.Uint8 },
-  { type: DataTypes.Padding, length: 74 },
-  { name: 'ownerInventory', type: DataTypes.Pointer },
-  { name: 'itemPrev', type: DataTypes.Pointer, model: () => UnitModel },
-  { name: 'itemNext', type: DataTypes.Pointer, model: () => UnitModel },
-  { name: 'nodePos', type: DataTypes.Uint8 },
-  { name: 'nodePosEx', type: DataTypes.Uint8 },
-  { type: DataTypes.Padding, length: 6 },
-]);
+  { name: 'quality', type: DataTypes.Uint32 },                            // 0x0000
+  { name: 'seed', model: SeedModel },                                     // 0x0004
+  { name: 'ownerId', type: DataTypes.Uint32 },                            // 0x000C
+  { type: DataTypes.Padding, length: 8 },                                 // 0x0010
+  { name: 'flags', type: DataTypes.Uint32 },                              // 0x0018
+  { type: DataTypes.Padding, length: 28 },                                // 0x001C
+  { name: 'itemLevel', type: DataTypes.Uint32 },                          // 0x0038
+  { type: DataTypes.Padding, length: 4 },                                 // 0x003C
+  { name: 'itemFormat', type: DataTypes.Uint16 },                         // 0x0040
+  { name: 'rarePrefix', type: DataTypes.Uint16 },                         // 0x0042
+  { name: 'rareSuffix', type: DataTypes.Uint16 },                         // 0x0044
+  { name: 'autoAffix', type: DataTypes.Uint16 },                          // 0x0046
+  { name: 'magicPrefix', type: DataTypes.Uint16, count: 3 },              // 0x0048
+  { name: 'magicSuffix', type: DataTypes.Uint16, count: 3 },              // 0x004E
+  { name: 'bodyLocation', type: DataTypes.Uint8 },                        // 0x0054
+  { name: 'inventoryPage', type: DataTypes.Uint8 },                       // 0x0055
+  { type: DataTypes.Padding, length: 74 },                                // 0x0056
+  { name: 'ownerInventory', type: DataTypes.Pointer },                    // 0x00A0
+  { name: 'itemPrev', type: DataTypes.Pointer, model: () => UnitModel },  // 0x00A8
+  { name: 'itemNext', type: DataTypes.Pointer, model: () => UnitModel },  // 0x00B0
+  { name: 'nodePos', type: DataTypes.Uint8 },                             // 0x00B8
+  { name: 'nodePosEx', type: DataTypes.Uint8 },                           // 0x00B9
+  { type: DataTypes.Padding, length: 6 },                                 // 0x00BA
+], null, { expectedSize: 0x00C0 });
 
 const UnitModel = MemoryModel.define('UnitModel', [
-  { name: 'type', type: DataTypes.Uint32 },                           // 0x0000
-  { name: 'classId', type: DataTypes.Uint32 },                        // 0x0004
-  { name: 'id', type: DataTypes.Uint32 },                             // 0x0008
-  { name: 'mode', type: DataTypes.Uint32 },                           // 0x000C
-  {
-    name: 'data', type: DataTypes.Union, fields: [
-      { name: 'playerData', type: DataTypes.Pointer, model: PlayerDataModel },
-      { name: 'monsterData', type: DataTypes.Pointer, model: MonsterDataModel },
-      { name: 'gameObjectData', type: DataTypes.Pointer, model: GameObjectDataModel },
-      { name: 'itemData', type: DataTypes.Pointer, model: ItemDataModel },
-    ]
-  },
-  { name: 'actId', type: DataTypes.Uint64 },                          // 0x0018
-  { name: 'drlgAct', type: DataTypes.Pointer, model: DrlgActModel },  // 0x0020
-  { name: 'seed', model: SeedModel },                                 // 0x0028
-  { name: 'initSeed', model: SeedModel },                             // 0x0030
-  { name: 'path', type: DataTypes.Pointer, model: DynamicPathModel }, // 0x0038
-  { type: DataTypes.Padding, length: 28 },                            // 0x0040
-  { name: 'animSeqFrame', type: DataTypes.Uint32 },                   // 0x005C
-  { name: 'animSeqFrame2', type: DataTypes.Uint32 },                  // 0x0060
-  { name: 'animSeqFrameCount', type: DataTypes.Uint32 },              // 0x0064
-  { name: 'animSpeed', type: DataTypes.Uint32 },                      // 0x0068
-  { type: DataTypes.Padding, length: 4 },                             // 0x006C
-  { name: 'animData', type: DataTypes.Pointer },                      // 0x0070
-  { name: 'gfxData', type: DataTypes.Pointer },                       // 0x0078
-  { type: DataTypes.Padding, length: 8 },                             // 0x0080
-  { name: 'statListEx', type: DataTypes.Pointer },                    // 0x0088
-  { name: 'inventory', type: DataTypes.Pointer },                     // 0x0090
-  { type: DataTypes.Padding, length: 40 },                            // 0x0098
-  { name: 'packetList', type: DataTypes.Pointer },                    // 0x00C0
-  { type: DataTypes.Padding, length: 12 },                            // 0x00C8
-  { name: 'posX', type: DataTypes.Int16 },                            // 0x00D4
-  { name: 'posY', type: DataTypes.Int16 },                            // 0x00D6
-  { type: DataTypes.Padding, length: 40 },                            // 0x00D8
-  { name: 'skills', type: DataTypes.Pointer, model: SkillListModel }, // 0x0100
-  { type: DataTypes.Padding, length: 28 },                            // 0x0108
-  { name: 'flags', type: DataTypes.Uint32 },                          // 0x0124
-  { name: 'flagsEx', type: DataTypes.Uint32 },                        // 0x0128
-  { type: DataTypes.Padding, length: 36 },                            // 0x012C
-  { name: 'changeNextUnit', type: DataTypes.Pointer },                // 0x0150
-  { name: 'unitNext', type: DataTypes.Pointer },                      // 0x0158
-  { name: 'roomUnitNext', type: DataTypes.Pointer },                  // 0x0160
-  { type: DataTypes.Padding, length: 16 },                            // 0x0168
-  { name: 'collisionUnitType', type: DataTypes.Uint32 },              // 0x0178
-  { name: 'collisionUnitClassId', type: DataTypes.Uint32 },           // 0x017C
-  { name: 'collisionUnitSizeX', type: DataTypes.Uint32 },             // 0x0180
-  { name: 'collisionUnitSizeY', type: DataTypes.Uint32 },             // 0x0184
-]);
+  { name: 'type', type: DataTypes.Uint32 },         // 0x0000
+  { name: 'classId', type: DataTypes.Uint32 },      // 0x0004
+  { name: 'id', type: DataTypes.Uint32 },           // 0x0008
+  { name: 'mode', type: DataTypes.Uint32 },         // 0x000C
+  { name: 'data', type: DataTypes.Union, fields: [  // 0x0010
+    { name: 'playerData', type: DataTypes.Pointer, model: PlayerDataModel },
+    { name: 'monsterData', type: DataTypes.Pointer, model: MonsterDataModel },
+    { name: 'itemData', type: DataTypes.Pointer, model: ItemDataModel },
+    { name: 'gameObjectData', type: DataTypes.Pointer, model: GameObjectDataModel },
+  ] },
+  { name: 'actId', type: DataTypes.Uint64 },                           // 0x0018
+  { name: 'drlgAct', type: DataTypes.Pointer, model: DrlgActModel },   // 0x0020
+  { name: 'seed', model: SeedModel },                                  // 0x0028
+  { name: 'initSeed', model: SeedModel },                              // 0x0030
+  { name: 'path', type: DataTypes.Pointer, model: DynamicPathModel },  // 0x0038
+  { type: DataTypes.Padding, length: 28 },                             // 0x0040
+  { name: 'animSeqFrame', type: DataTypes.Uint32 },                    // 0x005C
+  { name: 'animSeqFrame2', type: DataTypes.Uint32 },                   // 0x0060
+  { name: 'animSeqFrameCount', type: DataTypes.Uint32 },               // 0x0064
+  { name: 'animSpeed', type: DataTypes.Uint32 },                       // 0x0068
+  { type: DataTypes.Padding, length: 4 },                              // 0x006C
+  { name: 'animData', type: DataTypes.Pointer },                       // 0x0070
+  { name: 'gfxData', type: DataTypes.Pointer },                        // 0x0078
+  { type: DataTypes.Padding, length: 8 },                              // 0x0080
+  { name: 'statListEx', type: DataTypes.Pointer },                     // 0x0088
+  { name: 'inventory', type: DataTypes.Pointer },                      // 0x0090
+  { type: DataTypes.Padding, length: 40 },                             // 0x0098
+  { name: 'packetList', type: DataTypes.Pointer },                     // 0x00C0
+  { type: DataTypes.Padding, length: 12 },                             // 0x00C8
+  { name: 'posX', type: DataTypes.Int16 },                             // 0x00D4
+  { name: 'posY', type: DataTypes.Int16 },                             // 0x00D6
+  { name: 'resourceId', type: DataTypes.Uint64 },                      // 0x00D8
+  { type: DataTypes.Padding, length: 32 },                             // 0x00E0
+  { name: 'skills', type: DataTypes.Pointer, model: SkillListModel },  // 0x0100
+  { type: DataTypes.Padding, length: 28 },                             // 0x0108
+  { name: 'flags', type: DataTypes.Uint32 },                           // 0x0124
+  { name: 'flagsEx', type: DataTypes.Uint32 },                         // 0x0128
+  { type: DataTypes.Padding, length: 36 },                             // 0x012C
+  { name: 'changeNextUnit', type: DataTypes.Pointer },                 // 0x0150
+  { name: 'unitNext', type: DataTypes.Pointer },                       // 0x0158
+  { name: 'roomUnitNext', type: DataTypes.Pointer },                   // 0x0160
+  { type: DataTypes.Padding, length: 16 },                             // 0x0168
+  { name: 'collisionUnitType', type: DataTypes.Uint32 },               // 0x0178
+  { name: 'collisionUnitClassId', type: DataTypes.Uint32 },            // 0x017C
+  { name: 'collisionUnitSizeX', type: DataTypes.Uint32 },              // 0x0180
+  { name: 'collisionUnitSizeY', type: DataTypes.Uint32 },              // 0x0184
+  { type: DataTypes.Padding, length: 53 },                             // 0x0188
+  { name: 'dataTblsIndex', type: DataTypes.Uint8 },                    // 0x01BD
+  { type: DataTypes.Padding, length: 2 },                              // 0x01BE
+], null, { expectedSize: 0x01C0 });
 
 module.exports = {
   SeedModel,
-  DrlgCoordModel,
+  D2FP16Model,
+  D2FP32Model,
+  D2FP32_16Model,
+  PathPointModel,
   DrlgCoordsModel,
-  DrlgModel,
-  DrlgLevelModel,
+  DrlgCoordModel,
   DrlgRoomModel,
   ActiveRoomModel,
+  DrlgLevelModel,
+  DrlgModel,
   DrlgActModel,
-  PathPointModel,
   DynamicPathModel,
+  SkillModel,
+  SkillListModel,
+  PlayerDataModel,
+  MonsterDataModel,
+  GameObjectDataModel,
+  InventoryModel,
+  ItemDataModel,
   UnitModel,
 };
@@ -2,13 +2,20 @@
 
 const { WorldObject } = require('d2r/world-object');
 const { MonsterModes } = require('d2r/types');
+const { MonsterDataLayout } = require('d2r/layouts');
+const { loadModel } = require('d2r/model-cache');
+const { getDataTables } = require('d2r/data-tables');
+
+function readMonsterData(data) { return loadModel(MonsterDataLayout, this.data, data); }
 
 class Monster extends WorldObject {
-  constructor() {
-    super();
-    this.on('update', (cursor) => {
-      this.monsterData = cursor.monsterData?.$toObject(this.monsterData) ?? null;
-    });
+  get monsterData() { return this._cached('monsterData', readMonsterData); }
+
+  // Row of the monster's txt record in the monstats table, -1 if the table is not resolved.
+  get monStatsIndex() {
+    const table = getDataTables(this.dataTblsIndex)?.monStats;
+    const record = this.monsterData?.txtRecord;
+    return table && record ? table.indexOf(record) : -1;
   }
 
   get isAlive() {
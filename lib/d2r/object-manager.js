@@ -1,9 +1,17 @@
 'use strict';
 
 const { EventEmitter } = require('events');
-const { readMemoryInto, tryWithGameLock, highResolutionTime, invalidateCache } = require('memory');
-const { UnitModel } = require('d2r/models');
-const { UnitTypes } = require('d2r/types');
+const { tryWithGameLock, highResolutionTime, invalidateCache } = require('memory');
+const { UnitTypes, UnitFields } = require('d2r/types');
+const {
+  RECORD_SIZE, recordUnitId, recordType, recordChanged, writeHotFields, writeClientCoords,
+} = require('d2r/unit-snapshot');
+const { UnitStore } = require('d2r/unit-store');
+const { UnitBatch } = require('d2r/unit-batch');
+const { Inventory } = require('d2r/inventory');
+const { compileItemRules } = require('d2r/item-rules');
+const { loadCollisionMap } = require('d2r/collision-map');
+const { setMemorySource, invalidateSharedModels } = require('d2r/model-cache');
 const { Player, LocalPlayer } = require('d2r/player');
 const { Monster } = require('d2r/monster');
 const { Item } = require('d2r/item');
@@ -26,22 +34,65 @@ function formatTime(ns) {
   return `${(ns / 1000000000).toFixed(2)}s `;
 }
 
-const BUCKET_COUNT = 128;
 const TYPE_COUNT = 6;
-const POINTER_COUNT = TYPE_COUNT * BUCKET_COUNT;
-const pointerBuffer = new Uint8Array(POINTER_COUNT * 8);
-const pointerView = new DataView(
-  pointerBuffer.buffer,
-  pointerBuffer.byteOffset,
-  pointerBuffer.byteLength,
-);
+
+// Mirrors SnapshotEventHeader in src/snapshot_pipeline.h, in uint32 words.
+const EVENT_HEADER_WORDS = 8;
+const EVENT_REMOVED_COUNT = 2;
+const EVENT_ADDED_COUNT = 3;
+const EVENT_UPDATED_COUNT = 4;
+
+// Types that own a dynamic path, see HasDynamicPath in src/unit_snapshot.h.
+const MOTION_TYPES = [UnitTypes.Player, UnitTypes.Monster, UnitTypes.Missile];
+
+// How often each unit type is walked, in ms (0 = every tick). Items, objects and tiles are most of the walked units
+// but rarely change, they are also walked whenever the local player enters another room.
+const DEFAULT_UPDATE_PERIODS = {
+  [UnitTypes.Player]: 0,
+  [UnitTypes.Monster]: 0,
+  [UnitTypes.Object]: 500,
+  [UnitTypes.Missile]: 0,
+  [UnitTypes.Item]: 250,
+  [UnitTypes.Tile]: 500,
+};
 
 class ObjectManager extends EventEmitter {
-  constructor() {
+  // |source| replaces the live game, e.g. a SessionReplay. It provides `binding` (the subset of
+  // internalBinding('d2r') used here) and `tryWithGameLock`.
+  constructor(source = { binding, tryWithGameLock }) {
     super();
-    this._units = new Array(TYPE_COUNT);
-    this._cursor = UnitModel.createCursor(1);
+    this._source = source;
+    this._binding = source.binding;
+    setMemorySource(this._binding, (fn) => source.tryWithGameLock(fn));
+    this._store = new UnitStore();
+    this._store.binding = this._binding;
+    this._subscriptions = [];
     this._localPlayerId = -1;
+    this._roster = new BigUint64Array(0);
+    this._updatePeriodsNs = new Float64Array(TYPE_COUNT);
+    this._lastWalkNs = new Float64Array(TYPE_COUNT);
+    this._walkAll = true;
+    this._roomAddress = 0n;
+    this._roomRadius = null;
+    this._inventories = [];
+    this._inventoryBuffers = [];
+    this.itemRuleNames = [];
+    this._collisionMaps = false;
+    this._collisionLevel = -1;
+    this._collisionMap = null;
+    this._pipelined = false;
+    this._nativeSlots = []; // store slot by SnapshotPipeline slot
+    this._added = new UnitBatch();
+    this._removed = new UnitBatch();
+    this._batchAdded = false;
+    this._batchRemoved = false;
+    this._extrapolation = false;
+    this._motion = { count: 0, units: [], positions: new Int32Array(0) };
+    this._motionIndices = new Uint32Array(0);
+    this._motionNative = false;
+    this._motionSnapshotNs = 0;
+    this._lastGameLockStartNs = 0;
+    for (let type = 0; type < TYPE_COUNT; type++) this.setUpdatePeriod(type, DEFAULT_UPDATE_PERIODS[type]);
     this.me = null;
     this._lastTickTime = '';
     this._lastGameLockTime = '';
@@ -51,61 +102,316 @@ class ObjectManager extends EventEmitter {
   }
 
   reset() {
-    for (let i = 0; i < TYPE_COUNT; i++) {
-      this._units[i] = new Map();
+    this._clear();
+    // the worker forgets its units along with the store
+    if (this._pipelined) {
+      this._binding.snapshotPipelineEnable(false);
+      this._binding.snapshotPipelineEnable(true);
     }
+  }
+
+  _clear() {
+    this._store.clear();
+    this._nativeSlots = [];
+    this._walkAll = true;
     this.me = null;
+    this._clearMotion();
+  }
+
+  // Walk units of |type| at most every |ms| milliseconds, 0 walks them every tick. Units of a type that is not due
+  // keep the state of its last walk.
+  setUpdatePeriod(type, ms) {
+    this._updatePeriodsNs[type] = ms * 1e6;
+    return this;
+  }
+
+  getUpdatePeriod(type) {
+    return this._updatePeriodsNs[type] / 1e6;
+  }
+
+  // Only track units in the local player's room and the rooms up to |radius| hops away, null (the default) tracks
+  // every unit in the game's unit tables. Units outside the radius are removed, so are items in inventories.
+  setRoomRadius(radius) {
+    this._roomRadius = radius;
+    this._walkAll = true;
+    return this;
+  }
+
+  get roomRadius() {
+    return this._roomRadius;
+  }
+
+  // Compile |rules| (see d2r/item-rules) and evaluate them natively for every item from the next tick on, bit i of
+  // Item.ruleMask is rules[i]. Items are only evaluated again when they change. Returns false if the native side
+  // rejected the program, an empty list clears the rules.
+  setItemRules(rules) {
+    const { program, names } = compileItemRules(rules);
+    if (!this._binding.setItemRules(rules.length ? program : undefined)) return false;
+    this.itemRuleNames = names;
+    this._walkAll = true;
+    return true;
+  }
+
+  // Merge the collision grids of the rooms the local player's act loads into per-level walkability maps, keyed by
+  // seed, difficulty and level and persisted to |path| (collision.d2rc in the module directory by default) whenever
+  // the player leaves a level. Levels seen in an earlier run of the same seed are complete right away. Returns the
+  // path.
+  enableCollisionMaps(path) {
+    const result = this._binding.collisionMapsEnable(path);
+    this._collisionMaps = result !== undefined;
+    return result;
+  }
+
+  // Walkability map of the local player's level, null until collision maps are enabled and the player is in a level.
+  get collisionMap() {
+    if (this._collisionLevel < 0) return null;
+    this._collisionMap = loadCollisionMap(this._collisionLevel, this._collisionMap);
+    return this._collisionMap;
+  }
+
+  // Map of another level of the local player's seed and difficulty, null if it was never seen.
+  getCollisionMap(levelId) {
+    return levelId === this._collisionLevel ? this.collisionMap : loadCollisionMap(levelId);
+  }
+
+  // Match, place and diff the unit records on a native worker thread (see src/snapshot_pipeline.h) instead of the
+  // script thread. A tick then copies the units under the game lock, hands them to the worker and dispatches the
+  // events of the capture the worker finished last, so units are one tick behind. Switching forgets the tracked
+  // units without 'unitRemoved' events, they are added again on the next ticks. Returns false if the source has no
+  // worker (SessionReplay).
+  setPipelined(enabled) {
+    const running = this._binding.snapshotPipelineEnable(enabled) === true;
+    if (running !== this._pipelined) {
+      this._pipelined = running;
+      this._clear();
+    }
+    return running === enabled;
   }
 
+  get pipelined() {
+    return this._pipelined;
+  }
+
+  // Keep the dynamic paths of the players, monsters and missiles of every tick for extrapolate(), so overlays can
+  // move them at display rate while ticks run at a lower one.
+  setExtrapolation(enabled) {
+    this._extrapolation = enabled;
+    if (!enabled) this._clearMotion();
+    return this;
+  }
+
+  get extrapolation() {
+    return this._extrapolation;
+  }
+
+  // Where the units with a dynamic path are at |timeNs| (highResolutionTime() clock, now by default): their
+  // positions in the last tick's snapshot moved along their path, see PathMotion in src/path_motion.h. Returns
+  // { count, units, positions } with the client coordinates (what worldToAutomap takes) of units[i] at
+  // positions[2 * i] and positions[2 * i + 1]. The object is reused by every call and the units are those of the
+  // last tick. Sources without the native kernel (SessionReplay) report the snapshot positions.
+  extrapolate(timeNs = getTimeNs()) {
+    const motion = this._motion;
+    if (motion.count > 0 && this._motionNative) {
+      this._binding.extrapolatePaths(timeNs - this._motionSnapshotNs, motion.positions);
+    }
+    return motion;
+  }
+
+  // Map-like view, see UnitCollection in d2r/unit-store.
   getUnits(type) {
-    return this._units[type];
+    return this._store.collections[type];
+  }
+
+  // Call |listener(unit, type, changed)| for every unit where one of the UnitFields in |fields| changed since the
+  // previous tick. |types| optionally restricts the subscription to a list of unit types.
+  onChange(fields, listener, types) {
+    let typeMask = 0xFF;
+    if (types) {
+      typeMask = 0;
+      for (const type of types) typeMask |= 1 << type;
+    }
+    this._subscriptions.push({ fields, listener, typeMask });
+    return this;
+  }
+
+  // Keep |unit|'s inventory up to date from the native inventory reader, the returned Inventory is refreshed every
+  // tick and 'inventoryChanged' is emitted when items were added, moved, changed or removed.
+  watchInventory(unit) {
+    let inventory = this._inventories.find(inv => inv.owner === unit);
+    if (!inventory) {
+      inventory = new Inventory(unit);
+      this._inventories.push(inventory);
+    }
+    return inventory;
+  }
+
+  unwatchInventory(inventory) {
+    if (!this._inventories.includes(inventory)) return this;
+    this._inventories = this._inventories.filter(inv => inv !== inventory);
+    this._binding.releaseInventory(inventory.owner._address);
+    return this;
+  }
+
+  offChange(listener) {
+    this._subscriptions = this._subscriptions.filter(sub => sub.listener !== listener);
+    return this;
   }
 
   tick() {
+    this._binding.traceBegin('ObjectManager.tick');
+    try {
+      return this._tick();
+    } finally {
+      this._binding.traceEnd();
+    }
+  }
+
+  _tick() {
     const tick_start = getTimeNs();
 
     invalidateCache();
+    invalidateSharedModels();
+
+    // only collect the tick's batches while someone listens, a level change adds and removes hundreds of units
+    this._added._clear();
+    this._removed._clear();
+    this._batchAdded = this.listenerCount('unitsAdded') > 0;
+    this._batchRemoved = this.listenerCount('unitsRemoved') > 0;
 
-    const seen = new Array(TYPE_COUNT);
-    for (let i = 0; i < TYPE_COUNT; i++) seen[i] = new Set();
+    let typeMask = 0;
+    for (let type = 0; type < TYPE_COUNT; type++) {
+      if (this._walkAll || tick_start - this._lastWalkNs[type] >= this._updatePeriodsNs[type]) typeMask |= 1 << type;
+    }
 
-    const game_lock_elapsed = tryWithGameLock(() => {
-      const game_lock_start = getTimeNs();
-      this._localPlayerId = binding.getPlayerIdByIndex(binding.getLocalPlayerIndex());
-      this._scanTable(binding.getClientSideUnitHashTableAddress(), seen);
-      this._scanTable(binding.getServerSideUnitHashTableAddress(), seen);
+    // phase 1: only copy raw unit and path bytes while the game is stalled
+    let ranges = null;
+    let captured;
+    let collision;
+    let game_lock_start = 0;
+    const game_lock_elapsed = this._source.tryWithGameLock(() => {
+      game_lock_start = getTimeNs();
+      this._binding.traceBegin('ObjectManager.gameLock');
+      try {
+        if (this._pipelined) {
+          captured = this._binding.captureUnits(typeMask, this._roomRadius ?? undefined);
+        } else {
+          ranges = this._binding.snapshotUnits(typeMask, this._roomRadius ?? undefined);
+        }
+        for (let i = 0; i < this._inventories.length; i++) {
+          const inventory = this._inventories[i];
+          const owner = inventory.owner;
+          this._inventoryBuffers[i] =
+            owner.isValid ? this._binding.snapshotInventory(owner._address, !inventory._synced) : undefined;
+        }
+        this._updateRoster(this._binding.getPlayers(), this._binding.getLocalPlayerIndex());
+        if (this._collisionMaps) collision = this._binding.updateCollisionMaps();
+      } finally {
+        this._binding.traceEnd();
+      }
       return getTimeNs() - game_lock_start;
     });
     // failed to grab game lock due to timeout (game frozen)
     if (game_lock_elapsed === undefined) {
+      this._binding.recordTick(getTimeNs() - tick_start);
       return false;
     }
 
+    // the native side may walk more types than asked for (the arena grew), the worker may still hold both jobs
+    const walked = this._pipelined ? captured ?? 0 : ranges[0];
     for (let type = 0; type < TYPE_COUNT; type++) {
-      const existing = this._units[type];
-      for (const [id, unit] of existing) {
-        if (!seen[type].has(id)) {
-          this.emit('unitRemoved', unit, type);
-          unit._invalidate();
-          existing.delete(id);
-        }
+      if (walked & (1 << type)) this._lastWalkNs[type] = tick_start;
+    }
+    if (ranges || captured !== undefined) this._walkAll = false;
+
+    // phase 2: decode, diff and dispatch from the staging arena, or dispatch what the worker decoded
+    this._binding.traceBegin('ObjectManager.decode');
+    try {
+      if (this._pipelined) {
+        const result = this._binding.swapSnapshot();
+        if (result) this._processEvents(result[0], result[1]);
+      } else {
+        this._processSnapshot(ranges);
+      }
+    } finally {
+      this._binding.traceEnd();
+    }
+
+    for (let i = 0; i < this._inventories.length; i++) {
+      const inventory = this._inventories[i];
+      const buffer = this._inventoryBuffers[i];
+      if (buffer && inventory._apply(buffer)) this.emit('inventoryChanged', inventory);
+    }
+    this._inventoryBuffers.length = 0;
+
+    // a level that was left is as complete as it gets this visit, persist the maps outside the game lock
+    const levelId = collision ? collision[0] : -1;
+    if (levelId !== this._collisionLevel) {
+      if (this._collisionLevel >= 0) this._binding.saveCollisionMaps();
+      this._collisionLevel = levelId;
+    }
+
+    // the worker reports removed units itself
+    if (!this._pipelined) {
+      this._binding.traceBegin('ObjectManager.removeStale');
+      try {
+        this._store.sweep((unit, type) => this._unitRemoved(unit, type), walked);
+      } finally {
+        this._binding.traceEnd();
       }
     }
 
     if (this.me && !this.me.isValid) {
       this.me = null;
     }
-    if (this.me === null && this._units[0].has(this._localPlayerId)) {
-      this.me = this._units[0].get(this._localPlayerId);
+    if (this.me === null) {
+      this.me = this._store.collections[UnitTypes.Player].get(this._localPlayerId) ?? null;
+    }
+
+    // the worker's records were captured under the previous tick's game lock
+    const snapshotNs = this._pipelined ? this._lastGameLockStartNs : game_lock_start;
+    this._lastGameLockStartNs = game_lock_start;
+    if (this._extrapolation) this._loadMotion(snapshotNs);
+
+    // entering another room brings in units of the slow types, catch up with all of them next tick
+    const roomAddress = this.me?.path?._roomAddress ?? 0n;
+    if (roomAddress !== this._roomAddress) {
+      this._roomAddress = roomAddress;
+      this._walkAll = true;
     }
 
+    if (this._removed.size > 0) this.emit('unitsRemoved', this._removed);
+    if (this._added.size > 0) this.emit('unitsAdded', this._added);
+    this._added._clear();
+    this._removed._clear();
+
     this._lastTickTimeNs = getTimeNs() - tick_start;
     this._lastGameLockTimeNs = game_lock_elapsed;
     this._lastTickTime = formatTime(this._lastTickTimeNs);
     this._lastGameLockTime = formatTime(this._lastGameLockTimeNs);
+    this._binding.recordTick(this._lastTickTimeNs, game_lock_elapsed);
     return true;
   }
 
+  // Occupied player slots as of the last tick.
+  get party() {
+    const roster = this._roster;
+    const players = this._store.collections[UnitTypes.Player];
+    const party = [];
+    for (let i = 0; i < roster.length; i += 3) {
+      const id = Number(roster[i + 1]);
+      party.push({ index: Number(roster[i]), id, unit: players.get(id) ?? null });
+    }
+    return party;
+  }
+
+  _updateRoster(roster, localIndex) {
+    this._roster = roster;
+    this._localPlayerId = -1;
+    for (let i = 0; i < roster.length; i += 3) {
+      if (Number(roster[i]) === localIndex) this._localPlayerId = Number(roster[i + 1]);
+    }
+  }
+
   get tickTime() {
     return this._lastTickTime;
   }
@@ -122,63 +428,163 @@ class ObjectManager extends EventEmitter {
     return this._lastGameLockTimeNs;
   }
 
-  _scanTable(tableAddress, seen) {
-    readMemoryInto(tableAddress, pointerBuffer);
+  // |ranges| is the result of snapshotUnits(): the walked type mask, then a (first record, count) pair per type.
+  // Regions of types that were not walked are left alone, their units keep pointing at their last records.
+  _processSnapshot(ranges) {
+    const store = this._store;
+    store.tick++;
+    // the arena is reallocated when it grows, always view the current one
+    const buffer = this._binding.getSnapshotBuffer();
+    const view = buffer ? new DataView(buffer) : null;
+    store.view = view;
 
-    for (let i = 0; i < POINTER_COUNT; i++) {
-      const ptr = pointerView.getBigUint64(i * 8, true);
-      if (ptr === 0n) continue;
+    for (let type = 0; type < TYPE_COUNT; type++) {
+      if ((ranges[0] & (1 << type)) === 0) continue;
+      const first = ranges[1 + type * 2];
+      const end = first + ranges[2 + type * 2];
+      for (let i = first; i < end; i++) this._processRecord(view, i * RECORD_SIZE);
+    }
+  }
 
-      const type = (i / BUCKET_COUNT) | 0;
-      let currentPtr = ptr;
+  _processRecord(view, record) {
+    const store = this._store;
+    const type = recordType(view, record);
+    if (type >= TYPE_COUNT) return;
+    const id = recordUnitId(view, record);
 
-      while (currentPtr !== 0n) {
-        const changed = this._cursor.$load(currentPtr, 1);
-        const id = this._cursor.id;
+    let slot = store.find(type, id);
+    const isNew = slot < 0;
+    if (isNew) {
+      slot = store.alloc(type, id, this._createUnit);
+      // resolve early so listeners of the local player's first update can already compare against it
+      if (type === UnitTypes.Player && id === this._localPlayerId) this.me = store.units[slot];
+    }
 
-        let unit = this._units[type].get(id);
-        let isNew = false;
-        if (!unit) {
-          unit = this._createUnit(type);
-          if (unit) {
-            this._units[type].set(id, unit);
-            isNew = true;
-          }
-        }
+    this._applyRecord(view, record, slot, isNew, isNew ? UnitFields.All : recordChanged(view, record));
+  }
+
+  // |records| and |events| are a swapSnapshot() result: the records by worker slot and the SnapshotEventHeader
+  // followed by the removed slots, the added slots and a (slot, changed) pair per walked unit. A unit keeps its slot
+  // while it is seen, so nothing has to be looked up.
+  _processEvents(records, events) {
+    const store = this._store;
+    const slots = this._nativeSlots;
+    store.tick++;
+    const view = new DataView(records);
+    store.view = view;
+
+    let i = EVENT_HEADER_WORDS;
+    // removed first, the worker reuses their slots for the units added in the same capture
+    for (const end = i + events[EVENT_REMOVED_COUNT]; i < end; i++) {
+      const slot = slots[events[i]];
+      slots[events[i]] = -1;
+      this._unitRemoved(store.units[slot], store.type[slot]);
+      store.free(slot);
+    }
+    for (const end = i + events[EVENT_ADDED_COUNT]; i < end; i++) {
+      const record = events[i] * RECORD_SIZE;
+      const type = recordType(view, record);
+      const id = recordUnitId(view, record);
+      const slot = store.alloc(type, id, this._createUnit);
+      slots[events[i]] = slot;
+      if (type === UnitTypes.Player && id === this._localPlayerId) this.me = store.units[slot];
+    }
+    for (const end = i + events[EVENT_UPDATED_COUNT] * 2; i < end; i += 2) {
+      const slot = slots[events[i]];
+      const isNew = store.record[slot] < 0;
+      this._applyRecord(view, events[i] * RECORD_SIZE, slot, isNew, isNew ? UnitFields.All : events[i + 1]);
+    }
+  }
 
-        if (unit) {
-          if (changed || isNew) this._cursor.$toObject(unit);
-          unit._valid = true;
-          if (isNew) this.emit('unitAdded', unit, type);
-          unit.emit('update', this._cursor);
+  _applyRecord(view, record, slot, isNew, changed) {
+    const store = this._store;
+    const type = store.type[slot];
+    // hot fields only change along with the compared fields
+    if (changed !== 0 || store.record[slot] !== record) writeHotFields(view, record, store, slot);
+    store.seenTick[slot] = store.tick;
+    store.changed[slot] = changed;
+    const unit = store.units[slot];
+    unit._update();
+    if (isNew) {
+      this.emit('unitAdded', unit, type);
+      if (this._batchAdded) this._added._push(type, store.id[slot], unit);
+    }
+    this.emit('unitUpdated', unit, type);
+    this._dispatchChanges(unit, type, changed);
+  }
+
+  // Units of a type that was not walked this tick are extrapolated from their last walk as if it was this one, the
+  // path types are walked every tick unless their update period was raised.
+  _loadMotion(snapshotNs) {
+    const store = this._store;
+    const motion = this._motion;
+    const units = motion.units;
+    let indices = this._motionIndices;
+    let count = 0;
+    for (const type of MOTION_TYPES) {
+      for (const slot of store.index[type].values()) {
+        const record = store.record[slot];
+        if (record < 0) continue;
+        if (count === indices.length) {
+          indices = new Uint32Array(Math.max(64, count * 2));
+          indices.set(this._motionIndices);
+          this._motionIndices = indices;
         }
+        indices[count] = record / RECORD_SIZE;
+        units[count++] = store.units[slot];
+      }
+    }
+    units.length = count;
+    motion.count = count;
+    if (motion.positions.length < count * 2) motion.positions = new Int32Array(indices.length * 2);
+    this._motionSnapshotNs = snapshotNs;
+
+    const view = store.view;
+    const loaded = view ? this._binding.loadPathMotion(view.buffer, indices.subarray(0, count)) : 0;
+    this._motionNative = count > 0 && loaded === count;
+    if (!this._motionNative && view) {
+      for (let i = 0; i < count; i++) writeClientCoords(view, indices[i] * RECORD_SIZE, motion.positions, i * 2);
+    }
+  }
+
+  _clearMotion() {
+    this._motion.count = 0;
+    this._motion.units.length = 0;
+    this._motionNative = false;
+  }
+
+  // Called before the unit's slot is freed.
+  _unitRemoved(unit, type) {
+    this.emit('unitRemoved', unit, type);
+    if (this._batchRemoved) this._removed._push(type, unit.id);
+  }
 
-        seen[type].add(id);
-        currentPtr = this._cursor.unitNext;
+  _dispatchChanges(unit, type, changed) {
+    if (changed === 0) return;
+    const subscriptions = this._subscriptions;
+    for (let i = 0; i < subscriptions.length; i++) {
+      const sub = subscriptions[i];
+      if ((sub.fields & changed) !== 0 && (sub.typeMask & (1 << type)) !== 0) {
+        sub.listener(unit, type, changed);
       }
     }
   }
 
-  _createUnit(type) {
-    let unit;
-    switch (type) {
+  _createUnit(store, slot) {
+    switch (store.type[slot]) {
       case UnitTypes.Player:
-        unit = new Player(); break;
+        return new Player(store, slot);
       case UnitTypes.Monster:
-        unit = new Monster(); break;
+        return new Monster(store, slot);
       case UnitTypes.Object:
-        unit = new GameObject(); break;
+        return new GameObject(store, slot);
       case UnitTypes.Missile:
-        unit = new Missile(); break;
+        return new Missile(store, slot);
       case UnitTypes.Item:
-        unit = new Item(); break;
-      case UnitTypes.Tile:
-        unit = new RoomTile(); break;
+        return new Item(store, slot);
       default:
-        return null;
+        return new RoomTile(store, slot);
     }
-    UnitModel.initSnapshot(unit);
-    return unit;
   }
 }
 
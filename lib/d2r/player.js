@@ -2,14 +2,13 @@
 
 const { WorldObject } = require('d2r/world-object');
 const { PlayerModes } = require('d2r/types');
+const { PlayerDataLayout } = require('d2r/layouts');
+const { loadModel } = require('d2r/model-cache');
+
+function readPlayerData(data) { return loadModel(PlayerDataLayout, this.data, data); }
 
 class Player extends WorldObject {
-  constructor() {
-    super();
-    this.on('update', (cursor) => {
-      this.playerData = cursor.playerData?.$toObject(this.playerData) ?? null;
-    });
-  }
+  get playerData() { return this._cached('playerData', readPlayerData); }
 
   get isLocalPlayer() { return false; }
 
@@ -0,0 +1,216 @@
+'use strict';
+
+const { RECORD_SIZE, recordType } = require('d2r/unit-snapshot');
+
+// Mirrors the session format in src/session_recorder.h.
+const MAGIC = 'D2RSESS';
+const VERSION = 2;
+const TYPE_COUNT = 6;
+const FILE_HEADER_SIZE = 16;
+const FRAME_HEADER_SIZE = 24;
+const MAX_PLAYERS = 8;
+const PLAYER_SIZE = 16;
+const SAMPLE_SIZE = 16;
+const DELTA_HEADER_SIZE = 24;
+
+const BlobKinds = {
+  ActiveRoom: 1,
+  DrlgRoom: 2,
+  DrlgLevel: 3,
+};
+
+// Inverse of the zero-run encoding, see Compress() in src/session_recorder.cc.
+function decompress(bytes, offset, size, rawSize) {
+  const out = new Uint8Array(rawSize);
+  const view = new DataView(bytes.buffer, bytes.byteOffset + offset, size);
+  let read = 0;
+  let write = 0;
+  while (read < size) {
+    const zeros = view.getUint16(read, true);
+    const literals = view.getUint16(read + 2, true);
+    read += 4;
+    write += zeros;
+    out.set(bytes.subarray(offset + read, offset + read + literals), write);
+    read += literals;
+    write += literals;
+  }
+  if (write !== rawSize) throw new Error(`corrupt session frame (${write} != ${rawSize} bytes)`);
+  return out;
+}
+
+function xorInto(target, targetOffset, base, baseOffset, length) {
+  for (let i = 0; i < length; i++) target[targetOffset + i] ^= base[baseOffset + i];
+}
+
+// Plays back a session recorded with sessionRecordStart(). Pass it to the ObjectManager in place of the live
+// game: `new ObjectManager(replay)`. Every ObjectManager tick advances one recorded frame.
+//
+// Only the d2r binding is replaced. The replay still runs inside the nyx script host, and unit fields read through
+// the nyx memory models (rather than the recorded snapshot columns) read the memory of the process it runs in, so
+// those are only meaningful while attached to the game the session was recorded from. To replay a session without
+// the host, on Linux, see SessionReader in src/session_reader.h and d2r_bench --session.
+class SessionReplay {
+  constructor(buffer) {
+    this._bytes = buffer instanceof Uint8Array ? buffer : new Uint8Array(buffer);
+    const view = new DataView(this._bytes.buffer, this._bytes.byteOffset, this._bytes.byteLength);
+    const magic = String.fromCharCode(...this._bytes.subarray(0, MAGIC.length));
+    if (magic !== MAGIC) throw new Error('not a session file');
+    const version = view.getUint32(8, true);
+    if (version !== VERSION) throw new Error(`unsupported session version ${version}`);
+    const recordSize = view.getUint32(12, true);
+    if (recordSize !== RECORD_SIZE) throw new Error(`session record size ${recordSize} != ${RECORD_SIZE}`);
+
+    this._view = view;
+    this.binding = {
+      snapshotUnits: () => this._nextFrame(),
+      getSnapshotBuffer: () => this._arena.buffer,
+      // recorded frames are decoded on the script thread
+      snapshotPipelineEnable: () => false,
+      captureUnits: () => undefined,
+      swapSnapshot: () => undefined,
+      readMemory: (address, size) => this.readMemory(address, size),
+      snapshotInventory: () => undefined,
+      releaseInventory() { },
+      readStats: () => undefined,
+      // recorded items carry the rule matches of the recording session
+      setItemRules: () => false,
+      // ObjectManager.extrapolate() reports the recorded positions
+      loadPathMotion: () => 0,
+      extrapolatePaths: () => 0,
+      getDataTable: () => undefined,
+      snapshotWidgets: () => undefined,
+      collisionMapsEnable: () => undefined,
+      updateCollisionMaps: () => undefined,
+      getCollisionMap: () => undefined,
+      saveCollisionMaps: () => false,
+      // frame ticks fall back to a timer
+      getFrame: () => -1,
+      msUntilNextFrame: () => -1,
+      recordTick() { },
+      getPlayers: () => this._players,
+      getLocalPlayerIndex: () => this._localPlayerIndex,
+      getPlayerIdByIndex: index => this._playerIds[index] ?? -1,
+      worldToAutomap: (x, y) => this._samples.get(`${x},${y}`) ?? { x: -1, y: -1 },
+      worldToAutomapMany: (positions, out, count = positions.length / 2) => {
+        for (let i = 0; i < count; i++) {
+          const xy = this._samples.get(`${positions[i * 2]},${positions[i * 2 + 1]}`) ?? { x: -1, y: -1 };
+          out[i * 2] = xy.x;
+          out[i * 2 + 1] = xy.y;
+        }
+        return true;
+      },
+      traceBegin() { },
+      traceEnd() { },
+    };
+    this.rewind();
+  }
+
+  rewind() {
+    this._offset = FILE_HEADER_SIZE;
+    this.frameIndex = -1;
+    this.timestampNs = 0n;
+    this._arena = new Uint8Array(0);
+    this._blobs = [];
+    this._players = new BigUint64Array(0);
+    this._playerIds = [];
+    this._localPlayerIndex = 0;
+    this._samples = new Map();
+  }
+
+  get done() {
+    return this._offset >= this._bytes.byteLength;
+  }
+
+  // The replay has no game to stall.
+  tryWithGameLock(fn) {
+    return fn();
+  }
+
+  // Bytes of a recorded room or level struct containing |address|, null if it was not captured this frame.
+  readMemory(address, size) {
+    for (const blob of this._blobs) {
+      const offset = Number(address - blob.address);
+      if (offset >= 0 && offset + size <= blob.bytes.byteLength) {
+        return new DataView(blob.bytes.buffer, blob.bytes.byteOffset + offset, size);
+      }
+    }
+    return null;
+  }
+
+  // Every recorded frame holds all types, grouped by type, see SnapshotUnits() in src/d2r_binding.cc.
+  _ranges(count) {
+    const ranges = new Uint32Array(1 + TYPE_COUNT * 2);
+    ranges[0] = (1 << TYPE_COUNT) - 1;
+    const view = count > 0 ? new DataView(this._arena.buffer) : null;
+    for (let i = 0; i < count; i++) {
+      const type = recordType(view, i * RECORD_SIZE);
+      if (type >= TYPE_COUNT) continue;
+      if (ranges[2 + type * 2] === 0) ranges[1 + type * 2] = i;
+      ranges[2 + type * 2]++;
+    }
+    return ranges;
+  }
+
+  _nextFrame() {
+    if (this.done) return this._ranges(0);
+    const compressedSize = this._view.getUint32(this._offset, true);
+    const rawSize = this._view.getUint32(this._offset + 4, true);
+    const raw = decompress(this._bytes, this._offset + 8, compressedSize, rawSize);
+    this._offset += 8 + compressedSize;
+    this.frameIndex++;
+
+    const view = new DataView(raw.buffer);
+    this.timestampNs = view.getBigUint64(0, true);
+    this._localPlayerIndex = view.getUint32(8, true);
+    const recordCount = view.getUint32(12, true);
+    const blobCount = view.getUint32(16, true);
+    const sampleCount = view.getUint32(20, true);
+    let p = FRAME_HEADER_SIZE;
+
+    const players = [];
+    this._playerIds = [];
+    for (let i = 0; i < MAX_PLAYERS; i++, p += PLAYER_SIZE) {
+      const id = view.getUint32(p, true);
+      this._playerIds.push(id);
+      if (id !== 0) players.push(BigInt(i), BigInt(id), view.getBigUint64(p + 8, true));
+    }
+    this._players = new BigUint64Array(players);
+
+    this._samples.clear();
+    for (let i = 0; i < sampleCount; i++, p += SAMPLE_SIZE) {
+      const x = view.getInt32(p, true);
+      const y = view.getInt32(p + 4, true);
+      this._samples.set(`${x},${y}`, { x: view.getFloat32(p + 8, true), y: view.getFloat32(p + 12, true) });
+    }
+
+    const previous = this._arena;
+    const arena = new Uint8Array(recordCount * RECORD_SIZE);
+    for (let i = 0; i < recordCount; i++) {
+      const base = view.getInt32(p, true);
+      p += DELTA_HEADER_SIZE;
+      arena.set(raw.subarray(p, p + RECORD_SIZE), i * RECORD_SIZE);
+      if (base >= 0) xorInto(arena, i * RECORD_SIZE, previous, base * RECORD_SIZE, RECORD_SIZE);
+      p += RECORD_SIZE;
+    }
+    this._arena = arena;
+
+    const previousBlobs = this._blobs;
+    const blobs = new Array(blobCount);
+    for (let i = 0; i < blobCount; i++) {
+      const base = view.getInt32(p, true);
+      const kind = view.getUint32(p + 4, true);
+      const address = view.getBigUint64(p + 8, true);
+      const size = view.getUint32(p + 16, true);
+      p += DELTA_HEADER_SIZE;
+      const bytes = raw.slice(p, p + size);
+      if (base >= 0) xorInto(bytes, 0, previousBlobs[base].bytes, 0, size);
+      blobs[i] = { kind, address, bytes };
+      p += size;
+    }
+    this._blobs = blobs;
+
+    return this._ranges(recordCount);
+  }
+}
+
+module.exports = { SessionReplay, BlobKinds };
@@ -0,0 +1,91 @@
+'use strict';
+
+const { getMemorySource, withGameLock } = require('d2r/model-cache');
+
+// Mirrors the readStats() result and StatEntry in src/stat_list.h.
+const HEADER_SIZE = 16;
+
+const EMPTY = new Uint32Array(0);
+
+// Stats are (layer, statId, value) triples packed into two uint32 each, the first word is the sort key
+// statId << 16 | layer the game keeps each array ordered by.
+function statKey(statId, layer) {
+  return ((statId << 16) | layer) >>> 0;
+}
+
+function find(stats, key) {
+  let low = 0;
+  let high = (stats.length >> 1) - 1;
+  while (low <= high) {
+    const mid = (low + high) >> 1;
+    const k = stats[mid * 2];
+    if (k === key) return mid;
+    if (k < key) low = mid + 1;
+    else high = mid - 1;
+  }
+  return -1;
+}
+
+function* iterate(stats) {
+  for (let i = 0; i < stats.length; i += 2) {
+    yield { statId: stats[i] >>> 16, layer: stats[i] & 0xFFFF, value: stats[i + 1] | 0 };
+  }
+}
+
+// Base and full (after items, states and auras) stats of one unit, see Unit.stats. Values are raw: life, mana and
+// stamina are fixed point (>> 8), missing stats read as 0 like in the game.
+class StatList {
+  constructor() {
+    this.version = 0;
+    this._base = EMPTY;
+    this._full = EMPTY;
+  }
+
+  get baseCount() { return this._base.length >> 1; }
+  get count() { return this._full.length >> 1; }
+
+  get(statId, layer = 0) {
+    const index = find(this._full, statKey(statId, layer));
+    return index < 0 ? 0 : this._full[index * 2 + 1] | 0;
+  }
+
+  getBase(statId, layer = 0) {
+    const index = find(this._base, statKey(statId, layer));
+    return index < 0 ? 0 : this._base[index * 2 + 1] | 0;
+  }
+
+  has(statId, layer = 0) {
+    return find(this._full, statKey(statId, layer)) >= 0;
+  }
+
+  // Yields { statId, layer, value } for every full (or base) stat.
+  entries(base = false) {
+    return iterate(base ? this._base : this._full);
+  }
+
+  // |buffer| is a readStats() result with a new version.
+  _apply(buffer) {
+    const header = new Uint32Array(buffer, 0, 4);
+    const baseCount = header[1];
+    const fullCount = header[2];
+    this.version = header[0];
+    this._base = new Uint32Array(buffer, HEADER_SIZE, baseCount * 2);
+    this._full = new Uint32Array(buffer, HEADER_SIZE + baseCount * 8, fullCount * 2);
+  }
+}
+
+// Stats of the unit at |address|, decoded into |target| (or a new StatList). The native side only copies the stats
+// when they changed since |target|'s version, otherwise |target| is returned as is. The game grows and sorts the
+// stat arrays on its own threads, so they are only read with the game stalled.
+function loadStatList(address, target) {
+  if (!address) return null;
+  const version = target ? target.version : 0;
+  const result = withGameLock(() => getMemorySource().readStats(address, version));
+  if (result === undefined) return null;
+  if (typeof result === 'number') return target;
+  target ??= new StatList();
+  target._apply(result);
+  return target;
+}
+
+module.exports = { StatList, loadStatList };
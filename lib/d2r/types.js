@@ -61,4 +61,106 @@ const ItemModes = {
   Socketed: 6,
 };
 
-module.exports = { UnitTypes, PlayerModes, MonsterModes, ItemModes };
+// D2ItemDataStrc::dwQualityNo
+const ItemQuality = {
+  Inferior: 1,
+  Normal: 2,
+  Superior: 3,
+  Magic: 4,
+  Set: 5,
+  Rare: 6,
+  Unique: 7,
+  Crafted: 8,
+  Tempered: 9,
+};
+
+// D2ItemDataStrc::dwItemFlags
+const ItemFlags = {
+  NewItem: 0x1,
+  Identified: 0x10,
+  Broken: 0x100,
+  Socketed: 0x800,
+  Ear: 0x10000,
+  StarterItem: 0x20000,
+  Simple: 0x200000,
+  Ethereal: 0x400000,
+  Personalized: 0x1000000,
+  Runeword: 0x4000000,
+};
+
+// Change mask bits, see unit_change in src/unit_snapshot.h. Automap is computed on the JS side.
+const UnitFields = {
+  Position: 1 << 0,
+  Mode: 1 << 1,
+  Flags: 1 << 2,
+  Data: 1 << 3,
+  PathTarget: 1 << 4,
+  Automap: 1 << 8,
+  Added: 0x80000000,
+  All: 0xFFFFFFFF,
+};
+
+// Change mask bits of inventory items, see inventory_change in src/inventory_snapshot.h.
+const InventoryChanges = {
+  Placement: 1 << 0,
+  Flags: 1 << 1,
+  Added: 0x80000000,
+  All: 0xFFFFFFFF,
+};
+
+// Stat ids of ItemStatCost.txt, the ones overlays ask for most. Life, mana and stamina are fixed point (value >> 8).
+const Stats = {
+  Strength: 0,
+  Energy: 1,
+  Dexterity: 2,
+  Vitality: 3,
+  StatPoints: 4,
+  SkillPoints: 5,
+  Life: 6,
+  MaxLife: 7,
+  Mana: 8,
+  MaxMana: 9,
+  Stamina: 10,
+  MaxStamina: 11,
+  Level: 12,
+  Experience: 13,
+  Gold: 14,
+  GoldBank: 15,
+  Defense: 31,
+  DamageResist: 36,
+  MagicResist: 37,
+  FireResist: 39,
+  MaxFireResist: 40,
+  LightningResist: 41,
+  MaxLightningResist: 42,
+  ColdResist: 43,
+  MaxColdResist: 44,
+  PoisonResist: 45,
+  MaxPoisonResist: 46,
+  Velocity: 67,
+  Quantity: 70,
+  Durability: 72,
+  MaxDurability: 73,
+  MagicFind: 80,
+  ItemLevelRequire: 92,
+  FasterRunWalk: 96,
+  FasterHitRecovery: 99,
+  FasterBlockRate: 102,
+  FasterCastRate: 105,
+  SingleSkill: 107,
+  AllSkills: 127,
+  SkillTab: 188,
+  Sockets: 194,
+};
+
+module.exports = {
+  UnitTypes,
+  PlayerModes,
+  MonsterModes,
+  ItemModes,
+  ItemQuality,
+  ItemFlags,
+  UnitFields,
+  InventoryChanges,
+  Stats,
+};
@@ -0,0 +1,56 @@
+'use strict';
+
+const TYPE_COUNT = 6;
+
+// Units added or removed during one tick, grouped by unit type. The ObjectManager hands the same batch to every
+// 'unitsAdded' or 'unitsRemoved' listener and reuses it next tick, copy what has to outlive the event.
+class UnitBatch {
+  constructor(capacity = 64) {
+    this.counts = new Uint32Array(TYPE_COUNT);
+    this._ids = new Array(TYPE_COUNT);
+    this._units = new Array(TYPE_COUNT);
+    for (let type = 0; type < TYPE_COUNT; type++) {
+      this._ids[type] = new Uint32Array(capacity);
+      this._units[type] = [];
+    }
+  }
+
+  // Units of all types in the batch.
+  get size() {
+    let size = 0;
+    for (let type = 0; type < TYPE_COUNT; type++) size += this.counts[type];
+    return size;
+  }
+
+  // Unit ids of |type|, a view that is only valid during the event.
+  ids(type) {
+    return this._ids[type].subarray(0, this.counts[type]);
+  }
+
+  // Units of |type| in ids() order. Only batches of added units have them, removed units no longer have a slot to
+  // read from and leave this empty.
+  units(type) {
+    return this._units[type];
+  }
+
+  _push(type, id, unit) {
+    const count = this.counts[type];
+    let ids = this._ids[type];
+    if (count === ids.length) {
+      ids = new Uint32Array(count * 2);
+      ids.set(this._ids[type]);
+      this._ids[type] = ids;
+    }
+    ids[count] = id;
+    if (unit !== undefined) this._units[type].push(unit);
+    this.counts[type] = count + 1;
+  }
+
+  _clear() {
+    this.counts.fill(0);
+    // drop the references, a batch must not keep removed units alive
+    for (let type = 0; type < TYPE_COUNT; type++) this._units[type].length = 0;
+  }
+}
+
+module.exports = { UnitBatch };
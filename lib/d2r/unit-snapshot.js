@@ -0,0 +1,99 @@
+'use strict';
+
+const { Seed } = require('d2r/seed');
+const { DynamicPath } = require('d2r/dynamic-path');
+const { UnitLayout, DynamicPathLayout, D2FP32_16Layout, PathPointLayout, SeedLayout } = require('d2r/layouts');
+
+// Mirrors UnitSnapshotRecord in src/unit_snapshot.h. The native side copies the raw D2UnitStrc and
+// D2DynamicPathStrc bytes while the game lock is held, everything here runs after the lock was released.
+const RECORD_SIZE = 0x410;
+const RECORD_ADDRESS = 0x00;
+const RECORD_PATH_ADDRESS = 0x08;
+const RECORD_TYPE = 0x10;
+const RECORD_SOURCE = 0x14;
+const RECORD_CHANGED = 0x18;
+const RECORD_ITEM_RULES = 0x1C;
+const RECORD_UNIT = 0x20;
+const RECORD_PATH = 0x1E0;
+
+// D2UnitStrc field offsets, relative to the start of the record.
+const UNIT = Object.fromEntries(
+  Object.entries(UnitLayout.offsets).map(([name, offset]) => [name, RECORD_UNIT + offset]));
+const PATH = DynamicPathLayout.offsets;
+
+function recordUnitId(view, record) {
+  return view.getUint32(record + UNIT.id, true);
+}
+
+function recordType(view, record) {
+  return view.getUint32(record + RECORD_TYPE, true);
+}
+
+// Copy the hot fields of |record| into the store columns of |slot|.
+function writeHotFields(view, record, store, slot) {
+  store.record[slot] = record;
+  store.address[slot] = view.getBigUint64(record + RECORD_ADDRESS, true);
+  store.classId[slot] = view.getUint32(record + UNIT.classId, true);
+  store.mode[slot] = view.getUint32(record + UNIT.mode, true);
+  store.flags[slot] = view.getUint32(record + UNIT.flags, true);
+  store.flagsEx[slot] = view.getUint32(record + UNIT.flagsEx, true);
+  store.posX[slot] = view.getInt16(record + UNIT.posX, true);
+  store.posY[slot] = view.getInt16(record + UNIT.posY, true);
+}
+
+// UnitFields bits that changed since the previous snapshot, computed natively.
+function recordChanged(view, record) {
+  return view.getUint32(record + RECORD_CHANGED, true);
+}
+
+// Bitmask of the item rules an item record matches, see d2r/item-rules.
+function recordItemRules(view, record) {
+  return view.getUint32(record + RECORD_ITEM_RULES, true);
+}
+
+function recordSource(view, record) {
+  return view.getUint32(record + RECORD_SOURCE, true);
+}
+
+function decodeSeed(view, offset, seed) {
+  return SeedLayout.decode(view, offset, seed ?? new Seed());
+}
+
+// Decode the record's D2DynamicPathStrc, null if the unit has none.
+function decodePath(view, record, path) {
+  const address = view.getBigUint64(record + RECORD_PATH_ADDRESS, true);
+  if (address === 0n) return null;
+  const p = record + RECORD_PATH;
+  path ??= new DynamicPath();
+  path._address = address;
+  D2FP32_16Layout.decode(view, p + PATH.gameCoords, path.gameCoords);
+  path.clientCoordX = view.getInt32(p + PATH.clientCoordX, true);
+  path.clientCoordY = view.getInt32(p + PATH.clientCoordY, true);
+  PathPointLayout.decode(view, p + PATH.targetCoord, path.targetCoord);
+  PathPointLayout.decode(view, p + PATH.prevTargetCoord, path.prevTargetCoord);
+  PathPointLayout.decode(view, p + PATH.finalTargetCoord, path.finalTargetCoord);
+  path._roomAddress = view.getBigUint64(p + PATH.room, true);
+  return path;
+}
+
+// Client coordinates of the record's dynamic path into |out| at |index| (x) and |index + 1| (y), 0, 0 if the unit
+// has none.
+function writeClientCoords(view, record, out, index) {
+  const hasPath = view.getBigUint64(record + RECORD_PATH_ADDRESS, true) !== 0n;
+  out[index] = hasPath ? view.getInt32(record + RECORD_PATH + PATH.clientCoordX, true) : 0;
+  out[index + 1] = hasPath ? view.getInt32(record + RECORD_PATH + PATH.clientCoordY, true) : 0;
+}
+
+module.exports = {
+  RECORD_SIZE,
+  UNIT,
+  recordUnitId,
+  recordType,
+  recordSource,
+  recordChanged,
+  recordItemRules,
+  writeHotFields,
+  writeClientCoords,
+  decodeSeed,
+  decodePath,
+};
@@ -0,0 +1,162 @@
+'use strict';
+
+// Dense structure-of-arrays store for tracked units.
+//
+// Every unit owns a slot, hot fields live in typed array columns indexed by slot. Handles pack the slot with the
+// slot's generation so a handle to a removed unit never resolves to whatever reused the slot later. The Unit
+// classes are thin views over a slot, see d2r/unit.
+
+const SLOT_LIMIT = 2 ** 24;
+const TYPE_COUNT = 6;
+
+const COLUMNS = {
+  generation: Uint32Array,
+  alive: Uint8Array,
+  type: Uint8Array,
+  id: Uint32Array,
+  classId: Uint32Array,
+  mode: Uint32Array,
+  flags: Uint32Array,
+  flagsEx: Uint32Array,
+  posX: Int32Array,
+  posY: Int32Array,
+  automapX: Float64Array,
+  automapY: Float64Array,
+  record: Int32Array, // byte offset of the unit's record in the current snapshot, -1 if none
+  seenTick: Uint32Array,
+  changed: Uint32Array, // UnitFields bits that changed in the current tick
+  address: BigUint64Array,
+};
+
+// Read-only Map-like view over one unit type, keeps getUnits() source compatible with the old Map<id, Unit>.
+class UnitCollection {
+  constructor(store, type) {
+    this._store = store;
+    this._index = store.index[type];
+  }
+
+  get size() { return this._index.size; }
+
+  has(id) { return this._index.has(id); }
+
+  get(id) {
+    const slot = this._index.get(id);
+    return slot === undefined ? undefined : this._store.units[slot];
+  }
+
+  *keys() { yield* this._index.keys(); }
+
+  *values() {
+    for (const slot of this._index.values()) yield this._store.units[slot];
+  }
+
+  *entries() {
+    for (const [id, slot] of this._index) yield [id, this._store.units[slot]];
+  }
+
+  [Symbol.iterator]() { return this.entries(); }
+
+  forEach(fn, thisArg) {
+    for (const [id, slot] of this._index) fn.call(thisArg, this._store.units[slot], id, this);
+  }
+}
+
+class UnitStore {
+  constructor(capacity = 1024) {
+    this.capacity = 0;
+    this.tick = 0;
+    this.view = null; // DataView over the current snapshot arena
+    this.binding = null; // d2r binding of the snapshot source
+    this.units = [];
+    this.index = new Array(TYPE_COUNT);
+    this.collections = new Array(TYPE_COUNT);
+    this._free = [];
+    this._next = 0;
+    for (const name in COLUMNS) this[name] = new COLUMNS[name](0);
+    for (let i = 0; i < TYPE_COUNT; i++) {
+      this.index[i] = new Map();
+      this.collections[i] = new UnitCollection(this, i);
+    }
+    this._grow(capacity);
+  }
+
+  _grow(capacity) {
+    for (const name in COLUMNS) {
+      const column = new COLUMNS[name](capacity);
+      column.set(this[name]);
+      this[name] = column;
+    }
+    this.record.fill(-1, this.capacity);
+    this.units.length = capacity;
+    this.capacity = capacity;
+  }
+
+  // Allocate a slot for (type, id). |createView| builds the Unit view for the new slot.
+  alloc(type, id, createView) {
+    let slot;
+    if (this._free.length > 0) {
+      slot = this._free.pop();
+    } else {
+      if (this._next === this.capacity) {
+        if (this.capacity * 2 > SLOT_LIMIT) throw new RangeError('UnitStore capacity exceeded');
+        this._grow(this.capacity * 2);
+      }
+      slot = this._next++;
+    }
+    this.alive[slot] = 1;
+    this.type[slot] = type;
+    this.id[slot] = id;
+    this.record[slot] = -1;
+    this.index[type].set(id, slot);
+    this.units[slot] = createView(this, slot);
+    return slot;
+  }
+
+  free(slot) {
+    if (!this.alive[slot]) return;
+    this.index[this.type[slot]].delete(this.id[slot]);
+    this.alive[slot] = 0;
+    this.record[slot] = -1;
+    this.generation[slot]++;
+    this.units[slot] = undefined;
+    this._free.push(slot);
+  }
+
+  find(type, id) {
+    const slot = this.index[type].get(id);
+    return slot === undefined ? -1 : slot;
+  }
+
+  handle(slot) {
+    return this.generation[slot] * SLOT_LIMIT + slot;
+  }
+
+  isValid(handle) {
+    const slot = handle % SLOT_LIMIT;
+    return slot < this.capacity && this.alive[slot] === 1 && this.generation[slot] === Math.floor(handle / SLOT_LIMIT);
+  }
+
+  resolve(handle) {
+    return this.isValid(handle) ? this.units[handle % SLOT_LIMIT] : null;
+  }
+
+  // Free every slot of the types in |typeMask| whose unit was not seen in the current tick, |onRemove| is called
+  // before the slot is freed.
+  sweep(onRemove, typeMask = 0xFF) {
+    const tick = this.tick;
+    for (let slot = 0; slot < this._next; slot++) {
+      if (this.alive[slot] && this.seenTick[slot] !== tick && (typeMask & (1 << this.type[slot])) !== 0) {
+        onRemove(this.units[slot], this.type[slot]);
+        this.free(slot);
+      }
+    }
+  }
+
+  clear() {
+    for (let slot = 0; slot < this._next; slot++) {
+      if (this.alive[slot]) this.free(slot);
+    }
+  }
+}
+
+module.exports = { UnitStore, UnitCollection, SLOT_LIMIT };
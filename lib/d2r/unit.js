@@ -4,19 +4,151 @@
 require('d2r/seed');
 require('d2r/drlg-act');
 
-const { EventEmitter } = require('events');
+const { DrlgActLayout, SkillListLayout } = require('d2r/layouts');
+const { loadModel, loadShared } = require('d2r/model-cache');
+const { UNIT, decodeSeed, decodePath } = require('d2r/unit-snapshot');
+const { loadStatList } = require('d2r/stat-list');
+const { SLOT_LIMIT } = require('d2r/unit-store');
 
-class Unit extends EventEmitter {
-  constructor() {
-    super();
-    this._valid = true;
+// Column and record fields by prototype, serialized by Unit.toJSON. Own property so subclasses add to their own list.
+const JSON_FIELDS = Symbol('jsonFields');
+
+function addJsonField(proto, name) {
+  if (!Object.prototype.hasOwnProperty.call(proto, JSON_FIELDS)) proto[JSON_FIELDS] = [];
+  proto[JSON_FIELDS].push(name);
+}
+
+// Hot fields live in the store's typed array columns.
+function defineColumn(proto, name, column = name, fallback = 0) {
+  addJsonField(proto, name);
+  Object.defineProperty(proto, name, {
+    get() { return this.isValid ? this._store[column][this._slot] : fallback; },
+    configurable: true,
+  });
+}
+
+// Cold fields are read from the unit's record in the current snapshot on access.
+function defineRecordField(proto, name, offset, read) {
+  addJsonField(proto, name);
+  Object.defineProperty(proto, name, {
+    get() {
+      const record = this._record();
+      return record < 0 ? read.fallback : read(this._store.view, record + offset);
+    },
+    configurable: true,
+  });
+}
+
+const u32 = (view, offset) => view.getUint32(offset, true);
+u32.fallback = 0;
+const u64 = (view, offset) => view.getBigUint64(offset, true);
+u64.fallback = 0n;
+const u8 = (view, offset) => view.getUint8(offset);
+u8.fallback = 0;
+
+function readSeed(seed) { return decodeSeed(this._store.view, this._record() + UNIT.seed, seed); }
+function readInitSeed(seed) { return decodeSeed(this._store.view, this._record() + UNIT.initSeed, seed); }
+function readPath(path) { return decodePath(this._store.view, this._record(), path); }
+function readDrlgAct() { return loadShared(DrlgActLayout, this._recordU64(UNIT.drlgAct)); }
+function readSkills(skills) { return loadModel(SkillListLayout, this._recordU64(UNIT.skills), skills); }
+function readStats(stats) { return loadStatList(this._address, stats); }
+
+// Thin view over one UnitStore slot. Views are created by the ObjectManager and stay valid until the unit leaves
+// the unit tables, after that every field reads as its default.
+class Unit {
+  constructor(store, slot) {
+    this._store = store;
+    this._slot = slot;
+    this._generation = store.generation[slot];
+    this.type = store.type[slot];
+    this.id = store.id[slot];
+    this._cacheTicks = {};
+    this._cacheValues = {};
   }
 
-  get isValid() { return this._valid; }
+  get isValid() {
+    return this._store.generation[this._slot] === this._generation && this._store.alive[this._slot] === 1;
+  }
+
+  // Generation-checked handle, see UnitStore.resolve().
+  get handle() { return this._generation * SLOT_LIMIT + this._slot; }
+
+  get seed() { return this._cached('seed', readSeed); }
+  get initSeed() { return this._cached('initSeed', readInitSeed); }
+  get path() { return this._cached('path', readPath); }
 
-  _invalidate() {
-    this._valid = false;
+  // Nested structs are not part of the snapshot, they are read from game memory on access. The act is shared by
+  // every unit in it.
+  get drlgAct() { return this._cached('drlgAct', readDrlgAct); }
+  get skills() { return this._cached('skills', readSkills); }
+
+  // Decoded from the unit's stat list, which the native side copies only when it changed since the last read.
+  get stats() { return this._cached('stats', readStats); }
+
+  // The column and record fields as of the current tick. The store and the caches are left out, the store refers back
+  // to every unit.
+  toJSON() {
+    const json = { type: this.type, id: this.id, isValid: this.isValid };
+    const protos = [];
+    for (let proto = Object.getPrototypeOf(this); proto !== null; proto = Object.getPrototypeOf(proto)) {
+      protos.unshift(proto);
+    }
+    for (const proto of protos) {
+      if (!Object.prototype.hasOwnProperty.call(proto, JSON_FIELDS)) continue;
+      for (const name of proto[JSON_FIELDS]) json[name] = this[name];
+    }
+    return json;
+  }
+
+  // Called by the ObjectManager after the slot's columns were refreshed from the snapshot.
+  _update() { }
+
+  _record() {
+    return this.isValid && this._store.view ? this._store.record[this._slot] : -1;
+  }
+
+  _recordU64(offset) {
+    return this._store.view.getBigUint64(this._record() + offset, true);
+  }
+
+  // Decode once per tick, |decode| is called with the previous value so objects are reused.
+  _cached(key, decode) {
+    if (this._record() < 0) return null;
+    const tick = this._store.tick;
+    if (this._cacheTicks[key] !== tick) {
+      this._cacheTicks[key] = tick;
+      this._cacheValues[key] = decode.call(this, this._cacheValues[key]);
+    }
+    return this._cacheValues[key];
   }
 }
 
-module.exports = { Unit };
+defineColumn(Unit.prototype, '_address', 'address', 0n);
+defineColumn(Unit.prototype, 'classId');
+defineColumn(Unit.prototype, 'mode');
+defineColumn(Unit.prototype, 'posX');
+defineColumn(Unit.prototype, 'posY');
+defineColumn(Unit.prototype, 'flags');
+defineColumn(Unit.prototype, 'flagsEx');
+
+defineRecordField(Unit.prototype, 'data', UNIT.data, u64);
+defineRecordField(Unit.prototype, 'actId', UNIT.actId, u64);
+defineRecordField(Unit.prototype, 'animSeqFrame', UNIT.animSeqFrame, u32);
+defineRecordField(Unit.prototype, 'animSeqFrame2', UNIT.animSeqFrame2, u32);
+defineRecordField(Unit.prototype, 'animSeqFrameCount', UNIT.animSeqFrameCount, u32);
+defineRecordField(Unit.prototype, 'animSpeed', UNIT.animSpeed, u32);
+defineRecordField(Unit.prototype, 'animData', UNIT.animData, u64);
+defineRecordField(Unit.prototype, 'gfxData', UNIT.gfxData, u64);
+defineRecordField(Unit.prototype, 'statListEx', UNIT.statListEx, u64);
+defineRecordField(Unit.prototype, 'inventory', UNIT.inventory, u64);
+defineRecordField(Unit.prototype, 'packetList', UNIT.packetList, u64);
+defineRecordField(Unit.prototype, 'changeNextUnit', UNIT.changeNextUnit, u64);
+defineRecordField(Unit.prototype, 'unitNext', UNIT.unitNext, u64);
+defineRecordField(Unit.prototype, 'roomUnitNext', UNIT.roomUnitNext, u64);
+defineRecordField(Unit.prototype, 'collisionUnitType', UNIT.collisionUnitType, u32);
+defineRecordField(Unit.prototype, 'collisionUnitClassId', UNIT.collisionUnitClassId, u32);
+defineRecordField(Unit.prototype, 'collisionUnitSizeX', UNIT.collisionUnitSizeX, u32);
+defineRecordField(Unit.prototype, 'collisionUnitSizeY', UNIT.collisionUnitSizeY, u32);
+defineRecordField(Unit.prototype, 'dataTblsIndex', UNIT.dataTblsIndex, u8);
+
+module.exports = { Unit, defineColumn };
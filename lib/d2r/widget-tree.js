@@ -0,0 +1,117 @@
+'use strict';
+
+const { getMemorySource } = require('d2r/model-cache');
+
+// Mirrors the snapshotWidgets() result and WidgetEntry / WidgetFlags in src/widget_tree.h.
+const HEADER_SIZE = 16;
+const ENTRY_SIZE = 32;
+
+const WidgetFlags = {
+  Visible: 0x1,
+  Enabled: 0x2,
+  Shown: 0x4, // visible along with every ancestor
+};
+
+// FNV-1a of the lowercased name, same as WidgetNameHash in src/widget_tree.cc.
+function widgetNameHash(name) {
+  let hash = 0x811C9DC5;
+  for (let i = 0; i < name.length; i++) {
+    let c = name.charCodeAt(i) & 0xFF;
+    if (c >= 0x41 && c <= 0x5A) c += 0x20;
+    hash = Math.imul(hash ^ c, 0x01000193) >>> 0;
+  }
+  return hash;
+}
+
+// The game's UI flattened into depth-first entries (a widget's subtree follows it), index 0 is the PanelManager.
+// update() copies the native snapshot only when something changed, names are only sent after the tree was rebuilt.
+// Rects are the widgets' absolute rects: x, y, width, height in screen pixels.
+class WidgetTree {
+  constructor() {
+    this.version = 0;
+    this.count = 0;
+    this.hoverPanel = -1;
+    this.hoverWidget = -1;
+    this._view = null;
+    this._names = [];
+    this._byHash = new Map();
+  }
+
+  // Refresh from the game, returns true if anything changed since the last update.
+  update() {
+    const result = getMemorySource().snapshotWidgets(this.version);
+    if (result === undefined) {
+      if (this.count === 0) return false;
+      this.version = 0;
+      this.count = 0;
+      this.hoverPanel = this.hoverWidget = -1;
+      this._view = null;
+      return true;
+    }
+    if (typeof result === 'number') return false;
+
+    const [buffer, names] = result;
+    const view = new DataView(buffer);
+    this.version = view.getUint32(0, true);
+    this.count = view.getUint32(4, true);
+    this.hoverPanel = view.getInt32(8, true);
+    this.hoverWidget = view.getInt32(12, true);
+    this._view = view;
+    if (names) {
+      this._names = names;
+      this._byHash.clear();
+      for (let i = this.count - 1; i >= 0; i--) this._byHash.set(this.nameHash(i), i);
+    }
+    return true;
+  }
+
+  name(index) { return this._names[index] ?? ''; }
+  nameHash(index) { return this._view.getUint32(HEADER_SIZE + index * ENTRY_SIZE, true); }
+  parent(index) { return this._view.getInt32(HEADER_SIZE + index * ENTRY_SIZE + 4, true); }
+  flags(index) { return this._view.getUint8(HEADER_SIZE + index * ENTRY_SIZE + 24); }
+  depth(index) { return this._view.getUint8(HEADER_SIZE + index * ENTRY_SIZE + 25); }
+  childCount(index) { return this._view.getUint16(HEADER_SIZE + index * ENTRY_SIZE + 26, true); }
+
+  isVisible(index) { return (this.flags(index) & WidgetFlags.Visible) !== 0; }
+  isEnabled(index) { return (this.flags(index) & WidgetFlags.Enabled) !== 0; }
+  // visible along with every ancestor, i.e. actually on screen
+  isShown(index) { return (this.flags(index) & WidgetFlags.Shown) !== 0; }
+
+  rect(index) {
+    const offset = HEADER_SIZE + index * ENTRY_SIZE + 8;
+    const view = this._view;
+    return {
+      x: view.getInt32(offset, true),
+      y: view.getInt32(offset + 4, true),
+      width: view.getInt32(offset + 8, true),
+      height: view.getInt32(offset + 12, true),
+    };
+  }
+
+  // Index of the first widget (depth-first) named |name|, case-insensitive like the game's lookup. -1 if none.
+  find(name) {
+    return this._byHash.get(widgetNameHash(name)) ?? -1;
+  }
+
+  // Rects of the shown widgets up to |maxDepth| below the root (1 = the top-level panels) that cover some area.
+  // Overlays can skip drawing under them.
+  visibleRects(maxDepth = 1) {
+    const rects = [];
+    for (let i = 1; i < this.count; i++) {
+      if (this.depth(i) > maxDepth || !this.isShown(i)) continue;
+      const rect = this.rect(i);
+      if (rect.width > 0 && rect.height > 0) rects.push(rect);
+    }
+    return rects;
+  }
+
+  // true if screen point |x|, |y| lies under one of visibleRects(|maxDepth|).
+  isCovered(x, y, maxDepth = 1) {
+    for (const rect of this.visibleRects(maxDepth)) {
+      if (x >= rect.x && y >= rect.y && x < rect.x + rect.width && y < rect.y + rect.height) return true;
+    }
+    return false;
+  }
+}
+
+module.exports = { WidgetTree, WidgetFlags, widgetNameHash };
@@ -1,26 +1,31 @@
 'use strict';
 
-const { Unit } = require('d2r/unit');
-
-const binding = internalBinding('d2r');
+const { Unit, defineColumn } = require('d2r/unit');
+const { UnitFields } = require('d2r/types');
 
 class WorldObject extends Unit {
-  constructor() {
-    super();
-    this.automapX = -1;
-    this.automapY = -1;
+  constructor(store, slot) {
+    super(store, slot);
+    store.automapX[slot] = -1;
+    store.automapY[slot] = -1;
+  }
 
-    this.on('update', () => {
-      if (this.path) {
-        const pos = binding.worldToAutomap(
-          this.path.clientCoordX,
-          this.path.clientCoordY,
-        );
-        this.automapX = pos.x;
-        this.automapY = pos.y;
+  _update() {
+    const path = this.path;
+    if (path) {
+      const store = this._store;
+      const slot = this._slot;
+      const pos = store.binding.worldToAutomap(path.clientCoordX, path.clientCoordY);
+      if (store.automapX[slot] !== pos.x || store.automapY[slot] !== pos.y) {
+        store.automapX[slot] = pos.x;
+        store.automapY[slot] = pos.y;
+        store.changed[slot] |= UnitFields.Automap;
       }
-    });
+    }
   }
 }
 
+defineColumn(WorldObject.prototype, 'automapX', 'automapX', -1);
+defineColumn(WorldObject.prototype, 'automapY', 'automapY', -1);
+
 module.exports = { WorldObject };
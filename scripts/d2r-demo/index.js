@@ -1,6 +1,6 @@
 'use strict';
 
-import { ObjectManager, UnitTypes, DebugPanel, revealLevel } from 'nyx:d2r';
+import { ObjectManager, UnitTypes, DebugPanel, onFrame, revealLevel } from 'nyx:d2r';
 import { withGameLock } from 'nyx:memory';
 import { Markers } from './markers.js';
 
@@ -42,7 +42,8 @@ try {
   }
 
   let revealed_levels = [];
-  setInterval(() => {
+  // ticks are the expensive part, the markers move along the units' paths on the frames in between
+  onFrame(() => {
     objMgr.tick();
     debugPanel.refresh();
     const me = objMgr.me;
@@ -61,7 +62,8 @@ try {
         });
       }
     }
-  }, 20);
+  }, { every: 3 });
+  onFrame(() => markers.draw());
 } catch (err) {
   console.error(err.message);
   console.error(err.stack);
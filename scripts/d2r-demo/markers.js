@@ -1,7 +1,7 @@
 'use strict';
 
 import { background } from 'gui';
-import { UnitTypes } from 'nyx:d2r';
+import { UnitTypes, worldToAutomapMany } from 'nyx:d2r';
 
 // color format: 0xAABBGGRR
 const COLOR_PLAYER   = 0xFF00FF00; // green
@@ -15,59 +15,66 @@ const RADIUS_MISSILE = 2;
 
 const MARKER_TYPES = new Set([UnitTypes.Player, UnitTypes.Monster, UnitTypes.Missile]);
 
+// Markers follow the units along their paths between ticks, draw() runs once per displayed frame.
 class Markers {
   constructor(objMgr) {
     this._objMgr = objMgr;
     this._keys = new Set();
+    this._automap = new Float32Array(0);
 
-    this._onUnitAdded   = (unit, type) => this._handleUnitAdded(unit, type);
-    this._onUnitRemoved = (unit, type) => this._handleUnitRemoved(unit, type);
+    this._onUnitsRemoved = (batch) => this._handleUnitsRemoved(batch);
 
-    objMgr.on('unitAdded',   this._onUnitAdded);
-    objMgr.on('unitRemoved', this._onUnitRemoved);
+    objMgr.setExtrapolation(true);
+    objMgr.on('unitsRemoved', this._onUnitsRemoved);
   }
 
   _key(type, id) {
     return `marker-${type}-${id}`;
   }
 
-  _handleUnitAdded(unit, type) {
-    if (!MARKER_TYPES.has(type)) return;
+  draw() {
+    const motion = this._objMgr.extrapolate();
+    if (this._automap.length < motion.positions.length) {
+      this._automap = new Float32Array(motion.positions.length);
+    }
+    const shown = worldToAutomapMany(motion.positions, this._automap, motion.count);
+    const me = this._objMgr.me;
 
-    const key = this._key(type, unit.id);
-    this._keys.add(key);
-
-    unit.on('update', () => {
-      if (unit.automapX < 0) {
-        background.remove(key);
-        return;
+    for (let i = 0; i < motion.count; i++) {
+      const unit = motion.units[i];
+      const type = unit.type;
+      const key = this._key(type, unit.id);
+      const x = this._automap[i * 2];
+      const y = this._automap[i * 2 + 1];
+      if (!shown || x < 0 || (type === UnitTypes.Monster && !unit.isAlive)) {
+        if (this._keys.delete(key)) background.remove(key);
+        continue;
       }
 
+      this._keys.add(key);
       if (type === UnitTypes.Player) {
-        const color = (unit === this._objMgr.me) ? COLOR_ME : COLOR_PLAYER;
-        background.addCircleFilled(key, [unit.automapX, unit.automapY], RADIUS_PLAYER, color);
+        background.addCircleFilled(key, [x, y], RADIUS_PLAYER, unit === me ? COLOR_ME : COLOR_PLAYER);
       } else if (type === UnitTypes.Monster) {
-        if (!unit.isAlive) {
-          background.remove(key);
-          return;
-        }
-        background.addCircleFilled(key, [unit.automapX, unit.automapY], RADIUS_MONSTER, COLOR_MONSTER);
+        background.addCircleFilled(key, [x, y], RADIUS_MONSTER, COLOR_MONSTER);
       } else {
-        background.addCircleFilled(key, [unit.automapX, unit.automapY], RADIUS_MISSILE, COLOR_MISSILE);
+        background.addCircleFilled(key, [x, y], RADIUS_MISSILE, COLOR_MISSILE);
       }
-    });
+    }
   }
 
-  _handleUnitRemoved(unit, type) {
-    if (!MARKER_TYPES.has(type)) return;
-    const key = this._key(type, unit.id);
-    this._keys.delete(key);
-    background.remove(key);
+  _handleUnitsRemoved(batch) {
+    for (const type of MARKER_TYPES) {
+      const ids = batch.ids(type);
+      for (let i = 0; i < ids.length; i++) {
+        const key = this._key(type, ids[i]);
+        if (this._keys.delete(key)) background.remove(key);
+      }
+    }
   }
 
   destroy() {
-    this._objMgr.off('unitAdded',   this._onUnitAdded);
-    this._objMgr.off('unitRemoved', this._onUnitRemoved);
+    this._objMgr.off('unitsRemoved', this._onUnitsRemoved);
+    this._objMgr.setExtrapolation(false);
     for (const key of this._keys) background.remove(key);
     this._keys.clear();
   }
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace d2r {
+
+enum class AutomapPackResult {
+  kOk,
+  kLowOutOfBounds,
+  kHighOutOfBounds,
+};
+
+// Converts an absolute tile position into the packed automap cell coordinates AUTOMAP_NewAutomapCell expects:
+// isometric projection, scaled down by 10, x in the low and y in the high dword. Both halves must fit a signed
+// 16-bit value.
+inline AutomapPackResult PackAutomapCellCoords(int32_t tile_x, int32_t tile_y, bool large_tile, int64_t* packed) {
+  int32_t absx = 80 * (tile_x - tile_y);
+  int32_t absy = (80 * (tile_y + tile_x)) >> 1;
+  if (large_tile) {
+    absx += 24;
+    absy += 24;
+  }
+
+  int32_t low = absx / 10;
+  int32_t high = absy / 10;
+  if (low + 0x8000 > 0xFFFF) {
+    return AutomapPackResult::kLowOutOfBounds;
+  }
+  if (high + 0x8000 > 0xFFFF) {
+    return AutomapPackResult::kHighOutOfBounds;
+  }
+  *packed = static_cast<int64_t>((static_cast<uint64_t>(high) << 32) | static_cast<uint32_t>(low));
+  return AutomapPackResult::kOk;
+}
+
+}  // namespace d2r
@@ -0,0 +1,198 @@
+#include "binary_log.h"
+
+#include "trace.h"
+
+#include <Windows.h>
+#include <dolos/pipe_log.h>
+
+#include <array>
+#include <thread>
+
+namespace d2r {
+
+namespace {
+
+constexpr std::size_t kRingCapacity = 1 << 13;  // must be a power of two
+constexpr std::size_t kBatchSize = 256;
+// the reader writes its level right after the connect, a silent one is treated as not keeping trace lines
+constexpr DWORD kGreetingTimeoutMs = 1000;
+
+// Bounded multi-producer/single-consumer ring. Every slot carries a sequence number: producers claim a position
+// with a CAS on the enqueue cursor and publish the slot by advancing its sequence, the flush thread is the only
+// consumer.
+struct Slot {
+  std::atomic<uint64_t> seq;
+  BinlogRecord record;
+};
+
+std::array<Slot, kRingCapacity> s_ring;
+std::atomic<uint64_t> s_enqueue_pos{0};
+uint64_t s_dequeue_pos = 0;
+
+std::atomic<bool> s_running{false};
+std::thread s_flush_thread;
+
+bool Enqueue(const BinlogRecord& record) {
+  uint64_t pos = s_enqueue_pos.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot& slot = s_ring[pos & (kRingCapacity - 1)];
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+    if (diff == 0) {
+      if (s_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        slot.record = record;
+        slot.seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;  // full
+    } else {
+      pos = s_enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool Dequeue(BinlogRecord* out) {
+  Slot& slot = s_ring[s_dequeue_pos & (kRingCapacity - 1)];
+  if (slot.seq.load(std::memory_order_acquire) != s_dequeue_pos + 1) {
+    return false;
+  }
+  *out = slot.record;
+  slot.seq.store(s_dequeue_pos + kRingCapacity, std::memory_order_release);
+  ++s_dequeue_pos;
+  return true;
+}
+
+// Reads the BinlogReaderLevel byte of a fresh connection. Returns false if the reader closed the pipe.
+bool ReadReaderLevel(HANDLE pipe, BinlogReaderLevel* level) {
+  *level = BinlogReaderLevel::kAboveTrace;
+  DWORD start = GetTickCount();
+  DWORD available = 0;
+  while (available == 0) {
+    if (!PeekNamedPipe(pipe, nullptr, 0, nullptr, &available, nullptr)) {
+      return false;
+    }
+    if (available == 0) {
+      if (GetTickCount() - start >= kGreetingTimeoutMs || !s_running) {
+        return true;
+      }
+      Sleep(10);
+    }
+  }
+  uint8_t byte = 0;
+  DWORD read = 0;
+  if (!ReadFile(pipe, &byte, 1, &read, nullptr)) {
+    return false;
+  }
+  *level = static_cast<BinlogReaderLevel>(byte);
+  return true;
+}
+
+}  // namespace
+
+bool BinaryLog::Initialize() {
+  if (s_running) {
+    return true;
+  }
+  for (std::size_t i = 0; i < kRingCapacity; ++i) {
+    s_ring[i].seq.store(i, std::memory_order_relaxed);
+  }
+  s_enqueue_pos.store(0, std::memory_order_relaxed);
+  s_dequeue_pos = 0;
+
+  s_running = true;
+  s_flush_thread = std::thread(&BinaryLog::FlushLoop);
+  return true;
+}
+
+void BinaryLog::Shutdown() {
+  s_running = false;
+  if (s_flush_thread.joinable()) {
+    s_flush_thread.join();
+  }
+}
+
+void BinaryLog::Write(BinlogFormat format, uint8_t arg_count, const BinlogArgType* types, const uint64_t* args) {
+  BinlogRecord record{};
+  record.timestamp_ns = trace::NowNs();
+  record.format_id = static_cast<uint16_t>(format);
+  record.arg_count = arg_count;
+  for (uint8_t i = 0; i < arg_count; ++i) {
+    record.arg_types[i] = types[i];
+    record.args[i] = args[i];
+  }
+  if (!Enqueue(record)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void BinaryLog::FlushLoop() {
+  HANDLE pipe = INVALID_HANDLE_VALUE;
+  std::array<BinlogRecord, kBatchSize> batch;
+  DWORD last_attempt = 0;
+
+  while (s_running) {
+    if (pipe == INVALID_HANDLE_VALUE) {
+      DWORD now = GetTickCount();
+      if (now - last_attempt >= 1000) {
+        last_attempt = now;
+        pipe = CreateFileA(kBinlogPipeName, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+        BinlogReaderLevel level;
+        if (pipe != INVALID_HANDLE_VALUE && !ReadReaderLevel(pipe, &level)) {
+          CloseHandle(pipe);
+          pipe = INVALID_HANDLE_VALUE;
+        }
+        if (pipe != INVALID_HANDLE_VALUE) {
+          // drop whatever was queued before the reader showed up
+          BinlogRecord discard;
+          while (Dequeue(&discard)) {
+          }
+          active_ = level == BinlogReaderLevel::kTrace;
+          PIPE_LOG_DEBUG("[BinaryLog] Reader connected{}", IsActive() ? "" : ", it does not keep trace lines");
+        }
+      }
+      if (pipe == INVALID_HANDLE_VALUE) {
+        Sleep(100);
+        continue;
+      }
+    }
+
+    if (!IsActive()) {
+      // nothing is recorded for this reader, only notice when it goes away
+      DWORD available = 0;
+      if (!PeekNamedPipe(pipe, nullptr, 0, nullptr, &available, nullptr)) {
+        CloseHandle(pipe);
+        pipe = INVALID_HANDLE_VALUE;
+        PIPE_LOG_DEBUG("[BinaryLog] Reader disconnected");
+      } else {
+        Sleep(100);
+      }
+      continue;
+    }
+
+    std::size_t count = 0;
+    while (count < batch.size() && Dequeue(&batch[count])) {
+      ++count;
+    }
+    if (count == 0) {
+      Sleep(5);
+      continue;
+    }
+
+    DWORD size = static_cast<DWORD>(count * sizeof(BinlogRecord));
+    DWORD written = 0;
+    if (!WriteFile(pipe, batch.data(), size, &written, nullptr) || written != size) {
+      active_ = false;
+      CloseHandle(pipe);
+      pipe = INVALID_HANDLE_VALUE;
+      PIPE_LOG_DEBUG("[BinaryLog] Reader disconnected");
+    }
+  }
+
+  active_ = false;
+  if (pipe != INVALID_HANDLE_VALUE) {
+    CloseHandle(pipe);
+  }
+}
+
+}  // namespace d2r
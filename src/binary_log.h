@@ -0,0 +1,89 @@
+#pragma once
+
+#include "binary_log_format.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace d2r {
+
+// Deferred-format binary log channel.
+//
+// BINLOG() stores a format id and the raw argument bits into a bounded lock-free ring, a background thread drains
+// the ring into the kBinlogPipeName pipe and simple_injector formats the records on its side. Nothing is formatted
+// in the game process. All records are trace output: they are only produced while a reader that keeps trace lines
+// (see BinlogReaderLevel) is connected, otherwise BINLOG() is one relaxed load.
+class BinaryLog {
+ public:
+  static bool Initialize();
+  static void Shutdown();
+
+  static bool IsActive() { return active_.load(std::memory_order_relaxed); }
+
+  static void Write(BinlogFormat format, uint8_t arg_count, const BinlogArgType* types, const uint64_t* args);
+
+  // records dropped because the ring was full
+  static uint64_t dropped() { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  static void FlushLoop();
+
+  static inline std::atomic<bool> active_{false};
+  static inline std::atomic<uint64_t> dropped_{0};
+};
+
+namespace binlog_detail {
+
+template <typename T>
+constexpr BinlogArgType ArgType() {
+  using U = std::remove_cvref_t<T>;
+  if constexpr (std::is_same_v<U, bool>) {
+    return BinlogArgType::kBool;
+  } else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+    return BinlogArgType::kPointer;
+  } else if constexpr (std::is_floating_point_v<U>) {
+    return BinlogArgType::kDouble;
+  } else if constexpr (std::is_enum_v<U>) {
+    return std::is_signed_v<std::underlying_type_t<U>> ? BinlogArgType::kInt64 : BinlogArgType::kUint64;
+  } else {
+    static_assert(std::is_integral_v<U>, "unsupported binary log argument type");
+    return std::is_signed_v<U> ? BinlogArgType::kInt64 : BinlogArgType::kUint64;
+  }
+}
+
+template <typename T>
+uint64_t ArgBits(const T& value) {
+  using U = std::remove_cvref_t<T>;
+  if constexpr (std::is_pointer_v<U>) {
+    return reinterpret_cast<uint64_t>(value);
+  } else if constexpr (std::is_null_pointer_v<U>) {
+    return 0;
+  } else if constexpr (std::is_floating_point_v<U>) {
+    return std::bit_cast<uint64_t>(static_cast<double>(value));
+  } else if constexpr (ArgType<T>() == BinlogArgType::kInt64) {
+    return static_cast<uint64_t>(static_cast<int64_t>(value));
+  } else {
+    return static_cast<uint64_t>(value);
+  }
+}
+
+template <typename... Args>
+void Write(BinlogFormat format, const Args&... args) {
+  static_assert(sizeof...(Args) <= kBinlogMaxArgs, "too many binary log arguments");
+  constexpr BinlogArgType types[kBinlogMaxArgs + 1] = {ArgType<Args>()..., BinlogArgType::kNone};
+  const uint64_t values[kBinlogMaxArgs + 1] = {ArgBits(args)..., 0};
+  BinaryLog::Write(format, static_cast<uint8_t>(sizeof...(Args)), types, values);
+}
+
+}  // namespace binlog_detail
+
+#define BINLOG(format, ...)                                                                                            \
+  do {                                                                                                                 \
+    if (::d2r::BinaryLog::IsActive()) {                                                                                \
+      ::d2r::binlog_detail::Write(::d2r::BinlogFormat::format, ##__VA_ARGS__);                                         \
+    }                                                                                                                  \
+  } while (0)
+
+}  // namespace d2r
@@ -0,0 +1,78 @@
+#pragma once
+
+// Wire format of the binary log channel. Shared between nyx.d2r (writer) and simple_injector (reader), keep this
+// header free of Windows and dolos dependencies.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace d2r {
+
+constexpr auto kBinlogPipeName = "\\\\.\\pipe\\dolos_binlog";
+
+// The one byte the reader writes right after accepting a connection. Every binary log record is trace output, the
+// writer only produces records for a reader that keeps trace lines.
+enum class BinlogReaderLevel : uint8_t {
+  kTrace = 0,
+  kAboveTrace = 1,
+};
+
+// Format strings use the same {} / {:p} syntax as PIPE_LOG but are only ever formatted by the reader. Append new
+// entries at the end, ids are positional.
+#define D2R_BINLOG_FORMAT_LIST(V)                                                                                      \
+  V(WorldToAutomapInput, "Converting {}, {} to automap coords")                                                        \
+  V(WorldToAutomapPanel, "Found AutoMapPanel at {:p}")                                                                 \
+  V(WorldToAutomapMode, "mode = {}")                                                                                   \
+  V(WorldToAutomapScaledPosition, "Scaled position = {}, {}")                                                          \
+  V(WorldToAutomapScaledSize, "Scaled size = {}, {}")                                                                  \
+  V(WorldToAutomapShift, "Shift = {}")                                                                                 \
+  V(WorldToAutomapCenter, "ptCenter = {}, {}")                                                                         \
+  V(AutoMapDataInputs, "AutoMapData inputs")                                                                           \
+  V(AutoMapDataRect, "  ptRect: {}, {}, {}, {}")                                                                       \
+  V(AutoMapDataCenter, "  ptCenter: {}, {}")                                                                           \
+  V(AutoMapDataScale, "  flFinalSize: {}")                                                                             \
+  V(AutoMapDataOutput, "AutoMapData output")                                                                           \
+  V(AutoMapDataFields0, "  automap_data.unk_0000: {} unk_0008: {} unk_0010: {} unk_0018: {}")                          \
+  V(AutoMapDataFields1, "  automap_data.unk_0020: {} unk_0028: {}")                                                    \
+  V(AutoMapDataFields2, "  automap_data.unk_0030: {} unk_0034: {} unk_0038: {}")                                       \
+  V(PrecisionToAutomapInputs, "PrecisionToAutomap inputs")                                                             \
+  V(PrecisionToAutomapOutputs, "PrecisionToAutomap outputs")                                                           \
+  V(PrecisionToAutomapValue, "  nPrecision: {} ({}, {})")                                                              \
+  V(WorldToAutomapResult, "Final result = {}, {}")
+
+enum class BinlogFormat : uint16_t {
+#define DEFINE_BINLOG_FORMAT(name, format) name,
+  D2R_BINLOG_FORMAT_LIST(DEFINE_BINLOG_FORMAT)
+#undef DEFINE_BINLOG_FORMAT
+      kCount,
+};
+
+inline constexpr const char* kBinlogFormats[] = {
+#define DEFINE_BINLOG_FORMAT_STRING(name, format) format,
+    D2R_BINLOG_FORMAT_LIST(DEFINE_BINLOG_FORMAT_STRING)
+#undef DEFINE_BINLOG_FORMAT_STRING
+};
+
+enum class BinlogArgType : uint8_t {
+  kNone = 0,
+  kInt64,
+  kUint64,
+  kDouble,
+  kPointer,
+  kBool,
+};
+
+constexpr std::size_t kBinlogMaxArgs = 4;
+
+// Fixed-size record, written to the pipe verbatim.
+struct BinlogRecord {
+  uint64_t timestamp_ns;
+  uint16_t format_id;
+  uint8_t arg_count;
+  BinlogArgType arg_types[kBinlogMaxArgs];
+  uint8_t reserved;
+  uint64_t args[kBinlogMaxArgs];
+};
+static_assert(sizeof(BinlogRecord) == 48);
+
+}  // namespace d2r
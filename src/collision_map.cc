@@ -0,0 +1,469 @@
+#include "collision_map.h"
+
+#include <dolos/pipe_log.h>
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+namespace d2r {
+
+constexpr char kCollisionMapMagic[8] = {'D', '2', 'R', 'C', 'M', 'A', 'P', '\0'};
+constexpr uint32_t kCollisionMapVersion = 1;
+
+// the largest levels (outdoor areas of act 4/5) span a few thousand subtiles, anything above is a corrupted level
+constexpr uint32_t kMaxLevelSubtiles = 0x2000;
+// rooms are at most a few hundred subtiles wide
+constexpr uint32_t kMaxRoomSubtiles = 0x400;
+// an act keeps a few hundred rooms active, the chain is cut after this many
+constexpr std::size_t kMaxActiveRooms = 0x1000;
+// a merged room is hashed again every this many updates, so a door shows up within a second or so
+constexpr uint32_t kRecheckPeriod = 16;
+
+// Per map file entry, followed by the room origins (uint64) and the runs.
+struct CollisionMapFileEntry {
+  uint32_t seed;
+  uint32_t level_id;
+  uint8_t difficulty;
+  uint8_t reserved[3];
+  int32_t origin_x;
+  int32_t origin_y;
+  uint32_t width;
+  uint32_t height;
+  uint32_t room_count;
+  uint32_t runs_size;
+};
+
+static void AppendVarint(std::vector<uint8_t>* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+static bool ReadVarint(std::span<const uint8_t> in, std::size_t* pos, uint64_t* value) {
+  *value = 0;
+  for (uint32_t shift = 0; shift < 64 && *pos < in.size(); shift += 7) {
+    uint8_t byte = in[(*pos)++];
+    *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+WalkableMap::WalkableMap(int32_t origin_x, int32_t origin_y, uint32_t width, uint32_t height)
+    : origin_x_(origin_x),
+      origin_y_(origin_y),
+      width_(width),
+      height_(height),
+      words_per_row_((width + 63) / 64),
+      bits_(static_cast<std::size_t>(words_per_row_) * height) {}
+
+bool WalkableMap::IsWalkable(int32_t x, int32_t y) const {
+  auto column = static_cast<uint32_t>(x - origin_x_);
+  auto row = static_cast<uint32_t>(y - origin_y_);
+  if (column >= width_ || row >= height_) {
+    return false;
+  }
+  return (bits_[static_cast<std::size_t>(row) * words_per_row_ + column / 64] >> (column % 64)) & 1;
+}
+
+void WalkableMap::Merge(int32_t x, int32_t y, uint32_t width, uint32_t height, const uint16_t* mask) {
+  int64_t first_column = std::max<int64_t>(x, origin_x_);
+  int64_t last_column = std::min<int64_t>(static_cast<int64_t>(x) + width, static_cast<int64_t>(origin_x_) + width_);
+  int64_t first_row = std::max<int64_t>(y, origin_y_);
+  int64_t last_row = std::min<int64_t>(static_cast<int64_t>(y) + height, static_cast<int64_t>(origin_y_) + height_);
+  for (int64_t row = first_row; row < last_row; ++row) {
+    const uint16_t* flags = mask + (row - y) * width;
+    uint64_t* words = &bits_[static_cast<std::size_t>(row - origin_y_) * words_per_row_];
+    for (int64_t column = first_column; column < last_column; ++column) {
+      auto bit = static_cast<uint32_t>(column - origin_x_);
+      uint64_t walkable = (flags[column - x] & kCollisionBlockWalk) == 0;
+      words[bit / 64] = (words[bit / 64] & ~(1ull << (bit % 64))) | (walkable << (bit % 64));
+    }
+  }
+}
+
+std::vector<uint8_t> WalkableMap::Compress() const {
+  std::vector<uint8_t> runs;
+  bool value = false;
+  uint64_t length = 0;
+  for (uint32_t row = 0; row < height_; ++row) {
+    const uint64_t* words = &bits_[static_cast<std::size_t>(row) * words_per_row_];
+    uint32_t column = 0;
+    while (column < width_) {
+      // next column whose bit differs from |value|, within the row
+      uint32_t end = width_;
+      for (uint32_t word = column / 64; word < words_per_row_; ++word) {
+        uint64_t diff = value ? ~words[word] : words[word];
+        if (word == column / 64) {
+          diff &= ~0ull << (column % 64);
+        }
+        if (diff != 0) {
+          end = std::min(width_, word * 64 + static_cast<uint32_t>(std::countr_zero(diff)));
+          break;
+        }
+      }
+      length += end - column;
+      column = end;
+      if (column < width_) {
+        AppendVarint(&runs, length);
+        value = !value;
+        length = 0;
+      }
+    }
+  }
+  AppendVarint(&runs, length);
+  return runs;
+}
+
+void WalkableMap::FillRun(uint64_t first, uint64_t length) {
+  while (length) {
+    auto row = static_cast<uint32_t>(first / width_);
+    auto column = static_cast<uint32_t>(first % width_);
+    auto count = static_cast<uint32_t>(std::min<uint64_t>(length, width_ - column));
+    uint64_t* words = &bits_[static_cast<std::size_t>(row) * words_per_row_];
+    for (uint32_t bit = column, end = column + count; bit < end;) {
+      uint32_t span = std::min(end - bit, 64 - bit % 64);
+      uint64_t mask = span == 64 ? ~0ull : ((1ull << span) - 1) << (bit % 64);
+      words[bit / 64] |= mask;
+      bit += span;
+    }
+    first += count;
+    length -= count;
+  }
+}
+
+bool WalkableMap::Decompress(std::span<const uint8_t> runs) {
+  std::fill(bits_.begin(), bits_.end(), 0);
+  uint64_t total = static_cast<uint64_t>(width_) * height_;
+  uint64_t position = 0;
+  bool value = false;
+  std::size_t pos = 0;
+  while (pos < runs.size()) {
+    uint64_t length = 0;
+    if (!ReadVarint(runs, &pos, &length) || length > total - position) {
+      return false;
+    }
+    if (value) {
+      FillRun(position, length);
+    }
+    position += length;
+    value = !value;
+  }
+  return position == total;
+}
+
+const D2DrlgLevelStrc* GetRoomLevel(const D2ActiveRoomStrc& room, SafeReader& reader, CollisionMapKey* key) {
+  const D2DrlgRoomStrc* drlg_room = reader.Check(room.ptDrlgRoom);
+  const D2DrlgLevelStrc* level = drlg_room ? reader.Check(drlg_room->ptLevel) : nullptr;
+  const D2DrlgStrc* drlg = level ? reader.Check(level->ptDrlg) : nullptr;
+  if (drlg == nullptr) {
+    return nullptr;
+  }
+  *key = {drlg->dwStartSeed, static_cast<uint32_t>(level->eLevelId), drlg->nDifficulty};
+  return level;
+}
+
+// Level bounds in subtiles, false if the level is not readable or implausibly large.
+static bool LevelBounds(const D2DrlgLevelStrc& level, int32_t* x, int32_t* y, uint32_t* width, uint32_t* height) {
+  const D2DrlgCoordStrc& coords = level.tCoords;
+  if (coords.nSizeTileX <= 0 || coords.nSizeTileY <= 0 ||
+      static_cast<uint32_t>(coords.nSizeTileX) * 5 > kMaxLevelSubtiles ||
+      static_cast<uint32_t>(coords.nSizeTileY) * 5 > kMaxLevelSubtiles) {
+    return false;
+  }
+  *x = coords.nBackCornerTileX * 5;
+  *y = coords.nBackCornerTileY * 5;
+  *width = static_cast<uint32_t>(coords.nSizeTileX) * 5;
+  *height = static_cast<uint32_t>(coords.nSizeTileY) * 5;
+  return true;
+}
+
+// FNV-1a over the mask words, tells whether a merged room's collision changed.
+static uint64_t HashMask(const uint16_t* mask, std::size_t count) {
+  uint64_t hash = 0xCBF29CE484222325ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    hash = (hash ^ mask[i]) * 0x100000001B3ull;
+  }
+  return hash | 1;  // 0 marks a room loaded from a file
+}
+
+// A map that is entirely walkable or entirely blocked does not come from real collision grids: either the rooms
+// were merged before the game filled in their collision or the level is corrupted. |runs| is a Compress() result of
+// a map of |size| subtiles.
+static bool IsPlausible(std::span<const uint8_t> runs, uint64_t size) {
+  uint64_t walkable = 0;
+  bool value = false;
+  std::size_t pos = 0;
+  uint64_t length = 0;
+  while (pos < runs.size() && ReadVarint(runs, &pos, &length)) {
+    walkable += value ? length : 0;
+    value = !value;
+  }
+  return walkable != 0 && walkable != size;
+}
+
+std::size_t CollisionMapCache::Update(const D2ActiveRoomStrc* rooms, SafeReader& reader) {
+  for (auto& [packed, entry] : entries_) {
+    entry.touched = false;
+  }
+  const uint32_t recheck_phase = update_count_++ % kRecheckPeriod;
+
+  std::size_t merged = 0;
+  std::size_t length = 0;
+  for (const D2ActiveRoomStrc* room = reader.Check(rooms); room && length < kMaxActiveRooms;
+       room = reader.Check(room->ptRoomNext), ++length) {
+    const D2RoomCollisionGridStrc* grid = reader.Check(room->ptCollisionGrid);
+    CollisionMapKey key;
+    const D2DrlgLevelStrc* level = grid ? GetRoomLevel(*room, reader, &key) : nullptr;
+    if (level == nullptr) {
+      continue;
+    }
+
+    Entry* entry = Acquire(key, *level);
+    if (entry == nullptr) {
+      continue;
+    }
+    entry->touched = true;
+
+    const D2DrlgCoordsStrc& coords = grid->tRoomCoords;
+    uint64_t origin = (static_cast<uint64_t>(static_cast<uint32_t>(coords.nSubtileX)) << 32) |
+                      static_cast<uint32_t>(coords.nSubtileY);
+    auto merged_room = entry->rooms.find(origin);
+    // rooms that were merged already are only hashed again when it is their turn
+    if (merged_room != entry->rooms.end() && length % kRecheckPeriod != recheck_phase) {
+      continue;
+    }
+    if (coords.nSubtileWidth <= 0 || coords.nSubtileHeight <= 0 ||
+        static_cast<uint32_t>(coords.nSubtileWidth) > kMaxRoomSubtiles ||
+        static_cast<uint32_t>(coords.nSubtileHeight) > kMaxRoomSubtiles) {
+      continue;
+    }
+    auto width = static_cast<uint32_t>(coords.nSubtileWidth);
+    auto height = static_cast<uint32_t>(coords.nSubtileHeight);
+    std::size_t count = static_cast<std::size_t>(width) * height;
+    // rooms stream in before their collision is filled in, retried on a later update
+    if (!reader.IsReadable(grid->pCollisionMask, count * sizeof(uint16_t))) {
+      continue;
+    }
+    uint64_t hash = HashMask(grid->pCollisionMask, count);
+    if (merged_room != entry->rooms.end() && merged_room->second == hash) {
+      continue;
+    }
+
+    Expand(*entry)->Merge(coords.nSubtileX, coords.nSubtileY, width, height, grid->pCollisionMask);
+    entry->rooms.insert_or_assign(origin, hash);
+    entry->version = next_version_++;
+    if (next_version_ == 0) {
+      next_version_ = 1;
+    }
+    dirty_ = true;
+    ++merged;
+  }
+
+  for (auto& [packed, entry] : entries_) {
+    if (!entry.touched) {
+      Idle(entry);
+    }
+  }
+  Evict();
+  return merged;
+}
+
+const WalkableMap* CollisionMapCache::Find(const CollisionMapKey& key, uint32_t* version) {
+  auto it = entries_.find(key.Pack());
+  if (it == entries_.end() || !(it->second.key == key)) {
+    return nullptr;
+  }
+  Entry& entry = it->second;
+  lru_.splice(lru_.begin(), lru_, entry.lru);
+  if (version) {
+    *version = entry.version;
+  }
+  return Expand(entry);
+}
+
+CollisionMapCache::Entry* CollisionMapCache::Acquire(const CollisionMapKey& key, const D2DrlgLevelStrc& level) {
+  uint64_t packed = key.Pack();
+  auto it = entries_.find(packed);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return &it->second;
+  }
+
+  Entry entry;
+  if (!LevelBounds(level, &entry.origin_x, &entry.origin_y, &entry.width, &entry.height)) {
+    return nullptr;
+  }
+  entry.key = key;
+  entry.map = std::make_unique<WalkableMap>(entry.origin_x, entry.origin_y, entry.width, entry.height);
+  lru_.push_front(packed);
+  entry.lru = lru_.begin();
+  return &entries_.emplace(packed, std::move(entry)).first->second;
+}
+
+WalkableMap* CollisionMapCache::Expand(Entry& entry) {
+  Metrics::Add(entry.map ? Metric::CollisionMapHits : Metric::CollisionMapMisses);
+  if (!entry.map) {
+    entry.map = std::make_unique<WalkableMap>(entry.origin_x, entry.origin_y, entry.width, entry.height);
+    if (!entry.map->Decompress(entry.runs)) {
+      // only reachable through a corrupted file, start the level over
+      entry.map = std::make_unique<WalkableMap>(entry.origin_x, entry.origin_y, entry.width, entry.height);
+      entry.rooms.clear();
+    }
+  }
+  return entry.map.get();
+}
+
+void CollisionMapCache::Idle(Entry& entry) {
+  if (entry.map) {
+    entry.runs = entry.map->Compress();
+    entry.map.reset();
+  }
+}
+
+void CollisionMapCache::Evict() {
+  while (entries_.size() > max_maps_) {
+    Entry& entry = entries_.at(lru_.back());
+    if (entry.touched) {
+      break;
+    }
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+}
+
+bool CollisionMapCache::Save(const std::string& path) {
+  std::string temp = path + ".tmp";
+  std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    PIPE_LOG_ERROR("[CollisionMap] Failed to open {}", temp);
+    return false;
+  }
+  // the expanded maps are compressed once, for the check and the file
+  std::vector<std::pair<const Entry*, std::vector<uint8_t>>> saved;
+  saved.reserve(entries_.size());
+  for (uint64_t packed : lru_) {
+    const Entry& entry = entries_.at(packed);
+    std::vector<uint8_t> runs = entry.map ? entry.map->Compress() : entry.runs;
+    if (!IsPlausible(runs, static_cast<uint64_t>(entry.width) * entry.height)) {
+      PIPE_LOG_WARN("[CollisionMap] Not saving level {} of seed {}, its map is entirely walkable or blocked",
+                    entry.key.level_id, entry.key.seed);
+      continue;
+    }
+    saved.emplace_back(&entry, std::move(runs));
+  }
+
+  uint32_t header[2] = {kCollisionMapVersion, static_cast<uint32_t>(saved.size())};
+  file.write(kCollisionMapMagic, sizeof(kCollisionMapMagic));
+  file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  std::vector<uint64_t> rooms;
+  for (const auto& [saved_entry, runs] : saved) {
+    const Entry& entry = *saved_entry;
+    rooms.clear();
+    for (const auto& [origin, hash] : entry.rooms) {
+      rooms.push_back(origin);
+    }
+
+    CollisionMapFileEntry record{};
+    record.seed = entry.key.seed;
+    record.level_id = entry.key.level_id;
+    record.difficulty = entry.key.difficulty;
+    record.origin_x = entry.origin_x;
+    record.origin_y = entry.origin_y;
+    record.width = entry.width;
+    record.height = entry.height;
+    record.room_count = static_cast<uint32_t>(rooms.size());
+    record.runs_size = static_cast<uint32_t>(runs.size());
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    file.write(reinterpret_cast<const char*>(rooms.data()),
+               static_cast<std::streamsize>(rooms.size() * sizeof(uint64_t)));
+    file.write(reinterpret_cast<const char*>(runs.data()), static_cast<std::streamsize>(runs.size()));
+  }
+  file.close();
+  if (!file) {
+    PIPE_LOG_ERROR("[CollisionMap] Failed to write {}", temp);
+    return false;
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp, path, error);
+  if (error) {
+    PIPE_LOG_ERROR("[CollisionMap] Failed to replace {}: {}", path, error.message());
+    return false;
+  }
+  dirty_ = false;
+  return true;
+}
+
+bool CollisionMapCache::Load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  char magic[sizeof(kCollisionMapMagic)];
+  uint32_t header[2];
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!file || std::memcmp(magic, kCollisionMapMagic, sizeof(magic)) != 0 || header[0] != kCollisionMapVersion) {
+    PIPE_LOG_WARN("[CollisionMap] Ignoring {}, not a version {} map file", path, kCollisionMapVersion);
+    return false;
+  }
+
+  std::size_t loaded = 0;
+  for (uint32_t i = 0; i < header[1] && entries_.size() < max_maps_; ++i) {
+    CollisionMapFileEntry record;
+    file.read(reinterpret_cast<char*>(&record), sizeof(record));
+    if (!file || record.width == 0 || record.height == 0 || record.width > kMaxLevelSubtiles ||
+        record.height > kMaxLevelSubtiles || record.room_count > kMaxActiveRooms ||
+        record.runs_size > static_cast<uint64_t>(record.width) * record.height * 2) {
+      PIPE_LOG_WARN("[CollisionMap] {} is truncated or corrupted after {} maps", path, loaded);
+      return false;
+    }
+    std::vector<uint64_t> rooms(record.room_count);
+    Entry entry;
+    entry.runs.resize(record.runs_size);
+    file.read(reinterpret_cast<char*>(rooms.data()), static_cast<std::streamsize>(rooms.size() * sizeof(uint64_t)));
+    file.read(reinterpret_cast<char*>(entry.runs.data()), static_cast<std::streamsize>(entry.runs.size()));
+    if (!file) {
+      PIPE_LOG_WARN("[CollisionMap] {} is truncated after {} maps", path, loaded);
+      return false;
+    }
+
+    entry.key = {record.seed, record.level_id, record.difficulty};
+    uint64_t packed = entry.key.Pack();
+    if (entries_.contains(packed)) {
+      continue;
+    }
+    entry.origin_x = record.origin_x;
+    entry.origin_y = record.origin_y;
+    entry.width = record.width;
+    entry.height = record.height;
+    for (uint64_t origin : rooms) {
+      entry.rooms.emplace(origin, 0);
+    }
+    entry.version = next_version_++;
+    if (next_version_ == 0) {
+      next_version_ = 1;
+    }
+    // the file is ordered most recently used first
+    lru_.push_back(packed);
+    entry.lru = std::prev(lru_.end());
+    entries_.emplace(packed, std::move(entry));
+    ++loaded;
+  }
+  PIPE_LOG_INFO("[CollisionMap] Loaded {} maps from {}", loaded, path);
+  return true;
+}
+
+}  // namespace d2r
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "d2r_structs.h"
+#include "safe_read.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace d2r {
+
+// Collision flag that blocks walking (COLLIDE_BLOCK_PLAYER), the walkability maps keep only this bit.
+constexpr uint16_t kCollisionBlockWalk = 0x1;
+
+// A generated level layout: the same seed, difficulty and level id always produce the same rooms.
+struct CollisionMapKey {
+  uint32_t seed = 0;
+  uint32_t level_id = 0;
+  uint8_t difficulty = 0;
+
+  uint64_t Pack() const {
+    return (static_cast<uint64_t>(seed) << 32) | (static_cast<uint64_t>(difficulty) << 16) | (level_id & 0xFFFF);
+  }
+  bool operator==(const CollisionMapKey&) const = default;
+};
+
+// Level of |room| and the key of its map, nullptr if the room is not linked to a readable level yet.
+const D2DrlgLevelStrc* GetRoomLevel(const D2ActiveRoomStrc& room, SafeReader& reader, CollisionMapKey* key);
+
+// Walkable subtiles of one level, one bit per subtile in rows of 64-bit words. Subtiles no room was merged into
+// yet read as not walkable.
+class WalkableMap {
+ public:
+  WalkableMap(int32_t origin_x, int32_t origin_y, uint32_t width, uint32_t height);
+
+  int32_t origin_x() const { return origin_x_; }
+  int32_t origin_y() const { return origin_y_; }
+  uint32_t width() const { return width_; }
+  uint32_t height() const { return height_; }
+  uint32_t words_per_row() const { return words_per_row_; }
+  std::span<const uint64_t> words() const { return bits_; }
+
+  // |x|, |y| are absolute subtile coordinates
+  bool IsWalkable(int32_t x, int32_t y) const;
+
+  // Overwrites the room's rectangle with its collision mask (|width| * |height| flags, row-major, starting at
+  // absolute subtile |x|, |y|), clipped to the level.
+  void Merge(int32_t x, int32_t y, uint32_t width, uint32_t height, const uint16_t* mask);
+
+  // Run-length form: LEB128 lengths of alternating runs over the width * height bits in row-major order,
+  // starting with a (possibly empty) run of blocked subtiles.
+  std::vector<uint8_t> Compress() const;
+  // Fills the map from a Compress() result of a map with the same size. Returns false if |runs| is malformed.
+  bool Decompress(std::span<const uint8_t> runs);
+
+ private:
+  void FillRun(uint64_t first, uint64_t length);
+
+  int32_t origin_x_;
+  int32_t origin_y_;
+  uint32_t width_;
+  uint32_t height_;
+  uint32_t words_per_row_;
+  std::vector<uint64_t> bits_;
+};
+
+// Per-level walkability maps keyed by CollisionMapKey, merged from the collision grids of the active rooms as they
+// stream in. Merged rooms are checked again every few updates and merged over if their collision changed (doors,
+// other dynamic collision). Only the maps of the levels touched by the last Update are kept expanded, the others are
+// held in their run-length form and the least recently used ones are dropped past |max_maps|. Save and Load persist
+// the run-length forms, so a level that was seen before is complete as soon as it is entered again.
+class CollisionMapCache {
+ public:
+  explicit CollisionMapCache(std::size_t max_maps = 64) : max_maps_(max_maps) {}
+
+  // Must be called with the game lock held. Merges every room of the chain starting at |rooms| (the act's active
+  // rooms) that was not merged before into the map of its level, and the merged rooms due for a check whose
+  // collision changed since. Returns the number of rooms merged.
+  std::size_t Update(const D2ActiveRoomStrc* rooms, SafeReader& reader);
+
+  // The map of |key|, nullptr if no room of it was merged yet. |version| is bumped whenever rooms are merged.
+  const WalkableMap* Find(const CollisionMapKey& key, uint32_t* version = nullptr);
+
+  // true if rooms were merged since the last Save
+  bool dirty() const { return dirty_; }
+  std::size_t size() const { return entries_.size(); }
+
+  // Writes every plausible map (see IsPlausible in collision_map.cc), implausible ones are left out of the file.
+  bool Save(const std::string& path);
+  // Adds the maps of |path| that are not already cached. Returns false if the file is missing or malformed.
+  bool Load(const std::string& path);
+
+ private:
+  struct Entry {
+    CollisionMapKey key;
+    int32_t origin_x = 0;
+    int32_t origin_y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t version = 0;
+    bool touched = false;
+    std::unique_ptr<WalkableMap> map;    // expanded form, null while idle
+    std::vector<uint8_t> runs;           // run-length form, stale while expanded
+    // subtile origin (x << 32 | y) of every room merged -> hash of its collision mask, 0 for rooms from a file
+    std::unordered_map<uint64_t, uint64_t> rooms;
+    std::list<uint64_t>::iterator lru;
+  };
+
+  Entry* Acquire(const CollisionMapKey& key, const D2DrlgLevelStrc& level);
+  WalkableMap* Expand(Entry& entry);
+  void Idle(Entry& entry);
+  void Evict();
+
+  std::unordered_map<uint64_t, Entry> entries_;
+  std::list<uint64_t> lru_;  // most recently used first
+  std::size_t max_maps_;
+  uint32_t next_version_ = 1;
+  uint32_t update_count_ = 0;
+  bool dirty_ = false;
+};
+
+}  // namespace d2r
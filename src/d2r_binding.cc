@@ -1,45 +1,82 @@
 #include "d2r_binding.h"
 
+#include "binary_log.h"
+#include "collision_map.h"
 #include "d2r_methods.h"
+#include "data_tables.h"
+#include "frame_hook.h"
+#include "inventory_snapshot.h"
+#include "item_rules.h"
+#include "metrics.h"
 #include "offsets.h"
+#include "path_motion.h"
+#include "session_recorder.h"
+#include "snapshot_pipeline.h"
+#include "stat_list.h"
+#include "trace.h"
+#include "unit_snapshot.h"
+#include "widget_tree.h"
 
 #include <nyx/env.h>
 #include <nyx/extension.h>
 #include <nyx/isolate_data.h>
 #include <nyx/util.h>
 
+#include <dolos/dolos.h>
 #include <dolos/pipe_log.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace d2r {
 
 using nyx::Environment;
+using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::BigInt;
+using v8::BigUint64Array;
 using v8::Context;
+using v8::DataView;
+using v8::Float32Array;
 using v8::FunctionCallbackInfo;
 using v8::HandleScope;
+using v8::Int32Array;
+using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::NewStringType;
 using v8::ObjectTemplate;
+using v8::String;
+using v8::Uint32Array;
+using v8::Undefined;
 using v8::Value;
 
 void AutomapGetMode(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(AutoMapPanel_GetMode());
 }
 
-void WorldToAutomap(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
-  HandleScope scope(isolate);
-  Environment* env = Environment::GetCurrent(isolate);
-  Local<Context> context = env->context();
-
-  // default return
-  ImVec2 xy(-1.0f, -1.0f);
-  args.GetReturnValue().Set(xy.ToObject(context));
+// Contents of a typed array.
+template <typename T, typename View>
+static T* TypedArrayData(Local<View> view) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(view->Buffer()->Data()) + view->ByteOffset());
+}
 
-  D2CoordStrc ptCoords(static_cast<int32_t>(args[0]->Int32Value(context).FromMaybe(0)),
-                       static_cast<int32_t>(args[1]->Int32Value(context).FromMaybe(0)));
-  PIPE_LOG_TRACE("Converting {}, {} to automap coords", ptCoords.nX, ptCoords.nY);
+static void LogAutoMapData(const AutoMapData& data) {
+  BINLOG(AutoMapDataFields0, data.unk_0000, data.unk_0008, data.unk_0010, data.unk_0018);
+  BINLOG(AutoMapDataFields1, data.unk_0020, data.unk_0028);
+  BINLOG(AutoMapDataFields2, data.unk_0030, data.unk_0034, data.unk_0038);
+}
 
+// Builds the projection of the automap as it is shown right now. Returns false if the automap is hidden.
+static bool CreateAutomapData(AutoMapData* automap_data) {
   // 16-byte alignement otherwise SIMD operations crash
   alignas(16) RectInt ptRect = {0, 0, 0, 0};
   Vector2i ptCenter;
@@ -47,31 +84,31 @@ void WorldToAutomap(const FunctionCallbackInfo<Value>& args) {
 
   if (s_panelManager == nullptr || *s_panelManager == nullptr) {
     PIPE_LOG_ERROR("Failed to get panel manager");
-    return;  // safety why not
+    return false;  // safety why not
   }
   PanelManager* panel_mgr = *s_panelManager;
 
   Widget* ptAutoMap = panel_mgr->GetWidget("AutoMap");
   if (ptAutoMap == nullptr) {
     PIPE_LOG_ERROR("AutoMapPanel not found");
-    return;
+    return false;
   }
-  PIPE_LOG_TRACE("Found AutoMapPanel at {:p}", static_cast<void*>(ptAutoMap));
+  BINLOG(WorldToAutomapPanel, static_cast<void*>(ptAutoMap));
   if (!ptAutoMap->bEnabled || !ptAutoMap->bVisible) {
     // PIPE_LOG_WARN("AutoMapPanel is disabled or not visible");
-    return;
+    return false;
   }
 
   uint32_t mode = AutoMapPanel_GetMode();
-  PIPE_LOG_TRACE("mode = {}", mode);
+  BINLOG(WorldToAutomapMode, mode);
   if (mode == 1) {
     // automap is in corner
     Vector2i ptPosition;
     Vector2i ptScaledSize;
     Widget::GetScaledPosition(ptAutoMap, &ptPosition);
     Widget::GetScaledSize(ptAutoMap, &ptScaledSize);
-    PIPE_LOG_TRACE("Scaled position = {}, {}", ptPosition.x, ptPosition.y);
-    PIPE_LOG_TRACE("Scaled size = {}, {}", ptScaledSize.x, ptScaledSize.y);
+    BINLOG(WorldToAutomapScaledPosition, ptPosition.x, ptPosition.y);
+    BINLOG(WorldToAutomapScaledSize, ptScaledSize.x, ptScaledSize.y);
     ptRect = {ptPosition, ptScaledSize};
     ptCenter = ptRect.center();
     flFinalScale = ptAutoMap->GetScale() * (*(float*)((uint64_t)ptAutoMap + 0x15AC));
@@ -81,13 +118,13 @@ void WorldToAutomap(const FunctionCallbackInfo<Value>& args) {
     Vector2i ptScaledSize;
     Widget::GetScaledPosition(panel_mgr, &ptPosition);
     Widget::GetScaledSize(panel_mgr, &ptScaledSize);
-    PIPE_LOG_TRACE("Scaled position = {}, {}", ptPosition.x, ptPosition.y);
-    PIPE_LOG_TRACE("Scaled size = {}, {}", ptScaledSize.x, ptScaledSize.y);
+    BINLOG(WorldToAutomapScaledPosition, ptPosition.x, ptPosition.y);
+    BINLOG(WorldToAutomapScaledSize, ptScaledSize.x, ptScaledSize.y);
     ptRect = {ptPosition, ptScaledSize};
     ptCenter = ptRect.center();
 
     uint32_t shift = *AutoMapPanel_spdwShift;
-    PIPE_LOG_TRACE("Shift = {}", shift);
+    BINLOG(WorldToAutomapShift, shift);
     if (shift == 1) {
       // automap is shifted to the left
       ptCenter.x -= PanelManager::GetScreenSizeX() / 4;
@@ -95,53 +132,99 @@ void WorldToAutomap(const FunctionCallbackInfo<Value>& args) {
       // automap is shifted to the right
       ptCenter.x += PanelManager::GetScreenSizeX() / 4;
     }
-    PIPE_LOG_TRACE("ptCenter = {}, {}", ptCenter.x, ptCenter.y);
+    BINLOG(WorldToAutomapCenter, ptCenter.x, ptCenter.y);
 
     flFinalScale = ptAutoMap->GetScale() * (*(float*)((uint64_t)ptAutoMap + 0x15A8));
   }
 
+  BINLOG(AutoMapDataInputs);
+  BINLOG(AutoMapDataRect, ptRect.left, ptRect.top, ptRect.right, ptRect.bottom);
+  BINLOG(AutoMapDataCenter, ptCenter.x, ptCenter.y);
+  BINLOG(AutoMapDataScale, flFinalScale);
+  AutoMapPanel_CreateAutoMapData(automap_data, &ptRect, *(uint64_t*)&ptCenter.x, flFinalScale);
+  BINLOG(AutoMapDataOutput);
+  LogAutoMapData(*automap_data);
+  return true;
+}
+
+void WorldToAutomap(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("WorldToAutomap");
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+  Environment* env = Environment::GetCurrent(isolate);
+  Local<Context> context = env->context();
+
+  // default return
+  ImVec2 xy(-1.0f, -1.0f);
+  args.GetReturnValue().Set(xy.ToObject(context));
+
+  D2CoordStrc ptCoords(static_cast<int32_t>(args[0]->Int32Value(context).FromMaybe(0)),
+                       static_cast<int32_t>(args[1]->Int32Value(context).FromMaybe(0)));
+  BINLOG(WorldToAutomapInput, ptCoords.nX, ptCoords.nY);
+
   AutoMapData automap_data{};
-  PIPE_LOG_TRACE("AutoMapData inputs");
-  PIPE_LOG_TRACE("  ptRect: {}, {}, {}, {}", ptRect.left, ptRect.top, ptRect.right, ptRect.bottom);
-  PIPE_LOG_TRACE("  ptCenter: {}, {}", ptCenter.x, ptCenter.y);
-  PIPE_LOG_TRACE("  flFinalSize: {}", flFinalScale);
-  AutoMapPanel_CreateAutoMapData(&automap_data, &ptRect, *(uint64_t*)&ptCenter.x, flFinalScale);
-  PIPE_LOG_TRACE("AutoMapData output");
-  PIPE_LOG_TRACE("  automap_data.unk_0000: {}", automap_data.unk_0000);
-  PIPE_LOG_TRACE("  automap_data.unk_0008: {}", automap_data.unk_0008);
-  PIPE_LOG_TRACE("  automap_data.unk_0010: {}", automap_data.unk_0010);
-  PIPE_LOG_TRACE("  automap_data.unk_0018: {}", automap_data.unk_0018);
-  PIPE_LOG_TRACE("  automap_data.unk_0020: {}", automap_data.unk_0020);
-  PIPE_LOG_TRACE("  automap_data.unk_0028: {}", automap_data.unk_0028);
-  PIPE_LOG_TRACE("  automap_data.unk_0030: {}", automap_data.unk_0030);
-  PIPE_LOG_TRACE("  automap_data.unk_0034: {}", automap_data.unk_0034);
-  PIPE_LOG_TRACE("  automap_data.unk_0038: {}", automap_data.unk_0038);
+  if (!CreateAutomapData(&automap_data)) {
+    return;
+  }
 
   int64_t nPrecision = *(int64_t*)&ptCoords.nX;
-  PIPE_LOG_TRACE("PrecisionToAutomap inputs");
-  PIPE_LOG_TRACE("  nPrecision: {} ({}, {})", nPrecision, ptCoords.nX, ptCoords.nY);
+  BINLOG(PrecisionToAutomapInputs);
+  BINLOG(PrecisionToAutomapValue, nPrecision, ptCoords.nX, ptCoords.nY);
   AutoMapPanel_PrecisionToAutomap(&automap_data, &nPrecision, nPrecision);
-  PIPE_LOG_TRACE("PrecisionToAutomap outputs");
-  PIPE_LOG_TRACE("  nPrecision: {} ({}, {})", nPrecision, ptCoords.nX, ptCoords.nY);
-  PIPE_LOG_TRACE("  automap_data.unk_0000: {}", automap_data.unk_0000);
-  PIPE_LOG_TRACE("  automap_data.unk_0008: {}", automap_data.unk_0008);
-  PIPE_LOG_TRACE("  automap_data.unk_0010: {}", automap_data.unk_0010);
-  PIPE_LOG_TRACE("  automap_data.unk_0018: {}", automap_data.unk_0018);
-  PIPE_LOG_TRACE("  automap_data.unk_0020: {}", automap_data.unk_0020);
-  PIPE_LOG_TRACE("  automap_data.unk_0028: {}", automap_data.unk_0028);
-  PIPE_LOG_TRACE("  automap_data.unk_0030: {}", automap_data.unk_0030);
-  PIPE_LOG_TRACE("  automap_data.unk_0034: {}", automap_data.unk_0034);
-  PIPE_LOG_TRACE("  automap_data.unk_0038: {}", automap_data.unk_0038);
+  BINLOG(PrecisionToAutomapOutputs);
+  BINLOG(PrecisionToAutomapValue, nPrecision, ptCoords.nX, ptCoords.nY);
+  LogAutoMapData(automap_data);
 
   ptCoords.nX = (int)nPrecision;
   ptCoords.nY = (int)(nPrecision >> 32);
 
-  PIPE_LOG_TRACE("Final result = {}, {}", ptCoords.nX, ptCoords.nY);
+  BINLOG(WorldToAutomapResult, ptCoords.nX, ptCoords.nY);
   xy = ImVec2(ptCoords.nX, ptCoords.nY);
+  SessionRecorder::AddAutomapSample(static_cast<int32_t>(args[0]->Int32Value(context).FromMaybe(0)),
+                                    static_cast<int32_t>(args[1]->Int32Value(context).FromMaybe(0)),
+                                    xy.x,
+                                    xy.y);
   args.GetReturnValue().Set(xy.ToObject(context));
 }
 
+// worldToAutomap() for the first |count| x, y pairs of |positions| (an Int32Array, e.g. filled by extrapolatePaths())
+// into |out|, a Float32Array of the same layout. The projection is built once for the whole batch instead of once
+// per unit. Returns false and leaves |out| alone if the automap is hidden.
+static void WorldToAutomapMany(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("WorldToAutomapMany");
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  args.GetReturnValue().Set(false);
+  if (!args[0]->IsInt32Array() || !args[1]->IsFloat32Array()) {
+    return;
+  }
+  Local<Int32Array> positions = args[0].As<Int32Array>();
+  Local<Float32Array> out = args[1].As<Float32Array>();
+  std::size_t count = std::min(positions->Length(), out->Length()) / 2;
+  if (args[2]->IsUint32()) {
+    count = std::min<std::size_t>(count, args[2]->Uint32Value(context).FromJust());
+  }
+
+  AutoMapData automap_data{};
+  if (!CreateAutomapData(&automap_data)) {
+    return;
+  }
+  const int32_t* in = TypedArrayData<int32_t>(positions);
+  float* xy = TypedArrayData<float>(out);
+  for (std::size_t i = 0; i < count; ++i) {
+    // same call as worldToAutomap, on a copy in case the game writes to the projection
+    AutoMapData data = automap_data;
+    int64_t nPrecision;
+    std::memcpy(&nPrecision, in + i * 2, sizeof(nPrecision));
+    AutoMapPanel_PrecisionToAutomap(&data, &nPrecision, nPrecision);
+    xy[i * 2] = static_cast<float>(static_cast<int32_t>(nPrecision));
+    xy[i * 2 + 1] = static_cast<float>(static_cast<int32_t>(nPrecision >> 32));
+  }
+  args.GetReturnValue().Set(true);
+}
+
 void RevealLevel(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("RevealLevel");
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
   Local<Context> context = env->context();
@@ -149,7 +232,9 @@ void RevealLevel(const FunctionCallbackInfo<Value>& args) {
     return;
   }
   uint32_t level_id = args[0]->Uint32Value(context).FromJust();
-  args.GetReturnValue().Set(RevealLevelById(level_id));
+  bool revealed = RevealLevelById(level_id);
+  Metrics::Add(revealed ? Metric::LevelsRevealed : Metric::RevealFailures);
+  args.GetReturnValue().Set(revealed);
 }
 
 // will break on patch, look at the end of GetPlayerUnit for decryption method
@@ -169,6 +254,30 @@ static void GetPlayerIdByIndex(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(id);
 }
 
+// Returns a BigUint64Array of (index, id, unit address) triples for every occupied player slot.
+static void GetPlayers(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("GetPlayers");
+  Isolate* isolate = args.GetIsolate();
+  const auto& roster = GetPlayerRoster();
+
+  uint32_t count = 0;
+  for (const PlayerRosterEntry& entry : roster) {
+    count += entry.id != 0;
+  }
+
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, count * 3 * sizeof(uint64_t));
+  auto* out = static_cast<uint64_t*>(buffer->Data());
+  for (uint32_t i = 0; i < kMaxPlayers; ++i) {
+    if (roster[i].id == 0) {
+      continue;
+    }
+    *out++ = i;
+    *out++ = roster[i].id;
+    *out++ = reinterpret_cast<uint64_t>(roster[i].unit);
+  }
+  args.GetReturnValue().Set(BigUint64Array::New(buffer, 0, count * 3));
+}
+
 static void GetLocalPlayerIndex(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(*s_PlayerUnitIndex);
 }
@@ -185,6 +294,788 @@ void GetServerSideUnitHashTableAddress(const FunctionCallbackInfo<Value>& args)
   args.GetReturnValue().Set(BigInt::NewFromUnsigned(isolate, addr));
 }
 
+// Staging arena for the two-phase tick. Allocated through V8 so scripts can view it without a copy, a grown
+// arena replaces the backing store and previously handed out ArrayBuffers keep the old one alive.
+static std::shared_ptr<BackingStore> s_snapshot_store;
+
+// The arena is split into one region per unit type (client and server records of a type share it). A type that is
+// not walked keeps its region, and the records scripts still refer to, from its last walk.
+struct SnapshotRegion {
+  std::size_t first = 0;  // record index
+  std::size_t capacity = 0;
+  std::size_t count = 0;
+};
+static std::array<SnapshotRegion, kUnitTypeCount> s_snapshot_regions;
+static std::array<UnitChangeTracker, kUnitTypeCount> s_change_trackers;
+// types whose last walk captureUnits() diffed itself, the trackers of the others are stale
+static uint32_t s_capture_diffed_mask = 0;
+// scratch lists of the room walk, kept to reuse their capacity
+static RoomUnitLists s_room_units;
+static ItemRuleProgram s_item_rules;
+static ItemRuleMatcher s_item_rule_matcher;
+
+// Where the units of a capture come from: the rooms around the local player (see CollectRoomUnits) or the client
+// and server hash tables.
+struct UnitWalk {
+  const EntityHashTable* client_tables = nullptr;
+  const EntityHashTable* server_tables = nullptr;
+  bool rooms = false;
+  ChainWalkStats stats;  // of the room walk
+};
+
+// With a room radius (|radius| is a uint32) the units are taken from the rooms around the local player, falling back
+// to the hash tables while the player has no room.
+static UnitWalk BeginUnitWalk(Local<Value> radius, Local<Context> context, SafeReader& reader) {
+  UnitWalk walk;
+  walk.client_tables = GetClientSideUnitHashTableByType(0);
+  walk.server_tables = GetServerSideUnitHashTableByType(0);
+  if (radius->IsUint32()) {
+    D2UnitStrc* player = reader.Check(GetPlayerUnit(*s_PlayerUnitIndex));
+    D2DynamicPathStrc* path = player ? reader.Check(player->pDynamicPath) : nullptr;
+    if (path && path->ptRoom) {
+      uint32_t hops = radius->Uint32Value(context).FromJust();
+      walk.rooms = CollectRoomUnits(path->ptRoom, hops, &s_room_units, reader, &walk.stats) > 0;
+    }
+  }
+  return walk;
+}
+
+// Copies the units of |type| into |out| starting at |offset|, see CaptureUnitType.
+static std::size_t CaptureType(const UnitWalk& walk,
+                               uint32_t type,
+                               UnitSnapshotRecord* out,
+                               std::size_t offset,
+                               std::size_t capacity,
+                               SafeReader& reader,
+                               ChainWalkStats* stats) {
+  if (walk.rooms) {
+    return CaptureUnitList(s_room_units[type], type, SnapshotSource::kClient, out, offset, capacity, reader, stats);
+  }
+  std::size_t count =
+      CaptureUnitType(walk.client_tables, type, SnapshotSource::kClient, out, offset, capacity, reader, stats);
+  return CaptureUnitType(walk.server_tables, type, SnapshotSource::kServer, out, count, capacity, reader, stats);
+}
+
+static void LogCutChains(const ChainWalkStats& stats) {
+  if (stats.bad_pointers || stats.type_mismatches || stats.cycles || stats.truncated) {
+    PIPE_LOG_DEBUG("[SnapshotUnits] Cut chains: {} bad pointers, {} type mismatches, {} cycles, {} truncated",
+                   stats.bad_pointers,
+                   stats.type_mismatches,
+                   stats.cycles,
+                   stats.truncated);
+  }
+}
+
+// Marks the fields that changed since |type| was last walked and evaluates the item rules of changed items.
+static void TrackChanges(uint32_t type, UnitSnapshotRecord* records, std::size_t count, SafeReader& reader) {
+  s_change_trackers[type].Update(records, count);
+  if (type == kUnitItem) {
+    s_item_rule_matcher.Update(records, count, s_item_rules, reader);
+  }
+}
+
+// Must be called with the game lock held. Copies every reachable unit (and its dynamic path) of the types in the
+// optional type mask (all types by default) into their regions of the staging arena and marks the fields that
+// changed since the type was last walked. Returns a Uint32Array of the walked type mask followed by a
+// (first record, record count) pair per type. Growing the arena moves every region, so that walks all types.
+// With a room radius as second argument the units are taken from the rooms around the local player instead of the
+// hash tables (see CollectRoomUnits), falling back to the hash tables while the player has no room.
+static void SnapshotUnits(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("SnapshotUnits");
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(isolate);
+  Local<Context> context = env->context();
+
+  uint32_t type_mask = kAllUnitTypes;
+  if (args[0]->IsUint32()) {
+    type_mask = args[0]->Uint32Value(context).FromJust() & kAllUnitTypes;
+  }
+  if (!s_snapshot_store) {
+    type_mask = kAllUnitTypes;
+  }
+
+  SafeReader reader;
+  UnitWalk walk = BeginUnitWalk(args[1], context, reader);
+
+  for (;;) {
+    auto* records = s_snapshot_store ? static_cast<UnitSnapshotRecord*>(s_snapshot_store->Data()) : nullptr;
+
+    ChainWalkStats stats = walk.stats;
+    std::array<std::size_t, kUnitTypeCount> counts{};
+    bool overflow = false;
+    for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+      if ((type_mask & (1u << type)) == 0) {
+        continue;
+      }
+      const SnapshotRegion& region = s_snapshot_regions[type];
+      UnitSnapshotRecord* out = records ? records + region.first : nullptr;
+      counts[type] = CaptureType(walk, type, out, 0, region.capacity, reader, &stats);
+      overflow |= counts[type] > region.capacity;
+    }
+
+    if (!overflow) {
+      LogCutChains(stats);
+      std::array<std::span<const UnitSnapshotRecord>, kUnitTypeCount> groups;
+      for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+        SnapshotRegion& region = s_snapshot_regions[type];
+        if (type_mask & (1u << type)) {
+          region.count = counts[type];
+          TrackChanges(type, records + region.first, region.count, reader);
+          Metrics::Set(UnitCountMetric(type), region.count);
+        }
+        groups[type] = {records + region.first, region.count};
+      }
+      if (SessionRecorder::IsRecording()) {
+        SessionRecorder::CaptureFrame(groups, type_mask, *s_PlayerUnitIndex, GetPlayerRoster(), reader);
+      }
+
+      Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, (1 + kUnitTypeCount * 2) * sizeof(uint32_t));
+      auto* out = static_cast<uint32_t*>(buffer->Data());
+      *out++ = type_mask;
+      for (const SnapshotRegion& region : s_snapshot_regions) {
+        *out++ = static_cast<uint32_t>(region.first);
+        *out++ = static_cast<uint32_t>(region.count);
+      }
+      return args.GetReturnValue().Set(Uint32Array::New(buffer, 0, 1 + kUnitTypeCount * 2));
+    }
+
+    // grow with some headroom so a busy area does not reallocate every tick
+    std::size_t first = 0;
+    for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+      SnapshotRegion& region = s_snapshot_regions[type];
+      std::size_t needed = (type_mask & (1u << type)) ? counts[type] : region.count;
+      region.first = first;
+      region.capacity = needed + needed / 2 + 64;
+      region.count = 0;
+      first += region.capacity;
+    }
+    s_snapshot_store = ArrayBuffer::NewBackingStore(isolate, first * sizeof(UnitSnapshotRecord));
+    type_mask = kAllUnitTypes;
+  }
+}
+
+static std::unique_ptr<SnapshotPipeline> s_snapshot_pipeline;
+// ArrayBuffer backing stores over the records of the pipeline's results, recreated when a result grew
+static std::unordered_map<const SnapshotResult*, std::shared_ptr<BackingStore>> s_pipeline_stores;
+
+// Starts (true) or stops the snapshot worker, see SnapshotPipeline. Returns whether it is running.
+static void SnapshotPipelineEnable(const FunctionCallbackInfo<Value>& args) {
+  bool enable = args[0]->BooleanValue(args.GetIsolate());
+  if (enable != (s_snapshot_pipeline != nullptr)) {
+    // snapshotUnits() and the worker diff against their own previous walks
+    for (UnitChangeTracker& tracker : s_change_trackers) {
+      tracker.Clear();
+    }
+    s_capture_diffed_mask = 0;
+  }
+  if (enable && !s_snapshot_pipeline) {
+    s_snapshot_pipeline = std::make_unique<SnapshotPipeline>();
+  } else if (!enable && s_snapshot_pipeline) {
+    s_snapshot_pipeline.reset();
+    s_pipeline_stores.clear();
+  }
+  args.GetReturnValue().Set(s_snapshot_pipeline != nullptr);
+}
+
+// Must be called with the game lock held. Like snapshotUnits, but captures into a job of the snapshot worker instead
+// of the staging arena and hands it over, the worker diffs and places the records and the result is picked up with
+// swapSnapshot(). Returns the walked type mask, undefined if the worker is not running or still holds both jobs.
+// Walks every type while a session is recorded, the recorder stores all of them each frame.
+static void CaptureUnits(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("CaptureUnits");
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  SnapshotJob* job = s_snapshot_pipeline ? s_snapshot_pipeline->AcquireJob() : nullptr;
+  if (job == nullptr) {
+    return;
+  }
+
+  uint32_t type_mask = kAllUnitTypes;
+  if (args[0]->IsUint32() && !SessionRecorder::IsRecording()) {
+    type_mask = args[0]->Uint32Value(context).FromJust() & kAllUnitTypes;
+  }
+
+  SafeReader reader;
+  UnitWalk walk = BeginUnitWalk(args[1], context, reader);
+
+  std::array<std::size_t, kUnitTypeCount + 1> firsts{};
+  for (;;) {
+    ChainWalkStats stats = walk.stats;
+    std::size_t count = 0;
+    for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+      firsts[type] = count;
+      if (type_mask & (1u << type)) {
+        count = CaptureType(walk, type, job->records.data(), count, job->records.size(), reader, &stats);
+      }
+    }
+    firsts[kUnitTypeCount] = count;
+    if (count <= job->records.size()) {
+      LogCutChains(stats);
+      break;
+    }
+    job->records.resize(count + count / 2 + 64);
+  }
+
+  // The worker diffs the records. Items are diffed here while item rules are loaded, the rule matcher reads the item
+  // data from game memory and only evaluates the items that changed, and so is everything while a session is
+  // recorded, the recorder stores the change bits.
+  uint32_t diffed_mask = SessionRecorder::IsRecording() ? type_mask : 0;
+  if (!s_item_rules.empty()) {
+    diffed_mask |= type_mask & (1u << kUnitItem);
+  }
+
+  std::array<std::span<const UnitSnapshotRecord>, kUnitTypeCount> groups;
+  for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+    UnitSnapshotRecord* first = job->records.data() + firsts[type];
+    std::size_t count = firsts[type + 1] - firsts[type];
+    if (diffed_mask & (1u << type)) {
+      if ((s_capture_diffed_mask & (1u << type)) == 0) {
+        s_change_trackers[type].Clear();
+      }
+      TrackChanges(type, first, count, reader);
+    }
+    if (type_mask & (1u << type)) {
+      Metrics::Set(UnitCountMetric(type), count);
+    }
+    groups[type] = {first, count};
+  }
+  if (SessionRecorder::IsRecording()) {
+    SessionRecorder::CaptureFrame(groups, type_mask, *s_PlayerUnitIndex, GetPlayerRoster(), reader);
+  }
+
+  job->count = firsts[kUnitTypeCount];
+  for (uint32_t type = 0; type <= kUnitTypeCount; ++type) {
+    job->firsts[type] = static_cast<uint32_t>(firsts[type]);
+  }
+  job->walked_mask = type_mask;
+  job->diffed_mask = diffed_mask;
+  s_capture_diffed_mask = (s_capture_diffed_mask & ~type_mask) | diffed_mask;
+  s_snapshot_pipeline->Submit(job);
+  args.GetReturnValue().Set(type_mask);
+}
+
+// Takes the snapshot worker's next result, see SnapshotPipeline::Swap. Returns [records, events]: an ArrayBuffer of
+// UnitSnapshotRecords by slot and a Uint32Array of the SnapshotEventHeader and event lists, see
+// lib/d2r/object-manager.js. Undefined if no capture finished since the last call. The previous records buffer must
+// not be read anymore.
+static void SwapSnapshot(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("SwapSnapshot");
+  Isolate* isolate = args.GetIsolate();
+  const SnapshotResult* result = s_snapshot_pipeline ? s_snapshot_pipeline->Swap() : nullptr;
+  if (result == nullptr) {
+    return;
+  }
+
+  std::shared_ptr<BackingStore>& store = s_pipeline_stores[result];
+  if (!store || store->Data() != result->records.get()) {
+    // the backing store keeps the records alive while scripts hold an ArrayBuffer over them
+    auto* owner = new std::shared_ptr<UnitSnapshotRecord[]>(result->records);
+    store = ArrayBuffer::NewBackingStore(
+        owner->get(),
+        result->capacity * sizeof(UnitSnapshotRecord),
+        [](void*, size_t, void* owner) { delete static_cast<std::shared_ptr<UnitSnapshotRecord[]>*>(owner); },
+        owner);
+  }
+
+  std::size_t event_bytes = result->events.size() * sizeof(uint32_t);
+  Local<ArrayBuffer> events = ArrayBuffer::New(isolate, event_bytes);
+  std::memcpy(events->Data(), result->events.data(), event_bytes);
+
+  Local<Value> values[] = {ArrayBuffer::New(isolate, store), Uint32Array::New(events, 0, result->events.size())};
+  args.GetReturnValue().Set(Array::New(isolate, values, std::size(values)));
+}
+
+// Replaces the item rules with the program compiled by lib/d2r/item-rules.js (a Uint32Array, undefined clears
+// them). Every item is evaluated again on the next item walk. Returns false if the program is malformed.
+static void SetItemRules(const FunctionCallbackInfo<Value>& args) {
+  bool loaded = false;
+  if (args[0]->IsUint32Array()) {
+    Local<Uint32Array> array = args[0].As<Uint32Array>();
+    std::vector<uint32_t> words(array->Length());
+    array->CopyContents(words.data(), words.size() * sizeof(uint32_t));
+    loaded = s_item_rules.Load(words);
+  } else {
+    loaded = s_item_rules.Load({});
+  }
+  if (!loaded) {
+    PIPE_LOG_ERROR("[ItemRules] Rejected a malformed rule program");
+  }
+  args.GetReturnValue().Set(loaded);
+}
+
+static void GetSnapshotBuffer(const FunctionCallbackInfo<Value>& args) {
+  if (!s_snapshot_store) {
+    return;
+  }
+  args.GetReturnValue().Set(ArrayBuffer::New(args.GetIsolate(), s_snapshot_store));
+}
+
+static PathMotion s_path_motion;
+static std::vector<uint32_t> s_path_motion_indices;
+
+// Loads the units extrapolatePaths() moves: |records| is the ArrayBuffer of UnitSnapshotRecords the last tick
+// dispatched (getSnapshotBuffer() or the records of swapSnapshot()), |indices| a Uint32Array of record indices.
+// Returns the number of units loaded, none if an index is out of range.
+static void LoadPathMotion(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("LoadPathMotion");
+  s_path_motion_indices.clear();
+  if (args[0]->IsArrayBuffer() && args[1]->IsUint32Array()) {
+    Local<ArrayBuffer> buffer = args[0].As<ArrayBuffer>();
+    Local<Uint32Array> indices = args[1].As<Uint32Array>();
+    std::size_t record_count = buffer->ByteLength() / sizeof(UnitSnapshotRecord);
+    s_path_motion_indices.resize(indices->Length());
+    indices->CopyContents(s_path_motion_indices.data(), s_path_motion_indices.size() * sizeof(uint32_t));
+    if (std::ranges::any_of(s_path_motion_indices, [&](uint32_t index) { return index >= record_count; })) {
+      s_path_motion_indices.clear();
+    }
+    s_path_motion.Load(static_cast<const UnitSnapshotRecord*>(buffer->Data()), s_path_motion_indices);
+  } else {
+    s_path_motion.Load(nullptr, {});
+  }
+  args.GetReturnValue().Set(static_cast<uint32_t>(s_path_motion.size()));
+}
+
+// Writes the client coordinates of the units loaded by loadPathMotion() |elapsed ns| after their snapshot into
+// |out|, an Int32Array of x, y pairs, see PathMotion. Units stop moving |max ns| (default 500 ms) after the
+// snapshot. Returns the number of units written.
+static void ExtrapolatePaths(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  if (!args[1]->IsInt32Array() || args[1].As<Int32Array>()->Length() < s_path_motion.size() * 2) {
+    args.GetReturnValue().Set(0);
+    return;
+  }
+  double elapsed_ns = args[0]->NumberValue(context).FromMaybe(0);
+  double max_ns = args[2]->IsNumber() ? args[2]->NumberValue(context).FromJust() : 500e6;
+  auto frames = [](double ns) { return static_cast<float>(ns * kGameFramesPerSecond / 1e9); };
+  s_path_motion.Extrapolate(frames(elapsed_ns), frames(max_ns), TypedArrayData<int32_t>(args[1].As<Int32Array>()));
+  args.GetReturnValue().Set(static_cast<uint32_t>(s_path_motion.size()));
+}
+
+// Largest struct loadModel() asks for is a few KiB, anything bigger is a script bug.
+constexpr uint32_t kMaxReadMemorySize = 0x10000;
+
+// Copies |size| bytes at |address| into a new buffer and returns a DataView over it, undefined if the range is
+// not committed. Backs loadModel() for structs that are not part of the tick snapshot.
+static void ReadMemory(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(isolate);
+  Local<Context> context = env->context();
+  if (!args[0]->IsBigInt() || !args[1]->IsUint32()) {
+    return;
+  }
+  const void* address = reinterpret_cast<const void*>(args[0].As<BigInt>()->Uint64Value());
+  uint32_t size = args[1]->Uint32Value(context).FromJust();
+  if (size == 0 || size > kMaxReadMemorySize) {
+    return;
+  }
+
+  SafeReader reader;
+  if (!reader.IsReadable(address, size)) {
+    return;
+  }
+  std::shared_ptr<BackingStore> store = ArrayBuffer::NewBackingStore(isolate, size);
+  std::memcpy(store->Data(), address, size);
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, std::move(store));
+  args.GetReturnValue().Set(DataView::New(buffer, 0, size));
+}
+
+// One tracker per inventory owner (type << 32 | id), only a handful of owners are ever watched.
+static std::unordered_map<uint64_t, InventoryTracker> s_inventory_trackers;
+static std::vector<InventoryEntry> s_inventory_entries;
+static std::vector<uint32_t> s_inventory_removed;
+
+// Must be called with the game lock held. Reads the inventory of the unit at |address| (BigInt) and returns an
+// ArrayBuffer laid out as uint32 entry count, uint32 removed count, the InventoryEntry array and the removed item
+// ids, see lib/d2r/inventory.js. With |reset| true every item is reported as added. Undefined if the unit or its
+// inventory are not readable.
+static void SnapshotInventory(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("SnapshotInventory");
+  Isolate* isolate = args.GetIsolate();
+  if (!args[0]->IsBigInt()) {
+    return;
+  }
+  const auto* owner = reinterpret_cast<const D2UnitStrc*>(args[0].As<BigInt>()->Uint64Value());
+
+  SafeReader reader;
+  if (!reader.IsReadable(owner, sizeof(D2UnitStrc))) {
+    return;
+  }
+  uint64_t key = (static_cast<uint64_t>(owner->dwUnitType) << 32) | owner->dwId;
+  InventoryTracker& tracker = s_inventory_trackers[key];
+  if (args[1]->BooleanValue(isolate)) {
+    tracker.Reset();
+  }
+  if (!tracker.Update(owner, reader, &s_inventory_entries, &s_inventory_removed)) {
+    return;
+  }
+
+  std::size_t entries_size = s_inventory_entries.size() * sizeof(InventoryEntry);
+  std::size_t removed_size = s_inventory_removed.size() * sizeof(uint32_t);
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, 2 * sizeof(uint32_t) + entries_size + removed_size);
+  auto* out = static_cast<uint8_t*>(buffer->Data());
+  uint32_t counts[2] = {static_cast<uint32_t>(s_inventory_entries.size()),
+                        static_cast<uint32_t>(s_inventory_removed.size())};
+  std::memcpy(out, counts, sizeof(counts));
+  std::memcpy(out + sizeof(counts), s_inventory_entries.data(), entries_size);
+  std::memcpy(out + sizeof(counts) + entries_size, s_inventory_removed.data(), removed_size);
+  args.GetReturnValue().Set(buffer);
+}
+
+// Drops the inventory state of the unit at |address| (BigInt) once it is no longer watched. Reads no game memory,
+// the unit may be gone already.
+static void ReleaseInventory(const FunctionCallbackInfo<Value>& args) {
+  if (!args[0]->IsBigInt()) {
+    return;
+  }
+  const auto* owner = reinterpret_cast<const D2UnitStrc*>(args[0].As<BigInt>()->Uint64Value());
+  std::erase_if(s_inventory_trackers, [owner](const auto& entry) { return entry.second.owner() == owner; });
+}
+
+static StatListCache s_stat_lists;
+
+// Reads the stat lists of the unit at |address| (BigInt). Call with the game lock held, the game reallocates the
+// arrays when stats are added. |version| is the version the caller decoded last: if the stats did not change since,
+// that version (a number) is returned and nothing is copied. Otherwise an ArrayBuffer laid out as uint32 version,
+// uint32 base count, uint32 full count, uint32 reserved and the base and full StatEntry arrays, see
+// lib/d2r/stat-list.js. Undefined if the unit or its stat list are not readable.
+static void ReadStats(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("ReadStats");
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  if (!args[0]->IsBigInt()) {
+    return;
+  }
+  const auto* unit = reinterpret_cast<const D2UnitStrc*>(args[0].As<BigInt>()->Uint64Value());
+  uint32_t version = args[1]->Uint32Value(context).FromJust();
+
+  SafeReader reader;
+  StatListCopy copy;
+  if (!s_stat_lists.Read(unit, reader, &copy)) {
+    return;
+  }
+  if (copy.version == version) {
+    args.GetReturnValue().Set(version);
+    return;
+  }
+
+  std::size_t base_size = copy.base.size_bytes();
+  std::size_t full_size = copy.full.size_bytes();
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, 4 * sizeof(uint32_t) + base_size + full_size);
+  auto* out = static_cast<uint8_t*>(buffer->Data());
+  uint32_t header[4] = {copy.version, static_cast<uint32_t>(copy.base.size()), static_cast<uint32_t>(copy.full.size()),
+                        0};
+  std::memcpy(out, header, sizeof(header));
+  if (base_size) {
+    std::memcpy(out + sizeof(header), copy.base.data(), base_size);
+  }
+  if (full_size) {
+    std::memcpy(out + sizeof(header) + base_size, copy.full.data(), full_size);
+  }
+  args.GetReturnValue().Set(buffer);
+}
+
+// Returns [ArrayBuffer, stride, count, BigInt address] for table |id| (DataTableId) of data tables |index|, the
+// buffer views the game's rows without a copy, see lib/d2r/data-tables.js. Undefined while the tables are not
+// loaded or if the table could not be resolved. The first call for an index should hold the game lock.
+static void GetDataTable(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  if (!args[0]->IsUint32() || !args[1]->IsUint32()) {
+    return;
+  }
+  uint32_t index = args[0]->Uint32Value(context).FromJust();
+  uint32_t id = args[1]->Uint32Value(context).FromJust();
+  if (index > 0xFF || id >= kDataTableCount) {
+    return;
+  }
+  const DataTableSet* tables = GetDataTables(static_cast<uint8_t>(index));
+  if (tables == nullptr || tables->tables[id].count == 0) {
+    return;
+  }
+
+  // the tables live as long as the process, the backing store must not free them
+  const DataTable& table = tables->tables[id];
+  std::shared_ptr<BackingStore> store =
+      ArrayBuffer::NewBackingStore(const_cast<uint8_t*>(table.rows),
+                                   static_cast<std::size_t>(table.count) * table.stride,
+                                   [](void*, std::size_t, void*) {},
+                                   nullptr);
+  Local<Value> values[] = {
+      ArrayBuffer::New(isolate, std::move(store)),
+      Integer::NewFromUnsigned(isolate, table.stride),
+      Integer::NewFromUnsigned(isolate, table.count),
+      BigInt::NewFromUnsigned(isolate, reinterpret_cast<uint64_t>(table.rows)),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, values, std::size(values)));
+}
+
+static WidgetTree s_widget_tree;
+
+// Flattens the UI below the PanelManager (see WidgetTree). |version| is the version the caller decoded last: if
+// nothing changed since, that version (a number) is returned. Otherwise [ArrayBuffer, names]: the buffer is laid out
+// as uint32 version, uint32 entry count, int32 hover panel index, int32 hover widget index and the WidgetEntry
+// array, see lib/d2r/widget-tree.js. names holds the widget names by entry when the structure was rebuilt since
+// |version|, undefined otherwise. Undefined while there is no PanelManager.
+static void SnapshotWidgets(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("SnapshotWidgets");
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  uint32_t known = args[0]->Uint32Value(context).FromMaybe(0);
+  if (s_panelManager == nullptr) {
+    return;
+  }
+
+  SafeReader reader;
+  const PanelManager* panel_mgr = *s_panelManager;
+  const FocusManager* focus = reader.Check(panel_mgr) ? panel_mgr->ptFocusManager : nullptr;
+  if (!s_widget_tree.Update(panel_mgr, focus, reader)) {
+    return;
+  }
+  uint32_t version = s_widget_tree.version();
+  if (version == known) {
+    args.GetReturnValue().Set(version);
+    return;
+  }
+
+  std::span<const WidgetEntry> entries = s_widget_tree.entries();
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, 4 * sizeof(uint32_t) + entries.size_bytes());
+  auto* out = static_cast<uint8_t*>(buffer->Data());
+  uint32_t header[4] = {version,
+                        static_cast<uint32_t>(entries.size()),
+                        static_cast<uint32_t>(s_widget_tree.hover_panel()),
+                        static_cast<uint32_t>(s_widget_tree.hover_widget())};
+  std::memcpy(out, header, sizeof(header));
+  std::memcpy(out + sizeof(header), entries.data(), entries.size_bytes());
+
+  // versions only grow, a caller from before the last rebuild (or a restart) needs the names
+  Local<Value> names = Undefined(isolate);
+  if (known < s_widget_tree.structure_version() || known > version) {
+    const std::vector<std::string>& strings = s_widget_tree.names();
+    std::vector<Local<Value>> values;
+    values.reserve(strings.size());
+    for (const std::string& name : strings) {
+      values.push_back(String::NewFromUtf8(isolate, name.data(), NewStringType::kNormal, static_cast<int>(name.size()))
+                           .ToLocalChecked());
+    }
+    names = Array::New(isolate, values.data(), values.size());
+  }
+  Local<Value> result[] = {buffer, names};
+  args.GetReturnValue().Set(Array::New(isolate, result, std::size(result)));
+}
+
+static CollisionMapCache s_collision_maps;
+static std::string s_collision_map_path;
+static bool s_collision_maps_enabled = false;
+// seed and difficulty of the local player's level as of the last update, getCollisionMap() looks up levels of it
+static CollisionMapKey s_collision_key;
+
+// Start merging the local player's act into per-level walkability maps on updateCollisionMaps(), loading the maps
+// persisted in the optional path (collision.d2rc in the module directory by default). Returns the path.
+static void CollisionMapsEnable(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+
+  if (args[0]->IsString()) {
+    nyx::Utf8Value utf8(isolate, args[0]);
+    s_collision_map_path = *utf8;
+  } else {
+    s_collision_map_path = dolos::get_module_cwd() + "\\collision.d2rc";
+  }
+  s_collision_maps.Load(s_collision_map_path);
+  s_collision_maps_enabled = true;
+  args.GetReturnValue().Set(
+      String::NewFromUtf8(isolate, s_collision_map_path.c_str(), NewStringType::kNormal).ToLocalChecked());
+}
+
+// Must be called with the game lock held. Merges the rooms of the local player's act that were not seen before and
+// returns [level id, map version] of the player's level, undefined while the maps are disabled or the player is not
+// in a level yet.
+static void UpdateCollisionMaps(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("UpdateCollisionMaps");
+  Isolate* isolate = args.GetIsolate();
+  if (!s_collision_maps_enabled) {
+    return;
+  }
+
+  SafeReader reader;
+  D2UnitStrc* player = reader.Check(GetPlayerUnit(*s_PlayerUnitIndex));
+  D2DrlgActStrc* act = player ? reader.Check(player->pDrlgAct) : nullptr;
+  if (act == nullptr) {
+    return;
+  }
+  s_collision_maps.Update(act->ptRoom, reader);
+
+  D2DynamicPathStrc* path = reader.Check(player->pDynamicPath);
+  D2ActiveRoomStrc* room = path ? reader.Check(path->ptRoom) : nullptr;
+  uint32_t version = 0;
+  if (!room || !GetRoomLevel(*room, reader, &s_collision_key) || !s_collision_maps.Find(s_collision_key, &version)) {
+    return;
+  }
+  Local<Value> values[] = {
+      Integer::NewFromUnsigned(isolate, s_collision_key.level_id),
+      Integer::NewFromUnsigned(isolate, version),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, values, std::size(values)));
+}
+
+// Copies the walkability map of |level id| (in the seed and difficulty of the local player's level) unless the
+// caller already has |version|, in which case that version (a number) is returned. The ArrayBuffer is laid out as
+// int32 origin x, int32 origin y, uint32 width, uint32 height (subtiles), uint32 version, uint32 bytes per row and
+// two reserved uint32, followed by the rows of bits, see lib/d2r/collision-map.js. Undefined if the level was not
+// seen yet.
+static void GetCollisionMap(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  if (!s_collision_maps_enabled || !args[0]->IsUint32()) {
+    return;
+  }
+  CollisionMapKey key = s_collision_key;
+  key.level_id = args[0]->Uint32Value(context).FromJust();
+  uint32_t known = args[1]->Uint32Value(context).FromMaybe(0);
+
+  uint32_t version = 0;
+  const WalkableMap* map = s_collision_maps.Find(key, &version);
+  if (map == nullptr) {
+    return;
+  }
+  if (version == known) {
+    args.GetReturnValue().Set(version);
+    return;
+  }
+
+  std::span<const uint64_t> words = map->words();
+  Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, 8 * sizeof(uint32_t) + words.size_bytes());
+  auto* out = static_cast<uint8_t*>(buffer->Data());
+  uint32_t header[8] = {static_cast<uint32_t>(map->origin_x()),
+                        static_cast<uint32_t>(map->origin_y()),
+                        map->width(),
+                        map->height(),
+                        version,
+                        map->words_per_row() * static_cast<uint32_t>(sizeof(uint64_t)),
+                        0,
+                        0};
+  std::memcpy(out, header, sizeof(header));
+  std::memcpy(out + sizeof(header), words.data(), words.size_bytes());
+  args.GetReturnValue().Set(buffer);
+}
+
+// Writes the maps to the path given to collisionMapsEnable() if rooms were merged since the last save. Does file
+// I/O, call it outside the game lock. Returns true if the file was written.
+static void SaveCollisionMaps(const FunctionCallbackInfo<Value>& args) {
+  TRACE_SPAN("SaveCollisionMaps");
+  bool saved = s_collision_maps_enabled && s_collision_maps.dirty() && s_collision_maps.Save(s_collision_map_path);
+  args.GetReturnValue().Set(saved);
+}
+
+// Number of frames the game presented so far, -1 if the frame hook is not installed.
+static void GetFrame(const FunctionCallbackInfo<Value>& args) {
+  if (!FrameHook::IsActive()) {
+    args.GetReturnValue().Set(-1);
+    return;
+  }
+  args.GetReturnValue().Set(static_cast<double>(FrameHook::frame()));
+}
+
+// Milliseconds until the game is expected to present its next frame, at most |cap ms| (default 50). 0 if it is due
+// or no frames were timed yet, -1 if the frame hook is not installed. Does not block, scripts arm a timer with it.
+static void MsUntilNextFrame(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  if (!FrameHook::IsActive()) {
+    args.GetReturnValue().Set(-1);
+    return;
+  }
+  uint32_t cap_ms = args[0]->IsUint32() ? args[0]->Uint32Value(context).FromJust() : 50;
+  args.GetReturnValue().Set(FrameHook::MsUntilNextFrame(cap_ms));
+}
+
+// Publishes the timings of an ObjectManager tick for simple_injector --top: |tick ns| and |game lock ns|, undefined
+// if the game lock could not be taken.
+static void RecordTick(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = Environment::GetCurrent(isolate)->context();
+  Metrics::Add(Metric::Ticks);
+  Metrics::Set(Metric::TickTime, static_cast<uint64_t>(args[0]->NumberValue(context).FromMaybe(0)));
+  if (args[1]->IsNumber()) {
+    Metrics::Set(Metric::GameLockTime, static_cast<uint64_t>(args[1]->NumberValue(context).FromJust()));
+  } else {
+    Metrics::Add(Metric::GameLockTimeouts);
+  }
+  Metrics::Set(Metric::Frames, FrameHook::frame());
+}
+
+// Start recording every snapshot into a session file for SessionReplay. Returns the path or undefined on failure.
+static void SessionRecordStart(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+
+  std::string path;
+  if (args[0]->IsString()) {
+    nyx::Utf8Value utf8(isolate, args[0]);
+    path = *utf8;
+  } else {
+    path = dolos::get_module_cwd() + "\\session.d2rs";
+  }
+
+  if (!SessionRecorder::Start(path)) {
+    return;
+  }
+  args.GetReturnValue().Set(String::NewFromUtf8(isolate, path.c_str(), NewStringType::kNormal).ToLocalChecked());
+}
+
+static void SessionRecordStop(const FunctionCallbackInfo<Value>& args) {
+  SessionRecorder::Stop();
+}
+
+static void TraceEnable(const FunctionCallbackInfo<Value>& args) {
+  trace::SetEnabled(args[0]->BooleanValue(args.GetIsolate()));
+}
+
+static void TraceBegin(const FunctionCallbackInfo<Value>& args) {
+  // still pushed while disabled so traceEnd stays balanced, but the name is neither converted nor interned
+  if (!trace::IsEnabled()) {
+    trace::Begin(nullptr);
+    return;
+  }
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+  nyx::Utf8Value name(isolate, args[0]);
+  trace::Begin(trace::InternName(*name));
+}
+
+static void TraceEnd(const FunctionCallbackInfo<Value>& args) {
+  trace::End();
+}
+
+// writes the recorded spans as Chrome trace-event JSON, returns the path written or undefined on failure
+static void TraceDump(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope scope(isolate);
+
+  std::string path;
+  if (args[0]->IsString()) {
+    nyx::Utf8Value utf8(isolate, args[0]);
+    path = *utf8;
+  } else {
+    path = dolos::get_module_cwd() + "\\trace.json";
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    PIPE_LOG_ERROR("[Trace] Failed to open {}", path);
+    return;
+  }
+  std::string json = trace::DumpChromeTrace();
+  file.write(json.data(), static_cast<std::streamsize>(json.size()));
+  if (!file) {
+    PIPE_LOG_ERROR("[Trace] Failed to write {}", path);
+    return;
+  }
+  PIPE_LOG_INFO("[Trace] Wrote {} bytes to {}", json.size(), path);
+  args.GetReturnValue().Set(String::NewFromUtf8(isolate, path.c_str(), NewStringType::kNormal).ToLocalChecked());
+}
+
 void InitD2RBinding(nyx::IsolateData* isolate_data, Local<ObjectTemplate> target) {
   Isolate* isolate = isolate_data->isolate();
 
@@ -197,11 +1088,52 @@ void InitD2RBinding(nyx::IsolateData* isolate_data, Local<ObjectTemplate> target
 
   nyx::SetMethod(isolate, target, "automapGetMode", AutomapGetMode);
   nyx::SetMethod(isolate, target, "worldToAutomap", WorldToAutomap);
+  nyx::SetMethod(isolate, target, "worldToAutomapMany", WorldToAutomapMany);
   nyx::SetMethod(isolate, target, "revealLevel", RevealLevel);
   nyx::SetMethod(isolate, target, "getPlayerIdByIndex", GetPlayerIdByIndex);
   nyx::SetMethod(isolate, target, "getLocalPlayerIndex", GetLocalPlayerIndex);
+  nyx::SetMethod(isolate, target, "getPlayers", GetPlayers);
   nyx::SetMethod(isolate, target, "getClientSideUnitHashTableAddress", GetClientSideUnitHashTableAddress);
   nyx::SetMethod(isolate, target, "getServerSideUnitHashTableAddress", GetServerSideUnitHashTableAddress);
+
+  nyx::SetMethod(isolate, target, "snapshotUnits", SnapshotUnits);
+  nyx::SetMethod(isolate, target, "getSnapshotBuffer", GetSnapshotBuffer);
+  nyx::SetMethod(isolate, target, "snapshotPipelineEnable", SnapshotPipelineEnable);
+  nyx::SetMethod(isolate, target, "captureUnits", CaptureUnits);
+  nyx::SetMethod(isolate, target, "swapSnapshot", SwapSnapshot);
+  nyx::SetMethod(isolate, target, "setItemRules", SetItemRules);
+  nyx::SetMethod(isolate, target, "loadPathMotion", LoadPathMotion);
+  nyx::SetMethod(isolate, target, "extrapolatePaths", ExtrapolatePaths);
+  nyx::SetMethod(isolate, target, "readMemory", ReadMemory);
+  nyx::SetMethod(isolate, target, "snapshotInventory", SnapshotInventory);
+  nyx::SetMethod(isolate, target, "releaseInventory", ReleaseInventory);
+  nyx::SetMethod(isolate, target, "readStats", ReadStats);
+  nyx::SetMethod(isolate, target, "getDataTable", GetDataTable);
+  nyx::SetMethod(isolate, target, "snapshotWidgets", SnapshotWidgets);
+  nyx::SetMethod(isolate, target, "collisionMapsEnable", CollisionMapsEnable);
+  nyx::SetMethod(isolate, target, "updateCollisionMaps", UpdateCollisionMaps);
+  nyx::SetMethod(isolate, target, "getCollisionMap", GetCollisionMap);
+  nyx::SetMethod(isolate, target, "saveCollisionMaps", SaveCollisionMaps);
+  nyx::SetMethod(isolate, target, "getFrame", GetFrame);
+  nyx::SetMethod(isolate, target, "msUntilNextFrame", MsUntilNextFrame);
+  nyx::SetMethod(isolate, target, "recordTick", RecordTick);
+
+  nyx::SetMethod(isolate, target, "traceEnable", TraceEnable);
+  nyx::SetMethod(isolate, target, "traceBegin", TraceBegin);
+  nyx::SetMethod(isolate, target, "traceEnd", TraceEnd);
+  nyx::SetMethod(isolate, target, "traceDump", TraceDump);
+  nyx::SetMethod(isolate, target, "sessionRecordStart", SessionRecordStart);
+  nyx::SetMethod(isolate, target, "sessionRecordStop", SessionRecordStop);
+}
+
+void ShutdownD2RBinding() {
+  // joins the worker, the results handed out as ArrayBuffers keep their records alive through the backing stores
+  s_snapshot_pipeline.reset();
+  s_pipeline_stores.clear();
+  // scripts only save when a level is left, the rooms merged in the current one would be lost
+  if (s_collision_maps_enabled && s_collision_maps.dirty()) {
+    s_collision_maps.Save(s_collision_map_path);
+  }
 }
 
 }  // namespace d2r
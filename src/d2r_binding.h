@@ -5,5 +5,8 @@
 namespace d2r {
 
 void InitD2RBinding(nyx::IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+// Stops the threads the binding started (the snapshot worker), before the metrics they report to are unmapped, and
+// saves the collision maps merged since the last save.
+void ShutdownD2RBinding();
 
 }  // namespace d2r
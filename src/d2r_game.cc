@@ -4,10 +4,15 @@
 #include <nyx/extension.h>
 #include <nyx/nyx.h>
 
+#include "binary_log.h"
 #include "d2r_binding.h"
 #include "d2r_builtins.h"
+#include "frame_hook.h"
+#include "metrics.h"
 #include "offsets.h"
 #include "retcheck_bypass.h"
+#include "safe_read.h"
+#include "session_recorder.h"
 
 #include <dolos/pipe_log.h>
 
@@ -18,6 +23,10 @@ dolos::Game* dolos::Game::Create() {
 namespace d2r {
 
 bool D2rGame::OnInitialize() {
+  if (!Metrics::Initialize()) {
+    PIPE_LOG_WARN("[nyx.d2r] Failed to publish metrics - simple_injector --top will not see this process");
+  }
+
   PIPE_LOG("[nyx.d2r] Initializing offsets...");
   if (!InitializeOffsets()) {
     PIPE_LOG_WARN("[nyx.d2r] Some offsets could not be resolved - features may be limited");
@@ -27,6 +36,12 @@ bool D2rGame::OnInitialize() {
     PIPE_LOG_WARN("[nyx.d2r] Failed to install retcheck bypass - game function calls may crash");
   }
 
+  BinaryLog::Initialize();
+
+  if (!FrameHook::Initialize()) {
+    PIPE_LOG_WARN("[nyx.d2r] Failed to install the frame hook - onFrame() falls back to timers");
+  }
+
   nyx::RegisterBinding("d2r", InitD2RBinding);
   d2r_builtins::RegisterBuiltins();
   nyx::SetScriptDirectory(dolos::get_module_cwd() + "\\scripts");
@@ -35,7 +50,13 @@ bool D2rGame::OnInitialize() {
 }
 
 void D2rGame::OnShutdown() {
+  FrameHook::Shutdown();
+  ShutdownD2RBinding();
+  SessionRecorder::Stop();
+  BinaryLog::Shutdown();
   RetcheckBypass::Shutdown();
+  SafeReader::Shutdown();
+  Metrics::Shutdown();
 }
 
 }  // namespace d2r
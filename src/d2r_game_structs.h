@@ -0,0 +1,934 @@
+#pragma once
+
+// Generated by tools/structgen/generate.js from tools/structgen/schema.js, do not edit.
+//
+// Plain game layouts, included by d2r_structs.h after the helper templates they use (vector<>).
+
+#include <cstddef>
+#include <cstdint>
+
+namespace d2r {
+
+class D2LevelDefBin;
+class D2MonStatsTxt;
+class D2ObjectsTxt;
+class D2ItemsTxt;
+class D2DataTablesStrc;
+class D2SeedStrc;
+class D2FP16;
+class D2FP32;
+class D2FP32_16;
+class D2PathPointStrc;
+class D2DrlgCoordsStrc;
+class D2CoordStrc;
+class D2DrlgCoordStrc;
+class D2DrlgTileInfoStrc;
+class D2DrlgRoomStrc;
+class D2TileLibraryEntryStrc;
+class D2DrlgTileDataStrc;
+class D2DrlgRoomTilesStrc;
+class D2RoomCollisionGridStrc;
+class D2ActiveRoomStrc;
+class D2DrlgLevelStrc;
+class D2DrlgStrc;
+class D2DrlgActStrc;
+class D2DynamicPathStrc;
+class D2SkillStrc;
+class D2SkillListStrc;
+class D2PlayerDataStrc;
+class D2MonsterDataStrc;
+class D2ObjectDataStrc;
+class D2StaticPathStrc;
+class D2StatStrc;
+class D2StatsArrayStrc;
+class D2StatListExStrc;
+class D2InventoryStrc;
+class D2ItemDataStrc;
+class D2UnitStrc;
+
+class D2LevelDefBin {
+ public:
+  uint32_t dwQuestFlag;     // 0x0000
+  uint32_t dwQuestFlagEx;   // 0x0004
+  int32_t dwLayer;          // 0x0008
+  uint32_t dwSizeX[3];      // 0x000C
+  uint32_t dwSizeY[3];      // 0x0018
+  int32_t dwOffsetX;        // 0x0024
+  int32_t dwOffsetY;        // 0x0028
+  uint32_t dwDepend;        // 0x002C
+  uint32_t dwDrlgType;      // 0x0030
+  uint32_t dwLevelType;     // 0x0034
+  int32_t nSubType;         // 0x0038
+  int32_t nSubTheme;        // 0x003C
+  int32_t nSubWaypoint;     // 0x0040
+  int32_t nSubShrine;       // 0x0044
+  uint32_t dwVis[8];        // 0x0048
+  int32_t nWarp[8];         // 0x0068
+  uint8_t nIntensity;       // 0x0088
+  uint8_t nRed;             // 0x0089
+  uint8_t nGreen;           // 0x008A
+  uint8_t nBlue;            // 0x008B
+  uint32_t dwPortal;        // 0x008C
+  uint32_t dwPosition;      // 0x0090
+  uint32_t dwSaveMonsters;  // 0x0094
+  uint32_t dwLOSDraw;       // 0x0098
+};  // Size: 0x009C
+static_assert(sizeof(D2LevelDefBin) == 0x9C);
+static_assert(offsetof(D2LevelDefBin, dwQuestFlag) == 0x0);
+static_assert(offsetof(D2LevelDefBin, dwQuestFlagEx) == 0x4);
+static_assert(offsetof(D2LevelDefBin, dwLayer) == 0x8);
+static_assert(offsetof(D2LevelDefBin, dwSizeX) == 0xC);
+static_assert(offsetof(D2LevelDefBin, dwSizeY) == 0x18);
+static_assert(offsetof(D2LevelDefBin, dwOffsetX) == 0x24);
+static_assert(offsetof(D2LevelDefBin, dwOffsetY) == 0x28);
+static_assert(offsetof(D2LevelDefBin, dwDepend) == 0x2C);
+static_assert(offsetof(D2LevelDefBin, dwDrlgType) == 0x30);
+static_assert(offsetof(D2LevelDefBin, dwLevelType) == 0x34);
+static_assert(offsetof(D2LevelDefBin, nSubType) == 0x38);
+static_assert(offsetof(D2LevelDefBin, nSubTheme) == 0x3C);
+static_assert(offsetof(D2LevelDefBin, nSubWaypoint) == 0x40);
+static_assert(offsetof(D2LevelDefBin, nSubShrine) == 0x44);
+static_assert(offsetof(D2LevelDefBin, dwVis) == 0x48);
+static_assert(offsetof(D2LevelDefBin, nWarp) == 0x68);
+static_assert(offsetof(D2LevelDefBin, nIntensity) == 0x88);
+static_assert(offsetof(D2LevelDefBin, nRed) == 0x89);
+static_assert(offsetof(D2LevelDefBin, nGreen) == 0x8A);
+static_assert(offsetof(D2LevelDefBin, nBlue) == 0x8B);
+static_assert(offsetof(D2LevelDefBin, dwPortal) == 0x8C);
+static_assert(offsetof(D2LevelDefBin, dwPosition) == 0x90);
+static_assert(offsetof(D2LevelDefBin, dwSaveMonsters) == 0x94);
+static_assert(offsetof(D2LevelDefBin, dwLOSDraw) == 0x98);
+
+class D2MonStatsTxt {
+ public:
+  char pad_0000[424];  // 0x0000
+};  // Size: 0x01A8
+static_assert(sizeof(D2MonStatsTxt) == 0x1A8);
+
+class D2ObjectsTxt {
+ public:
+  char pad_0000[448];  // 0x0000
+};  // Size: 0x01C0
+static_assert(sizeof(D2ObjectsTxt) == 0x1C0);
+
+class D2ItemsTxt {
+ public:
+  char pad_0000[424];  // 0x0000
+};  // Size: 0x01A8
+static_assert(sizeof(D2ItemsTxt) == 0x1A8);
+
+class D2DataTablesStrc {
+ public:
+  char pad_0000[3088];              // 0x0000
+  D2MonStatsTxt* pMonStatsTxt;      // 0x0C10
+  int32_t nMonStatsTxtRecordCount;  // 0x0C18
+  char pad_0C1C[1076];              // 0x0C1C
+  D2ObjectsTxt* pObjectsTxt;        // 0x1050
+  int32_t nObjectsTxtRecordCount;   // 0x1058
+  char pad_105C[92];                // 0x105C
+  int32_t nLevelsTxtRecordCount;    // 0x10B8
+  char pad_10BC[4];                 // 0x10BC
+  D2LevelDefBin* pLevelDefBin;      // 0x10C0
+  char pad_10C8[1400];              // 0x10C8
+  D2ItemsTxt* pItemsTxt;            // 0x1640
+  int32_t nItemsTxtRecordCount;     // 0x1648
+  char pad_164C[180];               // 0x164C
+};  // Size: 0x1700
+static_assert(sizeof(D2DataTablesStrc) == 0x1700);
+static_assert(offsetof(D2DataTablesStrc, pMonStatsTxt) == 0xC10);
+static_assert(offsetof(D2DataTablesStrc, nMonStatsTxtRecordCount) == 0xC18);
+static_assert(offsetof(D2DataTablesStrc, pObjectsTxt) == 0x1050);
+static_assert(offsetof(D2DataTablesStrc, nObjectsTxtRecordCount) == 0x1058);
+static_assert(offsetof(D2DataTablesStrc, nLevelsTxtRecordCount) == 0x10B8);
+static_assert(offsetof(D2DataTablesStrc, pLevelDefBin) == 0x10C0);
+static_assert(offsetof(D2DataTablesStrc, pItemsTxt) == 0x1640);
+static_assert(offsetof(D2DataTablesStrc, nItemsTxtRecordCount) == 0x1648);
+
+class D2SeedStrc {
+ public:
+  uint32_t dwLow;   // 0x0000
+  uint32_t dwHigh;  // 0x0004
+};  // Size: 0x0008
+static_assert(sizeof(D2SeedStrc) == 0x8);
+static_assert(offsetof(D2SeedStrc, dwLow) == 0x0);
+static_assert(offsetof(D2SeedStrc, dwHigh) == 0x4);
+
+class D2FP16 {
+ public:
+  uint16_t wOffsetX;  // 0x0000
+  uint16_t wPosX;     // 0x0002
+  uint16_t wOffsetY;  // 0x0004
+  uint16_t wPosY;     // 0x0006
+};  // Size: 0x0008
+static_assert(sizeof(D2FP16) == 0x8);
+static_assert(offsetof(D2FP16, wOffsetX) == 0x0);
+static_assert(offsetof(D2FP16, wPosX) == 0x2);
+static_assert(offsetof(D2FP16, wOffsetY) == 0x4);
+static_assert(offsetof(D2FP16, wPosY) == 0x6);
+
+class D2FP32 {
+ public:
+  uint32_t dwPrecisionX;  // 0x0000
+  uint32_t dwPrecisionY;  // 0x0004
+};  // Size: 0x0008
+static_assert(sizeof(D2FP32) == 0x8);
+static_assert(offsetof(D2FP32, dwPrecisionX) == 0x0);
+static_assert(offsetof(D2FP32, dwPrecisionY) == 0x4);
+
+class D2FP32_16 {
+ public:
+  union  // 0x0000
+  {
+    D2FP16 fp16;  // 0x0000
+    D2FP32 fp32;  // 0x0000
+  };
+};  // Size: 0x0008
+static_assert(sizeof(D2FP32_16) == 0x8);
+static_assert(offsetof(D2FP32_16, fp16) == 0x0);
+static_assert(offsetof(D2FP32_16, fp32) == 0x0);
+
+#pragma pack(push, 1)
+class D2PathPointStrc {
+ public:
+  uint16_t wX;  // 0x0000
+  uint16_t wY;  // 0x0002
+};  // Size: 0x0004
+static_assert(sizeof(D2PathPointStrc) == 0x4);
+static_assert(offsetof(D2PathPointStrc, wX) == 0x0);
+static_assert(offsetof(D2PathPointStrc, wY) == 0x2);
+#pragma pack(pop)
+
+class D2DrlgCoordsStrc {
+ public:
+  int32_t nSubtileX;       // 0x0000 nBackCornerTileX
+  int32_t nSubtileY;       // 0x0004 nBackCornerTileY
+  int32_t nSubtileWidth;   // 0x0008 nSizeGameX
+  int32_t nSubtileHeight;  // 0x000C nSizeGameY
+  int32_t nTileXPos;       // 0x0010 nSizeTileX
+  int32_t nTileYPos;       // 0x0014 nSizeTileY
+  int32_t nTileWidth;      // 0x0018
+  int32_t nTileHeight;     // 0x001C
+};  // Size: 0x0020
+static_assert(sizeof(D2DrlgCoordsStrc) == 0x20);
+static_assert(offsetof(D2DrlgCoordsStrc, nSubtileX) == 0x0);
+static_assert(offsetof(D2DrlgCoordsStrc, nSubtileY) == 0x4);
+static_assert(offsetof(D2DrlgCoordsStrc, nSubtileWidth) == 0x8);
+static_assert(offsetof(D2DrlgCoordsStrc, nSubtileHeight) == 0xC);
+static_assert(offsetof(D2DrlgCoordsStrc, nTileXPos) == 0x10);
+static_assert(offsetof(D2DrlgCoordsStrc, nTileYPos) == 0x14);
+static_assert(offsetof(D2DrlgCoordsStrc, nTileWidth) == 0x18);
+static_assert(offsetof(D2DrlgCoordsStrc, nTileHeight) == 0x1C);
+
+class D2CoordStrc {
+ public:
+  int32_t nX;  // 0x0000
+  int32_t nY;  // 0x0004
+};  // Size: 0x0008
+static_assert(sizeof(D2CoordStrc) == 0x8);
+static_assert(offsetof(D2CoordStrc, nX) == 0x0);
+static_assert(offsetof(D2CoordStrc, nY) == 0x4);
+
+class D2DrlgCoordStrc {
+ public:
+  int32_t nBackCornerTileX;  // 0x0000
+  int32_t nBackCornerTileY;  // 0x0004
+  int32_t nSizeTileX;        // 0x0008
+  int32_t nSizeTileY;        // 0x000C
+};  // Size: 0x0010
+static_assert(sizeof(D2DrlgCoordStrc) == 0x10);
+static_assert(offsetof(D2DrlgCoordStrc, nBackCornerTileX) == 0x0);
+static_assert(offsetof(D2DrlgCoordStrc, nBackCornerTileY) == 0x4);
+static_assert(offsetof(D2DrlgCoordStrc, nSizeTileX) == 0x8);
+static_assert(offsetof(D2DrlgCoordStrc, nSizeTileY) == 0xC);
+
+class D2DrlgTileInfoStrc {
+ public:
+  int32_t nPosX;       // 0x0000
+  int32_t nPosY;       // 0x0004
+  int32_t nTileIndex;  // 0x0008
+};  // Size: 0x000C
+static_assert(sizeof(D2DrlgTileInfoStrc) == 0xC);
+static_assert(offsetof(D2DrlgTileInfoStrc, nPosX) == 0x0);
+static_assert(offsetof(D2DrlgTileInfoStrc, nPosY) == 0x4);
+static_assert(offsetof(D2DrlgTileInfoStrc, nTileIndex) == 0x8);
+
+class D2DrlgRoomStrc {
+ public:
+  char pad_0000[8];                          // 0x0000
+  uint32_t dwInitSeed;                       // 0x0008
+  char pad_000C[4];                          // 0x000C
+  vector<D2DrlgRoomStrc*> ptRoomsNear;       // 0x0010
+  char pad_0028[8];                          // 0x0028
+  D2SeedStrc tSeed;                          // 0x0030
+  D2DrlgRoomStrc* ptStatusNext;              // 0x0038
+  size_t ptMaze;                             // 0x0040
+  D2DrlgRoomStrc* ptDrlgRoomNext;            // 0x0048
+  uint32_t dwFlags;                          // 0x0050
+  char pad_0054[4];                          // 0x0054
+  D2ActiveRoomStrc* hRoom;                   // 0x0058
+  D2DrlgCoordStrc tRoomCoords;               // 0x0060
+  uint8_t fRoomStatus;                       // 0x0070
+  char pad_0071[3];                          // 0x0071
+  int32_t nType;                             // 0x0074
+  size_t ptRoomTiles;                        // 0x0078
+  uint32_t dwDT1Mask;                        // 0x0080
+  char pad_0084[12];                         // 0x0084
+  D2DrlgLevelStrc* ptLevel;                  // 0x0090
+  /*D2PresetUnitStrc*/ void* ptPresetUnits;  // 0x0098
+  char pad_00A0[16];                         // 0x00A0
+  char pTiles[32][8];                        // 0x00B0
+  D2DrlgRoomStrc* ptStatusPrev;              // 0x01B0
+  uint64_t nUniqueId;                        // 0x01B8
+};  // Size: 0x01C0
+static_assert(sizeof(D2DrlgRoomStrc) == 0x1C0);
+static_assert(offsetof(D2DrlgRoomStrc, dwInitSeed) == 0x8);
+static_assert(offsetof(D2DrlgRoomStrc, ptRoomsNear) == 0x10);
+static_assert(offsetof(D2DrlgRoomStrc, tSeed) == 0x30);
+static_assert(offsetof(D2DrlgRoomStrc, ptStatusNext) == 0x38);
+static_assert(offsetof(D2DrlgRoomStrc, ptMaze) == 0x40);
+static_assert(offsetof(D2DrlgRoomStrc, ptDrlgRoomNext) == 0x48);
+static_assert(offsetof(D2DrlgRoomStrc, dwFlags) == 0x50);
+static_assert(offsetof(D2DrlgRoomStrc, hRoom) == 0x58);
+static_assert(offsetof(D2DrlgRoomStrc, tRoomCoords) == 0x60);
+static_assert(offsetof(D2DrlgRoomStrc, fRoomStatus) == 0x70);
+static_assert(offsetof(D2DrlgRoomStrc, nType) == 0x74);
+static_assert(offsetof(D2DrlgRoomStrc, ptRoomTiles) == 0x78);
+static_assert(offsetof(D2DrlgRoomStrc, dwDT1Mask) == 0x80);
+static_assert(offsetof(D2DrlgRoomStrc, ptLevel) == 0x90);
+static_assert(offsetof(D2DrlgRoomStrc, ptPresetUnits) == 0x98);
+static_assert(offsetof(D2DrlgRoomStrc, pTiles) == 0xB0);
+static_assert(offsetof(D2DrlgRoomStrc, ptStatusPrev) == 0x1B0);
+static_assert(offsetof(D2DrlgRoomStrc, nUniqueId) == 0x1B8);
+
+class D2TileLibraryEntryStrc {
+ public:
+  int32_t nLightDirection;         // 0x0000
+  int16_t nRoofHeight;             // 0x0004
+  int16_t nFlags;                  // 0x0006
+  int32_t nTotalHeight;            // 0x0008
+  int32_t nWidth;                  // 0x000C
+  int32_t nHeightToBottom;         // 0x0010
+  int32_t nType;                   // 0x0014
+  int32_t nStyle;                  // 0x0018
+  int32_t nSequence;               // 0x001C
+  int32_t nRarity_Frame;           // 0x0020
+  int32_t nTransparentColorRGB24;  // 0x0024
+  uint8_t dwTileFlags[4];          // 0x0028
+  char pad_002C[84];               // 0x002C
+};  // Size: 0x0080
+static_assert(sizeof(D2TileLibraryEntryStrc) == 0x80);
+static_assert(offsetof(D2TileLibraryEntryStrc, nLightDirection) == 0x0);
+static_assert(offsetof(D2TileLibraryEntryStrc, nRoofHeight) == 0x4);
+static_assert(offsetof(D2TileLibraryEntryStrc, nFlags) == 0x6);
+static_assert(offsetof(D2TileLibraryEntryStrc, nTotalHeight) == 0x8);
+static_assert(offsetof(D2TileLibraryEntryStrc, nWidth) == 0xC);
+static_assert(offsetof(D2TileLibraryEntryStrc, nHeightToBottom) == 0x10);
+static_assert(offsetof(D2TileLibraryEntryStrc, nType) == 0x14);
+static_assert(offsetof(D2TileLibraryEntryStrc, nStyle) == 0x18);
+static_assert(offsetof(D2TileLibraryEntryStrc, nSequence) == 0x1C);
+static_assert(offsetof(D2TileLibraryEntryStrc, nRarity_Frame) == 0x20);
+static_assert(offsetof(D2TileLibraryEntryStrc, nTransparentColorRGB24) == 0x24);
+static_assert(offsetof(D2TileLibraryEntryStrc, dwTileFlags) == 0x28);
+
+class D2DrlgTileDataStrc {
+ public:
+  int32_t nWidth;                  // 0x0000
+  int32_t nHeight;                 // 0x0004
+  int32_t nPosX;                   // 0x0008
+  int32_t nPosY;                   // 0x000C
+  char pad_0010[8];                // 0x0010
+  uint32_t dwFlags;                // 0x0018
+  char pad_001C[4];                // 0x001C
+  D2TileLibraryEntryStrc* ptTile;  // 0x0020
+  int32_t nTileCount;              // 0x0028
+  char pad_002C[28];               // 0x002C
+};  // Size: 0x0048
+static_assert(sizeof(D2DrlgTileDataStrc) == 0x48);
+static_assert(offsetof(D2DrlgTileDataStrc, nWidth) == 0x0);
+static_assert(offsetof(D2DrlgTileDataStrc, nHeight) == 0x4);
+static_assert(offsetof(D2DrlgTileDataStrc, nPosX) == 0x8);
+static_assert(offsetof(D2DrlgTileDataStrc, nPosY) == 0xC);
+static_assert(offsetof(D2DrlgTileDataStrc, dwFlags) == 0x18);
+static_assert(offsetof(D2DrlgTileDataStrc, ptTile) == 0x20);
+static_assert(offsetof(D2DrlgTileDataStrc, nTileCount) == 0x28);
+
+class D2DrlgRoomTilesStrc {
+ public:
+  D2DrlgTileDataStrc* ptWallTiles;   // 0x0000
+  uint64_t nWalls;                   // 0x0008
+  char pad_0010[16];                 // 0x0010
+  D2DrlgTileDataStrc* ptFloorTiles;  // 0x0020
+  uint64_t nFloors;                  // 0x0028
+  char pad_0030[16];                 // 0x0030
+  D2DrlgTileDataStrc* ptRoofTiles;   // 0x0040
+  uint64_t nRoofs;                   // 0x0048
+  char pad_0050[24];                 // 0x0050
+};  // Size: 0x0068
+static_assert(sizeof(D2DrlgRoomTilesStrc) == 0x68);
+static_assert(offsetof(D2DrlgRoomTilesStrc, ptWallTiles) == 0x0);
+static_assert(offsetof(D2DrlgRoomTilesStrc, nWalls) == 0x8);
+static_assert(offsetof(D2DrlgRoomTilesStrc, ptFloorTiles) == 0x20);
+static_assert(offsetof(D2DrlgRoomTilesStrc, nFloors) == 0x28);
+static_assert(offsetof(D2DrlgRoomTilesStrc, ptRoofTiles) == 0x40);
+static_assert(offsetof(D2DrlgRoomTilesStrc, nRoofs) == 0x48);
+
+class D2RoomCollisionGridStrc {
+ public:
+  D2DrlgCoordsStrc tRoomCoords;  // 0x0000
+  uint16_t* pCollisionMask;      // 0x0020 nSubtileWidth * nSubtileHeight flags, row-major
+};  // Size: 0x0028
+static_assert(sizeof(D2RoomCollisionGridStrc) == 0x28);
+static_assert(offsetof(D2RoomCollisionGridStrc, tRoomCoords) == 0x0);
+static_assert(offsetof(D2RoomCollisionGridStrc, pCollisionMask) == 0x20);
+
+class D2ActiveRoomStrc {
+ public:
+  D2ActiveRoomStrc** ptRoomList;             // 0x0000
+  D2DrlgRoomTilesStrc* ptRoomTiles;          // 0x0008
+  char pad_0010[8];                          // 0x0010
+  D2DrlgRoomStrc* ptDrlgRoom;                // 0x0018
+  char pad_0020[24];                         // 0x0020
+  D2RoomCollisionGridStrc* ptCollisionGrid;  // 0x0038
+  uint32_t dwNumRooms;                       // 0x0040
+  uint32_t dwNumUnits;                       // 0x0044
+  /*D2DrlgActStrc*/ void* ptDrlgAct;         // 0x0048
+  char pad_0050[4];                          // 0x0050
+  uint32_t dwFlags;                          // 0x0054
+  char pad_0058[40];                         // 0x0058
+  D2DrlgCoordsStrc tCoords;                  // 0x0080
+  D2SeedStrc tSeed;                          // 0x00A0
+  D2UnitStrc* ptUnitFirst;                   // 0x00A8
+  D2ActiveRoomStrc* ptRoomNext;              // 0x00B0
+  char pad_00B8[8];                          // 0x00B8
+};  // Size: 0x00C0
+static_assert(sizeof(D2ActiveRoomStrc) == 0xC0);
+static_assert(offsetof(D2ActiveRoomStrc, ptRoomList) == 0x0);
+static_assert(offsetof(D2ActiveRoomStrc, ptRoomTiles) == 0x8);
+static_assert(offsetof(D2ActiveRoomStrc, ptDrlgRoom) == 0x18);
+static_assert(offsetof(D2ActiveRoomStrc, ptCollisionGrid) == 0x38);
+static_assert(offsetof(D2ActiveRoomStrc, dwNumRooms) == 0x40);
+static_assert(offsetof(D2ActiveRoomStrc, dwNumUnits) == 0x44);
+static_assert(offsetof(D2ActiveRoomStrc, ptDrlgAct) == 0x48);
+static_assert(offsetof(D2ActiveRoomStrc, dwFlags) == 0x54);
+static_assert(offsetof(D2ActiveRoomStrc, tCoords) == 0x80);
+static_assert(offsetof(D2ActiveRoomStrc, tSeed) == 0xA0);
+static_assert(offsetof(D2ActiveRoomStrc, ptUnitFirst) == 0xA8);
+static_assert(offsetof(D2ActiveRoomStrc, ptRoomNext) == 0xB0);
+
+class D2DrlgLevelStrc {
+ public:
+  uint32_t dwDrlgType;          // 0x0000
+  uint32_t dwFlags;             // 0x0004
+  int32_t nRooms;               // 0x0008
+  char pad_000C[4];             // 0x000C
+  D2DrlgRoomStrc* ptRoomFirst;  // 0x0010
+  union                         // 0x0018
+  {
+    /*LevelMazeTableRecord*/ void* pMaze;           // 0x0000
+    /*D2DrlgPresetInfoStrc*/ void* pPresetInfo;     // 0x0000
+    /*D2DrlgOutdoorInfoStrc*/ void* pOutdoorsInfo;  // 0x0000
+  };
+  char pad_0020[8];                   // 0x0020
+  D2DrlgCoordStrc tCoords;            // 0x0028
+  D2DrlgTileInfoStrc ptTileInfo[32];  // 0x0038
+  D2DrlgLevelStrc* ptNextLevel;       // 0x01B8
+  size_t ptCurrentMap;                // 0x01C0 D2DrlgMapStrc*
+  D2DrlgStrc* ptDrlg;                 // 0x01C8
+  char pad_01D0[16];                  // 0x01D0
+  uint32_t dwLevelType;               // 0x01E0
+  D2SeedStrc tSeed;                   // 0x01E4
+  char pad_01EC[12];                  // 0x01EC
+  int32_t eLevelId;                   // 0x01F8
+  char pad_01FC[12];                  // 0x01FC
+  int32_t nRoom_Center_Warp_X[9];     // 0x0208
+  int32_t nRoom_Center_Warp_Y[9];     // 0x022C
+  uint32_t dwNumCenterWarps;          // 0x0250
+  char pad_0254[44];                  // 0x0254
+};  // Size: 0x0280
+static_assert(sizeof(D2DrlgLevelStrc) == 0x280);
+static_assert(offsetof(D2DrlgLevelStrc, dwDrlgType) == 0x0);
+static_assert(offsetof(D2DrlgLevelStrc, dwFlags) == 0x4);
+static_assert(offsetof(D2DrlgLevelStrc, nRooms) == 0x8);
+static_assert(offsetof(D2DrlgLevelStrc, ptRoomFirst) == 0x10);
+static_assert(offsetof(D2DrlgLevelStrc, pMaze) == 0x18);
+static_assert(offsetof(D2DrlgLevelStrc, pPresetInfo) == 0x18);
+static_assert(offsetof(D2DrlgLevelStrc, pOutdoorsInfo) == 0x18);
+static_assert(offsetof(D2DrlgLevelStrc, tCoords) == 0x28);
+static_assert(offsetof(D2DrlgLevelStrc, ptTileInfo) == 0x38);
+static_assert(offsetof(D2DrlgLevelStrc, ptNextLevel) == 0x1B8);
+static_assert(offsetof(D2DrlgLevelStrc, ptCurrentMap) == 0x1C0);
+static_assert(offsetof(D2DrlgLevelStrc, ptDrlg) == 0x1C8);
+static_assert(offsetof(D2DrlgLevelStrc, dwLevelType) == 0x1E0);
+static_assert(offsetof(D2DrlgLevelStrc, tSeed) == 0x1E4);
+static_assert(offsetof(D2DrlgLevelStrc, eLevelId) == 0x1F8);
+static_assert(offsetof(D2DrlgLevelStrc, nRoom_Center_Warp_X) == 0x208);
+static_assert(offsetof(D2DrlgLevelStrc, nRoom_Center_Warp_Y) == 0x22C);
+static_assert(offsetof(D2DrlgLevelStrc, dwNumCenterWarps) == 0x250);
+
+class D2DrlgStrc {
+ public:
+  D2SeedStrc tSeed;                     // 0x0000
+  uint32_t nAllocatedRooms;             // 0x0008
+  char pad_000C[4];                     // 0x000C
+  void* ptTiles[32];                    // 0x0010
+  uint32_t dwFlags;                     // 0x0110
+  char pad_0114[4];                     // 0x0114
+  /*D2DrlgWarpStrc*/ void* pWarp;       // 0x0118
+  uint32_t dwStaffLevelOffset;          // 0x0120
+  char pad_0124[4];                     // 0x0124
+  size_t ptGame;                        // 0x0128
+  D2DrlgRoomStrc tStatusRoomsLists[4];  // 0x0130
+  uint8_t nDifficulty;                  // 0x0830
+  char pad_0831[7];                     // 0x0831
+  void* pfnAutomap;                     // 0x0838
+  uint32_t dwInitSeed;                  // 0x0840 encrypted
+  uint32_t dwJungleInterlink;           // 0x0844
+  D2DrlgRoomStrc* ptDrlgRoom;           // 0x0848
+  char pad_0850[8];                     // 0x0850
+  D2DrlgActStrc* ptAct;                 // 0x0858
+  uint32_t dwStartSeed;                 // 0x0860
+  char pad_0864[4];                     // 0x0864
+  D2DrlgLevelStrc* ptLevel;             // 0x0868
+  uint8_t nActNo;                       // 0x0870
+  char pad_0871[3];                     // 0x0871
+  uint32_t dwBossLevelOffset;           // 0x0874
+  void* pfnTownAutomap;                 // 0x0878
+};  // Size: 0x0880
+static_assert(sizeof(D2DrlgStrc) == 0x880);
+static_assert(offsetof(D2DrlgStrc, tSeed) == 0x0);
+static_assert(offsetof(D2DrlgStrc, nAllocatedRooms) == 0x8);
+static_assert(offsetof(D2DrlgStrc, ptTiles) == 0x10);
+static_assert(offsetof(D2DrlgStrc, dwFlags) == 0x110);
+static_assert(offsetof(D2DrlgStrc, pWarp) == 0x118);
+static_assert(offsetof(D2DrlgStrc, dwStaffLevelOffset) == 0x120);
+static_assert(offsetof(D2DrlgStrc, ptGame) == 0x128);
+static_assert(offsetof(D2DrlgStrc, tStatusRoomsLists) == 0x130);
+static_assert(offsetof(D2DrlgStrc, nDifficulty) == 0x830);
+static_assert(offsetof(D2DrlgStrc, pfnAutomap) == 0x838);
+static_assert(offsetof(D2DrlgStrc, dwInitSeed) == 0x840);
+static_assert(offsetof(D2DrlgStrc, dwJungleInterlink) == 0x844);
+static_assert(offsetof(D2DrlgStrc, ptDrlgRoom) == 0x848);
+static_assert(offsetof(D2DrlgStrc, ptAct) == 0x858);
+static_assert(offsetof(D2DrlgStrc, dwStartSeed) == 0x860);
+static_assert(offsetof(D2DrlgStrc, ptLevel) == 0x868);
+static_assert(offsetof(D2DrlgStrc, nActNo) == 0x870);
+static_assert(offsetof(D2DrlgStrc, dwBossLevelOffset) == 0x874);
+static_assert(offsetof(D2DrlgStrc, pfnTownAutomap) == 0x878);
+
+class D2DrlgActStrc {
+ public:
+  uint32_t bUpdate;          // 0x0000
+  char pad_0004[4];          // 0x0004
+  size_t ptEnvironment;      // 0x0008
+  D2SeedStrc tInitSeed;      // 0x0010
+  D2ActiveRoomStrc* ptRoom;  // 0x0018
+  uint32_t dwActId;          // 0x0020
+  char pad_0024[36];         // 0x0024
+  size_t ptTileData;         // 0x0048
+  char pad_0050[32];         // 0x0050
+  D2DrlgStrc* ptDrlg;        // 0x0070
+  void* pfnActCallback;      // 0x0078
+  char pad_0080[16];         // 0x0080
+};  // Size: 0x0090
+static_assert(sizeof(D2DrlgActStrc) == 0x90);
+static_assert(offsetof(D2DrlgActStrc, bUpdate) == 0x0);
+static_assert(offsetof(D2DrlgActStrc, ptEnvironment) == 0x8);
+static_assert(offsetof(D2DrlgActStrc, tInitSeed) == 0x10);
+static_assert(offsetof(D2DrlgActStrc, ptRoom) == 0x18);
+static_assert(offsetof(D2DrlgActStrc, dwActId) == 0x20);
+static_assert(offsetof(D2DrlgActStrc, ptTileData) == 0x48);
+static_assert(offsetof(D2DrlgActStrc, ptDrlg) == 0x70);
+static_assert(offsetof(D2DrlgActStrc, pfnActCallback) == 0x78);
+
+#pragma pack(push, 1)
+class D2DynamicPathStrc {
+ public:
+  D2FP32_16 tGameCoords;              // 0x0000
+  uint32_t dwClientCoordX;            // 0x0008
+  uint32_t dwClientCoordY;            // 0x000C
+  D2PathPointStrc tTargetCoord;       // 0x0010
+  D2PathPointStrc tPrevTargetCoord;   // 0x0014
+  D2PathPointStrc tFinalTargetCoord;  // 0x0018
+  char pad_001C[4];                   // 0x001C
+  D2ActiveRoomStrc* ptRoom;           // 0x0020
+  D2ActiveRoomStrc* ptPreviousRoom;   // 0x0028
+  uint32_t dwCurrentPointIdx;         // 0x0030
+  uint32_t dwPathPoints;              // 0x0034
+  char pad_0038[8];                   // 0x0038
+  D2UnitStrc* ptUnit;                 // 0x0040
+  uint32_t dwFlags;                   // 0x0048
+  char pad_004C[4];                   // 0x004C
+  uint32_t dwPathType;                // 0x0050
+  uint32_t dwPrevPathType;            // 0x0054
+  uint32_t dwUnitSize;                // 0x0058
+  uint32_t dwCollisionPattern;        // 0x005C
+  uint32_t dwFootprintCollisionMask;  // 0x0060
+  uint32_t dwMoveTestCollisionMask;   // 0x0064
+  char pad_0068[8];                   // 0x0068
+  D2UnitStrc* pTargetUnit;            // 0x0070
+  uint32_t dwTargetType;              // 0x0078
+  uint32_t dwTargetId;                // 0x007C
+  float fDirection;                   // 0x0080
+  float fNewDirection;                // 0x0084
+  float fDiffDirection;               // 0x0088
+  char pad_008C[2];                   // 0x008C
+  D2CoordStrc tDirectionVector;       // 0x008E
+  D2CoordStrc tVelocityVector;        // 0x0096
+  char pad_009E[2];                   // 0x009E
+  int32_t nVelocity;                  // 0x00A0
+  int32_t nPreviousVelocity;          // 0x00A4
+  int32_t nMaxVelocity;               // 0x00A8
+  char pad_00AC[28];                  // 0x00AC
+  D2PathPointStrc ptPathPoints[78];   // 0x00C8
+  uint32_t dwSavedStepsCount;         // 0x0200
+  D2PathPointStrc ptSavedSteps[10];   // 0x0204
+  char pad_022C[4];                   // 0x022C
+};  // Size: 0x0230
+static_assert(sizeof(D2DynamicPathStrc) == 0x230);
+static_assert(offsetof(D2DynamicPathStrc, tGameCoords) == 0x0);
+static_assert(offsetof(D2DynamicPathStrc, dwClientCoordX) == 0x8);
+static_assert(offsetof(D2DynamicPathStrc, dwClientCoordY) == 0xC);
+static_assert(offsetof(D2DynamicPathStrc, tTargetCoord) == 0x10);
+static_assert(offsetof(D2DynamicPathStrc, tPrevTargetCoord) == 0x14);
+static_assert(offsetof(D2DynamicPathStrc, tFinalTargetCoord) == 0x18);
+static_assert(offsetof(D2DynamicPathStrc, ptRoom) == 0x20);
+static_assert(offsetof(D2DynamicPathStrc, ptPreviousRoom) == 0x28);
+static_assert(offsetof(D2DynamicPathStrc, dwCurrentPointIdx) == 0x30);
+static_assert(offsetof(D2DynamicPathStrc, dwPathPoints) == 0x34);
+static_assert(offsetof(D2DynamicPathStrc, ptUnit) == 0x40);
+static_assert(offsetof(D2DynamicPathStrc, dwFlags) == 0x48);
+static_assert(offsetof(D2DynamicPathStrc, dwPathType) == 0x50);
+static_assert(offsetof(D2DynamicPathStrc, dwPrevPathType) == 0x54);
+static_assert(offsetof(D2DynamicPathStrc, dwUnitSize) == 0x58);
+static_assert(offsetof(D2DynamicPathStrc, dwCollisionPattern) == 0x5C);
+static_assert(offsetof(D2DynamicPathStrc, dwFootprintCollisionMask) == 0x60);
+static_assert(offsetof(D2DynamicPathStrc, dwMoveTestCollisionMask) == 0x64);
+static_assert(offsetof(D2DynamicPathStrc, pTargetUnit) == 0x70);
+static_assert(offsetof(D2DynamicPathStrc, dwTargetType) == 0x78);
+static_assert(offsetof(D2DynamicPathStrc, dwTargetId) == 0x7C);
+static_assert(offsetof(D2DynamicPathStrc, fDirection) == 0x80);
+static_assert(offsetof(D2DynamicPathStrc, fNewDirection) == 0x84);
+static_assert(offsetof(D2DynamicPathStrc, fDiffDirection) == 0x88);
+static_assert(offsetof(D2DynamicPathStrc, tDirectionVector) == 0x8E);
+static_assert(offsetof(D2DynamicPathStrc, tVelocityVector) == 0x96);
+static_assert(offsetof(D2DynamicPathStrc, nVelocity) == 0xA0);
+static_assert(offsetof(D2DynamicPathStrc, nPreviousVelocity) == 0xA4);
+static_assert(offsetof(D2DynamicPathStrc, nMaxVelocity) == 0xA8);
+static_assert(offsetof(D2DynamicPathStrc, ptPathPoints) == 0xC8);
+static_assert(offsetof(D2DynamicPathStrc, dwSavedStepsCount) == 0x200);
+static_assert(offsetof(D2DynamicPathStrc, ptSavedSteps) == 0x204);
+#pragma pack(pop)
+
+class D2SkillStrc {
+ public:
+  /*D2SkillsTxt*/ void* pSkillsTxt;  // 0x0000
+  D2SkillStrc* pNextSkill;           // 0x0008
+  uint32_t dwSkillMode;              // 0x0010
+  uint32_t dwFlags;                  // 0x0014
+  char pad_0018[32];                 // 0x0018
+  uint32_t dwSkillLevel;             // 0x0038
+  char pad_003C[4];                  // 0x003C
+  int32_t nQuantity;                 // 0x0040
+  int32_t nOwnerId;                  // 0x0044
+  int32_t nCharges;                  // 0x0048
+  char pad_004C[4];                  // 0x004C
+};  // Size: 0x0050
+static_assert(sizeof(D2SkillStrc) == 0x50);
+static_assert(offsetof(D2SkillStrc, pSkillsTxt) == 0x0);
+static_assert(offsetof(D2SkillStrc, pNextSkill) == 0x8);
+static_assert(offsetof(D2SkillStrc, dwSkillMode) == 0x10);
+static_assert(offsetof(D2SkillStrc, dwFlags) == 0x14);
+static_assert(offsetof(D2SkillStrc, dwSkillLevel) == 0x38);
+static_assert(offsetof(D2SkillStrc, nQuantity) == 0x40);
+static_assert(offsetof(D2SkillStrc, nOwnerId) == 0x44);
+static_assert(offsetof(D2SkillStrc, nCharges) == 0x48);
+
+class D2SkillListStrc {
+ public:
+  D2SkillStrc* pFirstSkill;  // 0x0000
+  D2SkillStrc* pLeftSkill;   // 0x0008
+  D2SkillStrc* pRightSkill;  // 0x0010
+  D2SkillStrc* pUsedSkill;   // 0x0018
+};  // Size: 0x0020
+static_assert(sizeof(D2SkillListStrc) == 0x20);
+static_assert(offsetof(D2SkillListStrc, pFirstSkill) == 0x0);
+static_assert(offsetof(D2SkillListStrc, pLeftSkill) == 0x8);
+static_assert(offsetof(D2SkillListStrc, pRightSkill) == 0x10);
+static_assert(offsetof(D2SkillListStrc, pUsedSkill) == 0x18);
+
+class D2PlayerDataStrc {
+ public:
+  char szName[16];         // 0x0000
+  char pad_0010[48];       // 0x0010
+  void* pQuestData[3];     // 0x0040
+  void* pWaypointData[3];  // 0x0058
+  char pad_0070[8];        // 0x0070
+  uint32_t dwPortalFlags;  // 0x0078
+  char pad_007C[4];        // 0x007C
+};  // Size: 0x0080
+static_assert(sizeof(D2PlayerDataStrc) == 0x80);
+static_assert(offsetof(D2PlayerDataStrc, szName) == 0x0);
+static_assert(offsetof(D2PlayerDataStrc, pQuestData) == 0x40);
+static_assert(offsetof(D2PlayerDataStrc, pWaypointData) == 0x58);
+static_assert(offsetof(D2PlayerDataStrc, dwPortalFlags) == 0x78);
+
+class D2MonsterDataStrc {
+ public:
+  D2MonStatsTxt* pMonstatsTxt;  // 0x0000
+  char pad_0008[16];            // 0x0008
+  uint16_t wNameSeed;           // 0x0018
+  uint8_t nTypeFlag;            // 0x001A
+  uint8_t nLastAnimMode;        // 0x001B
+  uint32_t dwDurielFlag;        // 0x001C
+  uint8_t nMonUmod[10];         // 0x0020
+  uint16_t wBossHcIdx;          // 0x002A
+  char pad_002C[36];            // 0x002C
+  uint32_t dwOwnerType;         // 0x0050
+  uint32_t dwOwnerId;           // 0x0054
+};  // Size: 0x0058
+static_assert(sizeof(D2MonsterDataStrc) == 0x58);
+static_assert(offsetof(D2MonsterDataStrc, pMonstatsTxt) == 0x0);
+static_assert(offsetof(D2MonsterDataStrc, wNameSeed) == 0x18);
+static_assert(offsetof(D2MonsterDataStrc, nTypeFlag) == 0x1A);
+static_assert(offsetof(D2MonsterDataStrc, nLastAnimMode) == 0x1B);
+static_assert(offsetof(D2MonsterDataStrc, dwDurielFlag) == 0x1C);
+static_assert(offsetof(D2MonsterDataStrc, nMonUmod) == 0x20);
+static_assert(offsetof(D2MonsterDataStrc, wBossHcIdx) == 0x2A);
+static_assert(offsetof(D2MonsterDataStrc, dwOwnerType) == 0x50);
+static_assert(offsetof(D2MonsterDataStrc, dwOwnerId) == 0x54);
+
+class D2ObjectDataStrc {
+ public:
+  D2ObjectsTxt* pObjectTxt;  // 0x0000
+  uint8_t nInteractType;     // 0x0008
+  char pad_0009[7];          // 0x0009
+};  // Size: 0x0010
+static_assert(sizeof(D2ObjectDataStrc) == 0x10);
+static_assert(offsetof(D2ObjectDataStrc, pObjectTxt) == 0x0);
+static_assert(offsetof(D2ObjectDataStrc, nInteractType) == 0x8);
+
+class D2StaticPathStrc {
+ public:
+  char pad_0000[16];         // 0x0000
+  uint32_t dwPosX;           // 0x0010
+  uint32_t dwPosY;           // 0x0014
+  char pad_0018[8];          // 0x0018
+  D2ActiveRoomStrc* ptRoom;  // 0x0020
+};  // Size: 0x0028
+static_assert(sizeof(D2StaticPathStrc) == 0x28);
+static_assert(offsetof(D2StaticPathStrc, dwPosX) == 0x10);
+static_assert(offsetof(D2StaticPathStrc, dwPosY) == 0x14);
+static_assert(offsetof(D2StaticPathStrc, ptRoom) == 0x20);
+
+class D2StatStrc {
+ public:
+  uint16_t wLayer;   // 0x0000
+  uint16_t wStatId;  // 0x0002
+  int32_t nValue;    // 0x0004
+};  // Size: 0x0008
+static_assert(sizeof(D2StatStrc) == 0x8);
+static_assert(offsetof(D2StatStrc, wLayer) == 0x0);
+static_assert(offsetof(D2StatStrc, wStatId) == 0x2);
+static_assert(offsetof(D2StatStrc, nValue) == 0x4);
+
+class D2StatsArrayStrc {
+ public:
+  D2StatStrc* pStat;    // 0x0000
+  uint64_t nStatCount;  // 0x0008
+};  // Size: 0x0010
+static_assert(sizeof(D2StatsArrayStrc) == 0x10);
+static_assert(offsetof(D2StatsArrayStrc, pStat) == 0x0);
+static_assert(offsetof(D2StatsArrayStrc, nStatCount) == 0x8);
+
+class D2StatListExStrc {
+ public:
+  void* pMemPool;               // 0x0000
+  uint32_t dwOwnerType;         // 0x0008
+  uint32_t dwOwnerId;           // 0x000C
+  char pad_0010[12];            // 0x0010
+  uint32_t dwFlags;             // 0x001C
+  char pad_0020[16];            // 0x0020
+  D2StatsArrayStrc tBaseStats;  // 0x0030
+  char pad_0040[72];            // 0x0040
+  D2StatsArrayStrc tFullStats;  // 0x0088
+  char pad_0098[8];             // 0x0098
+};  // Size: 0x00A0
+static_assert(sizeof(D2StatListExStrc) == 0xA0);
+static_assert(offsetof(D2StatListExStrc, pMemPool) == 0x0);
+static_assert(offsetof(D2StatListExStrc, dwOwnerType) == 0x8);
+static_assert(offsetof(D2StatListExStrc, dwOwnerId) == 0xC);
+static_assert(offsetof(D2StatListExStrc, dwFlags) == 0x1C);
+static_assert(offsetof(D2StatListExStrc, tBaseStats) == 0x30);
+static_assert(offsetof(D2StatListExStrc, tFullStats) == 0x88);
+
+class D2InventoryStrc {
+ public:
+  uint32_t dwSignature;                  // 0x0000 kInventorySignature
+  char pad_0004[4];                      // 0x0004
+  void* pMemPool;                        // 0x0008
+  D2UnitStrc* pOwner;                    // 0x0010
+  D2UnitStrc* pFirstItem;                // 0x0018
+  D2UnitStrc* pLastItem;                 // 0x0020
+  /*D2InventoryGridStrc*/ void* pGrids;  // 0x0028
+  int32_t nGridCount;                    // 0x0030
+  uint32_t dwLeftItemGUID;               // 0x0034
+  D2UnitStrc* pCursorItem;               // 0x0038
+  uint32_t dwOwnerId;                    // 0x0040
+  uint32_t dwItemCount;                  // 0x0044
+};  // Size: 0x0048
+static_assert(sizeof(D2InventoryStrc) == 0x48);
+static_assert(offsetof(D2InventoryStrc, dwSignature) == 0x0);
+static_assert(offsetof(D2InventoryStrc, pMemPool) == 0x8);
+static_assert(offsetof(D2InventoryStrc, pOwner) == 0x10);
+static_assert(offsetof(D2InventoryStrc, pFirstItem) == 0x18);
+static_assert(offsetof(D2InventoryStrc, pLastItem) == 0x20);
+static_assert(offsetof(D2InventoryStrc, pGrids) == 0x28);
+static_assert(offsetof(D2InventoryStrc, nGridCount) == 0x30);
+static_assert(offsetof(D2InventoryStrc, dwLeftItemGUID) == 0x34);
+static_assert(offsetof(D2InventoryStrc, pCursorItem) == 0x38);
+static_assert(offsetof(D2InventoryStrc, dwOwnerId) == 0x40);
+static_assert(offsetof(D2InventoryStrc, dwItemCount) == 0x44);
+
+class D2ItemDataStrc {
+ public:
+  uint32_t dwQualityNo;              // 0x0000
+  D2SeedStrc tLoSeed;                // 0x0004
+  uint32_t dwOwnerGUID;              // 0x000C
+  char pad_0010[8];                  // 0x0010
+  uint32_t dwItemFlags;              // 0x0018
+  char pad_001C[28];                 // 0x001C
+  uint32_t dwItemLevel;              // 0x0038 always 1 for online
+  char pad_003C[4];                  // 0x003C
+  uint16_t wItemFormat;              // 0x0040
+  uint16_t wRarePrefix;              // 0x0042
+  uint16_t wRareSuffix;              // 0x0044
+  uint16_t wAutoAffix;               // 0x0046
+  uint16_t wMagicPrefix[3];          // 0x0048
+  uint16_t wMagicSuffix[3];          // 0x004E
+  uint8_t nBodyLoc;                  // 0x0054
+  uint8_t nInvPage;                  // 0x0055
+  char pad_0056[74];                 // 0x0056
+  D2InventoryStrc* pOwnerInventory;  // 0x00A0
+  D2UnitStrc* pPrevItem;             // 0x00A8
+  D2UnitStrc* pNextItem;             // 0x00B0
+  uint8_t nNodePos;                  // 0x00B8
+  uint8_t nNodePosOther;             // 0x00B9
+  char pad_00BA[6];                  // 0x00BA
+};  // Size: 0x00C0
+static_assert(sizeof(D2ItemDataStrc) == 0xC0);
+static_assert(offsetof(D2ItemDataStrc, dwQualityNo) == 0x0);
+static_assert(offsetof(D2ItemDataStrc, tLoSeed) == 0x4);
+static_assert(offsetof(D2ItemDataStrc, dwOwnerGUID) == 0xC);
+static_assert(offsetof(D2ItemDataStrc, dwItemFlags) == 0x18);
+static_assert(offsetof(D2ItemDataStrc, dwItemLevel) == 0x38);
+static_assert(offsetof(D2ItemDataStrc, wItemFormat) == 0x40);
+static_assert(offsetof(D2ItemDataStrc, wRarePrefix) == 0x42);
+static_assert(offsetof(D2ItemDataStrc, wRareSuffix) == 0x44);
+static_assert(offsetof(D2ItemDataStrc, wAutoAffix) == 0x46);
+static_assert(offsetof(D2ItemDataStrc, wMagicPrefix) == 0x48);
+static_assert(offsetof(D2ItemDataStrc, wMagicSuffix) == 0x4E);
+static_assert(offsetof(D2ItemDataStrc, nBodyLoc) == 0x54);
+static_assert(offsetof(D2ItemDataStrc, nInvPage) == 0x55);
+static_assert(offsetof(D2ItemDataStrc, pOwnerInventory) == 0xA0);
+static_assert(offsetof(D2ItemDataStrc, pPrevItem) == 0xA8);
+static_assert(offsetof(D2ItemDataStrc, pNextItem) == 0xB0);
+static_assert(offsetof(D2ItemDataStrc, nNodePos) == 0xB8);
+static_assert(offsetof(D2ItemDataStrc, nNodePosOther) == 0xB9);
+
+class D2UnitStrc {
+ public:
+  uint32_t dwUnitType;  // 0x0000
+  uint32_t dwClassId;   // 0x0004
+  uint32_t dwId;        // 0x0008
+  uint32_t dwMode;      // 0x000C
+  union                 // 0x0010
+  {
+    D2PlayerDataStrc* pPlayerData;    // 0x0000
+    D2MonsterDataStrc* pMonsterData;  // 0x0000
+    D2ItemDataStrc* pItemData;        // 0x0000
+    D2ObjectDataStrc* pObjectData;    // 0x0000
+  };
+  uint64_t dwAct;           // 0x0018
+  D2DrlgActStrc* pDrlgAct;  // 0x0020
+  D2SeedStrc tSeed;         // 0x0028
+  D2SeedStrc tInitSeed;     // 0x0030
+  union                     // 0x0038
+  {
+    D2DynamicPathStrc* pDynamicPath;  // 0x0000
+    D2StaticPathStrc* pStaticPath;    // 0x0000
+  };
+  char pad_0040[28];                         // 0x0040
+  uint32_t dwAnimSeqFrame;                   // 0x005C
+  uint32_t dwAnimSeqFrame2;                  // 0x0060
+  uint32_t dwAnimSeqFrameCount;              // 0x0064
+  uint32_t dwAnimSpeed;                      // 0x0068
+  char pad_006C[4];                          // 0x006C
+  /*D2AnimDataRecordStrc*/ void* pAnimData;  // 0x0070
+  /*D2GfxDataStrc*/ void* pGfxData;          // 0x0078
+  char pad_0080[8];                          // 0x0080
+  D2StatListExStrc* pStatListEx;             // 0x0088
+  D2InventoryStrc* pInventory;               // 0x0090
+  char pad_0098[40];                         // 0x0098
+  size_t pPacketList;                        // 0x00C0
+  char pad_00C8[12];                         // 0x00C8
+  uint16_t wPosX;                            // 0x00D4
+  uint16_t wPosY;                            // 0x00D6
+  uint64_t nResourceId;                      // 0x00D8
+  char pad_00E0[32];                         // 0x00E0
+  D2SkillListStrc* pSkills;                  // 0x0100
+  char pad_0108[28];                         // 0x0108
+  uint32_t dwFlags;                          // 0x0124
+  uint32_t dwFlagsEx;                        // 0x0128
+  char pad_012C[36];                         // 0x012C
+  D2UnitStrc* pChangeNextUnit;               // 0x0150
+  D2UnitStrc* pUnitNext;                     // 0x0158
+  D2UnitStrc* pRoomUnitNext;                 // 0x0160
+  char pad_0168[16];                         // 0x0168
+  uint32_t dwCollisionUnitType;              // 0x0178
+  uint32_t dwCollisionUnitClassId;           // 0x017C
+  uint32_t dwCollisionUnitSizeX;             // 0x0180
+  uint32_t dwCollisionUnitSizeY;             // 0x0184
+  char pad_0188[53];                         // 0x0188
+  uint8_t nDataTblsIndex;                    // 0x01BD
+  char pad_01BE[2];                          // 0x01BE
+};  // Size: 0x01C0
+static_assert(sizeof(D2UnitStrc) == 0x1C0);
+static_assert(offsetof(D2UnitStrc, dwUnitType) == 0x0);
+static_assert(offsetof(D2UnitStrc, dwClassId) == 0x4);
+static_assert(offsetof(D2UnitStrc, dwId) == 0x8);
+static_assert(offsetof(D2UnitStrc, dwMode) == 0xC);
+static_assert(offsetof(D2UnitStrc, pPlayerData) == 0x10);
+static_assert(offsetof(D2UnitStrc, pMonsterData) == 0x10);
+static_assert(offsetof(D2UnitStrc, pItemData) == 0x10);
+static_assert(offsetof(D2UnitStrc, pObjectData) == 0x10);
+static_assert(offsetof(D2UnitStrc, dwAct) == 0x18);
+static_assert(offsetof(D2UnitStrc, pDrlgAct) == 0x20);
+static_assert(offsetof(D2UnitStrc, tSeed) == 0x28);
+static_assert(offsetof(D2UnitStrc, tInitSeed) == 0x30);
+static_assert(offsetof(D2UnitStrc, pDynamicPath) == 0x38);
+static_assert(offsetof(D2UnitStrc, pStaticPath) == 0x38);
+static_assert(offsetof(D2UnitStrc, dwAnimSeqFrame) == 0x5C);
+static_assert(offsetof(D2UnitStrc, dwAnimSeqFrame2) == 0x60);
+static_assert(offsetof(D2UnitStrc, dwAnimSeqFrameCount) == 0x64);
+static_assert(offsetof(D2UnitStrc, dwAnimSpeed) == 0x68);
+static_assert(offsetof(D2UnitStrc, pAnimData) == 0x70);
+static_assert(offsetof(D2UnitStrc, pGfxData) == 0x78);
+static_assert(offsetof(D2UnitStrc, pStatListEx) == 0x88);
+static_assert(offsetof(D2UnitStrc, pInventory) == 0x90);
+static_assert(offsetof(D2UnitStrc, pPacketList) == 0xC0);
+static_assert(offsetof(D2UnitStrc, wPosX) == 0xD4);
+static_assert(offsetof(D2UnitStrc, wPosY) == 0xD6);
+static_assert(offsetof(D2UnitStrc, nResourceId) == 0xD8);
+static_assert(offsetof(D2UnitStrc, pSkills) == 0x100);
+static_assert(offsetof(D2UnitStrc, dwFlags) == 0x124);
+static_assert(offsetof(D2UnitStrc, dwFlagsEx) == 0x128);
+static_assert(offsetof(D2UnitStrc, pChangeNextUnit) == 0x150);
+static_assert(offsetof(D2UnitStrc, pUnitNext) == 0x158);
+static_assert(offsetof(D2UnitStrc, pRoomUnitNext) == 0x160);
+static_assert(offsetof(D2UnitStrc, dwCollisionUnitType) == 0x178);
+static_assert(offsetof(D2UnitStrc, dwCollisionUnitClassId) == 0x17C);
+static_assert(offsetof(D2UnitStrc, dwCollisionUnitSizeX) == 0x180);
+static_assert(offsetof(D2UnitStrc, dwCollisionUnitSizeY) == 0x184);
+static_assert(offsetof(D2UnitStrc, nDataTblsIndex) == 0x1BD);
+
+}  // namespace d2r
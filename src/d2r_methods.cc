@@ -1,8 +1,14 @@
 #include "d2r_methods.h"
 
 #include <dolos/pipe_log.h>
+#include "automap_cells.h"
 #include "d2r_structs.h"
+#include "data_tables.h"
+#include "metrics.h"
 #include "offsets.h"
+#include "safe_read.h"
+#include "trace.h"
+#include "unit_snapshot.h"
 
 #include <bit>
 #include <map>
@@ -16,25 +22,11 @@
 namespace d2r {
 
 D2UnitStrc* GetUnit(uint32_t id, uint32_t type) {
-  EntityHashTable* client_units = sgptClientSideUnitHashTable;
-  for (size_t i = id & 0x7F; i < kUnitHashTableCount; ++i) {
-    D2UnitStrc* current = client_units[type][i];
-    for (; current; current = current->pUnitNext) {
-      if (current->dwId == id) {
-        return current;
-      }
-    }
-  }
-  return nullptr;
+  SafeReader reader;
+  return FindUnit(sgptClientSideUnitHashTable[type], id, reader);
 }
 
-uint32_t GetPlayerId(uint32_t index) {
-  if (index < 0 || index >= 8) {
-    return 0;
-  };
-
-  uint32_t key = *(uint32_t*)(*EncEncryptionKeys + 0x146);
-  uint32_t encrypted = PlayerIndexToIDEncryptedTable[index];
+static uint32_t DecryptPlayerId(uint32_t encrypted, uint32_t key) {
   // TODO: find xor values using patterns
   uint32_t temp = (encrypted ^ key ^ 0x8633C320) + 0x53D5CDD3;
   uint32_t v = std::rotl(std::rotl(temp, 9), 7);
@@ -48,12 +40,84 @@ uint32_t GetPlayerId(uint32_t index) {
   return id;
 }
 
+// upper bound for the units a roster revalidation steps over, guards against a chain that was relinked into a cycle
+constexpr uint32_t kMaxRosterProbeSteps = 0x10000;
+
+static std::array<PlayerRosterEntry, kMaxPlayers> s_roster{};
+static std::array<uint32_t, kMaxPlayers> s_encrypted_ids{};
+static uint32_t s_roster_key = 0;
+static bool s_roster_valid = false;
+
+// Decrypts the ids again if the encrypted table or the key changed since the last call, which drops the cached units
+// of every slot. No unit is looked up.
+static void RefreshPlayerIds() {
+  uint32_t key = *(uint32_t*)(*EncEncryptionKeys + 0x146);
+  bool ids_changed = !s_roster_valid || key != s_roster_key;
+  for (uint32_t i = 0; i < kMaxPlayers && !ids_changed; ++i) {
+    ids_changed = PlayerIndexToIDEncryptedTable[i] != s_encrypted_ids[i];
+  }
+  if (!ids_changed) {
+    return;
+  }
+  s_roster_key = key;
+  for (uint32_t i = 0; i < kMaxPlayers; ++i) {
+    s_encrypted_ids[i] = PlayerIndexToIDEncryptedTable[i];
+    s_roster[i] = {DecryptPlayerId(s_encrypted_ids[i], key), nullptr};
+  }
+  s_roster_valid = true;
+}
+
+// true if GetUnit() would still return |unit| for |id|. Takes the same probe, from the id's bucket on into the
+// following ones, but only compares pointers until it reaches |unit|, so a freed unit is never dereferenced. Must be
+// called with the game lock held, like the game's own lookups.
+static bool IsLinkedPlayerUnit(D2UnitStrc* unit, uint32_t id) {
+  uint32_t steps = 0;
+  for (size_t i = id & 0x7F; i < kUnitHashTableCount; ++i) {
+    for (D2UnitStrc* current = sgptClientSideUnitHashTable[0][i]; current; current = current->pUnitNext) {
+      if (current == unit) {
+        return current->dwId == id;
+      }
+      // GetUnit would stop at another unit with the id first
+      if (current->dwId == id || ++steps == kMaxRosterProbeSteps) {
+        return false;
+      }
+    }
+  }
+  return false;
+}
+
+// The unit of |entry|, revalidating the cached one and only searching the hash table again when it is gone.
+static D2UnitStrc* ResolvePlayerUnit(PlayerRosterEntry& entry) {
+  if (entry.id == 0) {
+    entry.unit = nullptr;
+  } else if (entry.unit == nullptr || !IsLinkedPlayerUnit(entry.unit, entry.id)) {
+    entry.unit = GetUnit(entry.id, 0);
+  }
+  return entry.unit;
+}
+
+const std::array<PlayerRosterEntry, kMaxPlayers>& GetPlayerRoster() {
+  RefreshPlayerIds();
+  for (PlayerRosterEntry& entry : s_roster) {
+    ResolvePlayerUnit(entry);
+  }
+  return s_roster;
+}
+
+uint32_t GetPlayerId(uint32_t index) {
+  if (index < 0 || index >= kMaxPlayers) {
+    return 0;
+  };
+  RefreshPlayerIds();
+  return s_roster[index].id;
+}
+
 D2UnitStrc* GetPlayerUnit(uint32_t index) {
-  uint32_t id = GetPlayerId(index);
-  if (id == 0) {
+  if (index < 0 || index >= kMaxPlayers) {
     return nullptr;
-  }
-  return GetUnit(id, 0);
+  };
+  RefreshPlayerIds();
+  return ResolvePlayerUnit(s_roster[index]);
 }
 
 static void* D2Alloc(size_t size, size_t align = 0x10) {
@@ -68,6 +132,7 @@ static void* D2Alloc(size_t size, size_t align = 0x10) {
 }
 
 static D2AutomapLayerStrc* InitAutomapLayer(int32_t layer_id) {
+  TRACE_SPAN("InitAutomapLayer");
   D2AutomapLayerStrc* link = *s_automapLayerLink;
   D2AutomapLayerStrc* current = *s_currentAutomapLayer;
   if (link != nullptr) {
@@ -132,13 +197,13 @@ static void RevealAutomapCells(uint8_t datatbls_index,
                                D2DrlgTileDataStrc* tile_data,
                                D2DrlgRoomStrc* drlg_room,
                                D2LinkedList<D2AutomapCellStrc>* cells) {
-  D2LevelDefBin* level_def;
+  const D2LevelDefBin* level_def;
 
   if ((tile_data->dwFlags & 0x40000) != 0) {
     return;  // already revealed
   }
   tile_data->dwFlags |= 0x40000;  // set revealed flag
-  level_def = GetLevelDef(datatbls_index, drlg_room->ptLevel->eLevelId);
+  level_def = FindLevelDef(datatbls_index, drlg_room->ptLevel->eLevelId);
   uint32_t cell_id = DATATBLS_GetAutomapCellId(
       level_def->dwLevelType, tile_data->ptTile->nType, tile_data->ptTile->nStyle, tile_data->ptTile->nSequence);
 
@@ -148,27 +213,16 @@ static void RevealAutomapCells(uint8_t datatbls_index,
 
   int32_t x = tile_data->nPosX + drlg_room->tRoomCoords.nBackCornerTileX;
   int32_t y = tile_data->nPosY + drlg_room->tRoomCoords.nBackCornerTileY;
-  int32_t absx = 80 * (x - y);
-  int32_t absy = (80 * (y + x)) >> 1;
-  if (tile_data->nTileCount >= 16) {
-    absx += 24;
-    absy += 24;
-  }
-
-  auto pack_coords = [](int32_t low, int32_t high) -> uint64_t {
-    return (static_cast<uint64_t>(high / 10) << 32) | static_cast<uint32_t>(low / 10);
-  };
-  auto get_low_value = [](uint64_t value) -> int32_t { return (value << 32) >> 32; };
-  auto get_high_value = [](uint64_t value) -> int32_t { return value >> 32; };
-
-  int64_t packed = pack_coords(absx, absy);
-  if (get_low_value(packed) + 0x8000 > 0xFFFF) {
-    PIPE_LOG("low value out of bounds");
-    return;
-  }
-  if (get_high_value(packed) + 0x8000 > 0xFFFF) {
-    PIPE_LOG("high value out of bounds");
-    return;
+  int64_t packed;
+  switch (PackAutomapCellCoords(x, y, tile_data->nTileCount >= 16, &packed)) {
+    case AutomapPackResult::kOk:
+      break;
+    case AutomapPackResult::kLowOutOfBounds:
+      PIPE_LOG("low value out of bounds");
+      return;
+    case AutomapPackResult::kHighOutOfBounds:
+      PIPE_LOG("high value out of bounds");
+      return;
   }
   if (cell_id + 0x8000 > 0xFFFF) {
     PIPE_LOG("cell_id out of bounds");
@@ -241,6 +295,7 @@ static void RevealRoom(uint8_t datatbls_index,
                        D2ActiveRoomStrc* hRoom,
                        int32_t reveal_entire_room,
                        D2AutomapLayerStrc* layer) {
+  TRACE_SPAN("RevealRoom");
   D2DrlgRoomTilesStrc* tiles = hRoom->ptRoomTiles;
   D2DrlgRoomStrc* drlg_room = hRoom->ptDrlgRoom;
   if (tiles && tiles->nFloors > 0) {
@@ -263,11 +318,12 @@ static void RevealRoom(uint8_t datatbls_index,
 }
 
 bool AutomapReveal(D2ActiveRoomStrc* hRoom) {
+  TRACE_SPAN("AutomapReveal");
   D2UnitStrc* player = GetPlayerUnit(*s_PlayerUnitIndex);
   uint8_t datatbls_index = 0;
   uint32_t current_layer_id = -1;
   uint32_t level_id = 0;
-  D2LevelDefBin* level_def = nullptr;
+  const D2LevelDefBin* level_def = nullptr;
   D2AutomapLayerStrc* inited = nullptr;
   D2AutomapLayerStrc* current = *s_currentAutomapLayer;
 
@@ -283,7 +339,7 @@ bool AutomapReveal(D2ActiveRoomStrc* hRoom) {
     level_id = hRoom->ptDrlgRoom->ptLevel->eLevelId;
   }
 
-  level_def = GetLevelDef(datatbls_index, level_id);
+  level_def = FindLevelDef(datatbls_index, level_id);
   inited = InitAutomapLayer(level_def->dwLayer);
   if (inited == nullptr) {
     return false;
@@ -298,6 +354,7 @@ bool AutomapReveal(D2ActiveRoomStrc* hRoom) {
 }
 
 bool RevealLevelById(uint32_t id) {
+  TRACE_SPAN("RevealLevelById");
   if (id <= 0 || id >= 137) {
     return false;
   }
@@ -320,8 +377,9 @@ bool RevealLevelById(uint32_t id) {
     return false;
   }
 
+  SafeReader reader;
   D2DrlgLevelStrc* level;
-  for (level = drlg->ptLevel; level; level = level->ptNextLevel) {
+  for (level = reader.Check(drlg->ptLevel); level; level = reader.Check(level->ptNextLevel)) {
     if (level->eLevelId == id && level->tCoords.nBackCornerTileX > 0) {
       break;
     }
@@ -348,6 +406,7 @@ bool RevealLevelById(uint32_t id) {
       PIPE_LOG("Unsupported revealing level in another act ({})", id);
       return false;
     }
+    TRACE_SPAN("DRLG_InitLevel");
     reinterpret_cast<void (*)(uint8_t, D2DrlgLevelStrc*)>(DRLG_InitLevel)(player->nDataTblsIndex, level);
     if (level->ptRoomFirst == nullptr) {
       PIPE_LOG("Failed to init level");
@@ -357,6 +416,7 @@ bool RevealLevelById(uint32_t id) {
   RetcheckFunction pfnAutomap(reinterpret_cast<void (*)(D2ActiveRoomStrc*)>(drlg->pfnAutomap));
   for (D2DrlgRoomStrc* drlg_room = level->ptRoomFirst; drlg_room; drlg_room = drlg_room->ptDrlgRoomNext) {
     if (drlg_room->hRoom == nullptr) {
+      TRACE_SPAN("ROOMS_AddRoomData");
       ROOMS_AddRoomData(player->nDataTblsIndex,
                         drlg_room->ptLevel->ptDrlg->ptAct,
                         drlg_room->ptLevel->eLevelId,
@@ -369,6 +429,7 @@ bool RevealLevelById(uint32_t id) {
       return false;
     }
     pfnAutomap(drlg_room->hRoom);
+    Metrics::Add(Metric::RoomsRevealed);
   }
   return true;
 }
@@ -2,11 +2,25 @@
 
 #include "d2r_structs.h"
 
+#include <array>
+
 namespace d2r {
 
+constexpr uint32_t kMaxPlayers = 8;
+
+struct PlayerRosterEntry {
+  uint32_t id;  // 0 if the slot is empty
+  D2UnitStrc* unit;
+};
+
 D2UnitStrc* GetUnit(uint32_t id, uint32_t type);
 uint32_t GetPlayerId(uint32_t index);
 D2UnitStrc* GetPlayerUnit(uint32_t index);
+// Decrypted ids and units of all player slots. Ids are cached until the encrypted table or the key changes, units
+// are cached next to them and revalidated against the hash table on every call, GetUnit() only runs when a cached
+// unit is no longer linked. GetPlayerId() resolves no unit, GetPlayerUnit() only the one slot. Must be called with
+// the game lock held.
+const std::array<PlayerRosterEntry, kMaxPlayers>& GetPlayerRoster();
 bool AutomapReveal(D2ActiveRoomStrc* hRoom);
 bool RevealLevelById(uint32_t id);
 
@@ -0,0 +1,187 @@
+#include "data_tables.h"
+
+#include "safe_read.h"
+#include "unit_snapshot.h"
+
+#include <dolos/pipe_log.h>
+
+#include <array>
+#include <chrono>
+#include <utility>
+
+namespace d2r {
+
+// sanity bound for the txt record counts, the largest table has a few thousand rows
+constexpr int32_t kMaxRecordCount = 0x10000;
+constexpr std::size_t kDataTblsIndexCount = 0x100;
+// units whose txt row pointer has to match their class id before a table is trusted
+constexpr uint32_t kVerifySamples = 4;
+constexpr std::size_t kMaxVerifyChain = 0x100;
+// a table waiting for units to verify it is checked again at most this often
+constexpr uint64_t kVerifyIntervalMs = 1000;
+
+static std::array<DataTableSet, kDataTblsIndexCount> s_tables;
+static std::array<bool, kDataTblsIndexCount> s_resolved;
+// Txt tables whose stride is only the reversed row size, moved to s_tables once units confirm it. Bits of
+// |s_unverified| are DataTableIds still waiting for a unit.
+static std::array<DataTableSet, kDataTblsIndexCount> s_candidates;
+static std::array<uint32_t, kDataTblsIndexCount> s_unverified;
+static std::array<uint64_t, kDataTblsIndexCount> s_verified_ms;
+
+enum class TableCheck {
+  kNoUnits,
+  kMatch,
+  kMismatch,
+};
+
+// The txt row |unit|'s data points at, nullptr if it is not readable.
+static const void* TxtRow(DataTableId id, const D2UnitStrc* unit, SafeReader& reader) {
+  if (id == DataTableId::kMonStats) {
+    const D2MonsterDataStrc* data = reader.Check(unit->pMonsterData);
+    return data ? data->pMonstatsTxt : nullptr;
+  }
+  const D2ObjectDataStrc* data = reader.Check(unit->pObjectData);
+  return data ? data->pObjectTxt : nullptr;
+}
+
+// Checks |table| against the units of |type| in the client unit table: a unit's txt row pointer has to be row
+// dwClassId. Class 0 is skipped, its row is the table start whatever the stride.
+static TableCheck CheckRowPointers(const DataTable& table,
+                                   DataTableId id,
+                                   uint32_t type,
+                                   uint8_t datatbls_index,
+                                   SafeReader& reader) {
+  if (sgptClientSideUnitHashTable == nullptr ||
+      !reader.IsReadable(&sgptClientSideUnitHashTable[type], sizeof(EntityHashTable))) {
+    return TableCheck::kNoUnits;
+  }
+  uint32_t matched = 0;
+  for (std::size_t bucket = 0; bucket < kUnitHashTableCount && matched < kVerifySamples; ++bucket) {
+    const D2UnitStrc* unit = reader.Check(sgptClientSideUnitHashTable[type][bucket]);
+    for (std::size_t length = 0; unit && length < kMaxVerifyChain; ++length, unit = reader.Check(unit->pUnitNext)) {
+      if (unit->dwUnitType != type || unit->nDataTblsIndex != datatbls_index || unit->dwClassId == 0) {
+        continue;
+      }
+      const void* row = TxtRow(id, unit, reader);
+      if (row == nullptr) {
+        continue;
+      }
+      if (table.IndexOf(row) != static_cast<int32_t>(unit->dwClassId)) {
+        return TableCheck::kMismatch;
+      }
+      ++matched;
+    }
+  }
+  return matched ? TableCheck::kMatch : TableCheck::kNoUnits;
+}
+
+// Publishes the candidate tables of |datatbls_index| the units confirm, drops the ones they contradict.
+static void VerifyCandidates(uint8_t datatbls_index) {
+  uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                           std::chrono::steady_clock::now().time_since_epoch())
+                                           .count());
+  if (now - s_verified_ms[datatbls_index] < kVerifyIntervalMs) {
+    return;
+  }
+  s_verified_ms[datatbls_index] = now;
+
+  SafeReader reader;
+  constexpr std::pair<DataTableId, uint32_t> kChecks[] = {{DataTableId::kMonStats, kUnitMonster},
+                                                          {DataTableId::kObjects, kUnitObject}};
+  for (auto [id, type] : kChecks) {
+    const uint32_t bit = 1u << static_cast<uint32_t>(id);
+    if ((s_unverified[datatbls_index] & bit) == 0) {
+      continue;
+    }
+    const DataTable& candidate = s_candidates[datatbls_index][id];
+    TableCheck check = CheckRowPointers(candidate, id, type, datatbls_index, reader);
+    if (check == TableCheck::kNoUnits) {
+      continue;
+    }
+    s_unverified[datatbls_index] &= ~bit;
+    if (check == TableCheck::kMatch) {
+      s_tables[datatbls_index].tables[static_cast<uint32_t>(id)] = candidate;
+      PIPE_LOG_INFO("[DataTables] Index {}: table {} verified, {} rows of 0x{:X} bytes", datatbls_index,
+                    static_cast<uint32_t>(id), candidate.count, candidate.stride);
+    } else {
+      PIPE_LOG_WARN("[DataTables] Index {}: row pointers of table {} do not match a 0x{:X} byte stride, disabled",
+                    datatbls_index, static_cast<uint32_t>(id), candidate.stride);
+    }
+  }
+}
+
+template <typename Row>
+static DataTable MakeTable(const Row* rows, int32_t count, SafeReader& reader) {
+  if (rows == nullptr || count <= 0 || count > kMaxRecordCount || !reader.IsReadable(rows, sizeof(Row) * count)) {
+    return {};
+  }
+  return {reinterpret_cast<const uint8_t*>(rows), sizeof(Row), static_cast<uint32_t>(count)};
+}
+
+// Returns false while the game has not loaded the tables, |set| is left empty if the layout does not match.
+static bool Resolve(uint8_t datatbls_index, DataTableSet* set) {
+  if (GetLevelDef == nullptr || sgptDataTbls == nullptr) {
+    return false;
+  }
+  const D2LevelDefBin* first = GetLevelDef(datatbls_index, 0);
+  if (first == nullptr) {
+    return false;
+  }
+
+  SafeReader reader;
+  D2DataTablesStrc* const* slot = &sgptDataTbls[datatbls_index];
+  const D2DataTablesStrc* tables = reader.IsReadable(slot, sizeof(*slot)) ? reader.Check(*slot) : nullptr;
+  // only ask GetLevelDef for ids the layout claims exist, it is not known to bounds-check them
+  int32_t level_count = tables ? tables->nLevelsTxtRecordCount : 0;
+  if (tables == nullptr || tables->pLevelDefBin != first || level_count <= 0 || level_count > kMaxRecordCount ||
+      GetLevelDef(datatbls_index, level_count - 1) != first + (level_count - 1)) {
+    PIPE_LOG_WARN("[DataTables] D2DataTablesStrc of index {} does not match GetLevelDef, tables disabled",
+                  datatbls_index);
+    return true;
+  }
+
+  // The level rows were just checked against GetLevelDef. The txt strides are only the reversed row sizes, those
+  // tables wait until units confirm them (VerifyCandidates). No unit points at its items.txt row, so the items
+  // table has no such check and stays unresolved.
+  set->tables[static_cast<uint32_t>(DataTableId::kLevelDefs)] = MakeTable(first, level_count, reader);
+  DataTableSet& candidates = s_candidates[datatbls_index];
+  candidates.tables[static_cast<uint32_t>(DataTableId::kMonStats)] =
+      MakeTable(tables->pMonStatsTxt, tables->nMonStatsTxtRecordCount, reader);
+  candidates.tables[static_cast<uint32_t>(DataTableId::kObjects)] =
+      MakeTable(tables->pObjectsTxt, tables->nObjectsTxtRecordCount, reader);
+  for (DataTableId id : {DataTableId::kMonStats, DataTableId::kObjects}) {
+    if (candidates[id].count) {
+      s_unverified[datatbls_index] |= 1u << static_cast<uint32_t>(id);
+    }
+  }
+  PIPE_LOG_INFO("[DataTables] Index {}: {} levels, {} monstats and {} objects to verify",
+                datatbls_index,
+                (*set)[DataTableId::kLevelDefs].count,
+                candidates[DataTableId::kMonStats].count,
+                candidates[DataTableId::kObjects].count);
+  return true;
+}
+
+const DataTableSet* GetDataTables(uint8_t datatbls_index) {
+  if (!s_resolved[datatbls_index]) {
+    if (!Resolve(datatbls_index, &s_tables[datatbls_index])) {
+      return nullptr;
+    }
+    s_resolved[datatbls_index] = true;
+  }
+  if (s_unverified[datatbls_index]) {
+    VerifyCandidates(datatbls_index);
+  }
+  return &s_tables[datatbls_index];
+}
+
+const D2LevelDefBin* FindLevelDef(uint8_t datatbls_index, uint32_t level_id) {
+  if (const DataTableSet* tables = GetDataTables(datatbls_index)) {
+    if (const D2LevelDefBin* level_def = tables->LevelDef(level_id)) {
+      return level_def;
+    }
+  }
+  return GetLevelDef(datatbls_index, level_id);
+}
+
+}  // namespace d2r
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "d2r_structs.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace d2r {
+
+// Tables resolved by GetDataTables(), mirrored by DataTableIds in lib/d2r/data-tables.js.
+enum class DataTableId : uint32_t {
+  kLevelDefs = 0,  // D2LevelDefBin, by level id
+  kMonStats = 1,   // D2MonStatsTxt, by monster class id (D2MonsterDataStrc::pMonstatsTxt points into it)
+  kObjects = 2,    // D2ObjectsTxt, by object class id (D2ObjectDataStrc::pObjectTxt points into it)
+  kItems = 3,      // D2ItemsTxt, by item class id. Never resolved, its stride cannot be verified
+  kCount,
+};
+constexpr uint32_t kDataTableCount = static_cast<uint32_t>(DataTableId::kCount);
+
+// Rows of one table. The tables are loaded with the game's data files and never move afterwards.
+struct DataTable {
+  const uint8_t* rows = nullptr;
+  uint32_t stride = 0;
+  uint32_t count = 0;
+
+  const void* Row(uint32_t index) const {
+    return index < count ? rows + static_cast<std::size_t>(index) * stride : nullptr;
+  }
+
+  // Row index of |row|, -1 if it does not point at the start of a row of this table.
+  int32_t IndexOf(const void* row) const {
+    uintptr_t offset = reinterpret_cast<uintptr_t>(row) - reinterpret_cast<uintptr_t>(rows);
+    if (rows == nullptr || offset >= static_cast<uintptr_t>(count) * stride || offset % stride != 0) {
+      return -1;
+    }
+    return static_cast<int32_t>(offset / stride);
+  }
+};
+
+struct DataTableSet {
+  DataTable tables[kDataTableCount];
+
+  const DataTable& operator[](DataTableId id) const { return tables[static_cast<uint32_t>(id)]; }
+
+  const D2LevelDefBin* LevelDef(uint32_t level_id) const {
+    return static_cast<const D2LevelDefBin*>((*this)[DataTableId::kLevelDefs].Row(level_id));
+  }
+};
+
+// Tables of |datatbls_index| (D2UnitStrc::nDataTblsIndex), resolved from sgptDataTbls on first use and cached.
+// The level table is taken from GetLevelDef, the others only if the D2DataTablesStrc layout agrees with it. The
+// monstats and objects tables are empty until the txt row pointers of loaded units confirm their strides, items are
+// never resolved (nothing to check them against). Returns null while the game has not loaded its data tables yet.
+// Must be called from the game thread or with the game lock held.
+const DataTableSet* GetDataTables(uint8_t datatbls_index);
+
+// GetLevelDef through the cached level table, falls back to the game function while the tables are not resolved.
+const D2LevelDefBin* FindLevelDef(uint8_t datatbls_index, uint32_t level_id);
+
+}  // namespace d2r
@@ -0,0 +1,194 @@
+#include "frame_hook.h"
+
+#include <Windows.h>
+#include <d3d11.h>
+#include <dolos/pipe_log.h>
+#include <dxgi1_2.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace d2r {
+
+// IDXGISwapChain vtable slots: IUnknown (3), IDXGIObject (4), IDXGIDeviceSubObject (1), then Present.
+// IDXGISwapChain1::Present1 follows the 10 IDXGISwapChain and 11 IDXGISwapChain1 methods before it.
+constexpr std::size_t kPresentSlot = 8;
+constexpr std::size_t kPresent1Slot = 22;
+
+using PresentFn = HRESULT(STDMETHODCALLTYPE*)(IDXGISwapChain*, UINT, UINT);
+using Present1Fn = HRESULT(STDMETHODCALLTYPE*)(IDXGISwapChain1*, UINT, UINT, const DXGI_PRESENT_PARAMETERS*);
+
+static void** s_present_slot = nullptr;
+static void** s_present1_slot = nullptr;
+static PresentFn s_present = nullptr;
+static Present1Fn s_present1 = nullptr;
+// longest Shutdown waits for the hooks that already entered, a present blocks for a vblank or two at most
+constexpr auto kDrainTimeout = std::chrono::milliseconds(500);
+
+// hooks between their entry and the return of the original, Shutdown waits for them to leave
+static std::atomic<uint32_t> s_in_flight{0};
+
+// Counts a hook in s_in_flight for as long as it runs.
+class InFlight {
+ public:
+  InFlight() { s_in_flight.fetch_add(1, std::memory_order_acquire); }
+  ~InFlight() { s_in_flight.fetch_sub(1, std::memory_order_release); }
+  InFlight(const InFlight&) = delete;
+  InFlight& operator=(const InFlight&) = delete;
+};
+
+static HRESULT STDMETHODCALLTYPE PresentHook(IDXGISwapChain* swap_chain, UINT sync_interval, UINT flags) {
+  InFlight in_flight;
+  // DXGI_PRESENT_TEST only checks occlusion, nothing is shown
+  if ((flags & DXGI_PRESENT_TEST) == 0) {
+    FrameHook::OnPresent();
+  }
+  return s_present(swap_chain, sync_interval, flags);
+}
+
+static HRESULT STDMETHODCALLTYPE Present1Hook(IDXGISwapChain1* swap_chain, UINT sync_interval, UINT flags,
+                                              const DXGI_PRESENT_PARAMETERS* parameters) {
+  InFlight in_flight;
+  if ((flags & DXGI_PRESENT_TEST) == 0) {
+    FrameHook::OnPresent();
+  }
+  return s_present1(swap_chain, sync_interval, flags, parameters);
+}
+
+// Swaps the function pointer in |slot| (read-only vtable memory of dxgi.dll) for |hook|, returns the previous one.
+static void* SwapSlot(void** slot, void* hook) {
+  DWORD protection;
+  if (!VirtualProtect(slot, sizeof(void*), PAGE_READWRITE, &protection)) {
+    return nullptr;
+  }
+  void* previous = InterlockedExchangePointer(slot, hook);
+  VirtualProtect(slot, sizeof(void*), protection, &protection);
+  FlushInstructionCache(GetCurrentProcess(), slot, sizeof(void*));
+  return previous;
+}
+
+// Vtable of dxgi's swap chain implementation, taken from a throwaway swap chain on a hidden window. Every swap chain
+// of the process shares it whichever device created it, the game's D3D12 one included.
+static void** FindSwapChainVtable() {
+  HWND window = CreateWindowExW(0, L"STATIC", L"", WS_OVERLAPPED, 0, 0, 8, 8, nullptr, nullptr, nullptr, nullptr);
+  if (window == nullptr) {
+    PIPE_LOG_ERROR("FrameHook: failed to create the dummy window ({})", GetLastError());
+    return nullptr;
+  }
+
+  DXGI_SWAP_CHAIN_DESC desc = {};
+  desc.BufferCount = 1;
+  desc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+  desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+  desc.OutputWindow = window;
+  desc.SampleDesc.Count = 1;
+  desc.Windowed = TRUE;
+  desc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
+
+  IDXGISwapChain* swap_chain = nullptr;
+  ID3D11Device* device = nullptr;
+  ID3D11DeviceContext* device_context = nullptr;
+  HRESULT hr = E_FAIL;
+  for (D3D_DRIVER_TYPE driver : {D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP}) {
+    hr = D3D11CreateDeviceAndSwapChain(nullptr, driver, nullptr, 0, nullptr, 0, D3D11_SDK_VERSION, &desc,
+                                       &swap_chain, &device, nullptr, &device_context);
+    if (SUCCEEDED(hr)) {
+      break;
+    }
+  }
+
+  void** vtable = nullptr;
+  if (SUCCEEDED(hr)) {
+    vtable = *reinterpret_cast<void***>(swap_chain);
+    swap_chain->Release();
+    device_context->Release();
+    device->Release();
+  } else {
+    PIPE_LOG_ERROR("FrameHook: failed to create the dummy swap chain (0x{:08X})", static_cast<uint32_t>(hr));
+  }
+  DestroyWindow(window);
+  return vtable;
+}
+
+bool FrameHook::Initialize() {
+  if (IsActive()) {
+    return true;
+  }
+
+  void** vtable = FindSwapChainVtable();
+  if (vtable == nullptr) {
+    return false;
+  }
+  s_present_slot = &vtable[kPresentSlot];
+  s_present1_slot = &vtable[kPresent1Slot];
+  // the originals must be in place before a hook can run
+  s_present = reinterpret_cast<PresentFn>(*s_present_slot);
+  s_present1 = reinterpret_cast<Present1Fn>(*s_present1_slot);
+  if (SwapSlot(s_present_slot, reinterpret_cast<void*>(&PresentHook)) == nullptr) {
+    PIPE_LOG_ERROR("FrameHook: failed to patch Present");
+    return false;
+  }
+  if (SwapSlot(s_present1_slot, reinterpret_cast<void*>(&Present1Hook)) == nullptr) {
+    PIPE_LOG_WARN("FrameHook: failed to patch Present1, only Present is counted");
+    s_present1_slot = nullptr;
+  }
+
+  active_.store(true, std::memory_order_relaxed);
+  PIPE_LOG_TRACE("FrameHook: installed (vtable {:p})", static_cast<void*>(vtable));
+  return true;
+}
+
+void FrameHook::Shutdown() {
+  if (!IsActive()) {
+    return;
+  }
+  // no new calls enter the hooks once the originals are back in the vtable, the ones inside still run code of this
+  // module (and the original they are blocked in returns to it), so the module must not go away before they leave
+  SwapSlot(s_present_slot, reinterpret_cast<void*>(s_present));
+  if (s_present1_slot) {
+    SwapSlot(s_present1_slot, reinterpret_cast<void*>(s_present1));
+  }
+  active_.store(false, std::memory_order_relaxed);
+
+  auto deadline = std::chrono::steady_clock::now() + kDrainTimeout;
+  while (s_in_flight.load(std::memory_order_acquire) != 0) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      PIPE_LOG_WARN("FrameHook: {} present calls still inside the hooks", s_in_flight.load());
+      break;
+    }
+    std::this_thread::yield();
+  }
+  PIPE_LOG_TRACE("FrameHook: removed");
+}
+
+void FrameHook::OnPresent() {
+  using namespace std::chrono;
+  const int64_t now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+  const int64_t previous = present_ns_.exchange(now, std::memory_order_relaxed);
+  if (previous != 0) {
+    // 1/8 of each new interval, a hitch shifts the estimate for a few frames only
+    const int64_t interval = interval_ns_.load(std::memory_order_relaxed);
+    const int64_t sample = now - previous;
+    interval_ns_.store(interval == 0 ? sample : interval + (sample - interval) / 8, std::memory_order_relaxed);
+  }
+  frame_.fetch_add(1, std::memory_order_release);
+}
+
+uint32_t FrameHook::MsUntilNextFrame(uint32_t cap_ms) {
+  using namespace std::chrono;
+  const int64_t present = present_ns_.load(std::memory_order_relaxed);
+  const int64_t interval = interval_ns_.load(std::memory_order_relaxed);
+  if (present == 0 || interval == 0) {
+    return 0;
+  }
+  const int64_t now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+  const int64_t remaining = present + interval - now;
+  if (remaining <= 0) {
+    return 0;
+  }
+  // rounded up, a timer that fires just before the present finds the old frame and has to be armed again
+  return static_cast<uint32_t>(std::min<int64_t>((remaining + 999'999) / 1'000'000, cap_ms));
+}
+
+}  // namespace d2r
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace d2r {
+
+// Counts the frames the game presents. Initialize swaps IDXGISwapChain::Present and IDXGISwapChain1::Present1 in
+// dxgi's swap chain vtable (shared by every swap chain of the process, including the game's) for hooks that bump
+// the frame counter and time the frames before presenting, so scripts can tick once per frame instead of on a timer
+// that drifts against the frame rate. The render thread never waits on or wakes the script thread, scripts arm
+// their timer for the next expected present (MsUntilNextFrame) and read the counter when it fires.
+class FrameHook {
+ public:
+  static bool Initialize();
+  static void Shutdown();
+
+  static bool IsActive() { return active_.load(std::memory_order_relaxed); }
+
+  // frames presented since Initialize
+  static uint64_t frame() { return frame_.load(std::memory_order_acquire); }
+
+  // Milliseconds until the next frame is expected, from the time of the last present and the average frame
+  // interval. 0 if it is due already or no frame was timed yet, capped at |cap_ms| for a stalled render thread.
+  static uint32_t MsUntilNextFrame(uint32_t cap_ms);
+
+  // called by the Present hooks on the render thread
+  static void OnPresent();
+
+ private:
+  static inline std::atomic<bool> active_{false};
+  static inline std::atomic<uint64_t> frame_{0};
+  // steady clock nanoseconds of the last present and the moving average of the intervals, render thread writes
+  static inline std::atomic<int64_t> present_ns_{0};
+  static inline std::atomic<int64_t> interval_ns_{0};
+};
+
+}  // namespace d2r
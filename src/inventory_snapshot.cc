@@ -0,0 +1,83 @@
+#include "inventory_snapshot.h"
+
+namespace d2r {
+
+// an inventory holds a few hundred items at most (stash tabs included), anything longer is a corrupted list
+constexpr std::size_t kMaxInventoryItems = 0x1000;
+
+static uint32_t Diff(const InventoryEntry& previous, const InventoryEntry& current) {
+  uint32_t changed = 0;
+  if (previous.page != current.page || previous.x != current.x || previous.y != current.y ||
+      previous.body_location != current.body_location || previous.node_pos != current.node_pos ||
+      previous.mode != current.mode) {
+    changed |= inventory_change::kPlacement;
+  }
+  if (previous.flags != current.flags || previous.quality != current.quality) {
+    changed |= inventory_change::kFlags;
+  }
+  return changed;
+}
+
+bool InventoryTracker::Update(const D2UnitStrc* owner,
+                              SafeReader& reader,
+                              std::vector<InventoryEntry>* entries,
+                              std::vector<uint32_t>* removed) {
+  entries->clear();
+  removed->clear();
+  if (!reader.IsReadable(owner, sizeof(D2UnitStrc))) {
+    return false;
+  }
+  const D2InventoryStrc* inventory = reader.Check(owner->pInventory);
+  if (inventory == nullptr || inventory->dwSignature != kInventorySignature) {
+    return false;
+  }
+  if (owner != owner_) {
+    owner_ = owner;
+    Reset();
+  }
+
+  current_.clear();
+  const D2UnitStrc* item = inventory->pFirstItem;
+  for (std::size_t length = 0; item && length < kMaxInventoryItems; ++length) {
+    if (!reader.IsReadable(item, sizeof(D2UnitStrc)) || item->dwUnitType != kUnitItem) {
+      break;
+    }
+    const D2ItemDataStrc* data = reader.Check(item->pItemData);
+    if (data == nullptr) {
+      break;
+    }
+
+    InventoryEntry entry{};
+    entry.item_id = item->dwId;
+    entry.class_id = item->dwClassId;
+    entry.mode = item->dwMode;
+    entry.flags = data->dwItemFlags;
+    entry.quality = data->dwQualityNo;
+    entry.page = data->nInvPage;
+    entry.body_location = data->nBodyLoc;
+    entry.node_pos = data->nNodePos;
+    if (const D2StaticPathStrc* path = reader.Check(item->pStaticPath)) {
+      entry.x = static_cast<uint16_t>(path->dwPosX);
+      entry.y = static_cast<uint16_t>(path->dwPosY);
+    }
+    // a list that loops back shows up as a repeated id
+    if (!current_.emplace(entry.item_id, entry).second) {
+      break;
+    }
+
+    auto it = previous_.find(entry.item_id);
+    entry.changed = it == previous_.end() ? inventory_change::kAll : Diff(it->second, entry);
+    entries->push_back(entry);
+    item = data->pNextItem;
+  }
+
+  for (const auto& [id, entry] : previous_) {
+    if (!current_.contains(id)) {
+      removed->push_back(id);
+    }
+  }
+  previous_.swap(current_);
+  return true;
+}
+
+}  // namespace d2r
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "d2r_structs.h"
+#include "safe_read.h"
+#include "unit_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace d2r {
+
+constexpr uint32_t kInventorySignature = 0x01020304;
+
+// Bits of InventoryEntry::changed, mirrored by InventoryChanges in lib/d2r/inventory.js.
+namespace inventory_change {
+constexpr uint32_t kPlacement = 1u << 0;  // page, grid cell, body location, node or item mode
+constexpr uint32_t kFlags = 1u << 1;      // dwItemFlags or quality (identified, socketed, ...)
+constexpr uint32_t kAdded = 1u << 31;     // not in the owner's inventory at the previous read
+constexpr uint32_t kAll = 0xFFFFFFFFu;
+}  // namespace inventory_change
+
+// One item of an inventory, the layout is mirrored by lib/d2r/inventory.js.
+struct InventoryEntry {
+  uint32_t item_id;
+  uint32_t class_id;
+  uint32_t mode;     // ItemModes
+  uint32_t flags;    // D2ItemDataStrc::dwItemFlags
+  uint32_t quality;  // D2ItemDataStrc::dwQualityNo
+  uint8_t page;      // D2ItemDataStrc::nInvPage
+  uint8_t body_location;
+  uint8_t node_pos;
+  uint8_t reserved;
+  uint16_t x;  // grid cell, from the item's static path
+  uint16_t y;
+  uint32_t changed;  // inventory_change bits relative to the previous read
+};
+static_assert(sizeof(InventoryEntry) == 32);
+
+// Walks the item list of one owner's D2InventoryStrc and diffs it against the previous walk, so scripts read one
+// compact table per owner instead of decoding every item unit.
+class InventoryTracker {
+ public:
+  // Must be called with the game lock held. Fills |entries| with every item of |owner|'s inventory and |removed|
+  // with the ids of items that left it since the previous call. Returns false (and leaves the previous state alone)
+  // if |owner| or its inventory are not readable. A different |owner| unit than last time (the same id in a new
+  // game) starts over like Reset.
+  bool Update(const D2UnitStrc* owner,
+              SafeReader& reader,
+              std::vector<InventoryEntry>* entries,
+              std::vector<uint32_t>* removed);
+
+  // Forgets the previous walk, the next Update reports every item as added and none as removed.
+  void Reset() { previous_.clear(); }
+
+  const D2UnitStrc* owner() const { return owner_; }
+
+ private:
+  const D2UnitStrc* owner_ = nullptr;
+  std::unordered_map<uint32_t, InventoryEntry> previous_;
+  std::unordered_map<uint32_t, InventoryEntry> current_;
+};
+
+}  // namespace d2r
@@ -0,0 +1,199 @@
+#include "item_rules.h"
+
+namespace d2r {
+
+constexpr uint32_t kFieldCount = static_cast<uint32_t>(ItemRuleField::kCount);
+
+// Values of |field|, up to three for the magic affixes. Returns the number of values.
+static uint32_t ReadField(ItemRuleField field, const D2UnitStrc& unit, const D2ItemDataStrc& data, uint32_t* out) {
+  switch (field) {
+    case ItemRuleField::kClassId:
+      out[0] = unit.dwClassId;
+      return 1;
+    case ItemRuleField::kMode:
+      out[0] = unit.dwMode;
+      return 1;
+    case ItemRuleField::kQuality:
+      out[0] = data.dwQualityNo;
+      return 1;
+    case ItemRuleField::kFlags:
+      out[0] = data.dwItemFlags;
+      return 1;
+    case ItemRuleField::kItemFormat:
+      out[0] = data.wItemFormat;
+      return 1;
+    case ItemRuleField::kItemLevel:
+      out[0] = data.dwItemLevel;
+      return 1;
+    case ItemRuleField::kRarePrefix:
+      out[0] = data.wRarePrefix;
+      return 1;
+    case ItemRuleField::kRareSuffix:
+      out[0] = data.wRareSuffix;
+      return 1;
+    case ItemRuleField::kAutoAffix:
+      out[0] = data.wAutoAffix;
+      return 1;
+    case ItemRuleField::kMagicPrefix:
+      for (uint32_t i = 0; i < 3; ++i) {
+        out[i] = data.wMagicPrefix[i];
+      }
+      return 3;
+    case ItemRuleField::kMagicSuffix:
+      for (uint32_t i = 0; i < 3; ++i) {
+        out[i] = data.wMagicSuffix[i];
+      }
+      return 3;
+    default:
+      return 0;
+  }
+}
+
+static bool Test(ItemRuleOp op, const uint32_t* operands, uint32_t operand_count, uint32_t value) {
+  switch (op) {
+    case ItemRuleOp::kEqual:
+      return value == operands[0];
+    case ItemRuleOp::kRange:
+      return value >= operands[0] && value <= operands[1];
+    case ItemRuleOp::kAnyBits:
+      return (value & operands[0]) != 0;
+    case ItemRuleOp::kAllBits:
+      return (value & operands[0]) == operands[0];
+    case ItemRuleOp::kNoBits:
+      return (value & operands[0]) == 0;
+    case ItemRuleOp::kInSet: {
+      uint32_t bit = value - operands[0];
+      return bit < (operand_count - 1) * 32 && ((operands[1 + bit / 32] >> (bit % 32)) & 1) != 0;
+    }
+    case ItemRuleOp::kOneOf:
+      for (uint32_t i = 0; i < operand_count; ++i) {
+        if (value == operands[i]) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
+static bool ValidOperandCount(ItemRuleOp op, uint32_t count) {
+  switch (op) {
+    case ItemRuleOp::kRange:
+      return count == 2;
+    case ItemRuleOp::kInSet:
+      return count >= 2;
+    case ItemRuleOp::kOneOf:
+      return count >= 1;
+    default:
+      return count == 1;
+  }
+}
+
+bool ItemRuleProgram::Load(std::span<const uint32_t> words) {
+  if (words.empty()) {
+    words_.clear();
+    rule_count_ = 0;
+    ++generation_;
+    return true;
+  }
+
+  uint32_t rule_count = words[0];
+  if (rule_count > kMaxItemRules) {
+    return false;
+  }
+  std::size_t pc = 1;
+  for (uint32_t rule = 0; rule < rule_count; ++rule) {
+    if (pc >= words.size() || words[pc] > words.size() - pc - 1) {
+      return false;
+    }
+    std::size_t end = pc + 1 + words[pc];
+    for (pc = pc + 1; pc < end;) {
+      auto op = static_cast<ItemRuleOp>(words[pc] & 0xFF);
+      uint32_t field = (words[pc] >> 8) & 0xFF;
+      uint32_t operand_count = words[pc] >> 16;
+      if (op >= ItemRuleOp::kCount || field >= kFieldCount || !ValidOperandCount(op, operand_count) ||
+          operand_count > end - pc - 1) {
+        return false;
+      }
+      pc += 1 + operand_count;
+    }
+  }
+  if (pc != words.size()) {
+    return false;
+  }
+
+  words_.assign(words.begin(), words.end());
+  rule_count_ = rule_count;
+  ++generation_;
+  return true;
+}
+
+uint32_t ItemRuleProgram::Evaluate(const D2UnitStrc& unit, const D2ItemDataStrc& data) const {
+  uint32_t mask = 0;
+  std::size_t pc = 1;
+  for (uint32_t rule = 0; rule < rule_count_; ++rule) {
+    std::size_t end = pc + 1 + words_[pc];
+    bool match = true;
+    for (pc = pc + 1; pc < end && match;) {
+      auto op = static_cast<ItemRuleOp>(words_[pc] & 0xFF);
+      auto field = static_cast<ItemRuleField>((words_[pc] >> 8) & 0xFF);
+      uint32_t operand_count = words_[pc] >> 16;
+      const uint32_t* operands = &words_[pc + 1];
+
+      uint32_t values[3];
+      uint32_t value_count = ReadField(field, unit, data, values);
+      bool any = false;
+      for (uint32_t i = 0; i < value_count && !any; ++i) {
+        any = Test(op, operands, operand_count, values[i]);
+      }
+      match = any;
+      pc += 1 + operand_count;
+    }
+    if (match) {
+      mask |= 1u << rule;
+    }
+    pc = end;
+  }
+  return mask;
+}
+
+std::size_t ItemRuleMatcher::Update(UnitSnapshotRecord* records,
+                                    std::size_t count,
+                                    const ItemRuleProgram& program,
+                                    SafeReader& reader) {
+  bool rules_changed = generation_ != program.generation();
+  generation_ = program.generation();
+  if (program.empty()) {
+    for (std::size_t i = 0; i < count; ++i) {
+      records[i].item_rules = 0;
+    }
+    previous_.clear();
+    return 0;
+  }
+
+  std::size_t evaluated = 0;
+  current_.clear();
+  current_.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    UnitSnapshotRecord& record = records[i];
+    uint64_t key = SnapshotRecordKey(record);
+    auto it = previous_.find(key);
+    uint32_t mask = 0;
+    if (it != previous_.end() && record.changed == 0 && !rules_changed) {
+      mask = it->second;
+    } else {
+      const auto* unit = reinterpret_cast<const D2UnitStrc*>(record.unit);
+      if (const D2ItemDataStrc* data = reader.Check(unit->pItemData)) {
+        mask = program.Evaluate(*unit, *data);
+        ++evaluated;
+      }
+    }
+    record.item_rules = mask;
+    current_.insert_or_assign(key, mask);
+  }
+  previous_.swap(current_);
+  return evaluated;
+}
+
+}  // namespace d2r
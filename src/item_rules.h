@@ -0,0 +1,86 @@
+#pragma once
+
+#include "d2r_structs.h"
+#include "safe_read.h"
+#include "unit_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace d2r {
+
+// Loot-filter style rules compiled by lib/d2r/item-rules.js. A rule matches when all of its conditions hold, every
+// item gets a bitmask with one bit per matching rule.
+//
+// Program layout (uint32 words): rule count, then per rule the word count of its conditions followed by the
+// conditions. A condition is op | field << 8 | operand count << 16 followed by its operands.
+constexpr uint32_t kMaxItemRules = 32;
+
+enum class ItemRuleOp : uint8_t {
+  kEqual = 0,    // value == a
+  kRange = 1,    // a <= value <= b
+  kAnyBits = 2,  // value & a != 0
+  kAllBits = 3,  // value & a == a
+  kNoBits = 4,   // value & a == 0
+  kInSet = 5,    // bit (value - a) of the bitmap in the remaining operands is set
+  kOneOf = 6,    // value is one of the operands, for short lists of far apart values
+  kCount,
+};
+
+// Mirrored by ItemRuleFields in lib/d2r/item-rules.js. The magic affix fields hold three values, the condition
+// holds if it holds for any of them.
+enum class ItemRuleField : uint8_t {
+  kClassId = 0,
+  kMode = 1,
+  kQuality = 2,
+  kFlags = 3,
+  kItemFormat = 4,
+  kItemLevel = 5,
+  kRarePrefix = 6,
+  kRareSuffix = 7,
+  kAutoAffix = 8,
+  kMagicPrefix = 9,
+  kMagicSuffix = 10,
+  kCount,
+};
+
+class ItemRuleProgram {
+ public:
+  // Validates and takes over |words|, an empty span clears the rules. Returns false (and keeps the previous
+  // program) if the program is malformed.
+  bool Load(std::span<const uint32_t> words);
+
+  // Bitmask of the rules |unit| (an item) with |data| matches.
+  uint32_t Evaluate(const D2UnitStrc& unit, const D2ItemDataStrc& data) const;
+
+  bool empty() const { return rule_count_ == 0; }
+  // bumped by every successful Load, matches of an older program are stale
+  uint32_t generation() const { return generation_; }
+
+ private:
+  std::vector<uint32_t> words_;
+  uint32_t rule_count_ = 0;
+  uint32_t generation_ = 0;
+};
+
+// Keeps the rule matches of every item across snapshots so only items that were added or changed since the last
+// walk (UnitSnapshotRecord::changed) are evaluated, and writes them to UnitSnapshotRecord::item_rules.
+class ItemRuleMatcher {
+ public:
+  // Must be called with the game lock held, the item data is read from game memory. |records| are the item records
+  // of one walk, after UnitChangeTracker::Update. Returns the number of items evaluated.
+  std::size_t Update(UnitSnapshotRecord* records,
+                     std::size_t count,
+                     const ItemRuleProgram& program,
+                     SafeReader& reader);
+
+ private:
+  std::unordered_map<uint64_t, uint32_t> previous_;
+  std::unordered_map<uint64_t, uint32_t> current_;
+  uint32_t generation_ = 0;
+};
+
+}  // namespace d2r
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "metrics_format.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace d2r {
+
+// Live counters and gauges for simple_injector --top, published through the shared MetricsBlock. Set and Add are a
+// relaxed store or add on the metric's own slot, wait-free from any thread and cheap enough for per-tick paths.
+// Until Initialize maps the segment (and after Shutdown) they land in a block local to the process.
+class Metrics {
+ public:
+  // Maps the segment for the current process and carries over what was recorded so far.
+  static bool Initialize();
+  // Must run after the script thread stopped, the segment is unmapped.
+  static void Shutdown();
+
+  static void Set(Metric metric, uint64_t value) { Slot(metric).store(value, std::memory_order_relaxed); }
+  static void Add(Metric metric, uint64_t delta = 1) { Slot(metric).fetch_add(delta, std::memory_order_relaxed); }
+  static uint64_t Get(Metric metric) { return Slot(metric).load(std::memory_order_relaxed); }
+
+ private:
+  static std::atomic<uint64_t>& Slot(Metric metric) {
+    return block_.load(std::memory_order_acquire)->values[static_cast<std::size_t>(metric)];
+  }
+
+  static inline MetricsBlock local_{};
+  static inline std::atomic<MetricsBlock*> block_{&local_};
+};
+
+// Unit count metric of unit type |type|.
+inline Metric UnitCountMetric(uint32_t type) {
+  return static_cast<Metric>(static_cast<uint32_t>(Metric::UnitsPlayer) + type);
+}
+
+}  // namespace d2r
@@ -0,0 +1,85 @@
+#pragma once
+
+// Layout of the live metrics segment. Shared between nyx.d2r (writer) and simple_injector --top (reader), keep this
+// header free of Windows and dolos dependencies.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace d2r {
+
+// Name of the file mapping, followed by the game's process id.
+constexpr auto kMetricsSegmentPrefix = "Local\\nyx_d2r_metrics_";
+constexpr uint32_t kMetricsMagic = 0x4D58594E;  // "NYXM"
+constexpr uint32_t kMetricsVersion = 1;
+
+enum class MetricKind : uint8_t {
+  kCounter,  // only grows, shown as a rate
+  kGauge,    // current value
+};
+
+enum class MetricUnit : uint8_t {
+  kCount,
+  kNanoseconds,
+};
+
+// Slots are positional, append new entries at the end and bump kMetricsVersion when reordering. The unit counts
+// are in UnitType order.
+#define D2R_METRIC_LIST(V)                                                                                             \
+  V(Ticks, kCounter, kCount, "ticks")                                                                                  \
+  V(TickTime, kGauge, kNanoseconds, "tick time")                                                                       \
+  V(GameLockTime, kGauge, kNanoseconds, "game lock time")                                                              \
+  V(GameLockTimeouts, kCounter, kCount, "game lock timeouts")                                                          \
+  V(Frames, kCounter, kCount, "frames")                                                                                \
+  V(UnitsPlayer, kGauge, kCount, "players")                                                                            \
+  V(UnitsMonster, kGauge, kCount, "monsters")                                                                          \
+  V(UnitsObject, kGauge, kCount, "objects")                                                                            \
+  V(UnitsMissile, kGauge, kCount, "missiles")                                                                          \
+  V(UnitsItem, kGauge, kCount, "items")                                                                                \
+  V(UnitsTile, kGauge, kCount, "tiles")                                                                                \
+  V(LevelsRevealed, kCounter, kCount, "levels revealed")                                                               \
+  V(RevealFailures, kCounter, kCount, "reveal failures")                                                               \
+  V(RoomsRevealed, kCounter, kCount, "rooms revealed")                                                                 \
+  V(StatListHits, kCounter, kCount, "stat list cache hits")                                                            \
+  V(StatListMisses, kCounter, kCount, "stat list cache misses")                                                        \
+  V(CollisionMapHits, kCounter, kCount, "collision map cache hits")                                                    \
+  V(CollisionMapMisses, kCounter, kCount, "collision map cache misses")                                                \
+  V(OffsetsResolved, kGauge, kCount, "offsets resolved")                                                               \
+  V(OffsetsTotal, kGauge, kCount, "offsets")                                                                           \
+  V(OffsetsFromCache, kGauge, kCount, "offsets from cache")
+
+enum class Metric : uint16_t {
+#define DEFINE_METRIC(name, kind, unit, label) name,
+  D2R_METRIC_LIST(DEFINE_METRIC)
+#undef DEFINE_METRIC
+      kCount,
+};
+
+struct MetricInfo {
+  const char* label;
+  MetricKind kind;
+  MetricUnit unit;
+};
+
+inline constexpr MetricInfo kMetricInfo[] = {
+#define DEFINE_METRIC_INFO(name, kind, unit, label) {label, MetricKind::kind, MetricUnit::unit},
+    D2R_METRIC_LIST(DEFINE_METRIC_INFO)
+#undef DEFINE_METRIC_INFO
+};
+
+constexpr std::size_t kMetricCount = static_cast<std::size_t>(Metric::kCount);
+
+// The segment. Every value is a lock-free 64-bit atomic, which works across processes, the writer only ever stores
+// or adds to single values so the reader needs no synchronization either.
+struct MetricsBlock {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t metric_count;
+  uint32_t pid;
+  std::atomic<uint32_t> open;  // cleared when the module unloads
+  alignas(64) std::atomic<uint64_t> values[kMetricCount];
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+}  // namespace d2r
@@ -0,0 +1,56 @@
+#include "metrics.h"
+
+#include <Windows.h>
+#include <dolos/pipe_log.h>
+
+#include <string>
+
+namespace d2r {
+
+static HANDLE s_mapping = nullptr;
+
+bool Metrics::Initialize() {
+  if (s_mapping != nullptr) {
+    return true;
+  }
+
+  std::string name = kMetricsSegmentPrefix + std::to_string(GetCurrentProcessId());
+  s_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(MetricsBlock), name.c_str());
+  if (s_mapping == nullptr) {
+    PIPE_LOG_ERROR("Metrics: failed to create {} ({})", name, GetLastError());
+    return false;
+  }
+  auto* block = static_cast<MetricsBlock*>(MapViewOfFile(s_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(MetricsBlock)));
+  if (block == nullptr) {
+    PIPE_LOG_ERROR("Metrics: failed to map {} ({})", name, GetLastError());
+    CloseHandle(s_mapping);
+    s_mapping = nullptr;
+    return false;
+  }
+
+  // a mapping left by an earlier injection is reused, its values restart
+  for (std::size_t i = 0; i < kMetricCount; ++i) {
+    block->values[i].store(local_.values[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  block->magic = kMetricsMagic;
+  block->version = kMetricsVersion;
+  block->metric_count = static_cast<uint32_t>(kMetricCount);
+  block->pid = GetCurrentProcessId();
+  block->open.store(1, std::memory_order_release);
+  block_.store(block, std::memory_order_release);
+  PIPE_LOG_TRACE("Metrics: publishing to {}", name);
+  return true;
+}
+
+void Metrics::Shutdown() {
+  if (s_mapping == nullptr) {
+    return;
+  }
+  MetricsBlock* block = block_.exchange(&local_, std::memory_order_acq_rel);
+  block->open.store(0, std::memory_order_release);
+  UnmapViewOfFile(block);
+  CloseHandle(s_mapping);
+  s_mapping = nullptr;
+}
+
+}  // namespace d2r
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace d2r {
+
+// Points the target of every signature that has a cache entry with the same name at |module_base + offset|.
+// Templated on the entry and signature types (name/offset and name/target members) so it does not depend on
+// dolos and can be benchmarked off Windows.
+template <typename Entries, typename Signatures>
+void ApplyOffsetEntries(const Entries& entries, Signatures& signatures, uint64_t module_base) {
+  for (const auto& entry : entries) {
+    auto it = std::find_if(
+        signatures.begin(), signatures.end(), [&entry](const auto& sig) { return entry.name == sig.name; });
+    if (it != signatures.end()) {
+      *it->target = reinterpret_cast<void*>(module_base + entry.offset);
+    }
+  }
+}
+
+}  // namespace d2r
@@ -6,6 +6,10 @@
 #include <dolos/pe_builder.h>
 #include <dolos/pipe_log.h>
 
+#include "metrics.h"
+#include "offset_cache_apply.h"
+#include "trace.h"
+
 #include <algorithm>
 #include <cstddef>
 #include <string>
@@ -40,14 +44,7 @@ std::vector<SignatureDef> BuildSignatureList() {
 
 void ApplyCachedOffsets(const OffsetCache& cache, std::vector<SignatureDef>& signatures) {
   HMODULE module = GetModuleHandle(NULL);
-  uint64_t module_base = reinterpret_cast<uint64_t>(module);
-  for (const auto& entry : cache.entries) {
-    auto it = std::find_if(
-        signatures.begin(), signatures.end(), [&entry](const SignatureDef& sig) { return entry.name == sig.name; });
-    if (it != signatures.end()) {
-      *it->target = reinterpret_cast<void*>(module_base + entry.offset);
-    }
-  }
+  ApplyOffsetEntries(cache.entries, signatures, reinterpret_cast<uint64_t>(module));
 }
 
 OffsetCache BuildCache(std::uint64_t exe_hash, std::uint32_t sig_hash, const std::vector<SignatureDef>& signatures) {
@@ -74,6 +71,7 @@ void RegisterOffsetsWithDolos() {
 }  // namespace
 
 bool InitializeOffsets() {
+  TRACE_SPAN("InitializeOffsets");
   PIPE_LOG_INFO("[Offsets] Initializing...");
 
   auto signatures = BuildSignatureList();
@@ -84,6 +82,7 @@ bool InitializeOffsets() {
   }
 
   PIPE_LOG_DEBUG("[Offsets] {} offsets to resolve", signatures.size());
+  Metrics::Set(Metric::OffsetsTotal, signatures.size());
 
   OffsetCacheManager cache_mgr;
   std::uint64_t exe_hash = cache_mgr.ComputeExecutableHash();
@@ -94,6 +93,7 @@ bool InitializeOffsets() {
   }
 
   if (exe_hash != 0) {
+    TRACE_SPAN("Offsets::LoadCache");
     auto cached = cache_mgr.LoadCache(exe_hash, sig_hash);
     if (cached.has_value()) {
       PIPE_LOG_DEBUG("[Offsets] Applying cached offsets...");
@@ -101,6 +101,8 @@ bool InitializeOffsets() {
 
       if (ValidateOffsets()) {
         PIPE_LOG_INFO("[Offsets] Loaded {} offsets from cache", signatures.size());
+        Metrics::Set(Metric::OffsetsResolved, signatures.size());
+        Metrics::Set(Metric::OffsetsFromCache, 1);
         RegisterOffsetsWithDolos();
         return true;
       }
@@ -117,8 +119,11 @@ bool InitializeOffsets() {
     return false;
   }
 
-  if (!scanner.ScanAll(signatures)) {
-    PIPE_LOG_WARN("[Offsets] Not all patterns were found");
+  {
+    TRACE_SPAN("Offsets::ScanAll");
+    if (!scanner.ScanAll(signatures)) {
+      PIPE_LOG_WARN("[Offsets] Not all patterns were found");
+    }
   }
 
   if (exe_hash != 0) {
@@ -146,6 +151,7 @@ bool InitializeOffsets() {
   }
 
   PIPE_LOG_INFO("[Offsets] Resolved {}/{} offsets", found_count, signatures.size());
+  Metrics::Set(Metric::OffsetsResolved, found_count);
 
   if (exe_hash != 0 && found_count > 0) {
     auto cache = BuildCache(exe_hash, sig_hash, signatures);
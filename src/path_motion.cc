@@ -0,0 +1,76 @@
+#include "path_motion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define D2R_PATH_MOTION_SSE2 1
+#endif
+
+namespace d2r {
+
+void PathMotion::Load(const UnitSnapshotRecord* records, std::span<const uint32_t> indices) {
+  size_ = indices.size();
+  std::size_t padded = (size_ + 3) & ~std::size_t{3};
+  x_.assign(padded, 0);
+  y_.assign(padded, 0);
+  velocity_x_.assign(padded, 0);
+  velocity_y_.assign(padded, 0);
+  frames_to_target_.assign(padded, 0);
+
+  for (std::size_t i = 0; i < size_; ++i) {
+    const UnitSnapshotRecord& record = records[indices[i]];
+    if (!record.path_address) {
+      continue;
+    }
+    // the record keeps the raw bytes, D2DynamicPathStrc is packed
+    D2DynamicPathStrc path;
+    std::memcpy(&path, record.path, sizeof(path));
+    x_[i] = static_cast<int32_t>(path.dwClientCoordX);
+    y_[i] = static_cast<int32_t>(path.dwClientCoordY);
+
+    double velocity_x = path.tVelocityVector.nX;
+    double velocity_y = path.tVelocityVector.nY;
+    double speed = velocity_x * velocity_x + velocity_y * velocity_y;
+    if (speed == 0 || (path.tTargetCoord.wX == 0 && path.tTargetCoord.wY == 0)) {
+      continue;
+    }
+    // frames until the unit passes the target along its velocity, projected so a target off the line still stops it
+    double to_x = (static_cast<double>(path.tTargetCoord.wX) * 65536.0) - x_[i];
+    double to_y = (static_cast<double>(path.tTargetCoord.wY) * 65536.0) - y_[i];
+    double frames = (to_x * velocity_x + to_y * velocity_y) / speed;
+    if (frames <= 0) {
+      continue;
+    }
+    velocity_x_[i] = static_cast<float>(velocity_x);
+    velocity_y_[i] = static_cast<float>(velocity_y);
+    frames_to_target_[i] = static_cast<float>(frames);
+  }
+}
+
+void PathMotion::Extrapolate(float frames, float max_frames, int32_t* out) const {
+  frames = std::clamp(frames, 0.0f, max_frames);
+  std::size_t i = 0;
+#if defined(D2R_PATH_MOTION_SSE2)
+  // cvtps rounds to nearest like lrintf below, so a unit lands on the same coordinate whichever path it takes
+  const __m128 elapsed = _mm_set1_ps(frames);
+  for (; i + 4 <= size_; i += 4) {
+    __m128 steps = _mm_min_ps(elapsed, _mm_loadu_ps(&frames_to_target_[i]));
+    __m128i dx = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&velocity_x_[i]), steps));
+    __m128i dy = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&velocity_y_[i]), steps));
+    __m128i x = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&x_[i])), dx);
+    __m128i y = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&y_[i])), dy);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), _mm_unpacklo_epi32(x, y));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2 + 4), _mm_unpackhi_epi32(x, y));
+  }
+#endif
+  for (; i < size_; ++i) {
+    float steps = std::min(frames, frames_to_target_[i]);
+    out[i * 2] = x_[i] + static_cast<int32_t>(std::lrintf(velocity_x_[i] * steps));
+    out[i * 2 + 1] = y_[i] + static_cast<int32_t>(std::lrintf(velocity_y_[i] * steps));
+  }
+}
+
+}  // namespace d2r
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "unit_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace d2r {
+
+// The game advances a dynamic path once per game frame, assumed to run at a fixed 25 frames per second regardless of
+// the frame rate it renders at. Like the velocity units below this is carried over from the original game and not
+// verified against D2R yet.
+constexpr double kGameFramesPerSecond = 25.0;
+
+// Where the units with a dynamic path were heading as of one snapshot, kept as structure of arrays so Extrapolate
+// moves four units per SSE2 instruction. Coordinates are the path's client coordinates (dwClientCoordX/Y, 16.16
+// fixed point subtiles, what worldToAutomap takes). A unit is assumed to move by tVelocityVector, in the same 16.16
+// subtiles, every game frame (unverified, a wrong scale shows as units overshooting or lagging between ticks) and
+// stops at tTargetCoord, the end of its current path segment: units are not steered around the later path points,
+// the next snapshot arrives long before a segment is walked. The SSE2 and scalar loops round alike, bench/main.cc
+// checks that they agree.
+class PathMotion {
+ public:
+  // Replaces the loaded units with the records |indices| of |records| point at, in that order. Records without a
+  // dynamic path come out at 0, 0.
+  void Load(const UnitSnapshotRecord* records, std::span<const uint32_t> indices);
+
+  std::size_t size() const { return size_; }
+
+  // Writes the x, y pairs of every loaded unit |frames| game frames after the snapshot to |out|, which holds
+  // 2 * size() values. |frames| is clamped to [0, max_frames].
+  void Extrapolate(float frames, float max_frames, int32_t* out) const;
+
+ private:
+  std::size_t size_ = 0;
+  // padded to a multiple of four units
+  std::vector<int32_t> x_;
+  std::vector<int32_t> y_;
+  std::vector<float> velocity_x_;
+  std::vector<float> velocity_y_;
+  std::vector<float> frames_to_target_;
+};
+
+}  // namespace d2r
@@ -0,0 +1,149 @@
+#include "safe_read.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace d2r {
+
+namespace {
+
+// guards everything below, never held while the regions are walked
+std::mutex s_mutex;
+std::condition_variable s_wake_refresher;
+std::shared_ptr<const RegionMap> s_map;
+uint64_t s_refreshed_ms = 0;
+bool s_building = false;           // a thread is walking the regions
+bool s_refresh_requested = false;  // a reader found memory the map is missing
+std::thread s_refresher;
+bool s_shutdown = false;
+
+uint64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Walks the regions with |lock| released and swaps the result in. Returns the new map.
+std::shared_ptr<const RegionMap> Rebuild(std::unique_lock<std::mutex>& lock) {
+  s_building = true;
+  lock.unlock();
+  auto map = std::make_shared<const RegionMap>(QueryReadableRegions());
+  uint64_t now = NowMs();
+  lock.lock();
+  s_map = std::move(map);
+  s_refreshed_ms = now;
+  s_building = false;
+  s_refresh_requested = false;
+  return s_map;
+}
+
+// Keeps the map at most kRefreshIntervalMs old, or kMissRefreshIntervalMs once a reader found memory it is missing.
+// The only thread that walks the regions after the first map.
+void RefreshLoop() {
+  std::unique_lock lock(s_mutex);
+  while (!s_shutdown) {
+    uint64_t interval = s_refresh_requested ? SafeReader::kMissRefreshIntervalMs : SafeReader::kRefreshIntervalMs;
+    uint64_t age = NowMs() - s_refreshed_ms;
+    if (age >= interval && !s_building) {
+      Rebuild(lock);
+      continue;
+    }
+    uint64_t wait_ms = age < interval ? interval - age : 1;
+    s_wake_refresher.wait_for(lock, std::chrono::milliseconds(wait_ms));
+  }
+}
+
+// Returns the current map, the first call builds it.
+std::shared_ptr<const RegionMap> AcquireMap() {
+  std::unique_lock lock(s_mutex);
+  if (!s_refresher.joinable() && !s_shutdown) {
+    s_refresher = std::thread(&RefreshLoop);
+  }
+  if (s_map) {
+    return s_map;
+  }
+  return Rebuild(lock);
+}
+
+// Has the refresher rebuild the map early, does not wait for it.
+void RequestRefresh() {
+  {
+    std::lock_guard lock(s_mutex);
+    if (s_refresh_requested) {
+      return;
+    }
+    s_refresh_requested = true;
+  }
+  s_wake_refresher.notify_one();
+}
+
+}  // namespace
+
+RegionMap::RegionMap(std::vector<Region> regions) {
+  for (const Region& region : regions) {
+    if (!regions_.empty() && regions_.back().end == region.begin) {
+      regions_.back().end = region.end;
+    } else {
+      regions_.push_back(region);
+    }
+  }
+}
+
+// the refresher keeps the map fresh, a reader only builds the first one
+SafeReader::SafeReader() : map_(AcquireMap()) {}
+
+void SafeReader::Shutdown() {
+  {
+    std::lock_guard lock(s_mutex);
+    s_shutdown = true;
+  }
+  s_wake_refresher.notify_one();
+  if (s_refresher.joinable()) {
+    s_refresher.join();
+  }
+}
+
+bool SafeReader::IsReadable(const void* address, std::size_t size) {
+  if (map_->Contains(address, size)) {
+    return true;
+  }
+  uintptr_t begin = reinterpret_cast<uintptr_t>(address);
+  uintptr_t end = begin + size;
+  return end >= begin && IsQueriedReadable(begin, end);
+}
+
+// Answers a miss of the map from the queried regions, asking the OS about the ones not queried yet. A range may span
+// several regions.
+bool SafeReader::IsQueriedReadable(uintptr_t begin, uintptr_t end) {
+  for (uintptr_t cursor = begin; cursor < end;) {
+    const QueriedRegion* found = nullptr;
+    for (const QueriedRegion& queried : queried_) {
+      if (queried.region.begin <= cursor && cursor < queried.region.end) {
+        found = &queried;
+        break;
+      }
+    }
+    if (found == nullptr) {
+      QueriedRegion& slot = queried_[next_queried_];
+      next_queried_ = (next_queried_ + 1) % kQueriedRegions;
+      slot.readable = QueryRegionAt(cursor, &slot.region);
+      // a failed query still has to cover the cursor, or the loop would not advance
+      if (slot.region.begin > cursor || slot.region.end <= cursor) {
+        slot.region = {cursor, cursor + 1};
+        slot.readable = false;
+      }
+      if (slot.readable) {
+        RequestRefresh();
+      }
+      found = &slot;
+    }
+    if (!found->readable) {
+      return false;
+    }
+    cursor = found->region.end;
+  }
+  return true;
+}
+
+}  // namespace d2r
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace d2r {
+
+// Sorted, merged list of committed readable address ranges. Lookups are a binary search, no OS calls.
+class RegionMap {
+ public:
+  struct Region {
+    uintptr_t begin;
+    uintptr_t end;  // exclusive
+  };
+
+  RegionMap() = default;
+  // |regions| must be sorted by begin, adjacent ranges are merged
+  explicit RegionMap(std::vector<Region> regions);
+
+  bool Contains(const void* address, std::size_t size) const {
+    uintptr_t begin = reinterpret_cast<uintptr_t>(address);
+    uintptr_t end = begin + size;
+    if (end < begin) {
+      return false;
+    }
+    auto it = std::upper_bound(regions_.begin(), regions_.end(), begin,
+                               [](uintptr_t value, const Region& region) { return value < region.begin; });
+    if (it == regions_.begin()) {
+      return false;
+    }
+    --it;
+    return end <= it->end;
+  }
+
+  std::size_t size() const { return regions_.size(); }
+
+ private:
+  std::vector<Region> regions_;
+};
+
+// Pointer validation for walks over game memory that may be freed while we read it.
+//
+// The process-wide region map is rebuilt every kRefreshIntervalMs by a background thread. A reader pins the map
+// that was current when it was constructed. A miss never walks the regions on the reader's thread (which usually
+// holds the game lock): it asks the OS about the one region containing the address, memory may have been committed
+// since the last walk, and keeps the answer for the reader's lifetime. Memory found that way has the refresher
+// rebuild early, but not more often than kMissRefreshIntervalMs. Committed does not mean alive - callers still sanity
+// check what they read and guard against cycles.
+class SafeReader {
+ public:
+  static constexpr uint64_t kRefreshIntervalMs = 1000;
+  static constexpr uint64_t kMissRefreshIntervalMs = 50;
+
+  SafeReader();
+
+  // Stops the background refresh, misses are still answered by region queries.
+  static void Shutdown();
+
+  bool IsReadable(const void* address, std::size_t size);
+
+  // |pointer| if the whole object is readable, nullptr otherwise
+  template <typename T>
+  T* Check(T* pointer) {
+    return pointer && IsReadable(pointer, sizeof(T)) ? pointer : nullptr;
+  }
+
+ private:
+  struct QueriedRegion {
+    RegionMap::Region region{};
+    bool readable = false;
+  };
+
+  // regions the OS was asked about after a miss of |map_|, both readable and not, replaced round robin
+  static constexpr std::size_t kQueriedRegions = 4;
+
+  bool IsQueriedReadable(uintptr_t begin, uintptr_t end);
+
+  std::shared_ptr<const RegionMap> map_;
+  std::array<QueriedRegion, kQueriedRegions> queried_{};
+  std::size_t next_queried_ = 0;
+};
+
+// Enumerates the committed readable regions of the process, sorted by address. Implemented per platform
+// (safe_read_win.cc), the benchmarks provide one over their fixtures.
+std::vector<RegionMap::Region> QueryReadableRegions();
+
+// Sets |region| to the extent of the region of like pages containing |address| and returns whether it is committed
+// and readable. A single OS query, implemented next to QueryReadableRegions.
+bool QueryRegionAt(uintptr_t address, RegionMap::Region* region);
+
+}  // namespace d2r
@@ -0,0 +1,48 @@
+#include "safe_read.h"
+
+#include <Windows.h>
+
+namespace d2r {
+
+namespace {
+
+constexpr DWORD kReadableProtection = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ |
+                                     PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+
+bool IsReadableRegion(const MEMORY_BASIC_INFORMATION& mbi) {
+  return mbi.State == MEM_COMMIT && (mbi.Protect & kReadableProtection) != 0 &&
+         (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) == 0;
+}
+
+}  // namespace
+
+std::vector<RegionMap::Region> QueryReadableRegions() {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+
+  std::vector<RegionMap::Region> regions;
+  regions.reserve(4096);
+  auto* address = static_cast<uint8_t*>(info.lpMinimumApplicationAddress);
+  auto* max_address = static_cast<uint8_t*>(info.lpMaximumApplicationAddress);
+  MEMORY_BASIC_INFORMATION mbi;
+  while (address < max_address && VirtualQuery(address, &mbi, sizeof(mbi)) == sizeof(mbi)) {
+    if (IsReadableRegion(mbi)) {
+      uintptr_t begin = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+      regions.push_back({begin, begin + mbi.RegionSize});
+    }
+    address = static_cast<uint8_t*>(mbi.BaseAddress) + mbi.RegionSize;
+  }
+  return regions;
+}
+
+bool QueryRegionAt(uintptr_t address, RegionMap::Region* region) {
+  MEMORY_BASIC_INFORMATION mbi;
+  if (VirtualQuery(reinterpret_cast<const void*>(address), &mbi, sizeof(mbi)) != sizeof(mbi)) {
+    return false;
+  }
+  uintptr_t begin = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+  *region = {begin, begin + mbi.RegionSize};
+  return IsReadableRegion(mbi);
+}
+
+}  // namespace d2r
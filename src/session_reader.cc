@@ -0,0 +1,201 @@
+#include "session_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace d2r {
+
+namespace {
+
+constexpr std::size_t kFileHeaderSize = sizeof(kSessionMagic) + 2 * sizeof(uint32_t);
+
+template <typename T>
+T Load(const uint8_t* bytes) {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+void XorInto(uint8_t* target, const uint8_t* base, std::size_t size) {
+  for (std::size_t i = 0; i < size; ++i) {
+    target[i] ^= base[i];
+  }
+}
+
+}  // namespace
+
+bool SessionReader::Open(std::vector<uint8_t> bytes, std::string* error) {
+  if (bytes.size() < kFileHeaderSize || std::memcmp(bytes.data(), kSessionMagic, sizeof(kSessionMagic)) != 0) {
+    *error = "not a session file";
+    return false;
+  }
+  uint32_t version = Load<uint32_t>(bytes.data() + sizeof(kSessionMagic));
+  uint32_t record_size = Load<uint32_t>(bytes.data() + sizeof(kSessionMagic) + sizeof(uint32_t));
+  if (version != kSessionVersion) {
+    *error = "unsupported session version " + std::to_string(version);
+    return false;
+  }
+  if (record_size != sizeof(UnitSnapshotRecord)) {
+    *error = "session record size " + std::to_string(record_size) + " != " +
+             std::to_string(sizeof(UnitSnapshotRecord));
+    return false;
+  }
+  bytes_ = std::move(bytes);
+  Rewind();
+  return true;
+}
+
+bool SessionReader::OpenFile(const std::string& path, std::string* error) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    *error = "could not open " + path;
+    return false;
+  }
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return Open(std::move(bytes), error);
+}
+
+void SessionReader::Rewind() {
+  offset_ = kFileHeaderSize;
+  frame_index_ = 0;
+  frames_[0] = SessionFrame{};
+  frames_[1] = SessionFrame{};
+  error_.clear();
+}
+
+const SessionFrame* SessionReader::Next() {
+  if (done() || !error_.empty()) {
+    return nullptr;
+  }
+  if (bytes_.size() - offset_ < 2 * sizeof(uint32_t)) {
+    Fail("truncated frame header");
+    return nullptr;
+  }
+  uint32_t compressed_size = Load<uint32_t>(bytes_.data() + offset_);
+  uint32_t raw_size = Load<uint32_t>(bytes_.data() + offset_ + sizeof(uint32_t));
+  const uint8_t* payload = bytes_.data() + offset_ + 2 * sizeof(uint32_t);
+  if (bytes_.size() - offset_ - 2 * sizeof(uint32_t) < compressed_size) {
+    Fail("truncated frame");
+    return nullptr;
+  }
+  std::swap(current_, previous_);
+  if (!Decode(payload, compressed_size, raw_size)) {
+    return nullptr;
+  }
+  offset_ += 2 * sizeof(uint32_t) + compressed_size;
+  ++frame_index_;
+  return current_;
+}
+
+bool SessionReader::Fail(std::string error) {
+  error_ = "frame " + std::to_string(frame_index_) + ": " + std::move(error);
+  return false;
+}
+
+// Inverse of Compress() and WriteFrame() in session_recorder.cc.
+bool SessionReader::Decode(const uint8_t* payload, std::size_t size, std::size_t raw_size) {
+  raw_.assign(raw_size, 0);
+  std::size_t read = 0;
+  std::size_t write = 0;
+  while (read < size) {
+    if (size - read < 2 * sizeof(uint16_t)) {
+      return Fail("truncated token");
+    }
+    uint16_t zeros = Load<uint16_t>(payload + read);
+    uint16_t literals = Load<uint16_t>(payload + read + sizeof(uint16_t));
+    read += 2 * sizeof(uint16_t);
+    write += zeros;
+    if (size - read < literals || raw_size < write || raw_size - write < literals) {
+      return Fail("token past the end of the frame");
+    }
+    std::memcpy(raw_.data() + write, payload + read, literals);
+    read += literals;
+    write += literals;
+  }
+  if (write != raw_size) {
+    return Fail("decoded " + std::to_string(write) + " of " + std::to_string(raw_size) + " bytes");
+  }
+
+  const uint8_t* p = raw_.data();
+  const uint8_t* end = raw_.data() + raw_.size();
+  auto take = [&](std::size_t bytes) {
+    if (static_cast<std::size_t>(end - p) < bytes) {
+      return false;
+    }
+    p += bytes;
+    return true;
+  };
+
+  SessionFrame& frame = *current_;
+  const SessionFrame& previous = *previous_;
+  if (!take(sizeof(SessionFrameHeader) + sizeof(frame.players))) {
+    return Fail("truncated header");
+  }
+  std::memcpy(&frame.header, raw_.data(), sizeof(SessionFrameHeader));
+  std::memcpy(frame.players.data(), raw_.data() + sizeof(SessionFrameHeader), sizeof(frame.players));
+
+  const uint8_t* samples = p;
+  if (!take(std::size_t{frame.header.sample_count} * sizeof(SessionAutomapSample))) {
+    return Fail("truncated samples");
+  }
+  frame.samples.resize(frame.header.sample_count);
+  std::memcpy(frame.samples.data(), samples, frame.samples.size() * sizeof(SessionAutomapSample));
+
+  frame.records.resize(frame.header.record_count);
+  frame.firsts.fill(0);
+  std::array<uint32_t, kUnitTypeCount> counts{};
+  for (UnitSnapshotRecord& record : frame.records) {
+    const uint8_t* delta = p;
+    if (!take(sizeof(SessionDeltaHeader) + sizeof(UnitSnapshotRecord))) {
+      return Fail("truncated record");
+    }
+    auto base = Load<int32_t>(delta);
+    std::memcpy(&record, delta + sizeof(SessionDeltaHeader), sizeof(UnitSnapshotRecord));
+    if (base >= 0) {
+      if (static_cast<std::size_t>(base) >= previous.records.size()) {
+        return Fail("record delta against a missing record");
+      }
+      XorInto(reinterpret_cast<uint8_t*>(&record), reinterpret_cast<const uint8_t*>(&previous.records[base]),
+              sizeof(UnitSnapshotRecord));
+    }
+    if (record.type < kUnitTypeCount) {
+      ++counts[record.type];
+    }
+  }
+  // the recorder writes the types in order, see SessionRecorder::CaptureFrame
+  for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+    frame.firsts[type + 1] = frame.firsts[type] + counts[type];
+  }
+
+  frame.blobs.resize(frame.header.blob_count);
+  for (SessionBlob& blob : frame.blobs) {
+    const uint8_t* delta = p;
+    if (!take(sizeof(SessionDeltaHeader))) {
+      return Fail("truncated blob");
+    }
+    auto header = Load<SessionDeltaHeader>(delta);
+    const uint8_t* bytes = p;
+    if (!take(header.size)) {
+      return Fail("truncated blob");
+    }
+    blob.kind = header.kind;
+    blob.address = header.address;
+    blob.bytes.assign(bytes, bytes + header.size);
+    if (header.base >= 0) {
+      if (static_cast<std::size_t>(header.base) >= previous.blobs.size() ||
+          previous.blobs[header.base].bytes.size() < header.size) {
+        return Fail("blob delta against a missing blob");
+      }
+      XorInto(blob.bytes.data(), previous.blobs[header.base].bytes.data(), header.size);
+    }
+  }
+  if (p != end) {
+    return Fail("trailing bytes");
+  }
+  return true;
+}
+
+}  // namespace d2r
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "session_recorder.h"
+#include "unit_snapshot.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace d2r {
+
+struct SessionBlob {
+  SessionBlobKind kind;
+  uint64_t address;
+  std::vector<uint8_t> bytes;
+};
+
+// One decoded frame. Records are grouped by unit type like the arena they were captured into.
+struct SessionFrame {
+  SessionFrameHeader header{};
+  std::array<SessionPlayer, kMaxPlayers> players{};
+  std::vector<SessionAutomapSample> samples;
+  std::vector<UnitSnapshotRecord> records;
+  std::array<uint32_t, kUnitTypeCount + 1> firsts{};  // record index each type starts at, then the record count
+  std::vector<SessionBlob> blobs;
+};
+
+// Decodes a session written by SessionRecorder, the native counterpart of lib/d2r/session-replay.js. Needs neither
+// the game nor Windows, the benchmarks replay sessions through it to feed UnitChangeTracker and SnapshotPipeline.
+class SessionReader {
+ public:
+  // Takes the whole file. False with |error| set if it is not a session of kSessionVersion with this build's record
+  // size.
+  bool Open(std::vector<uint8_t> bytes, std::string* error);
+  bool OpenFile(const std::string& path, std::string* error);
+
+  // Decodes the next frame, valid until the next call. nullptr at the end of the session or if the frame is corrupt,
+  // see error().
+  const SessionFrame* Next();
+  // Back to the first frame.
+  void Rewind();
+
+  bool done() const { return offset_ >= bytes_.size(); }
+  std::size_t frame_index() const { return frame_index_; }  // of the frame Next() returned last
+  const std::string& error() const { return error_; }
+
+ private:
+  bool Decode(const uint8_t* payload, std::size_t size, std::size_t raw_size);
+  bool Fail(std::string error);
+
+  std::vector<uint8_t> bytes_;
+  std::size_t offset_ = 0;
+  std::size_t frame_index_ = 0;
+  std::vector<uint8_t> raw_;
+  // records and blobs are deltas against the frame before
+  SessionFrame frames_[2];
+  SessionFrame* current_ = &frames_[0];
+  SessionFrame* previous_ = &frames_[1];
+  std::string error_;
+};
+
+}  // namespace d2r
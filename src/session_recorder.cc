@@ -0,0 +1,338 @@
+#include "session_recorder.h"
+
+#include "trace.h"
+
+#include <dolos/pipe_log.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace d2r {
+
+namespace {
+
+struct Blob {
+  SessionBlobKind kind;
+  uint64_t address;
+  std::vector<uint8_t> bytes;
+};
+
+struct Frame {
+  SessionFrameHeader header{};
+  SessionPlayer players[kMaxPlayers]{};
+  std::vector<SessionAutomapSample> samples;
+  std::vector<UnitSnapshotRecord> records;
+  std::vector<Blob> blobs;
+};
+
+// frames the writer may fall behind by before new ones are dropped, each holds a copy of the snapshot and blobs
+constexpr std::size_t kMaxQueuedFrames = 32;
+
+// guards the capture side and the queue
+std::mutex s_mutex;
+std::condition_variable s_queue_changed;
+std::atomic<bool> s_recording{false};
+bool s_has_pending = false;
+Frame s_pending;
+std::deque<Frame> s_queue;
+bool s_stopping = false;
+std::thread s_writer;
+uint64_t s_dropped_frames = 0;
+
+// writer thread only, and Start/Stop while it is not running
+std::ofstream s_file;
+Frame s_previous;
+std::unordered_map<uint64_t, int32_t> s_previous_records;  // SnapshotRecordKey -> index
+std::unordered_map<uint64_t, int32_t> s_previous_blobs;    // BlobKey -> index
+std::vector<uint8_t> s_raw;
+std::vector<uint8_t> s_compressed;
+
+uint64_t BlobKey(SessionBlobKind kind, uint64_t address) {
+  return address ^ (static_cast<uint64_t>(kind) << 60);
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>* out, const T& value) {
+  std::size_t offset = out->size();
+  out->resize(offset + sizeof(T));
+  std::memcpy(out->data() + offset, &value, sizeof(T));
+}
+
+// appends |size| bytes of |data|, XORed with |base| if there is one
+void AppendDelta(std::vector<uint8_t>* out, const uint8_t* data, const uint8_t* base, std::size_t size) {
+  std::size_t offset = out->size();
+  out->insert(out->end(), data, data + size);
+  if (base) {
+    for (std::size_t i = 0; i < size; ++i) {
+      (*out)[offset + i] ^= base[i];
+    }
+  }
+}
+
+void Compress(const std::vector<uint8_t>& in, std::vector<uint8_t>* out) {
+  out->clear();
+  std::size_t i = 0;
+  while (i < in.size()) {
+    uint16_t zeros = 0;
+    while (i < in.size() && in[i] == 0 && zeros < 0xFFFF) {
+      ++zeros;
+      ++i;
+    }
+    std::size_t literal_start = i;
+    uint16_t literals = 0;
+    // a literal run only ends at two consecutive zeros, a single zero is cheaper inline than a new token
+    while (i < in.size() && literals < 0xFFFF && !(in[i] == 0 && i + 1 < in.size() && in[i + 1] == 0)) {
+      ++literals;
+      ++i;
+    }
+    Append(out, zeros);
+    Append(out, literals);
+    out->insert(out->end(), in.begin() + literal_start, in.begin() + literal_start + literals);
+  }
+}
+
+void CaptureBlob(Frame* frame,
+                 std::unordered_set<uint64_t>* seen,
+                 SessionBlobKind kind,
+                 const void* address,
+                 std::size_t size) {
+  uint64_t key = BlobKey(kind, reinterpret_cast<uint64_t>(address));
+  if (!seen->insert(key).second) {
+    return;
+  }
+  const auto* bytes = static_cast<const uint8_t*>(address);
+  frame->blobs.push_back({kind, reinterpret_cast<uint64_t>(address), std::vector<uint8_t>(bytes, bytes + size)});
+}
+
+// rooms and levels are not part of the unit snapshot, follow every path's room up to its level
+void CaptureRooms(Frame* frame, SafeReader& reader) {
+  std::unordered_set<uint64_t> seen;
+  for (const UnitSnapshotRecord& record : frame->records) {
+    if (record.path_address == 0) {
+      continue;
+    }
+    const auto* path = reinterpret_cast<const D2DynamicPathStrc*>(record.path);
+    D2ActiveRoomStrc* room = reader.Check(path->ptRoom);
+    if (room == nullptr) {
+      continue;
+    }
+    CaptureBlob(frame, &seen, SessionBlobKind::kActiveRoom, room, sizeof(D2ActiveRoomStrc));
+    D2DrlgRoomStrc* drlg_room = reader.Check(room->ptDrlgRoom);
+    if (drlg_room == nullptr) {
+      continue;
+    }
+    CaptureBlob(frame, &seen, SessionBlobKind::kDrlgRoom, drlg_room, sizeof(D2DrlgRoomStrc));
+    D2DrlgLevelStrc* level = reader.Check(drlg_room->ptLevel);
+    if (level != nullptr) {
+      CaptureBlob(frame, &seen, SessionBlobKind::kDrlgLevel, level, sizeof(D2DrlgLevelStrc));
+    }
+  }
+}
+
+// Writer thread. Delta-encodes |frame| against the previously written one, compresses and appends it.
+void WriteFrame(Frame& frame) {
+  TRACE_SPAN("SessionRecorder::WriteFrame");
+  frame.header.record_count = static_cast<uint32_t>(frame.records.size());
+  frame.header.blob_count = static_cast<uint32_t>(frame.blobs.size());
+  frame.header.sample_count = static_cast<uint32_t>(frame.samples.size());
+
+  std::vector<uint8_t>& raw = s_raw;
+  std::vector<uint8_t>& compressed = s_compressed;
+  raw.clear();
+  Append(&raw, frame.header);
+  for (const SessionPlayer& player : frame.players) {
+    Append(&raw, player);
+  }
+  for (const SessionAutomapSample& sample : frame.samples) {
+    Append(&raw, sample);
+  }
+
+  std::unordered_map<uint64_t, int32_t> record_index;
+  record_index.reserve(frame.records.size());
+  for (std::size_t i = 0; i < frame.records.size(); ++i) {
+    const UnitSnapshotRecord& record = frame.records[i];
+    uint64_t key = SnapshotRecordKey(record);
+    auto it = s_previous_records.find(key);
+    SessionDeltaHeader delta{};
+    delta.base = it == s_previous_records.end() ? -1 : it->second;
+    Append(&raw, delta);
+    const auto* base = delta.base < 0 ? nullptr : reinterpret_cast<const uint8_t*>(&s_previous.records[delta.base]);
+    AppendDelta(&raw, reinterpret_cast<const uint8_t*>(&record), base, sizeof(UnitSnapshotRecord));
+    record_index.insert_or_assign(key, static_cast<int32_t>(i));
+  }
+
+  std::unordered_map<uint64_t, int32_t> blob_index;
+  blob_index.reserve(frame.blobs.size());
+  for (std::size_t i = 0; i < frame.blobs.size(); ++i) {
+    const Blob& blob = frame.blobs[i];
+    uint64_t key = BlobKey(blob.kind, blob.address);
+    auto it = s_previous_blobs.find(key);
+    SessionDeltaHeader delta{};
+    delta.base = it == s_previous_blobs.end() ? -1 : it->second;
+    delta.kind = blob.kind;
+    delta.address = blob.address;
+    delta.size = static_cast<uint32_t>(blob.bytes.size());
+    Append(&raw, delta);
+    const uint8_t* base = delta.base < 0 ? nullptr : s_previous.blobs[delta.base].bytes.data();
+    AppendDelta(&raw, blob.bytes.data(), base, blob.bytes.size());
+    blob_index.insert_or_assign(key, static_cast<int32_t>(i));
+  }
+
+  Compress(raw, &compressed);
+  uint32_t sizes[2] = {static_cast<uint32_t>(compressed.size()), static_cast<uint32_t>(raw.size())};
+  s_file.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+  s_file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+
+  s_previous = std::move(frame);
+  s_previous_records = std::move(record_index);
+  s_previous_blobs = std::move(blob_index);
+}
+
+void WriterLoop() {
+  for (;;) {
+    Frame frame;
+    {
+      std::unique_lock lock(s_mutex);
+      s_queue_changed.wait(lock, [] { return !s_queue.empty() || s_stopping; });
+      if (s_queue.empty()) {
+        return;
+      }
+      frame = std::move(s_queue.front());
+      s_queue.pop_front();
+    }
+    // a failed file drops the rest, the captures stop with s_recording
+    if (s_file) {
+      WriteFrame(frame);
+      if (!s_file) {
+        PIPE_LOG_ERROR("[SessionRecorder] Write failed, stopping");
+        s_recording = false;
+      }
+    }
+  }
+}
+
+// Must hold s_mutex. Hands the pending frame to the writer thread.
+void QueuePending() {
+  if (!s_has_pending) {
+    return;
+  }
+  if (s_queue.size() < kMaxQueuedFrames) {
+    s_queue.push_back(std::move(s_pending));
+    s_queue_changed.notify_one();
+  } else if (s_dropped_frames++ == 0) {
+    PIPE_LOG_WARN("[SessionRecorder] The writer fell behind, dropping frames");
+  }
+  s_pending = Frame{};
+  s_has_pending = false;
+}
+
+}  // namespace
+
+bool SessionRecorder::Start(const std::string& path) {
+  if (IsRecording()) {
+    return false;
+  }
+  // joins the writer of a recording that stopped on a failed write
+  Stop();
+  std::lock_guard lock(s_mutex);
+  s_file.open(path, std::ios::binary | std::ios::trunc);
+  if (!s_file) {
+    PIPE_LOG_ERROR("[SessionRecorder] Failed to open {}", path);
+    return false;
+  }
+  uint32_t header[2] = {kSessionVersion, static_cast<uint32_t>(sizeof(UnitSnapshotRecord))};
+  s_file.write(kSessionMagic, sizeof(kSessionMagic));
+  s_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  s_previous = Frame{};
+  s_previous_records.clear();
+  s_previous_blobs.clear();
+  s_pending = Frame{};
+  s_has_pending = false;
+  s_queue.clear();
+  s_stopping = false;
+  s_dropped_frames = 0;
+  s_recording = true;
+  s_writer = std::thread(&WriterLoop);
+  PIPE_LOG_INFO("[SessionRecorder] Recording to {}", path);
+  return true;
+}
+
+void SessionRecorder::Stop() {
+  {
+    std::lock_guard lock(s_mutex);
+    // the writer may have stopped the recording after a failed write, it still has to be joined
+    if (!s_writer.joinable()) {
+      return;
+    }
+    QueuePending();
+    s_recording = false;
+    s_stopping = true;
+    s_queue_changed.notify_one();
+  }
+  // writes out the queued frames first
+  s_writer.join();
+  if (s_dropped_frames) {
+    PIPE_LOG_WARN("[SessionRecorder] Dropped {} frames", s_dropped_frames);
+  }
+  s_file.close();
+  s_previous = Frame{};
+  s_previous_records.clear();
+  s_previous_blobs.clear();
+}
+
+bool SessionRecorder::IsRecording() {
+  return s_recording.load(std::memory_order_relaxed);
+}
+
+void SessionRecorder::CaptureFrame(const std::array<std::span<const UnitSnapshotRecord>, kUnitTypeCount>& groups,
+                                   uint32_t walked_mask,
+                                   uint32_t local_player_index,
+                                   const std::array<PlayerRosterEntry, kMaxPlayers>& roster,
+                                   SafeReader& reader) {
+  TRACE_SPAN("SessionRecorder::CaptureFrame");
+  std::lock_guard lock(s_mutex);
+  if (!s_recording) {
+    return;
+  }
+  QueuePending();
+
+  Frame& frame = s_pending;
+  frame.header.timestamp_ns = trace::NowNs();
+  frame.header.local_player_index = local_player_index;
+  for (uint32_t i = 0; i < kMaxPlayers; ++i) {
+    frame.players[i] = {roster[i].id, 0, reinterpret_cast<uint64_t>(roster[i].unit)};
+  }
+  frame.records.clear();
+  for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+    std::size_t first = frame.records.size();
+    frame.records.insert(frame.records.end(), groups[type].begin(), groups[type].end());
+    if ((walked_mask & (1u << type)) == 0) {
+      for (std::size_t i = first; i < frame.records.size(); ++i) {
+        frame.records[i].changed = 0;
+      }
+    }
+  }
+  CaptureRooms(&frame, reader);
+  s_has_pending = true;
+}
+
+void SessionRecorder::AddAutomapSample(int32_t x, int32_t y, float automap_x, float automap_y) {
+  if (!s_recording.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::lock_guard lock(s_mutex);
+  if (s_has_pending) {
+    s_pending.samples.push_back({x, y, automap_x, automap_y});
+  }
+}
+
+}  // namespace d2r
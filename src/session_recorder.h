@@ -0,0 +1,89 @@
+#pragma once
+
+#include "d2r_methods.h"
+#include "safe_read.h"
+#include "unit_snapshot.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace d2r {
+
+// Session file format, read by SessionReader (session_reader.h) and lib/d2r/session-replay.js.
+//
+//   header: char magic[8] = "D2RSESS", uint32 version, uint32 record size
+//   frame:  uint32 compressed size, uint32 raw size, compressed payload
+//
+// A raw frame payload is a SessionFrameHeader followed by kMaxPlayers SessionPlayer entries, |sample_count|
+// SessionAutomapSample entries, |record_count| (SessionDeltaHeader, UnitSnapshotRecord) pairs and |blob_count|
+// (SessionDeltaHeader, bytes) pairs. Records and blobs are XORed against the entry of the previous frame named by
+// SessionDeltaHeader::base, which turns everything that did not change into zeros. The payload is then compressed
+// with a zero-run encoding: repeated (uint16 zero run, uint16 literal count, literals) tokens.
+constexpr char kSessionMagic[8] = {'D', '2', 'R', 'S', 'E', 'S', 'S', '\0'};
+constexpr uint32_t kSessionVersion = 2;  // 2: records are grouped by unit type
+
+enum class SessionBlobKind : uint32_t {
+  kActiveRoom = 1,
+  kDrlgRoom = 2,
+  kDrlgLevel = 3,
+};
+
+struct SessionFrameHeader {
+  uint64_t timestamp_ns;
+  uint32_t local_player_index;
+  uint32_t record_count;
+  uint32_t blob_count;
+  uint32_t sample_count;
+};
+static_assert(sizeof(SessionFrameHeader) == 24);
+
+struct SessionPlayer {
+  uint32_t id;
+  uint32_t reserved;
+  uint64_t unit;
+};
+static_assert(sizeof(SessionPlayer) == 16);
+
+// one worldToAutomap call made while the frame was current
+struct SessionAutomapSample {
+  int32_t x;
+  int32_t y;
+  float automap_x;
+  float automap_y;
+};
+static_assert(sizeof(SessionAutomapSample) == 16);
+
+struct SessionDeltaHeader {
+  int32_t base;          // index of the matching record/blob in the previous frame, -1 if stored verbatim
+  SessionBlobKind kind;  // blobs only
+  uint64_t address;      // blobs only
+  uint32_t size;         // blobs only
+  uint32_t reserved;
+};
+static_assert(sizeof(SessionDeltaHeader) == 24);
+
+// Records every snapshot taken by SnapshotUnits, together with the rooms and levels reachable from the units'
+// paths, the player roster and the worldToAutomap results, so the ticks can be replayed by SessionReplay. Only the
+// copies are made under the game lock, a writer thread delta-encodes, compresses and writes the frames.
+class SessionRecorder {
+ public:
+  static bool Start(const std::string& path);
+  static void Stop();
+  static bool IsRecording();
+
+  // Called with the game lock held, right after a successful capture. Hands the previous frame to the writer thread.
+  // |groups| are the arena regions per unit type, the records of types missing from |walked_mask| are recorded as
+  // unchanged.
+  static void CaptureFrame(const std::array<std::span<const UnitSnapshotRecord>, kUnitTypeCount>& groups,
+                           uint32_t walked_mask,
+                           uint32_t local_player_index,
+                           const std::array<PlayerRosterEntry, kMaxPlayers>& roster,
+                           SafeReader& reader);
+
+  static void AddAutomapSample(int32_t x, int32_t y, float automap_x, float automap_y);
+};
+
+}  // namespace d2r
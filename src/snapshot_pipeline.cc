@@ -0,0 +1,208 @@
+#include "snapshot_pipeline.h"
+
+#include "trace.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace d2r {
+
+// Units are tracked by type and id like the script side does, the client and server record of a unit share a slot.
+static uint64_t UnitKey(const UnitSnapshotRecord& record) {
+  return SnapshotRecordKey(record) & ((uint64_t{1} << 40) - 1);
+}
+
+SnapshotPipeline::SnapshotPipeline() {
+  for (SnapshotJob& job : jobs_) {
+    free_jobs_.TryPush(&job);
+  }
+  // the second result is the script's until the first Swap
+  free_results_.TryPush(&results_[0]);
+  worker_ = std::thread(&SnapshotPipeline::WorkerLoop, this);
+}
+
+SnapshotPipeline::~SnapshotPipeline() {
+  running_.store(false, std::memory_order_release);
+  Wake();
+  worker_.join();
+}
+
+SnapshotJob* SnapshotPipeline::AcquireJob() {
+  SnapshotJob* job = nullptr;
+  free_jobs_.TryPop(&job);
+  return job;
+}
+
+void SnapshotPipeline::Submit(SnapshotJob* job) {
+  job->frame = next_frame_++;
+  // 0 marks a slot that was never written
+  if (next_frame_ == 0) {
+    next_frame_ = 1;
+  }
+  pending_jobs_.TryPush(job);
+  Wake();
+}
+
+const SnapshotResult* SnapshotPipeline::Swap() {
+  SnapshotResult* result = nullptr;
+  if (!done_results_.TryPop(&result)) {
+    return nullptr;
+  }
+  SnapshotResult* previous = front_ ? front_ : &results_[1];
+  front_ = result;
+  free_results_.TryPush(previous);
+  Wake();
+  return result;
+}
+
+void SnapshotPipeline::Wake() {
+  wake_.fetch_add(1, std::memory_order_release);
+  wake_.notify_one();
+}
+
+void SnapshotPipeline::WorkerLoop() {
+  SnapshotJob* job = nullptr;
+  SnapshotResult* back = nullptr;
+  while (running_.load(std::memory_order_acquire)) {
+    // loaded before the rings are polled, a push after the poll changes it and the wait returns right away
+    uint32_t wake = wake_.load(std::memory_order_acquire);
+    if (job == nullptr) {
+      pending_jobs_.TryPop(&job);
+    }
+    if (back == nullptr) {
+      free_results_.TryPop(&back);
+    }
+    if (job == nullptr || back == nullptr) {
+      wake_.wait(wake, std::memory_order_acquire);
+      continue;
+    }
+
+    Process(*job, back);
+    newest_ = back;
+    free_jobs_.TryPush(job);
+    done_results_.TryPush(back);
+    job = nullptr;
+    back = nullptr;
+  }
+}
+
+uint32_t SnapshotPipeline::AllocateSlot(uint64_t key, uint32_t type, uint32_t frame) {
+  uint32_t slot;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else {
+    slot = static_cast<uint32_t>(slots_.size());
+    slots_.emplace_back();
+  }
+  slots_[slot] = {key, type, frame, 0, 0, true};
+  slot_index_.emplace(key, slot);
+  return slot;
+}
+
+void SnapshotPipeline::Process(SnapshotJob& job, SnapshotResult* back) {
+  TRACE_SPAN("SnapshotPipeline::Process");
+  const uint32_t frame = job.frame;
+  for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+    const uint32_t bit = 1u << type;
+    if (job.diffed_mask & bit) {
+      // diffed by the capture, start over once it stops doing so
+      change_trackers_[type].Clear();
+    } else if (job.walked_mask & bit) {
+      change_trackers_[type].Update(job.records.data() + job.firsts[type], job.firsts[type + 1] - job.firsts[type]);
+    }
+  }
+
+  pending_.clear();
+  removed_.clear();
+  added_.clear();
+  updated_.clear();
+  record_slots_.assign(job.count, UINT32_MAX);
+
+  for (uint32_t i = 0; i < job.count; ++i) {
+    auto it = slot_index_.find(UnitKey(job.records[i]));
+    if (it == slot_index_.end()) {
+      pending_.push_back(i);
+      continue;
+    }
+    record_slots_[i] = it->second;
+    slots_[it->second].seen = frame;
+  }
+
+  // removed before the new units get their slots, a freed slot may be reused right away
+  for (uint32_t slot = 0; slot < slots_.size(); ++slot) {
+    Slot& state = slots_[slot];
+    if (state.alive && state.seen != frame && (job.walked_mask & (1u << state.type))) {
+      removed_.push_back(slot);
+      slot_index_.erase(state.key);
+      state.alive = false;
+      free_slots_.push_back(slot);
+    }
+  }
+
+  for (uint32_t i : pending_) {
+    const UnitSnapshotRecord& record = job.records[i];
+    uint64_t key = UnitKey(record);
+    auto it = slot_index_.find(key);
+    if (it != slot_index_.end()) {
+      record_slots_[i] = it->second;  // the other source's record of a unit added by this job
+      continue;
+    }
+    record_slots_[i] = AllocateSlot(key, record.type, frame);
+    added_.push_back(record_slots_[i]);
+  }
+
+  if (back->capacity < slots_.size()) {
+    std::size_t capacity = slots_.size() + slots_.size() / 2 + 64;
+    back->records = std::make_shared<UnitSnapshotRecord[]>(capacity);
+    back->capacity = capacity;
+    back->written.assign(capacity, 0);
+  }
+
+  UnitSnapshotRecord* records = back->records.get();
+  for (uint32_t i = 0; i < job.count; ++i) {
+    const UnitSnapshotRecord& record = job.records[i];
+    uint32_t slot = record_slots_[i];
+    Slot& state = slots_[slot];
+    records[slot] = record;
+    back->written[slot] = frame;
+    // both records of a unit report their changes, the later one is kept like the script side did
+    if (state.latest == frame) {
+      updated_[state.update + 1] |= record.changed;
+      continue;
+    }
+    state.latest = frame;
+    state.update = static_cast<uint32_t>(updated_.size());
+    updated_.push_back(slot);
+    updated_.push_back(record.changed);
+  }
+
+  // units of types that were not walked keep their newest record, which the other buffer holds
+  if (newest_) {
+    for (uint32_t slot = 0; slot < slots_.size(); ++slot) {
+      const Slot& state = slots_[slot];
+      if (state.alive && back->written[slot] != state.latest) {
+        records[slot] = newest_->records[slot];
+        back->written[slot] = state.latest;
+      }
+    }
+  }
+
+  SnapshotEventHeader header = {frame,
+                                job.walked_mask,
+                                static_cast<uint32_t>(removed_.size()),
+                                static_cast<uint32_t>(added_.size()),
+                                static_cast<uint32_t>(updated_.size() / 2),
+                                static_cast<uint32_t>(slots_.size()),
+                                {}};
+  std::vector<uint32_t>& events = back->events;
+  events.resize(sizeof(header) / sizeof(uint32_t) + removed_.size() + added_.size() + updated_.size());
+  uint32_t* out = events.data();
+  std::memcpy(out, &header, sizeof(header));
+  out += sizeof(header) / sizeof(uint32_t);
+  out = std::copy(removed_.begin(), removed_.end(), out);
+  out = std::copy(added_.begin(), added_.end(), out);
+  std::copy(updated_.begin(), updated_.end(), out);
+}
+
+}  // namespace d2r
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "spsc_ring.h"
+#include "unit_snapshot.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace d2r {
+
+// Records of one capture, filled on the script thread while the game lock is held and handed to the worker.
+struct SnapshotJob {
+  std::vector<UnitSnapshotRecord> records;  // grown by the capture, |count| are valid
+  std::size_t count = 0;
+  std::array<uint32_t, kUnitTypeCount + 1> firsts{};  // record index each type starts at, then |count|
+  uint32_t walked_mask = 0;
+  uint32_t diffed_mask = 0;  // types whose UnitSnapshotRecord::changed the capture already filled
+  uint32_t frame = 0;  // set by Submit
+};
+
+// Header of SnapshotResult::events, followed by the removed slots, the added slots and an (slot, changed) pair per
+// walked unit. Mirrored by lib/d2r/object-manager.js.
+struct SnapshotEventHeader {
+  uint32_t frame;
+  uint32_t walked_mask;
+  uint32_t removed_count;
+  uint32_t added_count;
+  uint32_t updated_count;
+  uint32_t slot_count;  // records in SnapshotResult::records
+  uint32_t reserved[2];
+};
+static_assert(sizeof(SnapshotEventHeader) == 8 * sizeof(uint32_t));
+
+// One side of the double buffer. Every tracked unit keeps its slot in |records| for as long as it is seen, so a
+// record offset handed to scripts stays valid across results and only the events have to be dispatched.
+struct SnapshotResult {
+  std::shared_ptr<UnitSnapshotRecord[]> records;  // shared with the ArrayBuffers handed out over it
+  std::size_t capacity = 0;
+  std::vector<uint32_t> written;  // frame each slot of this buffer was last written in
+  std::vector<uint32_t> events;   // SnapshotEventHeader and the event lists
+};
+
+// Moves the per-record work of a tick (diffing records against the previous capture, matching them to tracked
+// units, placing them, finding the removed ones) off the script thread and out of the game lock. The script thread
+// captures into a SnapshotJob under the game lock and submits it, a worker thread turns it into the back
+// SnapshotResult and Swap hands that to the script in O(1), returning the previous one to the worker. Jobs and
+// results only change hands through single-producer/single-consumer rings, the worker sleeps on an atomic counter
+// the script thread bumps.
+//
+// Results lag the submitted captures by the worker's latency, a result that was not swapped in yet makes the
+// worker wait, and captures are skipped while both jobs are with the worker.
+class SnapshotPipeline {
+ public:
+  SnapshotPipeline();
+  ~SnapshotPipeline();
+
+  SnapshotPipeline(const SnapshotPipeline&) = delete;
+  SnapshotPipeline& operator=(const SnapshotPipeline&) = delete;
+
+  // Script thread. A free job to capture into, nullptr while the worker holds both.
+  SnapshotJob* AcquireJob();
+  void Submit(SnapshotJob* job);
+
+  // Script thread. The result of the oldest finished job, which becomes front(), nullptr if none finished since the
+  // last call. The previous front goes back to the worker, views over its records must not be read anymore.
+  const SnapshotResult* Swap();
+  const SnapshotResult* front() const { return front_; }
+
+ private:
+  static constexpr std::size_t kJobCount = 2;
+
+  struct Slot {
+    uint64_t key = 0;  // type << 32 | id
+    uint32_t type = 0;
+    uint32_t seen = 0;    // frame the unit was last captured in
+    uint32_t latest = 0;  // frame of its newest record
+    uint32_t update = 0;  // index of its updated event in the current frame
+    bool alive = false;
+  };
+
+  void WorkerLoop();
+  void Process(SnapshotJob& job, SnapshotResult* back);
+  uint32_t AllocateSlot(uint64_t key, uint32_t type, uint32_t frame);
+  void Wake();
+
+  std::array<SnapshotJob, kJobCount> jobs_;
+  std::array<SnapshotResult, 2> results_;
+  SpscRing<SnapshotJob*, kJobCount> free_jobs_;     // worker -> script
+  SpscRing<SnapshotJob*, kJobCount> pending_jobs_;  // script -> worker
+  SpscRing<SnapshotResult*, 2> free_results_;       // script -> worker
+  SpscRing<SnapshotResult*, 2> done_results_;       // worker -> script
+  SnapshotResult* front_ = nullptr;                 // script thread
+  uint32_t next_frame_ = 1;                         // script thread
+
+  // worker state
+  std::array<UnitChangeTracker, kUnitTypeCount> change_trackers_;
+  std::unordered_map<uint64_t, uint32_t> slot_index_;
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+  std::vector<uint32_t> record_slots_;
+  std::vector<uint32_t> pending_;  // record indices of units without a slot yet
+  std::vector<uint32_t> removed_;
+  std::vector<uint32_t> added_;
+  std::vector<uint32_t> updated_;
+  const SnapshotResult* newest_ = nullptr;
+
+  std::atomic<uint32_t> wake_{0};
+  std::atomic<bool> running_{true};
+  std::thread worker_;
+};
+
+}  // namespace d2r
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace d2r {
+
+// Bounded single-producer/single-consumer ring. The producer only stores |tail_| and the consumer only stores
+// |head_|, each side caches the other's cursor and reloads it when the ring looks full (or empty), so a push or pop
+// is a relaxed load of its own cursor and one release store. Both sides keep their fields on separate cache lines.
+template <typename T, std::size_t kCapacity>
+class SpscRing {
+  static_assert(std::has_single_bit(kCapacity), "capacity must be a power of two");
+
+ public:
+  // Producer side. Returns false if the ring is full.
+  bool TryPush(const T& value) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == kCapacity) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == kCapacity) {
+        return false;
+      }
+    }
+    slots_[tail & (kCapacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Returns false if the ring is empty.
+  bool TryPop(T* out) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return false;
+      }
+    }
+    *out = slots_[head & (kCapacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  alignas(64) std::atomic<uint64_t> head_{0};
+  uint64_t tail_cache_ = 0;
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  uint64_t head_cache_ = 0;
+  alignas(64) std::array<T, kCapacity> slots_{};
+};
+
+}  // namespace d2r
@@ -0,0 +1,74 @@
+#include "stat_list.h"
+
+#include "metrics.h"
+
+#include <cstring>
+
+namespace d2r {
+
+// a unit has a few dozen stats, a fully rolled item with auras a few hundred, anything above is a corrupted list
+constexpr uint64_t kMaxStatCount = 0x400;
+// entries are never removed one by one, the cache starts over once this many units were read
+constexpr std::size_t kMaxCachedUnits = 0x4000;
+
+static bool CheckStats(const D2StatsArrayStrc& stats, SafeReader& reader) {
+  if (stats.nStatCount == 0) {
+    return true;
+  }
+  return stats.nStatCount <= kMaxStatCount && reader.IsReadable(stats.pStat, stats.nStatCount * sizeof(D2StatStrc));
+}
+
+static bool SameStats(const StatEntry* copy, const D2StatStrc* stats, std::size_t size) {
+  return size == 0 || std::memcmp(copy, stats, size) == 0;
+}
+
+bool StatListCache::Read(const D2UnitStrc* unit, SafeReader& reader, StatListCopy* copy) {
+  if (!reader.IsReadable(unit, sizeof(D2UnitStrc))) {
+    return false;
+  }
+  const D2StatListExStrc* list = reader.Check(unit->pStatListEx);
+  if (list == nullptr || !CheckStats(list->tBaseStats, reader) || !CheckStats(list->tFullStats, reader)) {
+    return false;
+  }
+
+  if (entries_.size() >= kMaxCachedUnits && !entries_.contains(reinterpret_cast<uint64_t>(unit))) {
+    entries_.clear();
+  }
+  Entry& entry = entries_[reinterpret_cast<uint64_t>(unit)];
+  auto base_count = static_cast<uint32_t>(list->tBaseStats.nStatCount);
+  auto full_count = static_cast<uint32_t>(list->tFullStats.nStatCount);
+  std::size_t base_size = base_count * sizeof(StatEntry);
+  std::size_t full_size = full_count * sizeof(StatEntry);
+
+  // same arrays as last time, the values are compared against the copy, which costs no more than copying them
+  bool unchanged = entry.version != 0 && entry.list == list && entry.base_stats == list->tBaseStats.pStat &&
+                   entry.full_stats == list->tFullStats.pStat && entry.base_count == base_count &&
+                   entry.stats.size() == base_count + full_count &&
+                   SameStats(entry.stats.data(), list->tBaseStats.pStat, base_size) &&
+                   SameStats(entry.stats.data() + base_count, list->tFullStats.pStat, full_size);
+  Metrics::Add(unchanged ? Metric::StatListHits : Metric::StatListMisses);
+  if (!unchanged) {
+    entry.list = list;
+    entry.base_stats = list->tBaseStats.pStat;
+    entry.full_stats = list->tFullStats.pStat;
+    entry.base_count = base_count;
+    entry.stats.resize(base_count + full_count);
+    if (base_size) {
+      std::memcpy(entry.stats.data(), list->tBaseStats.pStat, base_size);
+    }
+    if (full_size) {
+      std::memcpy(entry.stats.data() + base_count, list->tFullStats.pStat, full_size);
+    }
+    entry.version = next_version_++;
+    if (next_version_ == 0) {
+      next_version_ = 1;
+    }
+  }
+
+  copy->version = entry.version;
+  copy->base = std::span<const StatEntry>(entry.stats.data(), base_count);
+  copy->full = std::span<const StatEntry>(entry.stats.data() + base_count, full_count);
+  return true;
+}
+
+}  // namespace d2r
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "d2r_structs.h"
+#include "safe_read.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace d2r {
+
+// One stat as returned to scripts, same layout as D2StatStrc. The layout is mirrored by lib/d2r/stat-list.js.
+struct StatEntry {
+  uint16_t layer;
+  uint16_t stat_id;
+  int32_t value;
+};
+static_assert(sizeof(StatEntry) == sizeof(D2StatStrc));
+
+// Flattened copy of one unit's stat lists.
+struct StatListCopy {
+  uint32_t version = 0;  // changes whenever the copy does, never 0 for a filled copy
+  std::span<const StatEntry> base;
+  std::span<const StatEntry> full;
+};
+
+// Keeps the last copy of the base and full stat arrays per unit and only refreshes it when the unit's stat list
+// moved (pStatListEx or the array pointers/counts) or the stored values differ, so a script that polls the stats of
+// many units every tick only decodes the ones that changed.
+class StatListCache {
+ public:
+  // Reads the stat lists of |unit|. |copy| stays valid until the next call. Returns false if the unit or its stat
+  // list are not readable.
+  bool Read(const D2UnitStrc* unit, SafeReader& reader, StatListCopy* copy);
+
+  std::size_t size() const { return entries_.size(); }
+  void Clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    const D2StatListExStrc* list = nullptr;
+    const D2StatStrc* base_stats = nullptr;
+    const D2StatStrc* full_stats = nullptr;
+    uint32_t base_count = 0;
+    uint32_t version = 0;
+    std::vector<StatEntry> stats;  // base stats followed by the full stats
+  };
+
+  std::unordered_map<uint64_t, Entry> entries_;  // by unit address
+  uint32_t next_version_ = 1;
+};
+
+}  // namespace d2r
@@ -0,0 +1,198 @@
+#include "trace.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace d2r {
+namespace trace {
+
+namespace {
+
+constexpr std::size_t kMaxDepth = 32;
+
+// Seqlock style slot: the writer bumps |seq| to an odd value while the fields are being written and to the next
+// even value once they are complete, readers discard slots whose sequence changed under them.
+struct Slot {
+  std::atomic<uint64_t> seq{0};
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint64_t> start_ns{0};
+  std::atomic<uint64_t> duration_ns{0};
+};
+
+struct ThreadRing {
+  uint32_t tid = 0;
+  std::atomic<uint64_t> head{0};
+  std::array<Slot, kRingCapacity> slots;
+};
+
+struct ThreadStack {
+  const char* names[kMaxDepth];
+  uint64_t starts[kMaxDepth];
+  std::size_t depth = 0;
+};
+
+std::atomic<bool> s_enabled{false};
+
+std::mutex s_rings_mutex;
+std::vector<std::unique_ptr<ThreadRing>> s_rings;
+
+std::mutex s_names_mutex;
+std::unordered_set<std::string> s_names;
+
+thread_local ThreadRing* t_ring = nullptr;
+thread_local ThreadStack t_stack;
+
+ThreadRing* GetThreadRing() {
+  if (t_ring == nullptr) {
+    auto ring = std::make_unique<ThreadRing>();
+    std::lock_guard lock(s_rings_mutex);
+    ring->tid = static_cast<uint32_t>(s_rings.size() + 1);
+    t_ring = ring.get();
+    s_rings.push_back(std::move(ring));
+  }
+  return t_ring;
+}
+
+void AppendEscaped(std::string& out, const char* str) {
+  for (; *str; ++str) {
+    char c = *str;
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+      out += buf;
+    } else {
+      out += c;
+    }
+  }
+}
+
+}  // namespace
+
+bool IsEnabled() {
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+void SetEnabled(bool enabled) {
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t NowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+void Record(const char* name, uint64_t start_ns, uint64_t end_ns) {
+  ThreadRing* ring = GetThreadRing();
+  uint64_t idx = ring->head.load(std::memory_order_relaxed);
+  Slot& slot = ring->slots[idx % kRingCapacity];
+
+  slot.seq.store(2 * idx + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start_ns.store(start_ns, std::memory_order_relaxed);
+  slot.duration_ns.store(end_ns - start_ns, std::memory_order_relaxed);
+  slot.seq.store(2 * idx + 2, std::memory_order_release);
+
+  ring->head.store(idx + 1, std::memory_order_release);
+}
+
+void Begin(const char* name) {
+  ThreadStack& stack = t_stack;
+  if (stack.depth >= kMaxDepth) {
+    ++stack.depth;  // keep Begin/End balanced, the span is dropped
+    return;
+  }
+  stack.names[stack.depth] = name;
+  stack.starts[stack.depth] = name != nullptr && IsEnabled() ? NowNs() : 0;
+  ++stack.depth;
+}
+
+void End() {
+  ThreadStack& stack = t_stack;
+  if (stack.depth == 0) {
+    return;
+  }
+  --stack.depth;
+  if (stack.depth >= kMaxDepth) {
+    return;
+  }
+  uint64_t start_ns = stack.starts[stack.depth];
+  if (start_ns != 0) {
+    Record(stack.names[stack.depth], start_ns, NowNs());
+  }
+}
+
+const char* InternName(std::string_view name) {
+  std::lock_guard lock(s_names_mutex);
+  auto it = s_names.emplace(name).first;
+  return it->c_str();
+}
+
+std::string DumpChromeTrace() {
+  std::string out;
+  out.reserve(1 << 16);
+  out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+  bool first = true;
+  char buf[128];
+  std::lock_guard lock(s_rings_mutex);
+  for (const auto& ring : s_rings) {
+    std::snprintf(buf,
+                  sizeof(buf),
+                  "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                  first ? "" : ",",
+                  ring->tid,
+                  ring->tid);
+    out += buf;
+    first = false;
+
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t begin = head > kRingCapacity ? head - kRingCapacity : 0;
+    for (uint64_t idx = begin; idx < head; ++idx) {
+      const Slot& slot = ring->slots[idx % kRingCapacity];
+      uint64_t seq = slot.seq.load(std::memory_order_acquire);
+      const char* name = slot.name.load(std::memory_order_relaxed);
+      uint64_t start_ns = slot.start_ns.load(std::memory_order_relaxed);
+      uint64_t duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq != 2 * idx + 2 || slot.seq.load(std::memory_order_relaxed) != seq || name == nullptr) {
+        continue;  // overwritten or torn while we were reading it
+      }
+
+      out += ",{\"name\":\"";
+      AppendEscaped(out, name);
+      std::snprintf(buf,
+                    sizeof(buf),
+                    "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    ring->tid,
+                    static_cast<double>(start_ns) / 1000.0,
+                    static_cast<double>(duration_ns) / 1000.0);
+      out += buf;
+    }
+  }
+
+  out += "]}";
+  return out;
+}
+
+void Clear() {
+  std::lock_guard lock(s_rings_mutex);
+  for (const auto& ring : s_rings) {
+    for (auto& slot : ring->slots) {
+      slot.seq.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace trace
+}  // namespace d2r
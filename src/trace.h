@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace d2r {
+
+// Lightweight span tracing.
+//
+// Every thread records completed spans into its own fixed-size ring buffer. A ring has exactly one writer (the
+// owning thread) so recording is a couple of relaxed stores and one release store, no locks. The rings are
+// serialized as Chrome trace-event JSON which can be opened directly in Perfetto or chrome://tracing.
+//
+// Recording is disabled by default, a disabled span costs a single relaxed load.
+namespace trace {
+
+constexpr std::size_t kRingCapacity = 1 << 14;  // spans per thread, oldest spans are overwritten
+
+bool IsEnabled();
+void SetEnabled(bool enabled);
+
+uint64_t NowNs();
+
+// |name| must outlive the trace, use InternName() for names that are not string literals.
+void Record(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+// Begin/End pairs for callers that cannot use ScopedSpan (script bindings). Nesting depth is limited, unmatched
+// End() calls are ignored. A null |name| pushes a span that is never recorded.
+void Begin(const char* name);
+void End();
+
+const char* InternName(std::string_view name);
+
+std::string DumpChromeTrace();
+void Clear();
+
+class ScopedSpan {
+ public:
+  explicit ScopedSpan(const char* name) : name_(name), start_ns_(IsEnabled() ? NowNs() : 0) {}
+  ~ScopedSpan() {
+    if (start_ns_ != 0) {
+      Record(name_, start_ns_, NowNs());
+    }
+  }
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+ private:
+  const char* name_;
+  uint64_t start_ns_;
+};
+
+}  // namespace trace
+
+#define D2R_TRACE_CONCAT_INNER(a, b) a##b
+#define D2R_TRACE_CONCAT(a, b) D2R_TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(name) ::d2r::trace::ScopedSpan D2R_TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+}  // namespace d2r
@@ -0,0 +1,272 @@
+#include "unit_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace d2r {
+
+// upper bound for a single bucket chain, guards against walking a chain that was relinked into a cycle
+constexpr std::size_t kMaxChainLength = 0x10000;
+// sanity bound for D2ActiveRoomStrc::dwNumRooms, a loaded room has a handful of neighbors
+constexpr uint32_t kMaxNearRooms = 64;
+
+D2UnitStrc* FindUnit(const EntityHashTable& table, uint32_t id, SafeReader& reader) {
+  for (std::size_t i = id & 0x7F; i < kUnitHashTableCount; ++i) {
+    // same cycle detection as CaptureUnitType, a loop that does not pass through the head is caught as well
+    D2UnitStrc* anchor = nullptr;
+    std::size_t power = 1;
+    std::size_t length = 0;
+    for (D2UnitStrc* current = reader.Check(table[i]); current; current = reader.Check(current->pUnitNext)) {
+      if (current == anchor || length == kMaxChainLength) {
+        break;
+      }
+      if (current->dwId == id) {
+        return current;
+      }
+      if (++length == power) {
+        anchor = current;
+        power <<= 1;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// |unit| was validated by the caller, its dynamic path is checked here.
+static void CopyUnit(const D2UnitStrc* unit,
+                     uint32_t type,
+                     SnapshotSource source,
+                     UnitSnapshotRecord* record,
+                     SafeReader& reader,
+                     ChainWalkStats* stats) {
+  record->address = reinterpret_cast<uint64_t>(unit);
+  record->type = type;
+  record->source = source;
+  record->changed = 0;
+  record->item_rules = 0;
+  std::memcpy(record->unit, unit, sizeof(D2UnitStrc));
+
+  D2DynamicPathStrc* path = HasDynamicPath(type) ? unit->pDynamicPath : nullptr;
+  if (path && !reader.IsReadable(path, sizeof(D2DynamicPathStrc))) {
+    ++stats->bad_pointers;
+    path = nullptr;
+  }
+  record->path_address = reinterpret_cast<uint64_t>(path);
+  if (path) {
+    std::memcpy(record->path, path, sizeof(D2DynamicPathStrc));
+  }
+}
+
+std::size_t CaptureUnitType(const EntityHashTable* tables,
+                            uint32_t type,
+                            SnapshotSource source,
+                            UnitSnapshotRecord* out,
+                            std::size_t offset,
+                            std::size_t capacity,
+                            SafeReader& reader,
+                            ChainWalkStats* stats) {
+  if (tables == nullptr || type >= kUnitTypeCount || !reader.IsReadable(&tables[type], sizeof(EntityHashTable))) {
+    return offset;
+  }
+
+  std::size_t count = offset;
+  for (std::size_t bucket = 0; bucket < kUnitHashTableCount; ++bucket) {
+    // Brent's cycle detection: |anchor| jumps forward to the current unit every power-of-two steps, a chain that
+    // loops back is caught within two cycle lengths
+    D2UnitStrc* anchor = nullptr;
+    std::size_t power = 1;
+    std::size_t length = 0;
+    for (D2UnitStrc* unit = tables[type][bucket]; unit; unit = unit->pUnitNext) {
+      if (unit == anchor) {
+        ++stats->cycles;
+        break;
+      }
+      if (length == kMaxChainLength) {
+        ++stats->truncated;
+        break;
+      }
+      if (!reader.IsReadable(unit, sizeof(D2UnitStrc))) {
+        ++stats->bad_pointers;
+        break;
+      }
+      if (unit->dwUnitType != type) {
+        ++stats->type_mismatches;
+        break;
+      }
+      if (++length == power) {
+        anchor = unit;
+        power <<= 1;
+      }
+
+      if (count < capacity) {
+        CopyUnit(unit, type, source, &out[count], reader, stats);
+      }
+      ++count;
+    }
+  }
+  return count;
+}
+
+std::size_t CaptureUnitTable(const EntityHashTable* tables,
+                             SnapshotSource source,
+                             UnitSnapshotRecord* out,
+                             std::size_t offset,
+                             std::size_t capacity,
+                             SafeReader& reader,
+                             ChainWalkStats* stats) {
+  if (tables == nullptr || !reader.IsReadable(tables, sizeof(EntityHashTable) * kUnitTypeCount)) {
+    return offset;
+  }
+
+  std::size_t count = offset;
+  for (uint32_t type = 0; type < kUnitTypeCount; ++type) {
+    count = CaptureUnitType(tables, type, source, out, count, capacity, reader, stats);
+  }
+  return count;
+}
+
+std::size_t CollectRoomUnits(const D2ActiveRoomStrc* origin,
+                             uint32_t radius,
+                             RoomUnitLists* units,
+                             SafeReader& reader,
+                             ChainWalkStats* stats) {
+  for (auto& list : *units) {
+    list.clear();
+  }
+  if (origin == nullptr || !reader.IsReadable(origin, sizeof(D2ActiveRoomStrc))) {
+    return 0;
+  }
+
+  // breadth-first over the near-room lists, |rooms| doubles as the visited set (a few dozen rooms at most)
+  std::vector<const D2ActiveRoomStrc*> rooms{origin};
+  std::size_t ring_begin = 0;
+  for (uint32_t ring = 0; ring < radius && ring_begin < rooms.size(); ++ring) {
+    std::size_t ring_end = rooms.size();
+    for (std::size_t i = ring_begin; i < ring_end; ++i) {
+      const D2ActiveRoomStrc* room = rooms[i];
+      uint32_t near_count = std::min<uint32_t>(room->dwNumRooms, kMaxNearRooms);
+      if (near_count == 0 || !reader.IsReadable(room->ptRoomList, near_count * sizeof(D2ActiveRoomStrc*))) {
+        continue;
+      }
+      for (uint32_t n = 0; n < near_count; ++n) {
+        const D2ActiveRoomStrc* near_room = room->ptRoomList[n];
+        if (near_room == nullptr || std::find(rooms.begin(), rooms.end(), near_room) != rooms.end()) {
+          continue;
+        }
+        if (!reader.IsReadable(near_room, sizeof(D2ActiveRoomStrc))) {
+          ++stats->bad_pointers;
+          continue;
+        }
+        rooms.push_back(near_room);
+      }
+    }
+    ring_begin = ring_end;
+  }
+
+  for (const D2ActiveRoomStrc* room : rooms) {
+    D2UnitStrc* anchor = nullptr;
+    std::size_t power = 1;
+    std::size_t length = 0;
+    for (D2UnitStrc* unit = room->ptUnitFirst; unit; unit = unit->pRoomUnitNext) {
+      if (unit == anchor) {
+        ++stats->cycles;
+        break;
+      }
+      if (length == kMaxChainLength) {
+        ++stats->truncated;
+        break;
+      }
+      if (!reader.IsReadable(unit, sizeof(D2UnitStrc))) {
+        ++stats->bad_pointers;
+        break;
+      }
+      if (unit->dwUnitType >= kUnitTypeCount) {
+        ++stats->type_mismatches;
+        break;
+      }
+      if (++length == power) {
+        anchor = unit;
+        power <<= 1;
+      }
+      (*units)[unit->dwUnitType].push_back(unit);
+    }
+  }
+  return rooms.size();
+}
+
+std::size_t CaptureUnitList(std::span<D2UnitStrc* const> units,
+                            uint32_t type,
+                            SnapshotSource source,
+                            UnitSnapshotRecord* out,
+                            std::size_t offset,
+                            std::size_t capacity,
+                            SafeReader& reader,
+                            ChainWalkStats* stats) {
+  std::size_t count = offset;
+  for (D2UnitStrc* unit : units) {
+    if (count < capacity) {
+      CopyUnit(unit, type, source, &out[count], reader, stats);
+    }
+    ++count;
+  }
+  return count;
+}
+
+uint64_t SnapshotRecordKey(const UnitSnapshotRecord& record) {
+  uint32_t id;
+  std::memcpy(&id, record.unit + offsetof(D2UnitStrc, dwId), sizeof(id));
+  return (static_cast<uint64_t>(record.source) << 40) | (static_cast<uint64_t>(record.type) << 32) | id;
+}
+
+UnitChangeTracker::State UnitChangeTracker::Capture(const UnitSnapshotRecord& record) {
+  const auto* unit = reinterpret_cast<const D2UnitStrc*>(record.unit);
+  State state{};
+  state.data = reinterpret_cast<uint64_t>(unit->pPlayerData);
+  state.position = (static_cast<uint32_t>(unit->wPosY) << 16) | unit->wPosX;
+  state.mode = unit->dwMode;
+  state.flags = unit->dwFlags;
+  state.flags_ex = unit->dwFlagsEx;
+  if (record.path_address) {
+    const auto* path = reinterpret_cast<const D2DynamicPathStrc*>(record.path);
+    std::memcpy(&state.game_coords, &path->tGameCoords, sizeof(state.game_coords));
+    std::memcpy(&state.target, &path->tTargetCoord, sizeof(state.target));
+    std::memcpy(&state.final_target, &path->tFinalTargetCoord, sizeof(state.final_target));
+  }
+  return state;
+}
+
+uint32_t UnitChangeTracker::Diff(const State& previous, const State& current) {
+  uint32_t changed = 0;
+  if (previous.position != current.position || previous.game_coords != current.game_coords) {
+    changed |= unit_change::kPosition;
+  }
+  if (previous.mode != current.mode) {
+    changed |= unit_change::kMode;
+  }
+  if (previous.flags != current.flags || previous.flags_ex != current.flags_ex) {
+    changed |= unit_change::kFlags;
+  }
+  if (previous.data != current.data) {
+    changed |= unit_change::kData;
+  }
+  if (previous.target != current.target || previous.final_target != current.final_target) {
+    changed |= unit_change::kPathTarget;
+  }
+  return changed;
+}
+
+void UnitChangeTracker::Update(UnitSnapshotRecord* records, std::size_t count) {
+  current_.clear();
+  current_.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    UnitSnapshotRecord& record = records[i];
+    uint64_t key = SnapshotRecordKey(record);
+    State state = Capture(record);
+    auto it = previous_.find(key);
+    record.changed = it == previous_.end() ? unit_change::kAll : Diff(it->second, state);
+    current_.insert_or_assign(key, state);
+  }
+  previous_.swap(current_);
+}
+
+}  // namespace d2r
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "d2r_structs.h"
+#include "safe_read.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace d2r {
+
+// dwUnitType, also the index of the unit's hash table. Mirrored by UnitTypes in lib/d2r/types.js.
+enum UnitType : uint32_t {
+  kUnitPlayer = 0,
+  kUnitMonster = 1,
+  kUnitObject = 2,
+  kUnitMissile = 3,
+  kUnitItem = 4,
+  kUnitTile = 5,
+};
+
+constexpr uint32_t kUnitTypeCount = 6;
+constexpr uint32_t kAllUnitTypes = (1u << kUnitTypeCount) - 1;
+
+enum class SnapshotSource : uint32_t {
+  kClient = 0,
+  kServer = 1,
+};
+
+// Bits of UnitSnapshotRecord::changed, mirrored by UnitFields in lib/d2r/types.js.
+namespace unit_change {
+constexpr uint32_t kPosition = 1u << 0;    // wPosX/wPosY or the dynamic path's game coords
+constexpr uint32_t kMode = 1u << 1;        // dwMode
+constexpr uint32_t kFlags = 1u << 2;       // dwFlags/dwFlagsEx
+constexpr uint32_t kData = 1u << 3;        // p*Data pointer
+constexpr uint32_t kPathTarget = 1u << 4;  // target or final target coord of the dynamic path
+constexpr uint32_t kAdded = 1u << 31;      // not present in the previous snapshot
+constexpr uint32_t kAll = 0xFFFFFFFFu;
+}  // namespace unit_change
+
+// One reachable unit, copied verbatim while the game lock is held. Everything after the copy (decoding, diffing,
+// event dispatch) works on these records and no longer needs the lock. The layout is mirrored by
+// lib/d2r/unit-snapshot.js.
+struct UnitSnapshotRecord {
+  uint64_t address;       // D2UnitStrc*
+  uint64_t path_address;  // D2DynamicPathStrc*, 0 if the unit has no dynamic path or it was not copied
+  uint32_t type;          // hash table the unit was found in, equals unit.dwUnitType
+  SnapshotSource source;
+  uint32_t changed;     // unit_change bits relative to the previous snapshot, see UnitChangeTracker
+  uint32_t item_rules;  // ItemRuleProgram matches of an item, see ItemRuleMatcher. 0 for the other types
+  uint8_t unit[sizeof(D2UnitStrc)];
+  uint8_t path[sizeof(D2DynamicPathStrc)];
+};
+static_assert(offsetof(UnitSnapshotRecord, changed) == 0x18);
+static_assert(offsetof(UnitSnapshotRecord, unit) == 0x20);
+static_assert(offsetof(UnitSnapshotRecord, path) == 0x1E0);
+static_assert(sizeof(UnitSnapshotRecord) == 0x410);
+
+// Identifies the same unit across snapshots.
+uint64_t SnapshotRecordKey(const UnitSnapshotRecord& record);
+
+// Only players, monsters and missiles own a D2DynamicPathStrc, the other types point at a (smaller) static path.
+constexpr bool HasDynamicPath(uint32_t type) {
+  return type == kUnitPlayer || type == kUnitMonster || type == kUnitMissile;
+}
+
+// Looks up |id| starting at its bucket, same probing as the game's GetUnit. Chains are validated through |reader|
+// and end at the first bad pointer or when they link back to their head.
+D2UnitStrc* FindUnit(const EntityHashTable& table, uint32_t id, SafeReader& reader);
+
+// Chains that were cut short during a capture.
+struct ChainWalkStats {
+  uint32_t bad_pointers = 0;     // unreadable unit or path pointer
+  uint32_t type_mismatches = 0;  // unit does not belong to the table it was linked into, most likely freed
+  uint32_t cycles = 0;
+  uint32_t truncated = 0;  // hit kMaxChainLength
+};
+
+// Walks the bucket chains of |tables|[|type|] only, otherwise the same as CaptureUnitTable. Lets a caller refresh
+// some unit types more often than others.
+std::size_t CaptureUnitType(const EntityHashTable* tables,
+                            uint32_t type,
+                            SnapshotSource source,
+                            UnitSnapshotRecord* out,
+                            std::size_t offset,
+                            std::size_t capacity,
+                            SafeReader& reader,
+                            ChainWalkStats* stats);
+
+// Walks every bucket chain of |tables| (kUnitTypeCount consecutive EntityHashTables) and copies up to |capacity|
+// records into |out|, starting at |out[offset]|. Returns the number of records the walk produced, which may exceed
+// |capacity| - the caller is expected to grow the arena and capture again. Every pointer is validated through
+// |reader|, a chain stops at the first bad pointer or when it loops back on itself.
+std::size_t CaptureUnitTable(const EntityHashTable* tables,
+                             SnapshotSource source,
+                             UnitSnapshotRecord* out,
+                             std::size_t offset,
+                             std::size_t capacity,
+                             SafeReader& reader,
+                             ChainWalkStats* stats);
+
+// Units found by CollectRoomUnits, one list per unit type.
+using RoomUnitLists = std::array<std::vector<D2UnitStrc*>, kUnitTypeCount>;
+
+// Collects the units linked into |origin| and the rooms up to |radius| hops away through the near-room lists
+// (ptRoomList/dwNumRooms, radius 0 is |origin| alone) by following ptUnitFirst/pRoomUnitNext. Only sees units
+// placed in a loaded room, inventory items and far away units are skipped. Returns the number of rooms visited.
+std::size_t CollectRoomUnits(const D2ActiveRoomStrc* origin,
+                             uint32_t radius,
+                             RoomUnitLists* units,
+                             SafeReader& reader,
+                             ChainWalkStats* stats);
+
+// Copies the records of |units| (validated, all of |type|) like CaptureUnitType does for a hash table chain.
+std::size_t CaptureUnitList(std::span<D2UnitStrc* const> units,
+                            uint32_t type,
+                            SnapshotSource source,
+                            UnitSnapshotRecord* out,
+                            std::size_t offset,
+                            std::size_t capacity,
+                            SafeReader& reader,
+                            ChainWalkStats* stats);
+
+// Remembers the compared fields of every unit in the previous snapshot and fills UnitSnapshotRecord::changed of
+// the current one. Runs on the copied records, so it does not touch game memory.
+class UnitChangeTracker {
+ public:
+  void Update(UnitSnapshotRecord* records, std::size_t count);
+  // Forgets the previous snapshot, the next Update reports every unit as changed.
+  void Clear() { previous_.clear(); }
+
+ private:
+  struct State {
+    uint64_t data;
+    uint64_t game_coords;
+    uint32_t position;
+    uint32_t mode;
+    uint32_t flags;
+    uint32_t flags_ex;
+    uint32_t target;
+    uint32_t final_target;
+  };
+
+  static State Capture(const UnitSnapshotRecord& record);
+  static uint32_t Diff(const State& previous, const State& current);
+
+  std::unordered_map<uint64_t, State> previous_;
+  std::unordered_map<uint64_t, State> current_;
+};
+
+}  // namespace d2r
@@ -0,0 +1,185 @@
+#include "widget_tree.h"
+
+#include <cstring>
+
+namespace d2r {
+
+// the game's UI has a few thousand widgets, anything above is a corrupted tree
+constexpr std::size_t kMaxWidgets = 0x4000;
+constexpr uint64_t kMaxWidgetChildren = 0x1000;
+constexpr uint32_t kMaxWidgetDepth = 64;
+constexpr uint64_t kMaxWidgetNameLength = 0x100;
+
+uint32_t WidgetNameHash(std::string_view name) {
+  uint32_t hash = 0x811C9DC5;
+  for (char c : name) {
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+    hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193;
+  }
+  return hash;
+}
+
+static std::string_view ReadName(const Widget& widget, SafeReader& reader) {
+  const string& name = widget.szName;
+  if (name.m_size == 0 || name.m_size > kMaxWidgetNameLength || !reader.IsReadable(name.m_elements, name.m_size)) {
+    return {};
+  }
+  return {name.m_elements, name.m_size};
+}
+
+// Child vector of |widget|, empty if it is not readable or implausibly large.
+static std::span<Widget* const> ReadChildren(const Widget& widget, SafeReader& reader) {
+  const vector<Widget*>& children = widget.ptChildren;
+  if (children.m_size == 0 || children.m_size > kMaxWidgetChildren ||
+      !reader.IsReadable(children.m_elements, children.m_size * sizeof(Widget*))) {
+    return {};
+  }
+  return {children.m_elements, children.m_size};
+}
+
+bool WidgetTree::Update(const Widget* root, const FocusManager* focus, SafeReader& reader) {
+  if (!reader.IsReadable(root, sizeof(Widget))) {
+    if (!entries_.empty()) {
+      nodes_.clear();
+      children_.clear();
+      entries_.clear();
+      names_.clear();
+      indices_.clear();
+      hover_panel_ = hover_widget_ = -1;
+      Bump();
+      structure_version_ = version_;
+    }
+    return false;
+  }
+
+  bool rebuilt = StructureChanged(root, reader);
+  if (rebuilt) {
+    Rebuild(root, reader);
+  }
+  if (Refresh(focus, reader) || rebuilt) {
+    Bump();
+    if (rebuilt) {
+      structure_version_ = version_;
+    }
+  }
+  return true;
+}
+
+bool WidgetTree::StructureChanged(const Widget* root, SafeReader& reader) const {
+  if (nodes_.empty() || nodes_[0].widget != root) {
+    return true;
+  }
+  for (const Node& node : nodes_) {
+    if (!reader.IsReadable(node.widget, sizeof(Widget))) {
+      return true;
+    }
+    const vector<Widget*>& children = node.widget->ptChildren;
+    if (children.m_elements != node.children || children.m_size != node.vector_size) {
+      return true;
+    }
+    // the buffer is reused when a child is replaced in place
+    if (node.child_count &&
+        (!reader.IsReadable(node.children, node.child_count * sizeof(Widget*)) ||
+         std::memcmp(node.children, &children_[node.child_offset], node.child_count * sizeof(Widget*)) != 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WidgetTree::Rebuild(const Widget* root, SafeReader& reader) {
+  nodes_.clear();
+  children_.clear();
+  entries_.clear();
+  names_.clear();
+  indices_.clear();
+
+  struct Pending {
+    const Widget* widget;
+    int32_t parent;
+    uint32_t depth;
+  };
+  std::vector<Pending> stack = {{root, -1, 0}};
+  while (!stack.empty() && nodes_.size() < kMaxWidgets) {
+    Pending pending = stack.back();
+    stack.pop_back();
+    const Widget* widget = pending.widget;
+    // a widget reachable twice would make the tree a graph
+    if (!reader.IsReadable(widget, sizeof(Widget)) || indices_.contains(widget)) {
+      continue;
+    }
+
+    auto index = static_cast<int32_t>(nodes_.size());
+    std::span<Widget* const> children = ReadChildren(*widget, reader);
+    if (pending.depth + 1 >= kMaxWidgetDepth) {
+      children = {};
+    }
+    nodes_.push_back({widget, widget->ptChildren.m_elements, widget->ptChildren.m_size,
+                      static_cast<uint32_t>(children.size()), static_cast<uint32_t>(children_.size())});
+    children_.insert(children_.end(), children.begin(), children.end());
+    indices_.emplace(widget, index);
+
+    WidgetEntry entry{};
+    entry.name_hash = WidgetNameHash(ReadName(*widget, reader));
+    entry.parent = pending.parent;
+    entry.depth = static_cast<uint8_t>(pending.depth);
+    entry.child_count = static_cast<uint16_t>(children.size());
+    entries_.push_back(entry);
+    names_.emplace_back(ReadName(*widget, reader));
+
+    // pushed in reverse so children come out in order
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+      if (*it) {
+        stack.push_back({*it, index, pending.depth + 1});
+      }
+    }
+  }
+}
+
+bool WidgetTree::Refresh(const FocusManager* focus, SafeReader& reader) {
+  bool changed = false;
+  for (std::size_t i = 0; i < nodes_.size(); ++i) {
+    const Widget* widget = nodes_[i].widget;
+    WidgetEntry& entry = entries_[i];
+    uint8_t flags = (widget->bVisible ? kWidgetVisible : 0) | (widget->bEnabled ? kWidgetEnabled : 0);
+    bool parent_shown = entry.parent < 0 || (entries_[entry.parent].flags & kWidgetShown);
+    if (widget->bVisible && parent_shown) {
+      flags |= kWidgetShown;
+    }
+    const RectInt& rect = widget->tAbsolute;
+    if (flags != entry.flags || rect.left != entry.rect.left || rect.top != entry.rect.top ||
+        rect.right != entry.rect.right || rect.bottom != entry.rect.bottom) {
+      entry.flags = flags;
+      entry.rect = rect;
+      changed = true;
+    }
+  }
+
+  int32_t hover_panel = -1;
+  int32_t hover_widget = -1;
+  if (focus && reader.IsReadable(focus, sizeof(FocusManager))) {
+    hover_panel = IndexOf(focus->ptHoverPanel);
+    hover_widget = IndexOf(focus->ptHoverWidget);
+  }
+  if (hover_panel != hover_panel_ || hover_widget != hover_widget_) {
+    hover_panel_ = hover_panel;
+    hover_widget_ = hover_widget;
+    changed = true;
+  }
+  return changed;
+}
+
+int32_t WidgetTree::IndexOf(const Widget* widget) const {
+  auto it = indices_.find(widget);
+  return it == indices_.end() ? -1 : it->second;
+}
+
+void WidgetTree::Bump() {
+  if (++version_ == 0) {
+    version_ = 1;
+  }
+}
+
+}  // namespace d2r
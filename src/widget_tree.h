@@ -0,0 +1,83 @@
+#pragma once
+
+#include "d2r_structs.h"
+#include "safe_read.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace d2r {
+
+enum WidgetFlags : uint8_t {
+  kWidgetVisible = 0x1,
+  kWidgetEnabled = 0x2,
+  kWidgetShown = 0x4,  // visible along with every ancestor
+};
+
+// One widget of the flattened tree, in depth-first order so a widget's subtree follows it. Mirrored by
+// lib/d2r/widget-tree.js.
+struct WidgetEntry {
+  uint32_t name_hash;  // WidgetNameHash(szName)
+  int32_t parent;      // entry index, -1 for the root
+  RectInt rect;        // tAbsolute: x, y, width, height
+  uint8_t flags;       // WidgetFlags
+  uint8_t depth;
+  uint16_t child_count;
+  uint32_t reserved;
+};
+static_assert(sizeof(WidgetEntry) == 0x20);
+
+// FNV-1a of the lowercased name, widgets are looked up case-insensitively like Widget::GetWidget does.
+uint32_t WidgetNameHash(std::string_view name);
+
+// The widget tree below a root (the PanelManager) flattened into WidgetEntry records. The flattened structure is
+// kept until a child vector changes (another buffer, size or child pointer), otherwise Update only refreshes the
+// rects and flags of the known widgets.
+class WidgetTree {
+ public:
+  // Reads the tree through |reader|. Returns false (and clears the tree) if |root| is not readable.
+  bool Update(const Widget* root, const FocusManager* focus, SafeReader& reader);
+
+  // bumped whenever an entry, the hover indices or the structure changed
+  uint32_t version() const { return version_; }
+  // version of the last rebuild, names and parent indices of older versions are stale
+  uint32_t structure_version() const { return structure_version_; }
+
+  std::span<const WidgetEntry> entries() const { return entries_; }
+  const std::vector<std::string>& names() const { return names_; }
+  // entry indices of FocusManager::ptHoverPanel / ptHoverWidget, -1 if none
+  int32_t hover_panel() const { return hover_panel_; }
+  int32_t hover_widget() const { return hover_widget_; }
+
+ private:
+  struct Node {
+    const Widget* widget;
+    Widget* const* children;  // ptChildren as of the last rebuild
+    uint64_t vector_size;
+    uint32_t child_count;   // children followed, 0 if the vector was not readable
+    uint32_t child_offset;  // into children_
+  };
+
+  bool StructureChanged(const Widget* root, SafeReader& reader) const;
+  void Rebuild(const Widget* root, SafeReader& reader);
+  bool Refresh(const FocusManager* focus, SafeReader& reader);
+  int32_t IndexOf(const Widget* widget) const;
+  void Bump();
+
+  std::vector<Node> nodes_;
+  std::vector<const Widget*> children_;  // every child vector as of the last rebuild
+  std::vector<WidgetEntry> entries_;
+  std::vector<std::string> names_;
+  std::unordered_map<const Widget*, int32_t> indices_;
+  int32_t hover_panel_ = -1;
+  int32_t hover_widget_ = -1;
+  uint32_t version_ = 0;
+  uint32_t structure_version_ = 0;
+};
+
+}  // namespace d2r
@@ -0,0 +1,248 @@
+#include "gzip_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace d2r {
+
+namespace {
+
+constexpr std::size_t kWindowSize = 32768;
+constexpr std::size_t kHashBits = 15;
+constexpr std::size_t kMinMatch = 3;
+constexpr std::size_t kMaxMatch = 258;
+constexpr int kMaxChain = 16;
+
+constexpr std::array<uint32_t, 256> MakeCrcTable() {
+  std::array<uint32_t, 256> table = {};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr std::array<uint32_t, 256> kCrcTable = MakeCrcTable();
+
+// RFC 1951 3.2.5, base value and extra bits of the length codes 257..285 and the distance codes 0..29
+constexpr uint16_t kLengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                      2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,
+                                        129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+                                        12289, 16385, 24577};
+constexpr uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                        6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+class BitWriter {
+ public:
+  explicit BitWriter(std::string* out) : out_(out) {}
+
+  // |count| low bits of |bits|, least significant first
+  void Write(uint32_t bits, int count) {
+    buffer_ |= static_cast<uint64_t>(bits) << used_;
+    used_ += count;
+    if (used_ >= 32) {
+      char bytes[4] = {static_cast<char>(buffer_), static_cast<char>(buffer_ >> 8), static_cast<char>(buffer_ >> 16),
+                       static_cast<char>(buffer_ >> 24)};
+      out_->append(bytes, sizeof(bytes));
+      buffer_ >>= 32;
+      used_ -= 32;
+    }
+  }
+
+  void Flush() {
+    for (; used_ > 0; used_ -= 8) {
+      out_->push_back(static_cast<char>(buffer_ & 0xFF));
+      buffer_ >>= 8;
+    }
+    buffer_ = 0;
+    used_ = 0;
+  }
+
+ private:
+  std::string* out_;
+  uint64_t buffer_ = 0;
+  int used_ = 0;
+};
+
+struct Code {
+  uint16_t bits;  // bit-reversed, Huffman codes are stored most significant bit first
+  uint8_t length;
+};
+
+constexpr Code Reversed(uint32_t code, int length) {
+  uint32_t reversed = 0;
+  for (int i = 0; i < length; ++i) {
+    reversed |= ((code >> i) & 1) << (length - 1 - i);
+  }
+  return {static_cast<uint16_t>(reversed), static_cast<uint8_t>(length)};
+}
+
+// fixed literal/length codes, RFC 1951 3.2.6
+constexpr std::array<Code, 288> MakeLiteralCodes() {
+  std::array<Code, 288> codes = {};
+  for (uint32_t symbol = 0; symbol < 288; ++symbol) {
+    if (symbol < 144) {
+      codes[symbol] = Reversed(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+      codes[symbol] = Reversed(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+      codes[symbol] = Reversed(symbol - 256, 7);
+    } else {
+      codes[symbol] = Reversed(0xC0 + symbol - 280, 8);
+    }
+  }
+  return codes;
+}
+
+// length code index of every match length
+constexpr std::array<uint8_t, kMaxMatch + 1> MakeLengthCodes() {
+  std::array<uint8_t, kMaxMatch + 1> codes = {};
+  for (std::size_t length = kMinMatch; length <= kMaxMatch; ++length) {
+    uint8_t code = 28;
+    while (kLengthBase[code] > length) {
+      --code;
+    }
+    codes[length] = code;
+  }
+  return codes;
+}
+
+constexpr std::array<Code, 288> kLiteralCodes = MakeLiteralCodes();
+constexpr std::array<uint8_t, kMaxMatch + 1> kLengthCodes = MakeLengthCodes();
+
+void WriteLiteral(BitWriter& bits, uint32_t symbol) {
+  bits.Write(kLiteralCodes[symbol].bits, kLiteralCodes[symbol].length);
+}
+
+void WriteMatch(BitWriter& bits, std::size_t length, std::size_t distance) {
+  int code = kLengthCodes[length];
+  WriteLiteral(bits, 257 + code);
+  bits.Write(static_cast<uint32_t>(length - kLengthBase[code]), kLengthExtra[code]);
+
+  code = 29;
+  while (kDistanceBase[code] > distance) {
+    --code;
+  }
+  // distance codes are all 5 bits long
+  bits.Write(Reversed(code, 5).bits, 5);
+  bits.Write(static_cast<uint32_t>(distance - kDistanceBase[code]), kDistanceExtra[code]);
+}
+
+void WriteLe32(std::string* out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+}
+
+// common prefix of |a| and |b|, up to |limit| bytes, compared eight at a time
+std::size_t MatchLength(const uint8_t* a, const uint8_t* b, std::size_t limit) {
+  std::size_t length = 0;
+  while (length + 8 <= limit) {
+    uint64_t x;
+    uint64_t y;
+    std::memcpy(&x, a + length, sizeof(x));
+    std::memcpy(&y, b + length, sizeof(y));
+    if (x != y) {
+      return length + std::countr_zero(x ^ y) / 8;
+    }
+    length += 8;
+  }
+  while (length < limit && a[length] == b[length]) {
+    ++length;
+  }
+  return length;
+}
+
+uint32_t Hash(const uint8_t* p) {
+  uint32_t value = p[0] | (p[1] << 8) | (p[2] << 16);
+  return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+}  // namespace
+
+uint32_t Crc32(uint32_t crc, const void* data, std::size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = kCrcTable[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void GzipEncoder::Encode(std::string_view input, std::string* out) {
+  // magic, deflate, no flags, no mtime, no extra flags, unknown OS
+  static constexpr char kHeader[10] = {'\x1F', '\x8B', 8, 0, 0, 0, 0, 0, 0, '\xFF'};
+  out->append(kHeader, sizeof(kHeader));
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+  const std::size_t size = input.size();
+  head_.assign(std::size_t{1} << kHashBits, -1);
+  prev_.resize(kWindowSize);
+
+  BitWriter bits(out);
+  bits.Write(1, 1);  // final block
+  bits.Write(1, 2);  // fixed Huffman codes
+
+  std::size_t pos = 0;
+  auto insert = [&](std::size_t at) {
+    uint32_t hash = Hash(data + at);
+    prev_[at & (kWindowSize - 1)] = head_[hash];
+    head_[hash] = static_cast<int32_t>(at);
+  };
+
+  while (pos < size) {
+    std::size_t best_length = 0;
+    std::size_t best_distance = 0;
+    if (size - pos >= kMinMatch) {
+      const std::size_t limit = std::min(kMaxMatch, size - pos);
+      int32_t candidate = head_[Hash(data + pos)];
+      for (int chain = 0; chain < kMaxChain && candidate >= 0; ++chain) {
+        std::size_t distance = pos - static_cast<std::size_t>(candidate);
+        if (distance > kWindowSize) {
+          break;
+        }
+        const uint8_t* match = data + candidate;
+        if (match[best_length] == data[pos + best_length]) {
+          std::size_t length = MatchLength(match, data + pos, limit);
+          if (length > best_length) {
+            best_length = length;
+            best_distance = distance;
+            if (length == limit) {
+              break;
+            }
+          }
+        }
+        candidate = prev_[candidate & (kWindowSize - 1)];
+      }
+      insert(pos);
+    }
+
+    if (best_length >= kMinMatch) {
+      WriteMatch(bits, best_length, best_distance);
+      for (std::size_t i = 1; i < best_length; ++i) {
+        if (size - (pos + i) >= kMinMatch) {
+          insert(pos + i);
+        }
+      }
+      pos += best_length;
+    } else {
+      WriteLiteral(bits, data[pos]);
+      ++pos;
+    }
+  }
+
+  WriteLiteral(bits, 256);  // end of block
+  bits.Flush();
+  WriteLe32(out, Crc32(0, data, size));
+  WriteLe32(out, static_cast<uint32_t>(size));
+}
+
+}  // namespace d2r
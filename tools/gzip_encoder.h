@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace d2r {
+
+uint32_t Crc32(uint32_t crc, const void* data, std::size_t size);
+
+// Minimal gzip (RFC 1952) writer for log files. Every Encode call emits a complete member holding one deflate block
+// with the fixed Huffman codes and greedy LZ77 matches from a short hash chain, which gets log text to a fraction of
+// its size without a zlib dependency. Concatenated members are a valid gzip file, so zcat and gzip -d read a log
+// that is appended to batch by batch, and a file cut off by a crash only loses its last batch.
+class GzipEncoder {
+ public:
+  void Encode(std::string_view input, std::string* out);
+
+ private:
+  std::vector<int32_t> head_;
+  std::vector<int32_t> prev_;
+};
+
+}  // namespace d2r
@@ -0,0 +1,339 @@
+#include "log_sink.h"
+
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+
+namespace d2r {
+
+namespace {
+
+constexpr int kPollMs = 250;
+constexpr std::size_t kReadSize = 64 * 1024;
+// level names are looked for in this many leading bytes, past timestamps and module tags
+constexpr std::size_t kLevelSearchBytes = 64;
+
+bool EqualsNoCase(std::string_view a, std::string_view b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return (x >= 'A' && x <= 'Z' ? x + ('a' - 'A') : x) == y;
+         });
+}
+
+bool MatchLevel(std::string_view name, LogLevel* level) {
+  static constexpr struct {
+    std::string_view name;
+    LogLevel level;
+  } kNames[] = {
+      {"trace", LogLevel::kTrace}, {"debug", LogLevel::kDebug}, {"info", LogLevel::kInfo},
+      {"warn", LogLevel::kWarn},   {"warning", LogLevel::kWarn}, {"error", LogLevel::kError},
+      {"critical", LogLevel::kError},
+  };
+  for (const auto& entry : kNames) {
+    if (EqualsNoCase(name, entry.name)) {
+      *level = entry.level;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::filesystem::path RotatedPath(const std::string& path, unsigned index) {
+  return std::filesystem::path(path + "." + std::to_string(index));
+}
+
+}  // namespace
+
+bool ParseLogLevelName(std::string_view name, LogLevel* level) {
+  if (EqualsNoCase(name, "off")) {
+    *level = LogLevel::kOff;
+    return true;
+  }
+  return MatchLevel(name, level);
+}
+
+LogLevel ParseLogLevel(std::string_view line, LogLevel fallback) {
+  line = line.substr(0, std::min(line.size(), kLevelSearchBytes));
+  for (std::size_t open = line.find('['); open != std::string_view::npos; open = line.find('[', open + 1)) {
+    std::size_t close = line.find(']', open + 1);
+    if (close == std::string_view::npos) {
+      break;
+    }
+    LogLevel level;
+    if (MatchLevel(line.substr(open + 1, close - open - 1), &level)) {
+      return level;
+    }
+  }
+  return fallback;
+}
+
+LogLineRing::LogLineRing(std::size_t capacity)
+    : buffer_size_(std::bit_ceil(std::max<std::size_t>(capacity, 4096))), mask_(buffer_size_ - 1) {
+  buffer_ = std::make_unique<char[]>(buffer_size_);
+}
+
+bool LogLineRing::TryPush(LogLevel level, std::string_view line) {
+  line = line.substr(0, std::min(line.size(), max_line()));
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const std::size_t pos = tail & mask_;
+  const std::size_t record = RecordSize(line.size());
+  // records are 4-byte aligned, so there is always room for the padding header before the end
+  const std::size_t to_end = buffer_size_ - pos;
+  const std::size_t needed = record <= to_end ? record : to_end + record;
+  if (buffer_size_ - (tail - head_cache_) < needed) {
+    head_cache_ = head_.load(std::memory_order_acquire);
+    if (buffer_size_ - (tail - head_cache_) < needed) {
+      return false;
+    }
+  }
+
+  std::size_t at = pos;
+  if (record > to_end) {
+    std::memcpy(buffer_.get() + pos, &kPadding, sizeof(kPadding));
+    at = 0;
+  }
+  uint32_t header = static_cast<uint32_t>(line.size()) << 3 | static_cast<uint32_t>(level);
+  std::memcpy(buffer_.get() + at, &header, sizeof(header));
+  std::memcpy(buffer_.get() + at + sizeof(header), line.data(), line.size());
+  tail_.store(tail + needed, std::memory_order_release);
+  return true;
+}
+
+LogSink::LogSink(LogSinkOptions options, std::unique_ptr<LogTransport> transport,
+                 std::unique_ptr<LogDecoder> decoder)
+    : options_(std::move(options)),
+      transport_(std::move(transport)),
+      decoder_(std::move(decoder)),
+      queue_level_(std::min(options_.path.empty() ? LogLevel::kOff : options_.file_level, options_.console_level)),
+      ring_(options_.ring_bytes) {}
+
+LogSink::~LogSink() {
+  Stop();
+}
+
+bool LogSink::Start() {
+  if (running_) {
+    return true;
+  }
+  if (!options_.path.empty() && !OpenFile()) {
+    std::fprintf(stderr, "[%s] Failed to open %s\n", options_.name.c_str(), options_.path.c_str());
+    return false;
+  }
+  running_ = true;
+  reader_done_ = false;
+  last_flush_ = std::chrono::steady_clock::now();
+  writer_ = std::thread(&LogSink::WriterLoop, this);
+  reader_ = std::thread(&LogSink::ReaderLoop, this);
+  return true;
+}
+
+void LogSink::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  // the reader returns within a poll interval, the writer drains what it queued and exits behind it
+  reader_.join();
+  writer_.join();
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+void LogSink::ReaderLoop() {
+  std::vector<char> buffer(kReadSize);
+  bool waiting = false;
+  while (running_) {
+    if (!waiting) {
+      Status("Waiting for client...");
+      WakeWriter();
+      waiting = true;
+    }
+    if (!transport_->Accept(kPollMs)) {
+      continue;
+    }
+    waiting = false;
+    decoder_->Reset();
+    partial_.clear();
+    Status("Client connected");
+
+    while (running_) {
+      int size = transport_->Read(buffer.data(), buffer.size(), kPollMs);
+      if (size < 0) {
+        break;
+      }
+      if (size == 0) {
+        continue;
+      }
+      text_.clear();
+      decoder_->Decode(buffer.data(), static_cast<std::size_t>(size), &text_);
+      HandleText(text_);
+      WakeWriter();
+    }
+
+    if (!partial_.empty()) {
+      Queue(ParseLogLevel(partial_, options_.default_level), partial_);
+      partial_.clear();
+    }
+    transport_->Disconnect();
+    Status("Client disconnected");
+  }
+  reader_done_.store(true, std::memory_order_release);
+  WakeWriter();
+}
+
+void LogSink::HandleText(std::string_view text) {
+  std::size_t start = 0;
+  for (;;) {
+    std::size_t end = text.find('\n', start);
+    if (end == std::string_view::npos) {
+      partial_.append(text.substr(start));
+      // a client that never sends a newline still gets its text written
+      if (partial_.size() >= ring_.max_line()) {
+        Queue(ParseLogLevel(partial_, options_.default_level), partial_);
+        partial_.clear();
+      }
+      return;
+    }
+    std::string_view line = text.substr(start, end - start);
+    start = end + 1;
+    if (!partial_.empty()) {
+      partial_.append(line);
+      line = partial_;
+    }
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    Queue(ParseLogLevel(line, options_.default_level), line);
+    partial_.clear();
+  }
+}
+
+void LogSink::Queue(LogLevel level, std::string_view line) {
+  if (level < queue_level_) {
+    return;
+  }
+  if (unreported_drops_ > 0) {
+    std::string message = "[" + options_.name + "] [warn] Dropped " + std::to_string(unreported_drops_) +
+                          " lines, the log writer fell behind";
+    if (ring_.TryPush(LogLevel::kWarn, message)) {
+      unreported_drops_ = 0;
+    }
+  }
+  if (unreported_drops_ == 0 && ring_.TryPush(level, line)) {
+    return;
+  }
+  while (!options_.drop_when_full && running_) {
+    WakeWriter();
+    std::this_thread::yield();
+    if (ring_.TryPush(level, line)) {
+      return;
+    }
+  }
+  ++unreported_drops_;
+  lines_dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LogSink::Status(const std::string& message) {
+  Queue(LogLevel::kInfo, "[" + options_.name + "] " + message);
+}
+
+void LogSink::WakeWriter() {
+  {
+    std::lock_guard lock(wake_mutex_);
+    wake_pending_ = true;
+  }
+  wake_.notify_one();
+}
+
+void LogSink::WriterLoop() {
+  for (;;) {
+    {
+      std::unique_lock lock(wake_mutex_);
+      wake_.wait_for(lock, options_.flush_interval, [this] { return wake_pending_ || !ring_.empty(); });
+      wake_pending_ = false;
+    }
+    // loaded before the drain, everything the reader queued is seen by it
+    const bool done = reader_done_.load(std::memory_order_acquire);
+
+    std::size_t count = ring_.Drain([this](LogLevel level, std::string_view line) {
+      if (file_ && level >= options_.file_level) {
+        file_batch_.append(line);
+        file_batch_ += '\n';
+      }
+      if (level >= options_.console_level) {
+        console_batch_.append(line);
+        console_batch_ += '\n';
+      }
+    });
+
+    if (!console_batch_.empty()) {
+      std::fwrite(console_batch_.data(), 1, console_batch_.size(), stdout);
+      std::fflush(stdout);
+      console_batch_.clear();
+    }
+    if (file_batch_.size() >= options_.batch_bytes || done ||
+        std::chrono::steady_clock::now() - last_flush_ >= options_.flush_interval) {
+      FlushFile();
+    }
+    lines_processed_.fetch_add(count, std::memory_order_release);
+    if (done) {
+      return;
+    }
+  }
+}
+
+bool LogSink::OpenFile() {
+  file_ = std::fopen(options_.path.c_str(), "ab");
+  if (file_ == nullptr) {
+    return false;
+  }
+  // batches are written whole, stdio buffering would only add a copy
+  std::setvbuf(file_, nullptr, _IONBF, 0);
+  std::error_code error;
+  auto size = std::filesystem::file_size(options_.path, error);
+  file_size_ = error ? 0 : static_cast<std::size_t>(size);
+  return true;
+}
+
+void LogSink::FlushFile() {
+  last_flush_ = std::chrono::steady_clock::now();
+  if (file_batch_.empty() || file_ == nullptr) {
+    return;
+  }
+  std::string_view out = file_batch_;
+  if (options_.compress) {
+    compressed_.clear();
+    encoder_.Encode(file_batch_, &compressed_);
+    out = compressed_;
+  }
+  std::fwrite(out.data(), 1, out.size(), file_);
+  file_batch_.clear();
+  file_size_ += out.size();
+  file_bytes_.fetch_add(out.size(), std::memory_order_relaxed);
+  if (file_size_ >= options_.max_file_bytes) {
+    Rotate();
+  }
+}
+
+void LogSink::Rotate() {
+  std::fclose(file_);
+  file_ = nullptr;
+
+  std::error_code error;
+  if (options_.max_files == 0) {
+    std::filesystem::remove(options_.path, error);
+  } else {
+    std::filesystem::remove(RotatedPath(options_.path, options_.max_files), error);
+    for (unsigned index = options_.max_files - 1; index >= 1; --index) {
+      std::filesystem::rename(RotatedPath(options_.path, index), RotatedPath(options_.path, index + 1), error);
+    }
+    std::filesystem::rename(options_.path, RotatedPath(options_.path, 1), error);
+  }
+
+  if (!OpenFile()) {
+    std::fprintf(stderr, "[%s] Failed to reopen %s, file logging stopped\n", options_.name.c_str(),
+                 options_.path.c_str());
+  }
+}
+
+}  // namespace d2r
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "gzip_encoder.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace d2r {
+
+enum class LogLevel : uint8_t { kTrace, kDebug, kInfo, kWarn, kError, kOff };
+
+// Parses a level name (trace, debug, info, warn, error, off), returns false for anything else.
+bool ParseLogLevelName(std::string_view name, LogLevel* level);
+
+// Level of a log line, taken from the first bracketed level name ("[warn]", "[ERROR]", ...) near its start.
+// Lines without one get |fallback|.
+LogLevel ParseLogLevel(std::string_view line, LogLevel fallback);
+
+// Byte stream a LogSink reads from. Both calls are made from the sink's reader thread only and must return within
+// about |timeout_ms| so the sink can stop.
+class LogTransport {
+ public:
+  virtual ~LogTransport() = default;
+
+  // Waits for a client. Returns false if none connected in time.
+  virtual bool Accept(int timeout_ms) = 0;
+
+  // Reads what the client sent: the byte count, 0 if nothing arrived in time, -1 once the client is gone.
+  virtual int Read(char* buffer, std::size_t size, int timeout_ms) = 0;
+
+  // Ends the session with the current client.
+  virtual void Disconnect() = 0;
+};
+
+// Turns the bytes of a transport into log text, the default passes them through.
+class LogDecoder {
+ public:
+  virtual ~LogDecoder() = default;
+
+  // called when a client connects
+  virtual void Reset() {}
+  virtual void Decode(const char* data, std::size_t size, std::string* text) { text->append(data, size); }
+};
+
+// Bounded single-producer/single-consumer queue of log lines in one byte buffer. A line is stored contiguously
+// behind a 4-byte header (length << 3 | level), a line that does not fit before the end of the buffer is moved to
+// its start behind a padding header. Follows SpscRing's cursor scheme.
+class LogLineRing {
+ public:
+  explicit LogLineRing(std::size_t capacity);
+
+  // Producer side. Returns false if the ring is full.
+  bool TryPush(LogLevel level, std::string_view line);
+
+  // Consumer side. Calls |fn(level, line)| for every queued line and returns their count, the lines are only valid
+  // during the call.
+  template <typename Fn>
+  std::size_t Drain(Fn&& fn) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    std::size_t count = 0;
+    while (head != tail) {
+      std::size_t pos = head & mask_;
+      uint32_t header;
+      std::memcpy(&header, buffer_.get() + pos, sizeof(header));
+      if (header == kPadding) {
+        head += buffer_size_ - pos;
+        continue;
+      }
+      std::size_t length = header >> 3;
+      fn(static_cast<LogLevel>(header & 7), std::string_view(buffer_.get() + pos + sizeof(header), length));
+      head += RecordSize(length);
+      ++count;
+    }
+    head_.store(head, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer side.
+  bool empty() const { return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire); }
+
+  // longer lines are cut by TryPush
+  std::size_t max_line() const { return buffer_size_ / 4; }
+
+ private:
+  static constexpr uint32_t kPadding = UINT32_MAX;
+
+  static std::size_t RecordSize(std::size_t length) { return (sizeof(uint32_t) + length + 3) & ~std::size_t{3}; }
+
+  std::unique_ptr<char[]> buffer_;
+  std::size_t buffer_size_;
+  std::size_t mask_;
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  uint64_t head_cache_ = 0;
+};
+
+struct LogSinkOptions {
+  std::string name = "Pipe";  // prefix of the sink's own status lines
+  std::string path;           // log file, none if empty. Rotated to path.1 ... path.<max_files>
+  std::size_t max_file_bytes = std::size_t{64} << 20;
+  unsigned max_files = 5;
+  bool compress = false;  // write gzip members instead of text
+  LogLevel file_level = LogLevel::kTrace;
+  LogLevel console_level = LogLevel::kInfo;
+  LogLevel default_level = LogLevel::kInfo;  // of lines without a level name
+  std::size_t ring_bytes = std::size_t{8} << 20;
+  bool drop_when_full = true;  // otherwise the reader waits for the writer and the client blocks behind it
+  std::size_t batch_bytes = std::size_t{256} << 10;  // file writes are batched up to this size ...
+  std::chrono::milliseconds flush_interval{100};     // ... or this age
+};
+
+// Receives log text from a LogTransport and writes it to the console and rotating log files without letting either
+// slow down the client. A reader thread drains the transport as fast as it delivers, splits the text into lines,
+// drops those below both levels and queues the rest in a LogLineRing. A writer thread takes everything queued at
+// once and writes it with one console write and batched file writes. If the writer falls behind far enough for the
+// ring to fill up, lines are dropped and counted instead of stalling the reader, which would stall the client
+// (unless LogSinkOptions::drop_when_full is cleared).
+class LogSink {
+ public:
+  LogSink(LogSinkOptions options, std::unique_ptr<LogTransport> transport,
+          std::unique_ptr<LogDecoder> decoder = std::make_unique<LogDecoder>());
+  ~LogSink();
+
+  LogSink(const LogSink&) = delete;
+  LogSink& operator=(const LogSink&) = delete;
+
+  // Opens the log file and starts both threads. Returns false if the file cannot be opened.
+  bool Start();
+
+  // Stops reading, writes everything queued and closes the file.
+  void Stop();
+
+  LogTransport* transport() { return transport_.get(); }
+
+  // lines the writer has handled (written or filtered by the file and console levels)
+  uint64_t lines_processed() const { return lines_processed_.load(std::memory_order_acquire); }
+  uint64_t lines_dropped() const { return lines_dropped_.load(std::memory_order_relaxed); }
+  uint64_t file_bytes() const { return file_bytes_.load(std::memory_order_relaxed); }
+
+ private:
+  void ReaderLoop();
+  void WriterLoop();
+  void HandleText(std::string_view text);
+  void Queue(LogLevel level, std::string_view line);
+  void Status(const std::string& message);
+  void WakeWriter();
+  bool OpenFile();
+  void FlushFile();
+  void Rotate();
+
+  LogSinkOptions options_;
+  std::unique_ptr<LogTransport> transport_;
+  std::unique_ptr<LogDecoder> decoder_;
+  LogLevel queue_level_;  // lower of the file and console levels
+  LogLineRing ring_;
+
+  // reader thread
+  std::string text_;
+  std::string partial_;  // text after the last newline
+  uint64_t unreported_drops_ = 0;
+
+  // writer thread
+  std::FILE* file_ = nullptr;
+  std::size_t file_size_ = 0;
+  std::string file_batch_;
+  std::string console_batch_;
+  std::string compressed_;
+  GzipEncoder encoder_;
+  std::chrono::steady_clock::time_point last_flush_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  bool wake_pending_ = false;
+
+  std::atomic<bool> running_{false};
+  std::atomic<bool> reader_done_{false};
+  std::atomic<uint64_t> lines_processed_{0};
+  std::atomic<uint64_t> lines_dropped_{0};
+  std::atomic<uint64_t> file_bytes_{0};
+  std::thread reader_;
+  std::thread writer_;
+};
+
+}  // namespace d2r
@@ -0,0 +1,99 @@
+#include "metrics_top.h"
+
+#include <cstdio>
+
+namespace d2r {
+
+namespace {
+
+struct HitRate {
+  const char* label;
+  Metric hits;
+  Metric misses;
+};
+
+constexpr HitRate kHitRates[] = {
+    {"stat lists", Metric::StatListHits, Metric::StatListMisses},
+    {"collision maps", Metric::CollisionMapHits, Metric::CollisionMapMisses},
+};
+
+std::string FormatTime(uint64_t ns) {
+  char buffer[32];
+  if (ns < 1000) {
+    std::snprintf(buffer, sizeof(buffer), "%lluns", static_cast<unsigned long long>(ns));
+  } else if (ns < 1000000) {
+    std::snprintf(buffer, sizeof(buffer), "%.2fus", ns / 1e3);
+  } else if (ns < 1000000000) {
+    std::snprintf(buffer, sizeof(buffer), "%.2fms", ns / 1e6);
+  } else {
+    std::snprintf(buffer, sizeof(buffer), "%.2fs", ns / 1e9);
+  }
+  return buffer;
+}
+
+}  // namespace
+
+bool ValidateMetricsBlock(const MetricsBlock& block, std::string* error) {
+  if (block.magic != kMetricsMagic) {
+    *error = "not a metrics segment";
+    return false;
+  }
+  if (block.version != kMetricsVersion || block.metric_count != kMetricCount) {
+    *error = "metrics version " + std::to_string(block.version) + " with " + std::to_string(block.metric_count) +
+             " metrics, this build reads version " + std::to_string(kMetricsVersion) + " with " +
+             std::to_string(kMetricCount) + ", rebuild simple_injector";
+    return false;
+  }
+  return true;
+}
+
+void ReadMetrics(const MetricsBlock& block, double time_s, MetricsSample* sample) {
+  for (std::size_t i = 0; i < kMetricCount; ++i) {
+    sample->values[i] = block.values[i].load(std::memory_order_relaxed);
+  }
+  sample->time_s = time_s;
+}
+
+std::string RenderMetrics(const MetricsSample& current, const MetricsSample& previous, uint32_t pid, bool open) {
+  const double elapsed = current.time_s - previous.time_s;
+  auto rate = [&](std::size_t i) {
+    // a restarted module starts its counters over
+    if (elapsed <= 0 || current.values[i] < previous.values[i]) {
+      return 0.0;
+    }
+    return static_cast<double>(current.values[i] - previous.values[i]) / elapsed;
+  };
+
+  std::string out;
+  char line[128];
+  std::snprintf(line, sizeof(line), "nyx.d2r metrics, pid %u%s\n\n", pid, open ? "" : " (module unloaded)");
+  out += line;
+  std::snprintf(line, sizeof(line), "%-28s %14s %14s\n", "metric", "value", "per second");
+  out += line;
+  for (std::size_t i = 0; i < kMetricCount; ++i) {
+    const MetricInfo& info = kMetricInfo[i];
+    std::string value = info.unit == MetricUnit::kNanoseconds ? FormatTime(current.values[i])
+                                                               : std::to_string(current.values[i]);
+    if (info.kind == MetricKind::kCounter) {
+      std::snprintf(line, sizeof(line), "%-28s %14s %14.1f\n", info.label, value.c_str(), rate(i));
+    } else {
+      std::snprintf(line, sizeof(line), "%-28s %14s\n", info.label, value.c_str());
+    }
+    out += line;
+  }
+
+  out += "\ncache hit rates\n";
+  for (const HitRate& cache : kHitRates) {
+    double hits = rate(static_cast<std::size_t>(cache.hits));
+    double lookups = hits + rate(static_cast<std::size_t>(cache.misses));
+    if (lookups > 0) {
+      std::snprintf(line, sizeof(line), "%-28s %13.1f%% %14.1f\n", cache.label, 100 * hits / lookups, lookups);
+    } else {
+      std::snprintf(line, sizeof(line), "%-28s %14s %14.1f\n", cache.label, "-", 0.0);
+    }
+    out += line;
+  }
+  return out;
+}
+
+}  // namespace d2r
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "metrics_format.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace d2r {
+
+// Values of a MetricsBlock at one point in time.
+struct MetricsSample {
+  std::array<uint64_t, kMetricCount> values{};
+  double time_s = 0;
+};
+
+// Checks the header of a mapped segment, |error| says what is wrong with it.
+bool ValidateMetricsBlock(const MetricsBlock& block, std::string* error);
+
+void ReadMetrics(const MetricsBlock& block, double time_s, MetricsSample* sample);
+
+// Dashboard text for simple_injector --top: every metric with counters as totals and per-second rates since
+// |previous|, followed by the cache hit rates over the same interval.
+std::string RenderMetrics(const MetricsSample& current, const MetricsSample& previous, uint32_t pid, bool open);
+
+}  // namespace d2r
@@ -2,11 +2,19 @@
 //
 #include <TlHelp32.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <filesystem>
+#include <memory>
 #include <string>
-#include <thread>
+#include <string_view>
+
+#include "binary_log_format.h"
+#include "log_sink.h"
+#include "metrics_top.h"
 
 constexpr auto kTargetName = "D2R.exe";
 constexpr auto kModuleName = "nyx.d2r.dll";
@@ -75,46 +83,109 @@ static void WaitForModuleUnload(DWORD pid, const char* module_name) {
   } while (found && g_running);
 }
 
-// Pipe server that receives logs from the injected DLL
-class PipeServer {
+// Named pipe the injected DLL connects to, read with overlapped I/O so every call returns within its timeout. A read
+// that times out stays pending and is picked up by the next call.
+class NamedPipeTransport : public d2r::LogTransport {
  public:
-  PipeServer() : pipe_(INVALID_HANDLE_VALUE), connected_(false) {}
+  // |greeting| is written to every client right after it connects
+  explicit NamedPipeTransport(const char* name, DWORD type = PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE,
+                              std::string greeting = {})
+      : name_(name), type_(type), greeting_(std::move(greeting)) {}
 
-  ~PipeServer() { Stop(); }
+  ~NamedPipeTransport() override { Close(); }
 
-  bool Start() {
-    pipe_ = CreateNamedPipeA(kPipeName,
+  bool Open() {
+    pipe_ = CreateNamedPipeA(name_,
                              PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
-                             PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT,
-                             1,       // max instances
-                             4096,    // out buffer
-                             4096,    // in buffer
-                             0,       // timeout
-                             nullptr  // security
+                             type_ | PIPE_WAIT,
+                             1,            // max instances
+                             4096,         // out buffer
+                             kPipeBuffer,  // in buffer
+                             0,            // timeout
+                             nullptr       // security
     );
-
     if (pipe_ == INVALID_HANDLE_VALUE) {
       fprintf(stderr, "Failed to create pipe: %d\n", GetLastError());
       return false;
     }
-
-    running_ = true;
-    server_thread_ = std::thread(&PipeServer::ServerLoop, this);
+    event_ = CreateEvent(nullptr, TRUE, FALSE, nullptr);
     return true;
   }
 
-  void Stop() {
-    running_ = false;
+  void Close() {
     if (pipe_ != INVALID_HANDLE_VALUE) {
-      // Cancel any pending I/O
       CancelIoEx(pipe_, nullptr);
       DisconnectNamedPipe(pipe_);
       CloseHandle(pipe_);
       pipe_ = INVALID_HANDLE_VALUE;
     }
-    if (server_thread_.joinable()) {
-      server_thread_.join();
+    if (event_) {
+      CloseHandle(event_);
+      event_ = nullptr;
+    }
+  }
+
+  bool Accept(int timeout_ms) override {
+    if (!pending_) {
+      overlapped_ = {};
+      overlapped_.hEvent = event_;
+      if (ConnectNamedPipe(pipe_, &overlapped_)) {
+        return Connected();
+      }
+      DWORD err = GetLastError();
+      if (err == ERROR_PIPE_CONNECTED) {
+        return Connected();
+      }
+      if (err != ERROR_IO_PENDING) {
+        // ERROR_NO_DATA: a client came and went before the connect, the instance has to be reset
+        DisconnectNamedPipe(pipe_);
+        Sleep(timeout_ms);
+        return false;
+      }
+      pending_ = true;
+    }
+    if (WaitForSingleObject(event_, timeout_ms) != WAIT_OBJECT_0) {
+      return false;
+    }
+    pending_ = false;
+    return Connected();
+  }
+
+  int Read(char* buffer, size_t size, int timeout_ms) override {
+    if (!pending_) {
+      overlapped_ = {};
+      overlapped_.hEvent = event_;
+      if (!ReadFile(pipe_, read_buffer_, sizeof(read_buffer_), nullptr, &overlapped_)) {
+        DWORD err = GetLastError();
+        // a message larger than the buffer comes in pieces
+        if (err != ERROR_IO_PENDING && err != ERROR_MORE_DATA) {
+          return -1;
+        }
+      }
+      pending_ = true;
+    }
+    if (WaitForSingleObject(event_, timeout_ms) != WAIT_OBJECT_0) {
+      return 0;
+    }
+    pending_ = false;
+    DWORD bytes_read = 0;
+    if (!GetOverlappedResult(pipe_, &overlapped_, &bytes_read, FALSE) && GetLastError() != ERROR_MORE_DATA) {
+      return -1;
+    }
+    bytes_read = std::min<DWORD>(bytes_read, static_cast<DWORD>(size));
+    memcpy(buffer, read_buffer_, bytes_read);
+    return static_cast<int>(bytes_read);
+  }
+
+  void Disconnect() override {
+    if (pending_) {
+      CancelIoEx(pipe_, &overlapped_);
+      DWORD ignored;
+      GetOverlappedResult(pipe_, &overlapped_, &ignored, TRUE);
+      pending_ = false;
     }
+    connected_ = false;
+    DisconnectNamedPipe(pipe_);
   }
 
   bool SendCommand(const std::string& cmd) {
@@ -128,106 +199,282 @@ class PipeServer {
   }
 
  private:
-  void ServerLoop() {
-    char buffer[4096];
+  // Room the game can write into before its log calls block, large enough to ride out a slow disk.
+  static constexpr DWORD kPipeBuffer = 1 << 20;
+  static constexpr DWORD kReadSize = 64 * 1024;
+
+  bool Connected() {
+    connected_ = true;
+    if (!greeting_.empty()) {
+      // the pipe is opened for overlapped I/O, a few bytes into the empty out buffer complete right away
+      OVERLAPPED write = {};
+      write.hEvent = event_;
+      DWORD written = 0;
+      bool sent = WriteFile(pipe_, greeting_.data(), static_cast<DWORD>(greeting_.size()), nullptr, &write) ||
+                  GetLastError() == ERROR_IO_PENDING;
+      if (!sent || !GetOverlappedResult(pipe_, &write, &written, TRUE) || written != greeting_.size()) {
+        Disconnect();
+        return false;
+      }
+    }
+    return true;
+  }
 
-    while (running_) {
-      // Wait for client connection
-      fprintf(stdout, "[Pipe] Waiting for client...\n");
+  const char* name_;
+  DWORD type_;
+  std::string greeting_;
+  HANDLE pipe_ = INVALID_HANDLE_VALUE;
+  HANDLE event_ = nullptr;
+  OVERLAPPED overlapped_ = {};
+  bool pending_ = false;
+  std::atomic<bool> connected_{false};
+  char read_buffer_[kReadSize];
+};
 
-      OVERLAPPED overlapped = {};
-      overlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+static std::string FormatBinlogArg(d2r::BinlogArgType type, uint64_t bits) {
+  char buf[32];
+  switch (type) {
+    case d2r::BinlogArgType::kInt64:
+      snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(bits));
+      break;
+    case d2r::BinlogArgType::kUint64:
+      snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(bits));
+      break;
+    case d2r::BinlogArgType::kDouble: {
+      double value;
+      memcpy(&value, &bits, sizeof(value));
+      snprintf(buf, sizeof(buf), "%g", value);
+      break;
+    }
+    case d2r::BinlogArgType::kPointer:
+      snprintf(buf, sizeof(buf), "0x%llx", static_cast<unsigned long long>(bits));
+      break;
+    case d2r::BinlogArgType::kBool:
+      return bits ? "true" : "false";
+    default:
+      return "?";
+  }
+  return buf;
+}
 
-      BOOL connected = ConnectNamedPipe(pipe_, &overlapped);
-      if (!connected) {
-        DWORD err = GetLastError();
-        if (err == ERROR_IO_PENDING) {
-          // Wait for connection with timeout so we can check running_
-          while (running_) {
-            DWORD result = WaitForSingleObject(overlapped.hEvent, 500);
-            if (result == WAIT_OBJECT_0) {
-              connected = TRUE;
-              break;
-            }
-          }
-        } else if (err == ERROR_PIPE_CONNECTED) {
-          connected = TRUE;
-        }
-      }
+// Expands a binary log record with the shared format table. Only the {} / {:p} subset used by the module is
+// understood, format specs are otherwise ignored.
+static std::string FormatBinlogRecord(const d2r::BinlogRecord& record) {
+  if (record.format_id >= static_cast<uint16_t>(d2r::BinlogFormat::kCount)) {
+    return "<unknown binlog format " + std::to_string(record.format_id) + ">";
+  }
 
-      CloseHandle(overlapped.hEvent);
-
-      if (!running_) break;
-
-      if (connected) {
-        connected_ = true;
-        fprintf(stdout, "[Pipe] Client connected\n");
-
-        // Read messages from client
-        while (running_) {
-          DWORD bytes_read = 0;
-          OVERLAPPED read_overlapped = {};
-          read_overlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
-
-          BOOL success = ReadFile(pipe_, buffer, sizeof(buffer) - 1, &bytes_read, &read_overlapped);
-
-          if (!success) {
-            DWORD err = GetLastError();
-            if (err == ERROR_IO_PENDING) {
-              // Wait for read with timeout
-              while (running_) {
-                DWORD result = WaitForSingleObject(read_overlapped.hEvent, 500);
-                if (result == WAIT_OBJECT_0) {
-                  GetOverlappedResult(pipe_, &read_overlapped, &bytes_read, FALSE);
-                  success = TRUE;
-                  break;
-                }
-              }
-            } else if (err == ERROR_BROKEN_PIPE || err == ERROR_PIPE_NOT_CONNECTED) {
-              CloseHandle(read_overlapped.hEvent);
-              break;  // Client disconnected
-            }
-          }
-
-          CloseHandle(read_overlapped.hEvent);
-
-          if (!running_) break;
-
-          if (success && bytes_read > 0) {
-            buffer[bytes_read] = '\0';
-            // Print received log message
-            fprintf(stdout, "%s", buffer);
-            fflush(stdout);
-          }
-        }
+  const char* format = d2r::kBinlogFormats[record.format_id];
+  std::string out;
+  size_t arg = 0;
+  for (const char* p = format; *p; ++p) {
+    if (p[0] == '{' && p[1] == '{') {
+      out += '{';
+      ++p;
+    } else if (p[0] == '}' && p[1] == '}') {
+      out += '}';
+      ++p;
+    } else if (p[0] == '{') {
+      const char* end = strchr(p, '}');
+      if (end == nullptr) {
+        out += p;
+        break;
+      }
+      if (arg < record.arg_count && arg < d2r::kBinlogMaxArgs) {
+        out += FormatBinlogArg(record.arg_types[arg], record.args[arg]);
+      }
+      ++arg;
+      p = end;
+    } else {
+      out += *p;
+    }
+  }
+  return out;
+}
 
-        connected_ = false;
-        fprintf(stdout, "[Pipe] Client disconnected\n");
-        DisconnectNamedPipe(pipe_);
+// Decoder for the binary log channel, records arrive as a byte stream of fixed-size BinlogRecords and are
+// formatted here instead of in the game process.
+class BinlogDecoder : public d2r::LogDecoder {
+ public:
+  void Reset() override { pending_size_ = 0; }
+
+  void Decode(const char* data, size_t size, std::string* text) override {
+    while (size > 0) {
+      size_t take = std::min(size, sizeof(pending_) - pending_size_);
+      memcpy(pending_ + pending_size_, data, take);
+      pending_size_ += take;
+      data += take;
+      size -= take;
+
+      if (pending_size_ == sizeof(pending_)) {
+        d2r::BinlogRecord record;
+        memcpy(&record, pending_, sizeof(record));
+        pending_size_ = 0;
+        *text += "[binlog] ";
+        *text += FormatBinlogRecord(record);
+        *text += '\n';
       }
     }
   }
 
-  HANDLE pipe_;
-  std::atomic<bool> running_{false};
-  std::atomic<bool> connected_{false};
-  std::thread server_thread_;
+ private:
+  char pending_[sizeof(d2r::BinlogRecord)];
+  size_t pending_size_ = 0;
 };
 
-static PipeServer g_pipe_server;
+static std::unique_ptr<d2r::LogSink> g_log_sink;
+static std::unique_ptr<d2r::LogSink> g_binlog_sink;
+
+static void StopSinks() {
+  if (g_log_sink) {
+    g_log_sink->Stop();
+  }
+  if (g_binlog_sink) {
+    g_binlog_sink->Stop();
+  }
+}
+
+// Starts a sink reading the pipe |name|, nullptr if the pipe or the log file could not be opened.
+static std::unique_ptr<d2r::LogSink> StartSink(d2r::LogSinkOptions options, const char* name, DWORD type,
+                                                std::unique_ptr<d2r::LogDecoder> decoder,
+                                                std::string greeting = {}) {
+  auto transport = std::make_unique<NamedPipeTransport>(name, type, std::move(greeting));
+  if (!transport->Open()) {
+    return nullptr;
+  }
+  auto sink = std::make_unique<d2r::LogSink>(std::move(options), std::move(transport), std::move(decoder));
+  if (!sink->Start()) {
+    return nullptr;
+  }
+  return sink;
+}
+
+static void PrintUsage() {
+  fprintf(stderr,
+          "usage: simple_injector [--log=FILE] [--log-level=LEVEL] [--console-level=LEVEL] [--log-max-mb=N]\n"
+          "                       [--log-files=N] [--log-compress] [--binlog]\n"
+          "       simple_injector --top [--interval-ms=N]\n"
+          "  LEVEL is trace, debug, info, warn, error or off. --binlog also serves the binary log channel, its\n"
+          "  records are trace lines and written next to FILE with a .binlog suffix. --top shows the live metrics\n"
+          "  of an already injected module instead of injecting.\n");
+}
+
+struct TopOptions {
+  bool enabled = false;
+  DWORD interval_ms = 500;
+};
+
+// Fills the options of the text log sink, of the binary log channel and of --top from the command line.
+static bool ParseArgs(int argc, char** argv, d2r::LogSinkOptions* options, bool* binlog, TopOptions* top) {
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    auto value = [&](std::string_view name) -> const char* {
+      if (arg.size() > name.size() && arg.substr(0, name.size()) == name && arg[name.size()] == '=') {
+        return argv[i] + name.size() + 1;
+      }
+      return nullptr;
+    };
+    if (const char* v = value("--log")) {
+      options->path = v;
+    } else if (const char* v = value("--log-level")) {
+      if (!d2r::ParseLogLevelName(v, &options->file_level)) {
+        return false;
+      }
+    } else if (const char* v = value("--console-level")) {
+      if (!d2r::ParseLogLevelName(v, &options->console_level)) {
+        return false;
+      }
+    } else if (const char* v = value("--log-max-mb")) {
+      options->max_file_bytes = std::max<size_t>(1, strtoull(v, nullptr, 10)) << 20;
+    } else if (const char* v = value("--log-files")) {
+      options->max_files = static_cast<unsigned>(strtoul(v, nullptr, 10));
+    } else if (arg == "--log-compress") {
+      options->compress = true;
+    } else if (arg == "--binlog") {
+      *binlog = true;
+    } else if (arg == "--top") {
+      top->enabled = true;
+    } else if (const char* v = value("--interval-ms")) {
+      top->interval_ms = std::max<DWORD>(50, strtoul(v, nullptr, 10));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Renders the metrics segment of the injected module until Ctrl+C, waiting for the game and the module to show up
+// and reattaching when they restart. Reads shared memory only, nothing is logged or injected.
+static int RunTop(const TopOptions& options) {
+  HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+  DWORD mode = 0;
+  if (GetConsoleMode(console, &mode)) {
+    SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+  }
+  auto now = [] {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  };
+
+  while (g_running) {
+    DWORD pid = FindProcessByName(kTargetName);
+    std::string name = d2r::kMetricsSegmentPrefix + std::to_string(pid);
+    HANDLE mapping = pid ? OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str()) : nullptr;
+    if (mapping == nullptr) {
+      fprintf(stdout, "\x1b[H\x1b[2JWaiting for %s with %s...\n", kTargetName, kModuleName);
+      Sleep(1000);
+      continue;
+    }
+    auto* block =
+        static_cast<const d2r::MetricsBlock*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(d2r::MetricsBlock)));
+    // the module creates the segment before it fills the header and sets open last, a blank header is not ready yet
+    if (block != nullptr && (block->open.load(std::memory_order_acquire) == 0 || block->magic == 0)) {
+      UnmapViewOfFile(block);
+      CloseHandle(mapping);
+      fprintf(stdout, "\x1b[H\x1b[2JWaiting for %s to publish its metrics...\n", kModuleName);
+      Sleep(1000);
+      continue;
+    }
+    std::string error;
+    if (block == nullptr || !d2r::ValidateMetricsBlock(*block, &error)) {
+      fprintf(stderr, "%s: %s\n", name.c_str(), block ? error.c_str() : "could not be mapped");
+      if (block) {
+        UnmapViewOfFile(block);
+      }
+      CloseHandle(mapping);
+      return EXIT_FAILURE;
+    }
+
+    d2r::MetricsSample previous;
+    d2r::MetricsSample current;
+    d2r::ReadMetrics(*block, now(), &previous);
+    bool open = true;
+    while (g_running && open) {
+      Sleep(options.interval_ms);
+      open = block->open.load(std::memory_order_acquire) != 0;
+      d2r::ReadMetrics(*block, now(), &current);
+      std::string text = d2r::RenderMetrics(current, previous, pid, open);
+      fprintf(stdout, "\x1b[H\x1b[2J%s", text.c_str());
+      fflush(stdout);
+      previous = current;
+    }
+    UnmapViewOfFile(block);
+    CloseHandle(mapping);
+  }
+  return EXIT_SUCCESS;
+}
 
 // Console control handler for clean shutdown
 BOOL WINAPI ConsoleHandler(DWORD signal) {
   if (signal == CTRL_C_EVENT || signal == CTRL_BREAK_EVENT || signal == CTRL_CLOSE_EVENT) {
     fprintf(stdout, "\nShutting down...\n");
     g_running = false;
-    g_pipe_server.Stop();
+    StopSinks();
     return TRUE;
   }
   return FALSE;
 }
 
-int main() {
+int main(int argc, char** argv) {
   DWORD pid = 0;
   HANDLE process = nullptr;
   LPVOID path_address = nullptr;
@@ -238,13 +485,55 @@ int main() {
   std::filesystem::path filename;
   std::string filename_str;
 
+  d2r::LogSinkOptions log_options;
+  bool binlog = false;
+  TopOptions top_options;
+  if (!ParseArgs(argc, argv, &log_options, &binlog, &top_options)) {
+    PrintUsage();
+    return EXIT_FAILURE;
+  }
+  if (top_options.enabled) {
+    SetConsoleCtrlHandler(ConsoleHandler, TRUE);
+    return RunTop(top_options);
+  }
+  // binary log records carry no level, they are trace output
+  d2r::LogSinkOptions binlog_options = log_options;
+  binlog_options.name = "Binlog";
+  binlog_options.default_level = d2r::LogLevel::kTrace;
+  if (!binlog_options.path.empty()) {
+    binlog_options.path += ".binlog";
+  }
+
   SetConsoleCtrlHandler(ConsoleHandler, TRUE);
 
-  if (!g_pipe_server.Start()) {
+  g_log_sink = StartSink(log_options, kPipeName, PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE,
+                         std::make_unique<d2r::LogDecoder>());
+  if (!g_log_sink) {
     fprintf(stderr, "Failed to start pipe server\n");
     return EXIT_FAILURE;
   }
   fprintf(stdout, "Pipe server started on %s\n", kPipeName);
+  if (!log_options.path.empty()) {
+    fprintf(stdout, "Logging to %s\n", log_options.path.c_str());
+  }
+
+  if (binlog) {
+    // the module only records while the reader keeps trace lines somewhere
+    bool keeps_trace = binlog_options.console_level == d2r::LogLevel::kTrace ||
+                       (!binlog_options.path.empty() && binlog_options.file_level == d2r::LogLevel::kTrace);
+    if (!keeps_trace) {
+      fprintf(stderr, "--binlog records are trace lines, they are not produced without --console-level=trace or\n"
+                      "--log=FILE with --log-level=trace\n");
+    }
+    auto level = keeps_trace ? d2r::BinlogReaderLevel::kTrace : d2r::BinlogReaderLevel::kAboveTrace;
+    g_binlog_sink = StartSink(binlog_options, d2r::kBinlogPipeName, PIPE_TYPE_BYTE | PIPE_READMODE_BYTE,
+                              std::make_unique<BinlogDecoder>(), std::string(1, static_cast<char>(level)));
+    if (g_binlog_sink) {
+      fprintf(stdout, "Binary log server started on %s\n", d2r::kBinlogPipeName);
+    } else {
+      fprintf(stderr, "Failed to start binary log server, trace records will not be received\n");
+    }
+  }
 
   pid = FindProcessByName(kTargetName);
   if (pid == 0) {
@@ -294,7 +583,7 @@ int main() {
   WaitForModuleUnload(pid, kModuleName);
 
 cleanup:
-  g_pipe_server.Stop();
+  StopSinks();
   if (load_thread) {
     CloseHandle(load_thread);
     load_thread = nullptr;
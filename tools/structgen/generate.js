@@ -0,0 +1,604 @@
+'use strict';
+
+// Generates the native and script views of the game structs from schema.js:
+//   src/d2r_game_structs.h    C++ classes with explicit padding and offset/size static_asserts
+//   lib/d2r/models.js         MemoryModel definitions
+//   lib/d2r/layouts.js        fixed-offset decoders (straight-line DataView reads, no field interpreter)
+//   typings/d2r/layouts.d.ts  typings for layouts.js
+//
+// Usage: node tools/structgen/generate.js [--check]
+// --check only compares and exits with 1 if a generated file is out of date.
+
+const fs = require('fs');
+const path = require('path');
+const { structs } = require('./schema');
+
+const ROOT = path.join(__dirname, '..', '..');
+const BANNER = 'Generated by tools/structgen/generate.js from tools/structgen/schema.js, do not edit.';
+
+const SCALARS = {
+  u8: { cpp: 'uint8_t', size: 1, js: 'Uint8' },
+  u16: { cpp: 'uint16_t', size: 2, js: 'Uint16' },
+  u32: { cpp: 'uint32_t', size: 4, js: 'Uint32' },
+  u64: { cpp: 'uint64_t', size: 8, js: 'Uint64' },
+  i16: { cpp: 'int16_t', size: 2, js: 'Int16' },
+  i32: { cpp: 'int32_t', size: 4, js: 'Int32' },
+  f32: { cpp: 'float', size: 4, js: null },
+  char: { cpp: 'char', size: 1, js: null },
+  size: { cpp: 'size_t', size: 8, js: 'Pointer' },
+  ptr: { cpp: 'void*', size: 8, js: 'Pointer' },
+};
+
+// DataView reader, default value and TypeScript type per MemoryModel data type
+const JS_TYPES = {
+  Uint8: { read: o => `view.getUint8(${o})`, zero: '0', ts: 'number', size: 1 },
+  Uint16: { read: o => `view.getUint16(${o}, true)`, zero: '0', ts: 'number', size: 2 },
+  Uint32: { read: o => `view.getUint32(${o}, true)`, zero: '0', ts: 'number', size: 4 },
+  Uint64: { read: o => `view.getBigUint64(${o}, true)`, zero: '0n', ts: 'bigint', size: 8 },
+  Int16: { read: o => `view.getInt16(${o}, true)`, zero: '0', ts: 'number', size: 2 },
+  Int32: { read: o => `view.getInt32(${o}, true)`, zero: '0', ts: 'number', size: 4 },
+  Pointer: { read: o => `view.getBigUint64(${o}, true)`, zero: '0n', ts: 'bigint', size: 8 },
+};
+
+const byName = new Map(structs.map(s => [s.cpp, s]));
+
+function hex(value, digits = 4) {
+  return '0x' + value.toString(16).toUpperCase().padStart(digits, '0');
+}
+
+function shortHex(value) {
+  return '0x' + value.toString(16).toUpperCase();
+}
+
+function layoutName(s) {
+  return s.js.replace(/Model$/, '') + 'Layout';
+}
+
+function interfaceName(s) {
+  return s.js.replace(/Model$/, '') + 'Struct';
+}
+
+function dims(field) {
+  if (field.count === undefined) return [];
+  return Array.isArray(field.count) ? field.count : [field.count];
+}
+
+function elementCount(field) {
+  return dims(field).reduce((a, b) => a * b, 1);
+}
+
+// { cpp, size, align, js, struct }
+function resolveType(owner, field) {
+  const type = field.type;
+  if (typeof type === 'object') {
+    return { cpp: type.raw, size: type.size, align: 8, js: null };
+  }
+  if (SCALARS[type]) {
+    const scalar = SCALARS[type];
+    return { cpp: scalar.cpp, size: scalar.size, align: scalar.size, js: scalar.js };
+  }
+  if (type.endsWith('*')) {
+    return { cpp: type, size: 8, align: 8, js: 'Pointer' };
+  }
+  const struct = byName.get(type);
+  if (!struct) throw new Error(`${owner.cpp}.${field.cpp}: unknown type ${type}`);
+  if (structs.indexOf(struct) >= structs.indexOf(owner)) {
+    throw new Error(`${owner.cpp}.${field.cpp}: ${type} must be declared before ${owner.cpp}`);
+  }
+  return { cpp: type, size: struct.size, align: structAlign(struct), js: null, struct };
+}
+
+function structAlign(s) {
+  if (s.packed) return 1;
+  let align = 1;
+  for (const field of s.fields) {
+    for (const member of field.union ? field.alternatives : [field]) {
+      align = Math.max(align, resolveType(s, member).align);
+    }
+  }
+  return align;
+}
+
+function fieldSize(owner, field) {
+  if (field.union) return Math.max(...field.alternatives.map(alt => alt.offset + fieldSize(owner, alt)));
+  return resolveType(owner, field).size * elementCount(field);
+}
+
+// Script-side type of a field, null if the script side treats it as padding.
+function jsType(owner, field) {
+  if (!field.js) return null;
+  if (typeof field.type === 'string' && byName.has(field.type)) {
+    const struct = byName.get(field.type);
+    if (!struct.js) throw new Error(`${owner.cpp}.${field.cpp}: ${struct.cpp} has no script model`);
+    return { struct };
+  }
+  const type = field.as ?? resolveType(owner, field).js;
+  if (type === 'String') return { string: elementCount(field) };
+  if (!JS_TYPES[type]) throw new Error(`${owner.cpp}.${field.cpp}: no script type for ${field.type}`);
+  if (field.follow !== undefined) checkFollow(owner, field, type);
+  return { scalar: type };
+}
+
+// A pointer the scripts walk (me.path.room.drlgRoom.level) must resolve to a scripted struct, otherwise the layout
+// would silently hand out the raw address and every walk through it would end in undefined.
+function checkFollow(owner, field, type) {
+  const target = byName.get(field.follow);
+  if (type !== 'Pointer') throw new Error(`${owner.cpp}.${field.cpp}: only pointers can be followed`);
+  if (!target) throw new Error(`${owner.cpp}.${field.cpp}: follows unknown struct ${field.follow}`);
+  if (!target.js) throw new Error(`${owner.cpp}.${field.cpp}: follows ${target.cpp}, which has no script model`);
+}
+
+function validate(s) {
+  const align = structAlign(s);
+  let end = 0;
+  for (const field of s.fields) {
+    if (field.offset < end) throw new Error(`${s.cpp}.${field.cpp ?? field.js}: overlaps the previous field`);
+    const members = field.union ? field.alternatives : [field];
+    for (const member of members) {
+      const memberAlign = resolveType(s, member).align;
+      if (!s.packed && (field.offset + (field.union ? member.offset : 0)) % memberAlign !== 0) {
+        throw new Error(`${s.cpp}.${member.cpp}: offset ${hex(field.offset)} is not ${memberAlign}-byte aligned`);
+      }
+      if (member.js !== null) jsType(s, member);
+    }
+    end = field.offset + fieldSize(s, field);
+  }
+  if (end > s.size) throw new Error(`${s.cpp}: fields end at ${hex(end)}, past the size ${hex(s.size)}`);
+  if (s.size % align !== 0) throw new Error(`${s.cpp}: size ${hex(s.size)} is not a multiple of ${align}`);
+}
+
+// Aligns the trailing comments of consecutive commented lines, like clang-format does.
+function alignComments(lines) {
+  const out = [];
+  for (let i = 0; i < lines.length;) {
+    if (lines[i][1] === null) {
+      out.push(lines[i][0]);
+      i++;
+      continue;
+    }
+    let j = i;
+    let width = 0;
+    while (j < lines.length && lines[j][1] !== null) {
+      width = Math.max(width, lines[j][0].length);
+      j++;
+    }
+    for (; i < j; i++) out.push(`${lines[i][0].padEnd(width)}  // ${lines[i][1]}`);
+  }
+  return out;
+}
+
+// C++
+
+function cppDeclaration(owner, field) {
+  const type = resolveType(owner, field);
+  const suffix = dims(field).map(n => `[${n}]`).join('');
+  return `${type.cpp} ${field.cpp}${suffix};`;
+}
+
+function cppComment(offset, field) {
+  return field && field.note ? `${hex(offset)} ${field.note}` : hex(offset);
+}
+
+function generateCppStruct(s) {
+  const lines = [[`class ${s.cpp} {`, null], [' public:', null]];
+  let end = 0;
+  const pad = (from, to) => {
+    if (to > from) lines.push([`  char pad_${hex(from).slice(2)}[${to - from}];`, hex(from)]);
+  };
+  for (const field of s.fields) {
+    pad(end, field.offset);
+    if (field.union) {
+      lines.push(['  union', hex(field.offset)]);
+      lines.push(['  {', null]);
+      for (const alt of field.alternatives) lines.push([`    ${cppDeclaration(s, alt)}`, cppComment(alt.offset, alt)]);
+      lines.push(['  };', null]);
+    } else {
+      lines.push([`  ${cppDeclaration(s, field)}`, cppComment(field.offset, field)]);
+    }
+    end = field.offset + fieldSize(s, field);
+  }
+  pad(end, s.size);
+  lines.push([`};  // Size: ${hex(s.size)}`, null]);
+
+  const out = alignComments(lines);
+  out.push(`static_assert(sizeof(${s.cpp}) == ${shortHex(s.size)});`);
+  for (const field of s.fields) {
+    for (const member of field.union ? field.alternatives : [field]) {
+      const offset = field.offset + (field.union ? member.offset : 0);
+      out.push(`static_assert(offsetof(${s.cpp}, ${member.cpp}) == ${shortHex(offset)});`);
+    }
+  }
+  if (s.packed) {
+    out.unshift('#pragma pack(push, 1)');
+    out.push('#pragma pack(pop)');
+  }
+  return out.join('\n');
+}
+
+function generateCpp() {
+  const parts = [
+    '#pragma once',
+    '',
+    `// ${BANNER}`,
+    '//',
+    '// Plain game layouts, included by d2r_structs.h after the helper templates they use (vector<>).',
+    '',
+    '#include <cstddef>',
+    '#include <cstdint>',
+    '',
+    'namespace d2r {',
+    '',
+    ...structs.map(s => `class ${s.cpp};`),
+    '',
+  ];
+  for (const s of structs) {
+    parts.push(generateCppStruct(s), '');
+  }
+  parts.push('}  // namespace d2r', '');
+  return parts.join('\n');
+}
+
+// MemoryModel definitions
+
+function modelReference(owner, target) {
+  // models are defined in schema order, later ones are referenced lazily
+  return structs.indexOf(target) < structs.indexOf(owner) ? target.js : `() => ${target.js}`;
+}
+
+function modelField(owner, field, name) {
+  const type = jsType(owner, field);
+  const count = elementCount(field);
+  const countSuffix = field.count !== undefined ? `, count: ${count}` : '';
+  if (type.struct) return `{ name: '${name}', model: ${type.struct.js}${countSuffix} }`;
+  if (type.string) return `{ name: '${name}', type: DataTypes.String, length: ${type.string} }`;
+  let entry = `{ name: '${name}', type: DataTypes.${type.scalar}`;
+  if (field.follow) {
+    const target = byName.get(field.follow);
+    if (target.js) entry += `, model: ${modelReference(owner, target)}`;
+  }
+  return `${entry}${countSuffix} }`;
+}
+
+function generateModel(s) {
+  const lines = [[`const ${s.js} = MemoryModel.define('${s.js}', [`, null]];
+  let end = 0;
+  let paddingStart = 0;
+  const flushPadding = to => {
+    if (to > paddingStart) lines.push([`  { type: DataTypes.Padding, length: ${to - paddingStart} },`, hex(paddingStart)]);
+  };
+  for (const field of s.fields) {
+    const size = fieldSize(s, field);
+    if (field.union) {
+      const alternatives = field.alternatives.filter(alt => alt.js);
+      if (alternatives.length === 0) {
+        end = field.offset + size;
+        continue;
+      }
+      flushPadding(field.offset);
+      if (alternatives.length === 1 && !field.js) {
+        // a single visible alternative reads like a plain field
+        const alt = alternatives[0];
+        lines.push([`  ${modelField(s, alt, alt.js)},`, hex(field.offset + alt.offset)]);
+        paddingStart = field.offset + alt.offset + fieldSize(s, alt);
+        end = field.offset + size;
+        continue;
+      }
+      const name = field.js ? `name: '${field.js}', ` : '';
+      lines.push([`  { ${name}type: DataTypes.Union, fields: [`, hex(field.offset)]);
+      for (const alt of alternatives) lines.push([`    ${modelField(s, alt, alt.js)},`, null]);
+      lines.push(['  ] },', null]);
+      const used = Math.max(...alternatives.map(alt => alt.offset + fieldSize(s, alt)));
+      paddingStart = field.offset + used;
+      end = field.offset + size;
+      continue;
+    }
+    if (!field.js) {
+      end = field.offset + size;
+      continue;
+    }
+    flushPadding(field.offset);
+    lines.push([`  ${modelField(s, field, field.js)},`, hex(field.offset)]);
+    end = field.offset + size;
+    paddingStart = end;
+  }
+  flushPadding(s.size);
+  const options = s.packed ? `{ packed: true, expectedSize: ${hex(s.size)} }` : `{ expectedSize: ${hex(s.size)} }`;
+  lines.push([`], null, ${options});`, null]);
+  return alignComments(lines).join('\n');
+}
+
+function generateModels() {
+  const models = structs.filter(s => s.js);
+  const parts = [
+    "'use strict';",
+    '',
+    `// ${BANNER}`,
+    '',
+    "const { MemoryModel, DataTypes } = require('memory');",
+    '',
+  ];
+  for (const s of models) parts.push(generateModel(s), '');
+  parts.push('module.exports = {', ...models.map(s => `  ${s.js},`), '};', '');
+  return parts.join('\n');
+}
+
+// Fixed-offset decoders
+
+// Members of |s| as seen from script: { name, offset, field, type, container } with unions flattened into
+// either a nested object (named union) or the struct itself.
+function scriptMembers(s) {
+  const members = [];
+  for (const field of s.fields) {
+    if (field.union) {
+      for (const alt of field.alternatives) {
+        if (!alt.js) continue;
+        members.push({
+          name: alt.js,
+          offset: field.offset + alt.offset,
+          field: alt,
+          type: jsType(s, alt),
+          container: field.js,
+        });
+      }
+    } else if (field.js) {
+      members.push({ name: field.js, offset: field.offset, field, type: jsType(s, field), container: null });
+    }
+  }
+  return members;
+}
+
+function zeroValue(member) {
+  const { type, field } = member;
+  let single;
+  if (type.struct) single = `${layoutName(type.struct)}.create()`;
+  else if (type.string) return "''";
+  else single = JS_TYPES[type.scalar].zero;
+
+  if (field.count === undefined) return single;
+  const count = elementCount(field);
+  if (count > 16 || (type.struct && count > 2)) {
+    return type.struct ? `Array.from({ length: ${count} }, () => ${single})` : `new Array(${count}).fill(${single})`;
+  }
+  return `[${new Array(count).fill(single).join(', ')}]`;
+}
+
+function elementStride(s, member) {
+  if (member.type.struct) return member.type.struct.size;
+  return resolveType(s, member.field).size;
+}
+
+function decodeStatements(s, member) {
+  const { type, field } = member;
+  const key = isFollowed(member) ? addressKey(member) : member.name;
+  const target = member.container ? `target.${member.container}.${key}` : `target.${key}`;
+  const at = offset => `offset + ${hex(offset)}`;
+  const one = (lhs, offset) =>
+    type.struct ? `${layoutName(type.struct)}.decode(view, ${at(offset)}, ${lhs});` : `${lhs} = ${JS_TYPES[type.scalar].read(at(offset))};`;
+
+  if (type.string) return [`${target} = readString(view, ${at(member.offset)}, ${type.string});`];
+  if (field.count === undefined) return [one(target, member.offset)];
+
+  const count = elementCount(field);
+  const stride = elementStride(s, member);
+  if (count <= 16) {
+    return Array.from({ length: count }, (_, i) => one(`${target}[${i}]`, member.offset + i * stride));
+  }
+  const read = type.struct
+    ? `${layoutName(type.struct)}.decode(view, offset + ${hex(member.offset)} + i * ${hex(stride)}, ${target}[i]);`
+    : `${target}[i] = ${JS_TYPES[type.scalar].read(`offset + ${hex(member.offset)} + i * ${hex(stride)}`)};`;
+  return [`for (let i = 0; i < ${count}; i++) {`, `  ${read}`, '}'];
+}
+
+// Pointer members the script side follows: a getter resolves them through the per-tick memo of d2r/model-cache,
+// the raw address is kept in `_<name>Address`.
+function isFollowed(member) {
+  const { field } = member;
+  return !member.container && member.type.scalar === 'Pointer' && field.count === undefined && !!field.follow &&
+    !!byName.get(field.follow).js;
+}
+
+function addressKey(member) {
+  return `_${member.name}Address`;
+}
+
+// [key, zero value] of every property create() sets, unions collapsed into one nested object.
+function createEntries(members) {
+  const entries = [];
+  const unions = new Map();
+  for (const member of members) {
+    if (member.container) {
+      if (!unions.has(member.container)) {
+        const union = [];
+        unions.set(member.container, union);
+        entries.push([member.container, union]);
+      }
+      unions.get(member.container).push(`${member.name}: ${zeroValue(member)}`);
+    } else {
+      entries.push([isFollowed(member) ? addressKey(member) : member.name, zeroValue(member)]);
+    }
+  }
+  return entries.map(([key, value]) => [key, Array.isArray(value) ? `{ ${value.join(', ')} }` : value]);
+}
+
+function generateLayout(s) {
+  const name = layoutName(s);
+  const members = scriptMembers(s);
+  const followed = members.filter(isFollowed);
+  const lines = [];
+
+  // structs with followed pointers get a class for the getters, the rest stay plain objects
+  if (followed.length) {
+    lines.push(`class ${interfaceName(s)} {`, '  constructor() {');
+    for (const [key, value] of createEntries(members)) lines.push(`    this.${key} = ${value};`);
+    lines.push('  }', '');
+    for (const member of followed) {
+      const target = layoutName(byName.get(member.field.follow));
+      lines.push(`  get ${member.name}() { return loadShared(${target}, this.${addressKey(member)}); }`);
+    }
+    lines.push('}', '');
+  }
+
+  lines.push(`const ${name} = {`, `  size: ${hex(s.size)},`, '  offsets: {');
+
+  const offsets = [];
+  for (const field of s.fields) {
+    if (field.union) {
+      if (field.js) offsets.push([field.js, field.offset]);
+      else for (const alt of field.alternatives) if (alt.js) offsets.push([alt.js, field.offset + alt.offset]);
+    } else if (field.js) {
+      offsets.push([field.js, field.offset]);
+    }
+  }
+  for (const [key, offset] of offsets) lines.push(`    ${key}: ${hex(offset)},`);
+  lines.push('  },');
+
+  if (followed.length) {
+    lines.push('  create() {', `    return new ${interfaceName(s)}();`, '  },');
+  } else {
+    lines.push('  create() {', '    return {');
+    for (const [key, value] of createEntries(members)) lines.push(`      ${key}: ${value},`);
+    lines.push('    };', '  },');
+  }
+
+  lines.push('  decode(view, offset, target) {', `    target ??= ${name}.create();`);
+  for (let i = 0; i < members.length; i++) {
+    const member = members[i];
+    // alternatives of a union that decode the same bytes the same way share one read
+    const shared = [member];
+    while (
+      member.container && member.type.scalar && member.field.count === undefined && i + 1 < members.length &&
+      members[i + 1].container === member.container && members[i + 1].offset === member.offset &&
+      members[i + 1].type.scalar === member.type.scalar && members[i + 1].field.count === undefined
+    ) {
+      shared.push(members[++i]);
+    }
+    if (shared.length > 1) {
+      const first = `target.${member.container}.${member.name}`;
+      lines.push(`    ${first} = ${JS_TYPES[member.type.scalar].read(`offset + ${hex(member.offset)}`)};`);
+      for (const m of shared.slice(1)) lines.push(`    target.${m.container}.${m.name} = ${first};`);
+      continue;
+    }
+    for (const statement of decodeStatements(s, member)) lines.push(`    ${statement}`);
+  }
+  lines.push('    return target;', '  },', '};');
+  return lines.join('\n');
+}
+
+function generateLayouts() {
+  const layouts = structs.filter(s => s.js);
+  const parts = [
+    "'use strict';",
+    '',
+    `// ${BANNER}`,
+    '//',
+    '// Fixed-offset decoders for the structs in d2r/models. Every layout has',
+    '//   size                          struct size in bytes',
+    '//   offsets                       field name -> byte offset',
+    '//   create()                      a zeroed object, always the same shape',
+    '//   decode(view, offset, target)  fills |target| (or a new object) from the DataView at |offset|',
+    '// Pointers and 64-bit fields decode to BigInt. Pointers to another scripted struct decode to a getter that',
+    '// returns the pointed-to struct, decoded at most once per tick and shared by everything that points at it (see',
+    '// loadShared() in d2r/model-cache).',
+    '',
+    "const { loadShared } = require('d2r/model-cache');",
+    '',
+    'function readString(view, offset, length) {',
+    "  let value = '';",
+    '  for (let i = 0; i < length; i++) {',
+    '    const c = view.getUint8(offset + i);',
+    '    if (c === 0) break;',
+    '    value += String.fromCharCode(c);',
+    '  }',
+    '  return value;',
+    '}',
+    '',
+  ];
+  for (const s of layouts) parts.push(generateLayout(s), '');
+  parts.push('module.exports = {', ...layouts.map(s => `  ${layoutName(s)},`), '};', '');
+  return parts.join('\n');
+}
+
+// Typings
+
+function tsType(member) {
+  const { type, field } = member;
+  let single;
+  if (type.struct) single = interfaceName(type.struct);
+  else if (type.string) return 'string';
+  else single = JS_TYPES[type.scalar].ts;
+  return field.count === undefined ? single : `${single}[]`;
+}
+
+function generateTypings() {
+  const layouts = structs.filter(s => s.js);
+  const parts = [
+    `// ${BANNER}`,
+    '',
+    "declare module 'd2r/layouts' {",
+    '  export interface StructLayout<T> {',
+    '    readonly size: number;',
+    '    readonly offsets: Readonly<Record<string, number>>;',
+    '    /** A zeroed object, always the same shape */',
+    '    create(): T;',
+    '    /** Fill |target| (or a new object) from |view| at |offset| */',
+    '    decode(view: DataView, offset: number, target?: T | null): T;',
+    '  }',
+    '',
+  ];
+  for (const s of layouts) {
+    parts.push(`  export interface ${interfaceName(s)} {`);
+    const unions = new Map();
+    for (const member of scriptMembers(s)) {
+      if (member.container) {
+        if (!unions.has(member.container)) {
+          unions.set(member.container, []);
+          parts.push(`    ${member.container}: @${member.container}@;`);
+        }
+        unions.get(member.container).push(`${member.name}: ${tsType(member)}`);
+      } else if (isFollowed(member)) {
+        parts.push(`    ${addressKey(member)}: bigint;`);
+        parts.push(`    readonly ${member.name}: ${interfaceName(byName.get(member.field.follow))} | null;`);
+      } else {
+        parts.push(`    ${member.name}: ${tsType(member)};`);
+      }
+    }
+    for (const [container, entries] of unions) {
+      const index = parts.indexOf(`    ${container}: @${container}@;`);
+      parts[index] = `    ${container}: { ${entries.join('; ')} };`;
+    }
+    parts.push('  }', '');
+  }
+  for (const s of layouts) parts.push(`  export const ${layoutName(s)}: StructLayout<${interfaceName(s)}>;`);
+  parts.push('}', '');
+  return parts.join('\n');
+}
+
+function main() {
+  const check = process.argv.includes('--check');
+  for (const s of structs) validate(s);
+
+  const crlf = text => text.replace(/\n/g, '\r\n');
+  const outputs = [
+    ['src/d2r_game_structs.h', generateCpp()],
+    ['lib/d2r/models.js', crlf(generateModels())],
+    ['lib/d2r/layouts.js', crlf(generateLayouts())],
+    ['typings/d2r/layouts.d.ts', crlf(generateTypings())],
+  ];
+
+  let stale = 0;
+  for (const [file, content] of outputs) {
+    const target = path.join(ROOT, file);
+    const current = fs.existsSync(target) ? fs.readFileSync(target, 'utf8') : null;
+    if (current === content) continue;
+    if (check) {
+      console.error(`${file} is out of date, run node tools/structgen/generate.js`);
+      stale++;
+    } else {
+      fs.writeFileSync(target, content);
+      console.log(`wrote ${file}`);
+    }
+  }
+  process.exitCode = stale ? 1 : 0;
+}
+
+main();
@@ -0,0 +1,465 @@
+'use strict';
+
+// Game struct layouts, the single source for src/d2r_game_structs.h and lib/d2r/models.js + lib/d2r/layouts.js.
+// Run `node tools/structgen/generate.js` after editing, never edit the generated files by hand.
+//
+// struct(cppName, jsName, size, fields) - jsName is null for structs only the native side reads.
+//
+// Fields are [offset, type, cppName, jsName, options]. Gaps between fields become padding on both sides, a field
+// without a jsName is padding on the JS side. Types:
+//   u8 u16 u32 u64 i16 i32 f32 char   scalars
+//   size                               size_t, an untyped pointer-sized value
+//   ptr                                void*
+//   'D2FooStrc*', '/*D2FooStrc*/ void*' pointers, emitted verbatim
+//   'D2FooStrc'                        embedded struct from this schema
+//   raw('vector<T>', size)             anything else, emitted verbatim
+// Options:
+//   count     array length (or [outer, inner] for 2D C arrays)
+//   as        JS type override ('Int16', 'Int32', 'String', ...) when the script side decodes differently
+//   follow    schema struct the pointer points at, attached as `model` to the MemoryModel pointer field
+//   note      trailing comment after the offset
+//
+// union(offset, jsName, alternatives) overlays fields at the same offset. The C++ side is always an anonymous
+// union, the JS side is nested under jsName (or inlined when it is null). Alternative offsets are relative.
+
+const structs = [];
+
+function struct(cpp, js, size, fields, options = {}) {
+  structs.push({ cpp, js, size, fields, ...options });
+}
+
+function raw(cpp, size) {
+  return { raw: cpp, size };
+}
+
+function union(offset, js, alternatives) {
+  return { union: true, offset, js, alternatives };
+}
+
+function f(offset, type, cpp, js = null, options = {}) {
+  return { offset, type, cpp, js, ...options };
+}
+
+struct('D2LevelDefBin', null, 0x9C, [
+  f(0x0000, 'u32', 'dwQuestFlag'),
+  f(0x0004, 'u32', 'dwQuestFlagEx'),
+  f(0x0008, 'i32', 'dwLayer'),
+  f(0x000C, 'u32', 'dwSizeX', null, { count: 3 }),
+  f(0x0018, 'u32', 'dwSizeY', null, { count: 3 }),
+  f(0x0024, 'i32', 'dwOffsetX'),
+  f(0x0028, 'i32', 'dwOffsetY'),
+  f(0x002C, 'u32', 'dwDepend'),
+  f(0x0030, 'u32', 'dwDrlgType'),
+  f(0x0034, 'u32', 'dwLevelType'),
+  f(0x0038, 'i32', 'nSubType'),
+  f(0x003C, 'i32', 'nSubTheme'),
+  f(0x0040, 'i32', 'nSubWaypoint'),
+  f(0x0044, 'i32', 'nSubShrine'),
+  f(0x0048, 'u32', 'dwVis', null, { count: 8 }),
+  f(0x0068, 'i32', 'nWarp', null, { count: 8 }),
+  f(0x0088, 'u8', 'nIntensity'),
+  f(0x0089, 'u8', 'nRed'),
+  f(0x008A, 'u8', 'nGreen'),
+  f(0x008B, 'u8', 'nBlue'),
+  f(0x008C, 'u32', 'dwPortal'),
+  f(0x0090, 'u32', 'dwPosition'),
+  f(0x0094, 'u32', 'dwSaveMonsters'),
+  f(0x0098, 'u32', 'dwLOSDraw'),
+]);
+
+// Rows of the txt tables indexed by src/data_tables.h, only their size is used. The sizes are unverified guesses,
+// DataTables only uses a table once the units' txt row pointers agree with the size (items.txt has no such check).
+struct('D2MonStatsTxt', null, 0x1A8, []);
+struct('D2ObjectsTxt', null, 0x1C0, []);
+struct('D2ItemsTxt', null, 0x1A8, []);
+
+// sgptDataTbls[nDataTblsIndex], only the table pointers and record counts. 64-bit port of the classic layout,
+// DataTables checks pLevelDefBin against GetLevelDef before it trusts the other tables.
+struct('D2DataTablesStrc', null, 0x1700, [
+  f(0x0C10, 'D2MonStatsTxt*', 'pMonStatsTxt'),
+  f(0x0C18, 'i32', 'nMonStatsTxtRecordCount'),
+  f(0x1050, 'D2ObjectsTxt*', 'pObjectsTxt'),
+  f(0x1058, 'i32', 'nObjectsTxtRecordCount'),
+  f(0x10B8, 'i32', 'nLevelsTxtRecordCount'),
+  f(0x10C0, 'D2LevelDefBin*', 'pLevelDefBin'),
+  f(0x1640, 'D2ItemsTxt*', 'pItemsTxt'),
+  f(0x1648, 'i32', 'nItemsTxtRecordCount'),
+]);
+
+struct('D2SeedStrc', 'SeedModel', 0x8, [
+  f(0x0000, 'u32', 'dwLow', 'low'),
+  f(0x0004, 'u32', 'dwHigh', 'high'),
+]);
+
+struct('D2FP16', 'D2FP16Model', 0x8, [
+  f(0x0000, 'u16', 'wOffsetX', 'xOff'),
+  f(0x0002, 'u16', 'wPosX', 'x'),
+  f(0x0004, 'u16', 'wOffsetY', 'yOff'),
+  f(0x0006, 'u16', 'wPosY', 'y'),
+]);
+
+struct('D2FP32', 'D2FP32Model', 0x8, [
+  f(0x0000, 'u32', 'dwPrecisionX', 'x'),
+  f(0x0004, 'u32', 'dwPrecisionY', 'y'),
+]);
+
+struct('D2FP32_16', 'D2FP32_16Model', 0x8, [
+  union(0x0000, null, [
+    f(0x0000, 'D2FP16', 'fp16', 'fp16'),
+    f(0x0000, 'D2FP32', 'fp32', 'fp32'),
+  ]),
+]);
+
+struct('D2PathPointStrc', 'PathPointModel', 0x4, [
+  f(0x0000, 'u16', 'wX', 'x'),
+  f(0x0002, 'u16', 'wY', 'y'),
+], { packed: true });
+
+struct('D2DrlgCoordsStrc', 'DrlgCoordsModel', 0x20, [
+  f(0x0000, 'i32', 'nSubtileX', 'subtileX', { as: 'Uint32', note: 'nBackCornerTileX' }),
+  f(0x0004, 'i32', 'nSubtileY', 'subtileY', { as: 'Uint32', note: 'nBackCornerTileY' }),
+  f(0x0008, 'i32', 'nSubtileWidth', 'subtileWidth', { as: 'Uint32', note: 'nSizeGameX' }),
+  f(0x000C, 'i32', 'nSubtileHeight', 'subtileHeight', { as: 'Uint32', note: 'nSizeGameY' }),
+  f(0x0010, 'i32', 'nTileXPos', 'tileX', { as: 'Uint32', note: 'nSizeTileX' }),
+  f(0x0014, 'i32', 'nTileYPos', 'tileY', { as: 'Uint32', note: 'nSizeTileY' }),
+  f(0x0018, 'i32', 'nTileWidth', 'tileWidth', { as: 'Uint32' }),
+  f(0x001C, 'i32', 'nTileHeight', 'tileHeight', { as: 'Uint32' }),
+]);
+
+struct('D2CoordStrc', null, 0x8, [
+  f(0x0000, 'i32', 'nX'),
+  f(0x0004, 'i32', 'nY'),
+]);
+
+struct('D2DrlgCoordStrc', 'DrlgCoordModel', 0x10, [
+  f(0x0000, 'i32', 'nBackCornerTileX', 'backCornerTileX', { as: 'Uint32' }),
+  f(0x0004, 'i32', 'nBackCornerTileY', 'backCornerTileY', { as: 'Uint32' }),
+  f(0x0008, 'i32', 'nSizeTileX', 'sizeTileX', { as: 'Uint32' }),
+  f(0x000C, 'i32', 'nSizeTileY', 'sizeTileY', { as: 'Uint32' }),
+]);
+
+struct('D2DrlgTileInfoStrc', null, 0xC, [
+  f(0x0000, 'i32', 'nPosX'),
+  f(0x0004, 'i32', 'nPosY'),
+  f(0x0008, 'i32', 'nTileIndex'),
+]);
+
+struct('D2DrlgRoomStrc', 'DrlgRoomModel', 0x1C0, [
+  f(0x0008, 'u32', 'dwInitSeed', 'initSeed'),
+  f(0x0010, raw('vector<D2DrlgRoomStrc*>', 0x18), 'ptRoomsNear'),
+  f(0x0030, 'D2SeedStrc', 'tSeed', 'seed'),
+  f(0x0038, 'D2DrlgRoomStrc*', 'ptStatusNext', 'statusNext'),
+  f(0x0040, 'size', 'ptMaze', 'maze'),
+  f(0x0048, 'D2DrlgRoomStrc*', 'ptDrlgRoomNext', 'drlgRoomNext'),
+  f(0x0050, 'u32', 'dwFlags', 'flags'),
+  f(0x0058, 'D2ActiveRoomStrc*', 'hRoom', 'handleRoom'),
+  f(0x0060, 'D2DrlgCoordStrc', 'tRoomCoords', 'roomCoords'),
+  f(0x0070, 'u8', 'fRoomStatus', 'roomStatus'),
+  f(0x0074, 'i32', 'nType', 'type', { as: 'Uint32' }),
+  f(0x0078, 'size', 'ptRoomTiles', 'roomTiles'),
+  f(0x0080, 'u32', 'dwDT1Mask', 'dt1Mask'),
+  f(0x0090, 'D2DrlgLevelStrc*', 'ptLevel', 'level', { follow: 'D2DrlgLevelStrc' }),
+  f(0x0098, '/*D2PresetUnitStrc*/ void*', 'ptPresetUnits', 'presetUnits'),
+  f(0x00B0, 'char', 'pTiles', null, { count: [32, 8] }),
+  f(0x01B0, 'D2DrlgRoomStrc*', 'ptStatusPrev', 'statusPrev'),
+  f(0x01B8, 'u64', 'nUniqueId', 'uniqueID'),
+]);
+
+struct('D2TileLibraryEntryStrc', null, 0x80, [
+  f(0x0000, 'i32', 'nLightDirection'),
+  f(0x0004, 'i16', 'nRoofHeight'),
+  f(0x0006, 'i16', 'nFlags'),
+  f(0x0008, 'i32', 'nTotalHeight'),
+  f(0x000C, 'i32', 'nWidth'),
+  f(0x0010, 'i32', 'nHeightToBottom'),
+  f(0x0014, 'i32', 'nType'),
+  f(0x0018, 'i32', 'nStyle'),
+  f(0x001C, 'i32', 'nSequence'),
+  f(0x0020, 'i32', 'nRarity_Frame'),
+  f(0x0024, 'i32', 'nTransparentColorRGB24'),
+  f(0x0028, 'u8', 'dwTileFlags', null, { count: 4 }),
+]);
+
+struct('D2DrlgTileDataStrc', null, 0x48, [
+  f(0x0000, 'i32', 'nWidth'),
+  f(0x0004, 'i32', 'nHeight'),
+  f(0x0008, 'i32', 'nPosX'),
+  f(0x000C, 'i32', 'nPosY'),
+  f(0x0018, 'u32', 'dwFlags'),
+  f(0x0020, 'D2TileLibraryEntryStrc*', 'ptTile'),
+  f(0x0028, 'i32', 'nTileCount'),
+]);
+
+struct('D2DrlgRoomTilesStrc', null, 0x68, [
+  f(0x0000, 'D2DrlgTileDataStrc*', 'ptWallTiles'),
+  f(0x0008, 'u64', 'nWalls'),
+  f(0x0020, 'D2DrlgTileDataStrc*', 'ptFloorTiles'),
+  f(0x0028, 'u64', 'nFloors'),
+  f(0x0040, 'D2DrlgTileDataStrc*', 'ptRoofTiles'),
+  f(0x0048, 'u64', 'nRoofs'),
+]);
+
+struct('D2RoomCollisionGridStrc', null, 0x28, [
+  f(0x0000, 'D2DrlgCoordsStrc', 'tRoomCoords'),
+  f(0x0020, 'uint16_t*', 'pCollisionMask', null, { note: 'nSubtileWidth * nSubtileHeight flags, row-major' }),
+]);
+
+struct('D2ActiveRoomStrc', 'ActiveRoomModel', 0xC0, [
+  f(0x0000, 'D2ActiveRoomStrc**', 'ptRoomList', 'roomList'),
+  f(0x0008, 'D2DrlgRoomTilesStrc*', 'ptRoomTiles', 'roomTiles'),
+  f(0x0018, 'D2DrlgRoomStrc*', 'ptDrlgRoom', 'drlgRoom', { follow: 'D2DrlgRoomStrc' }),
+  f(0x0038, 'D2RoomCollisionGridStrc*', 'ptCollisionGrid', 'collisionGrid'),
+  f(0x0040, 'u32', 'dwNumRooms', 'roomCount'),
+  f(0x0044, 'u32', 'dwNumUnits', 'unitCount'),
+  f(0x0048, '/*D2DrlgActStrc*/ void*', 'ptDrlgAct', 'drlgAct'),
+  f(0x0054, 'u32', 'dwFlags', 'flags'),
+  f(0x0080, 'D2DrlgCoordsStrc', 'tCoords', 'coords'),
+  f(0x00A0, 'D2SeedStrc', 'tSeed', 'seed'),
+  f(0x00A8, 'D2UnitStrc*', 'ptUnitFirst', 'unitFirst'),
+  f(0x00B0, 'D2ActiveRoomStrc*', 'ptRoomNext', 'roomNext'),
+]);
+
+struct('D2DrlgLevelStrc', 'DrlgLevelModel', 0x280, [
+  f(0x0000, 'u32', 'dwDrlgType', 'drlgType'),
+  f(0x0004, 'u32', 'dwFlags', 'flags'),
+  f(0x0008, 'i32', 'nRooms', 'roomCount', { as: 'Int32' }),
+  f(0x0010, 'D2DrlgRoomStrc*', 'ptRoomFirst', 'roomFirst'),
+  union(0x0018, null, [
+    f(0x0000, '/*LevelMazeTableRecord*/ void*', 'pMaze', 'maze'),
+    f(0x0000, '/*D2DrlgPresetInfoStrc*/ void*', 'pPresetInfo'),
+    f(0x0000, '/*D2DrlgOutdoorInfoStrc*/ void*', 'pOutdoorsInfo'),
+  ]),
+  f(0x0028, 'D2DrlgCoordStrc', 'tCoords', 'coords'),
+  f(0x0038, 'D2DrlgTileInfoStrc', 'ptTileInfo', null, { count: 32 }),
+  f(0x01B8, 'D2DrlgLevelStrc*', 'ptNextLevel', 'nextLevel'),
+  f(0x01C0, 'size', 'ptCurrentMap', 'currentMap', { note: 'D2DrlgMapStrc*' }),
+  f(0x01C8, 'D2DrlgStrc*', 'ptDrlg', 'drlg'),
+  f(0x01E0, 'u32', 'dwLevelType', 'levelType'),
+  f(0x01E4, 'D2SeedStrc', 'tSeed', 'seed'),
+  f(0x01F8, 'i32', 'eLevelId', 'id', { as: 'Uint32' }),
+  f(0x0208, 'i32', 'nRoom_Center_Warp_X', 'roomCenterWarpX', { count: 9, as: 'Int32' }),
+  f(0x022C, 'i32', 'nRoom_Center_Warp_Y', 'roomCenterWarpY', { count: 9, as: 'Int32' }),
+  f(0x0250, 'u32', 'dwNumCenterWarps', 'centerWarpCount'),
+]);
+
+struct('D2DrlgStrc', 'DrlgModel', 0x880, [
+  f(0x0000, 'D2SeedStrc', 'tSeed', 'seed'),
+  f(0x0008, 'u32', 'nAllocatedRooms', 'allocatedRooms'),
+  f(0x0010, 'ptr', 'ptTiles', null, { count: 32 }),
+  f(0x0110, 'u32', 'dwFlags', 'flags'),
+  f(0x0118, '/*D2DrlgWarpStrc*/ void*', 'pWarp', 'warp'),
+  f(0x0120, 'u32', 'dwStaffLevelOffset', 'staffLevelOffset'),
+  f(0x0128, 'size', 'ptGame', 'game'),
+  f(0x0130, 'D2DrlgRoomStrc', 'tStatusRoomsLists', 'statusRoomsList', { count: 4 }),
+  f(0x0830, 'u8', 'nDifficulty', 'difficulty'),
+  f(0x0838, 'ptr', 'pfnAutomap', 'pfnAutomap'),
+  f(0x0840, 'u32', 'dwInitSeed', 'initSeed', { note: 'encrypted' }),
+  f(0x0844, 'u32', 'dwJungleInterlink', 'jungleInterlink'),
+  f(0x0848, 'D2DrlgRoomStrc*', 'ptDrlgRoom', 'drlgRoom'),
+  f(0x0858, 'D2DrlgActStrc*', 'ptAct', 'act'),
+  f(0x0860, 'u32', 'dwStartSeed', 'startSeed'),
+  f(0x0868, 'D2DrlgLevelStrc*', 'ptLevel', 'level'),
+  f(0x0870, 'u8', 'nActNo', 'actNo'),
+  f(0x0874, 'u32', 'dwBossLevelOffset', 'bossLevelOffset'),
+  f(0x0878, 'ptr', 'pfnTownAutomap', 'pfnTownAutomap'),
+]);
+
+struct('D2DrlgActStrc', 'DrlgActModel', 0x90, [
+  f(0x0000, 'u32', 'bUpdate', 'update'),
+  f(0x0008, 'size', 'ptEnvironment', 'environment'),
+  f(0x0010, 'D2SeedStrc', 'tInitSeed', 'initSeed'),
+  f(0x0018, 'D2ActiveRoomStrc*', 'ptRoom', 'room', { follow: 'D2ActiveRoomStrc' }),
+  f(0x0020, 'u32', 'dwActId', 'actId'),
+  f(0x0048, 'size', 'ptTileData', 'tileData'),
+  f(0x0070, 'D2DrlgStrc*', 'ptDrlg', 'drlg', { follow: 'D2DrlgStrc' }),
+  f(0x0078, 'ptr', 'pfnActCallback', 'actCallback'),
+]);
+
+struct('D2DynamicPathStrc', 'DynamicPathModel', 0x230, [
+  f(0x0000, 'D2FP32_16', 'tGameCoords', 'gameCoords'),
+  f(0x0008, 'u32', 'dwClientCoordX', 'clientCoordX', { as: 'Int32' }),
+  f(0x000C, 'u32', 'dwClientCoordY', 'clientCoordY', { as: 'Int32' }),
+  f(0x0010, 'D2PathPointStrc', 'tTargetCoord', 'targetCoord'),
+  f(0x0014, 'D2PathPointStrc', 'tPrevTargetCoord', 'prevTargetCoord'),
+  f(0x0018, 'D2PathPointStrc', 'tFinalTargetCoord', 'finalTargetCoord'),
+  f(0x0020, 'D2ActiveRoomStrc*', 'ptRoom', 'room', { follow: 'D2ActiveRoomStrc' }),
+  f(0x0028, 'D2ActiveRoomStrc*', 'ptPreviousRoom', 'previousRoom'),
+  f(0x0030, 'u32', 'dwCurrentPointIdx', 'currentPointIndex'),
+  f(0x0034, 'u32', 'dwPathPoints', 'pathPointCount'),
+  f(0x0040, 'D2UnitStrc*', 'ptUnit', 'unit'),
+  f(0x0048, 'u32', 'dwFlags', 'flags'),
+  f(0x0050, 'u32', 'dwPathType', 'pathType'),
+  f(0x0054, 'u32', 'dwPrevPathType', 'prevPathType'),
+  f(0x0058, 'u32', 'dwUnitSize', 'unitSize'),
+  f(0x005C, 'u32', 'dwCollisionPattern', 'collisionPattern'),
+  f(0x0060, 'u32', 'dwFootprintCollisionMask', 'footprintCollisionMask'),
+  f(0x0064, 'u32', 'dwMoveTestCollisionMask', 'moveTestCollisionMask'),
+  f(0x0070, 'D2UnitStrc*', 'pTargetUnit', 'targetUnit'),
+  f(0x0078, 'u32', 'dwTargetType', 'targetType'),
+  f(0x007C, 'u32', 'dwTargetId', 'targetId'),
+  f(0x0080, 'f32', 'fDirection'),
+  f(0x0084, 'f32', 'fNewDirection'),
+  f(0x0088, 'f32', 'fDiffDirection'),
+  f(0x008E, 'D2CoordStrc', 'tDirectionVector'),
+  f(0x0096, 'D2CoordStrc', 'tVelocityVector'),
+  f(0x00A0, 'i32', 'nVelocity', 'velocity', { as: 'Int32' }),
+  f(0x00A4, 'i32', 'nPreviousVelocity', 'previousVelocity', { as: 'Int32' }),
+  f(0x00A8, 'i32', 'nMaxVelocity', 'maxVelocity', { as: 'Int32' }),
+  f(0x00C8, 'D2PathPointStrc', 'ptPathPoints', 'pathPoints', { count: 78 }),
+  f(0x0200, 'u32', 'dwSavedStepsCount', 'savedStepCount'),
+  f(0x0204, 'D2PathPointStrc', 'ptSavedSteps', 'savedSteps', { count: 10 }),
+], { packed: true });
+
+struct('D2SkillStrc', 'SkillModel', 0x50, [
+  f(0x0000, '/*D2SkillsTxt*/ void*', 'pSkillsTxt', 'skillsTxt'),
+  f(0x0008, 'D2SkillStrc*', 'pNextSkill', 'next', { follow: 'D2SkillStrc' }),
+  f(0x0010, 'u32', 'dwSkillMode', 'mode'),
+  f(0x0014, 'u32', 'dwFlags', 'flags'),
+  f(0x0038, 'u32', 'dwSkillLevel', 'baseLevel'),
+  f(0x0040, 'i32', 'nQuantity', 'quantity', { as: 'Int32' }),
+  f(0x0044, 'i32', 'nOwnerId', 'ownerId', { as: 'Int32' }),
+  f(0x0048, 'i32', 'nCharges', 'charges', { as: 'Int32' }),
+]);
+
+struct('D2SkillListStrc', 'SkillListModel', 0x20, [
+  f(0x0000, 'D2SkillStrc*', 'pFirstSkill', 'first', { follow: 'D2SkillStrc' }),
+  f(0x0008, 'D2SkillStrc*', 'pLeftSkill', 'left', { follow: 'D2SkillStrc' }),
+  f(0x0010, 'D2SkillStrc*', 'pRightSkill', 'right', { follow: 'D2SkillStrc' }),
+  f(0x0018, 'D2SkillStrc*', 'pUsedSkill', 'used', { follow: 'D2SkillStrc' }),
+]);
+
+struct('D2PlayerDataStrc', 'PlayerDataModel', 0x80, [
+  f(0x0000, 'char', 'szName', 'name', { count: 16, as: 'String' }),
+  f(0x0040, 'ptr', 'pQuestData', 'questBuffers', { count: 3 }),
+  f(0x0058, 'ptr', 'pWaypointData', 'waypointBuffers', { count: 3 }),
+  f(0x0078, 'u32', 'dwPortalFlags', 'portalFlags'),
+]);
+
+struct('D2MonsterDataStrc', 'MonsterDataModel', 0x58, [
+  f(0x0000, 'D2MonStatsTxt*', 'pMonstatsTxt', 'txtRecord'),
+  f(0x0018, 'u16', 'wNameSeed', 'nameSeed'),
+  f(0x001A, 'u8', 'nTypeFlag', 'typeFlag'),
+  f(0x001B, 'u8', 'nLastAnimMode', 'lastAnimMode'),
+  f(0x001C, 'u32', 'dwDurielFlag', 'durielFlag'),
+  f(0x0020, 'u8', 'nMonUmod', 'monUMod', { count: 10 }),
+  f(0x002A, 'u16', 'wBossHcIdx', 'uniqueId'),
+  f(0x0050, 'u32', 'dwOwnerType', 'ownerType'),
+  f(0x0054, 'u32', 'dwOwnerId', 'ownerId'),
+]);
+
+struct('D2ObjectDataStrc', 'GameObjectDataModel', 0x10, [
+  f(0x0000, 'D2ObjectsTxt*', 'pObjectTxt', 'txtRecord'),
+  f(0x0008, 'u8', 'nInteractType', 'type'),
+]);
+
+// Items, objects and tiles sit on a static path, an item in an inventory keeps its grid cell in it.
+struct('D2StaticPathStrc', null, 0x28, [
+  f(0x0010, 'u32', 'dwPosX'),
+  f(0x0014, 'u32', 'dwPosY'),
+  f(0x0020, 'D2ActiveRoomStrc*', 'ptRoom'),
+]);
+
+// One stat, the game keeps each array sorted by (wStatId, wLayer) and binary-searches it.
+struct('D2StatStrc', null, 0x8, [
+  f(0x0000, 'u16', 'wLayer'),
+  f(0x0002, 'u16', 'wStatId'),
+  f(0x0004, 'i32', 'nValue'),
+]);
+
+struct('D2StatsArrayStrc', null, 0x10, [
+  f(0x0000, 'D2StatStrc*', 'pStat'),
+  f(0x0008, 'u64', 'nStatCount'),
+]);
+
+// Only the fields the stat reader uses. tBaseStats are the unit's own stats, tFullStats the stats after items,
+// states and auras were applied.
+struct('D2StatListExStrc', null, 0xA0, [
+  f(0x0000, 'ptr', 'pMemPool'),
+  f(0x0008, 'u32', 'dwOwnerType'),
+  f(0x000C, 'u32', 'dwOwnerId'),
+  f(0x001C, 'u32', 'dwFlags'),
+  f(0x0030, 'D2StatsArrayStrc', 'tBaseStats'),
+  f(0x0088, 'D2StatsArrayStrc', 'tFullStats'),
+]);
+
+// 64-bit port of the classic layout, items are linked through D2ItemDataStrc::pPrevItem/pNextItem.
+struct('D2InventoryStrc', 'InventoryModel', 0x48, [
+  f(0x0000, 'u32', 'dwSignature', 'signature', { note: 'kInventorySignature' }),
+  f(0x0008, 'ptr', 'pMemPool'),
+  f(0x0010, 'D2UnitStrc*', 'pOwner', 'owner'),
+  f(0x0018, 'D2UnitStrc*', 'pFirstItem', 'firstItem'),
+  f(0x0020, 'D2UnitStrc*', 'pLastItem', 'lastItem'),
+  f(0x0028, '/*D2InventoryGridStrc*/ void*', 'pGrids', 'grids'),
+  f(0x0030, 'i32', 'nGridCount', 'gridCount', { as: 'Int32' }),
+  f(0x0034, 'u32', 'dwLeftItemGUID', 'weaponId'),
+  f(0x0038, 'D2UnitStrc*', 'pCursorItem', 'cursorItem'),
+  f(0x0040, 'u32', 'dwOwnerId', 'ownerId'),
+  f(0x0044, 'u32', 'dwItemCount', 'itemCount'),
+]);
+
+struct('D2ItemDataStrc', 'ItemDataModel', 0xC0, [
+  f(0x0000, 'u32', 'dwQualityNo', 'quality'),
+  f(0x0004, 'D2SeedStrc', 'tLoSeed', 'seed'),
+  f(0x000C, 'u32', 'dwOwnerGUID', 'ownerId'),
+  f(0x0018, 'u32', 'dwItemFlags', 'flags'),
+  f(0x0038, 'u32', 'dwItemLevel', 'itemLevel', { note: 'always 1 for online' }),
+  f(0x0040, 'u16', 'wItemFormat', 'itemFormat'),
+  f(0x0042, 'u16', 'wRarePrefix', 'rarePrefix'),
+  f(0x0044, 'u16', 'wRareSuffix', 'rareSuffix'),
+  f(0x0046, 'u16', 'wAutoAffix', 'autoAffix'),
+  f(0x0048, 'u16', 'wMagicPrefix', 'magicPrefix', { count: 3 }),
+  f(0x004E, 'u16', 'wMagicSuffix', 'magicSuffix', { count: 3 }),
+  f(0x0054, 'u8', 'nBodyLoc', 'bodyLocation'),
+  f(0x0055, 'u8', 'nInvPage', 'inventoryPage'),
+  f(0x00A0, 'D2InventoryStrc*', 'pOwnerInventory', 'ownerInventory'),
+  f(0x00A8, 'D2UnitStrc*', 'pPrevItem', 'itemPrev', { follow: 'D2UnitStrc' }),
+  f(0x00B0, 'D2UnitStrc*', 'pNextItem', 'itemNext', { follow: 'D2UnitStrc' }),
+  f(0x00B8, 'u8', 'nNodePos', 'nodePos'),
+  f(0x00B9, 'u8', 'nNodePosOther', 'nodePosEx'),
+]);
+
+struct('D2UnitStrc', 'UnitModel', 0x1C0, [
+  f(0x0000, 'u32', 'dwUnitType', 'type'),
+  f(0x0004, 'u32', 'dwClassId', 'classId'),
+  f(0x0008, 'u32', 'dwId', 'id'),
+  f(0x000C, 'u32', 'dwMode', 'mode'),
+  union(0x0010, 'data', [
+    f(0x0000, 'D2PlayerDataStrc*', 'pPlayerData', 'playerData', { follow: 'D2PlayerDataStrc' }),
+    f(0x0000, 'D2MonsterDataStrc*', 'pMonsterData', 'monsterData', { follow: 'D2MonsterDataStrc' }),
+    f(0x0000, 'D2ItemDataStrc*', 'pItemData', 'itemData', { follow: 'D2ItemDataStrc' }),
+    f(0x0000, 'D2ObjectDataStrc*', 'pObjectData', 'gameObjectData', { follow: 'D2ObjectDataStrc' }),
+  ]),
+  f(0x0018, 'u64', 'dwAct', 'actId'),
+  f(0x0020, 'D2DrlgActStrc*', 'pDrlgAct', 'drlgAct', { follow: 'D2DrlgActStrc' }),
+  f(0x0028, 'D2SeedStrc', 'tSeed', 'seed'),
+  f(0x0030, 'D2SeedStrc', 'tInitSeed', 'initSeed'),
+  union(0x0038, null, [
+    f(0x0000, 'D2DynamicPathStrc*', 'pDynamicPath', 'path', { follow: 'D2DynamicPathStrc' }),
+    f(0x0000, 'D2StaticPathStrc*', 'pStaticPath'),
+  ]),
+  f(0x005C, 'u32', 'dwAnimSeqFrame', 'animSeqFrame'),
+  f(0x0060, 'u32', 'dwAnimSeqFrame2', 'animSeqFrame2'),
+  f(0x0064, 'u32', 'dwAnimSeqFrameCount', 'animSeqFrameCount'),
+  f(0x0068, 'u32', 'dwAnimSpeed', 'animSpeed'),
+  f(0x0070, '/*D2AnimDataRecordStrc*/ void*', 'pAnimData', 'animData'),
+  f(0x0078, '/*D2GfxDataStrc*/ void*', 'pGfxData', 'gfxData'),
+  f(0x0088, 'D2StatListExStrc*', 'pStatListEx', 'statListEx'),
+  f(0x0090, 'D2InventoryStrc*', 'pInventory', 'inventory'),
+  f(0x00C0, 'size', 'pPacketList', 'packetList'),
+  f(0x00D4, 'u16', 'wPosX', 'posX', { as: 'Int16' }),
+  f(0x00D6, 'u16', 'wPosY', 'posY', { as: 'Int16' }),
+  f(0x00D8, 'u64', 'nResourceId', 'resourceId'),
+  f(0x0100, 'D2SkillListStrc*', 'pSkills', 'skills', { follow: 'D2SkillListStrc' }),
+  f(0x0124, 'u32', 'dwFlags', 'flags'),
+  f(0x0128, 'u32', 'dwFlagsEx', 'flagsEx'),
+  f(0x0150, 'D2UnitStrc*', 'pChangeNextUnit', 'changeNextUnit'),
+  f(0x0158, 'D2UnitStrc*', 'pUnitNext', 'unitNext'),
+  f(0x0160, 'D2UnitStrc*', 'pRoomUnitNext', 'roomUnitNext'),
+  f(0x0178, 'u32', 'dwCollisionUnitType', 'collisionUnitType'),
+  f(0x017C, 'u32', 'dwCollisionUnitClassId', 'collisionUnitClassId'),
+  f(0x0180, 'u32', 'dwCollisionUnitSizeX', 'collisionUnitSizeX'),
+  f(0x0184, 'u32', 'dwCollisionUnitSizeY', 'collisionUnitSizeY'),
+  f(0x01BD, 'u8', 'nDataTblsIndex', 'dataTblsIndex'),
+]);
+
+module.exports = { structs };
@@ -15,6 +15,12 @@ declare function internalBinding(module: 'd2r'): {
    */
   automapGetMode(): number;
 
+  /**
+   * Project the first `count` x, y pairs of client coordinates in `positions` onto the automap, into `out`
+   * @returns false if the automap is hidden, `out` is left alone then
+   */
+  worldToAutomapMany(positions: Int32Array, out: Float32Array, count?: number): boolean;
+
   /**
    * Reveal a level on the map
    * @param levelId The level ID to reveal
@@ -27,6 +33,12 @@ declare function internalBinding(module: 'd2r'): {
    */
   getPlayerIdByIndex(index: number): number;
 
+  /**
+   * Get every occupied player slot in one call. Ids are cached natively until the encrypted table changes.
+   * @returns (index, id, unit address) triples
+   */
+  getPlayers(): BigUint64Array;
+
   /**
    * Get the local player's index
    */
@@ -41,4 +53,187 @@ declare function internalBinding(module: 'd2r'): {
    * Get the address of the server-side unit hash table
    */
   getServerSideUnitHashTableAddress(): bigint;
+
+  /**
+   * Copy every reachable unit (and its dynamic path) of both unit hash tables into the staging arena.
+   * Must be called while holding the game lock.
+   * @param typeMask Unit types to walk (bit per type, all by default), the others keep their records from their
+   * last walk
+   * @param roomRadius Take the units from the local player's room and its neighbors up to this many hops away instead
+   * of the hash tables
+   * @returns The walked type mask (may include types that were not asked for), then a (first record, record count)
+   * pair per unit type
+   */
+  snapshotUnits(typeMask?: number, roomRadius?: number): Uint32Array;
+
+  /**
+   * Get the staging arena filled by snapshotUnits(), records are laid out as UnitSnapshotRecord
+   */
+  getSnapshotBuffer(): ArrayBuffer | undefined;
+
+  /**
+   * Start or stop the native snapshot worker that matches, places and diffs the records of captureUnits()
+   * @returns whether the worker is running
+   */
+  snapshotPipelineEnable(enabled: boolean): boolean;
+
+  /**
+   * Like snapshotUnits(), but capture into a job of the snapshot worker. Must be called while holding the game lock.
+   * Walks every type while a session is recorded.
+   * @returns The walked type mask, undefined if the worker is not running or still busy with the previous captures
+   */
+  captureUnits(typeMask?: number, roomRadius?: number): number | undefined;
+
+  /**
+   * Take the snapshot worker's next result, the previous records buffer must not be read anymore
+   * @returns [records, events]: UnitSnapshotRecords by worker slot and uint32 frame, walked type mask, removed count,
+   * added count, updated count, slot count, two reserved words, the removed slots, the added slots and a
+   * (slot, changed) pair per walked unit. Undefined if no capture finished since the last call
+   */
+  swapSnapshot(): [ArrayBuffer, Uint32Array] | undefined;
+
+  /**
+   * Copy size bytes at address, validated against the committed-region map
+   * @returns A view over the copy, undefined if the range is not readable
+   */
+  readMemory(address: bigint, size: number): DataView | undefined;
+
+  /**
+   * Read the inventory of the unit at address and diff it against the previous read of the same owner.
+   * Must be called while holding the game lock.
+   * @param reset Report every item as added, for the first read of a new watcher
+   * @returns uint32 entry count, uint32 removed count, InventoryEntry[] and the removed item ids, undefined if the
+   * unit or its inventory are not readable
+   */
+  snapshotInventory(address: bigint, reset?: boolean): ArrayBuffer | undefined;
+
+  /**
+   * Drop the inventory state kept for the unit at address, once its inventory is no longer watched
+   */
+  releaseInventory(address: bigint): void;
+
+  /**
+   * Read the base and full stat lists of the unit at address, with the game lock held.
+   * @param version Version of the caller's last decode, 0 for none
+   * @returns version itself if the stats did not change since, otherwise uint32 version, uint32 base count, uint32
+   * full count, uint32 reserved and the StatEntry arrays. Undefined if the unit or its stat list are not readable
+   */
+  readStats(address: bigint, version: number): number | ArrayBuffer | undefined;
+
+  /**
+   * Replace the item rules with a program compiled by compileItemRules, undefined clears them. Items are evaluated
+   * again on the next item walk and their matches land in the item_rules field of their snapshot records.
+   * @returns false if the program is malformed
+   */
+  setItemRules(program?: Uint32Array): boolean;
+
+  /**
+   * Load the dynamic paths of the snapshot records at `indices` of `records` for extrapolatePaths()
+   * @returns the number of units loaded, 0 if an index is out of range
+   */
+  loadPathMotion(records: ArrayBuffer, indices: Uint32Array): number;
+
+  /**
+   * Write the client coordinates (x, y pairs) of the loaded units `elapsedNs` after their snapshot into `out`, units
+   * stop moving `maxNs` (default 500 ms) after it
+   * @returns the number of units written, 0 if `out` is too small
+   */
+  extrapolatePaths(elapsedNs: number, out: Int32Array, maxNs?: number): number;
+
+  /**
+   * Resolve a game data table (DataTableIds) of a data tables index, the buffer views the game's rows without a copy
+   * @returns [buffer, stride, count, address], undefined while the tables are not loaded or the table is unresolved
+   */
+  getDataTable(index: number, id: number): [ArrayBuffer, number, number, bigint] | undefined;
+
+  /**
+   * Flatten the UI below the PanelManager, the structure is only rebuilt when a child vector changed
+   * @param version Version of the caller's last decode, 0 for none
+   * @returns version itself if nothing changed since, otherwise [buffer, names]: uint32 version, uint32 entry count,
+   * int32 hover panel index, int32 hover widget index and the WidgetEntry array, names by entry if the structure
+   * was rebuilt since version. Undefined while there is no PanelManager
+   */
+  snapshotWidgets(version: number): number | [ArrayBuffer, string[] | undefined] | undefined;
+
+  /**
+   * Start merging room collision grids into per-level walkability maps on updateCollisionMaps(), loading the maps
+   * persisted in path (collision.d2rc in the module directory by default)
+   * @returns the path
+   */
+  collisionMapsEnable(path?: string): string;
+
+  /**
+   * Merge the rooms of the local player's act that were not seen before. Must be called while holding the game lock.
+   * @returns [level id, map version] of the local player's level, undefined while disabled or outside a level
+   */
+  updateCollisionMaps(): [number, number] | undefined;
+
+  /**
+   * Copy the walkability map of a level in the local player's seed and difficulty
+   * @param version Version of the caller's last decode, 0 for none
+   * @returns version itself if the map did not change since, otherwise int32 origin x, int32 origin y, uint32 width,
+   * uint32 height, uint32 version, uint32 bytes per row, two reserved uint32 and the rows of bits. Undefined if the
+   * level was not seen
+   */
+  getCollisionMap(levelId: number, version: number): number | ArrayBuffer | undefined;
+
+  /**
+   * Write the maps to the collisionMapsEnable() path if rooms were merged since the last save, call it outside the
+   * game lock
+   * @returns true if the file was written
+   */
+  saveCollisionMaps(): boolean;
+
+  /**
+   * @returns the number of frames the game presented so far, -1 if the Present hook is not installed
+   */
+  getFrame(): number;
+
+  /**
+   * Time until the next frame is expected, from the last present and the average frame interval. Does not block
+   * @param capMs Largest value returned, 50 by default
+   * @returns milliseconds, 0 if the frame is due, -1 if the Present hook is not installed
+   */
+  msUntilNextFrame(capMs?: number): number;
+
+  /**
+   * Publish the timings of an ObjectManager tick to the live metrics (simple_injector --top)
+   * @param gameLockNs Time the game lock was held, undefined if it could not be taken
+   */
+  recordTick(tickNs: number, gameLockNs?: number): void;
+
+  /**
+   * Enable or disable span recording (disabled by default)
+   */
+  traceEnable(enabled: boolean): void;
+
+  /**
+   * Begin a named span on the calling thread, must be paired with traceEnd()
+   */
+  traceBegin(name: string): void;
+
+  /**
+   * End the innermost span started with traceBegin()
+   */
+  traceEnd(): void;
+
+  /**
+   * Write all recorded spans as Chrome trace-event JSON (open in Perfetto or chrome://tracing)
+   * @param path Output file, defaults to trace.json next to the module
+   * @returns The path written, or undefined on failure
+   */
+  traceDump(path?: string): string | undefined;
+
+  /**
+   * Record every unit snapshot, the reachable rooms and levels, the player roster and worldToAutomap results into
+   * a delta-encoded session file that SessionReplay can play back without the game
+   * @param path Output file, defaults to session.d2rs next to the module
+   * @returns The path recorded to, or undefined on failure
+   */
+  sessionRecordStart(path?: string): string | undefined;
+
+  /**
+   * Flush and close the current session file
+   */
+  sessionRecordStop(): void;
 };
@@ -0,0 +1,23 @@
+declare module 'd2r/collision-map' {
+  /**
+   * Walkable subtiles of one level, merged from the collision grids of every room seen so far and kept across games
+   * of the same seed. Subtiles of rooms that were not loaded yet read as blocked.
+   */
+  export class CollisionMap {
+    readonly levelId: number;
+    /** Native map version this was decoded from */
+    readonly version: number;
+    /** Level bounds in absolute subtiles */
+    readonly originX: number;
+    readonly originY: number;
+    readonly width: number;
+    readonly height: number;
+
+    isWalkable(x: number, y: number): boolean;
+  }
+
+  /**
+   * Map of a level in the local player's seed and difficulty, refreshed into target if it changed
+   */
+  export function loadCollisionMap(levelId: number, target?: CollisionMap): CollisionMap | null;
+}
@@ -0,0 +1,45 @@
+declare module 'd2r/data-tables' {
+  export const DataTableIds: {
+    readonly LevelDefs: 0;
+    readonly MonStats: 1;
+    readonly Objects: 2;
+    readonly Items: 3;
+  };
+
+  /**
+   * Rows of one game data table, view covers the game's memory without a copy
+   */
+  export class DataTable {
+    readonly view: DataView;
+    readonly stride: number;
+    readonly count: number;
+    readonly address: bigint;
+
+    /**
+     * Byte offset of a row in view, -1 if out of range
+     */
+    offsetOf(index: number): number;
+
+    row(index: number): DataView | null;
+
+    /**
+     * Row index of a record pointer such as a txtRecord, -1 if it is not a row of this table
+     */
+    indexOf(address: bigint): number;
+  }
+
+  export interface DataTables {
+    levelDefs: DataTable;
+    /** null until loaded monsters confirmed the row size */
+    monStats: DataTable | null;
+    /** null until loaded objects confirmed the row size */
+    objects: DataTable | null;
+    /** always null, the row size cannot be verified */
+    items: DataTable | null;
+  }
+
+  /**
+   * Data tables of a Unit.dataTblsIndex, null while the game has not loaded them
+   */
+  export function getDataTables(index: number): DataTables | null;
+}
@@ -0,0 +1,26 @@
+declare module 'd2r/dynamic-path' {
+  import { ActiveRoomStruct } from 'd2r/layouts';
+
+  export interface PathPoint {
+    x: number;
+    y: number;
+  }
+
+  export class DynamicPath {
+    gameCoords: {
+      fp16: { xOff: number; x: number; yOff: number; y: number };
+      fp32: { x: number; y: number };
+    };
+    clientCoordX: number;
+    clientCoordY: number;
+    targetCoord: PathPoint;
+    prevTargetCoord: PathPoint;
+    finalTargetCoord: PathPoint;
+    _address: bigint;
+
+    /**
+     * Room the path is in, read from game memory on access
+     */
+    readonly room: ActiveRoomStruct | null;
+  }
+}
@@ -0,0 +1,26 @@
+declare module 'd2r/frame-ticker' {
+  export interface FrameSubscription {
+    /** Unsubscribe, the callback is not called again */
+    stop(): boolean;
+  }
+
+  /**
+   * Runs callbacks on the frames the game presents instead of a timer. Without the frame hook (replays) the
+   * callbacks run on a ~60 Hz timer with a synthetic frame counter.
+   */
+  export class FrameTicker {
+    /**
+     * Call callback every `every` frames
+     * @param callback Receives the frame number and the frames since its previous call
+     */
+    add(callback: (frame: number, elapsed: number) => void, every?: number): FrameSubscription;
+  }
+
+  /**
+   * Call callback once per presented frame, or every `every` frames
+   */
+  export function onFrame(
+    callback: (frame: number, elapsed: number) => void,
+    options?: { every?: number },
+  ): FrameSubscription;
+}
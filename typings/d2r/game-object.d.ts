@@ -1,5 +1,10 @@
 declare module 'd2r/game-object' {
   import { Unit } from 'd2r/unit';
 
-  export class GameObject extends Unit {}
+  export class GameObject extends Unit {
+    /**
+     * Row of the object's txt record in the objects table, -1 if the table is not resolved
+     */
+    readonly objectsIndex: number;
+  }
 }
@@ -4,22 +4,45 @@ declare module 'd2r' {
 
   // Re-export models
   export * from 'd2r/models';
+  export { UnitLayout, SeedLayout, DrlgActLayout } from 'd2r/layouts';
 
   // Re-export classes
   export { Seed } from 'd2r/seed';
   export { DrlgAct } from 'd2r/drlg-act';
+  export { DynamicPath } from 'd2r/dynamic-path';
   export { Unit } from 'd2r/unit';
+  export { UnitStore, UnitCollection } from 'd2r/unit-store';
+  export { UnitBatch } from 'd2r/unit-batch';
   export { Player, LocalPlayer } from 'd2r/player';
   export { Monster } from 'd2r/monster';
   export { Item } from 'd2r/item';
   export { GameObject } from 'd2r/game-object';
   export { Missile } from 'd2r/missile';
   export { RoomTile } from 'd2r/room-tile';
+  export { Inventory, InventoryItem } from 'd2r/inventory';
+  export { StatList, StatEntry } from 'd2r/stat-list';
+  export { compileItemRules, ItemRule, ItemRuleCondition } from 'd2r/item-rules';
+  export { DataTable, DataTableIds, DataTables, getDataTables } from 'd2r/data-tables';
+  export { CollisionMap } from 'd2r/collision-map';
+  export { WidgetTree, WidgetFlags, WidgetRect } from 'd2r/widget-tree';
+  export { FrameTicker, FrameSubscription, onFrame } from 'd2r/frame-ticker';
   export { ObjectManager } from 'd2r/object-manager';
+  export { SessionReplay } from 'd2r/session-replay';
   export { DebugPanel } from 'd2r/debug-panel';
 
   // Binding function
   export function revealLevel(levelId: number): boolean;
+  export function worldToAutomapMany(positions: Int32Array, out: Float32Array, count?: number): boolean;
+
+  // Span tracing, see internalBinding('d2r').traceDump
+  export function traceEnable(enabled: boolean): void;
+  export function traceBegin(name: string): void;
+  export function traceEnd(): void;
+  export function traceDump(path?: string): string | undefined;
+
+  // Session recording, see internalBinding('d2r').sessionRecordStart
+  export function sessionRecordStart(path?: string): string | undefined;
+  export function sessionRecordStop(): void;
 }
 
 // Support nyx: prefix
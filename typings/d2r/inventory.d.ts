@@ -0,0 +1,38 @@
+declare module 'd2r/inventory' {
+  import { Unit } from 'd2r/unit';
+
+  export interface InventoryItem {
+    id: number;
+    classId: number;
+    /** ItemModes */
+    mode: number;
+    flags: number;
+    quality: number;
+    page: number;
+    bodyLocation: number;
+    nodePos: number;
+    /** Grid cell of the item's top-left corner */
+    x: number;
+    y: number;
+    /** InventoryChanges bits of the last update */
+    changed: number;
+  }
+
+  export class Inventory {
+    readonly owner: Unit;
+    readonly items: Map<number, InventoryItem>;
+    /** Items added or changed by the last update */
+    readonly changed: InventoryItem[];
+    /** Ids of the items that left the inventory in the last update */
+    readonly removed: number[];
+
+    /**
+     * Item whose top-left cell is (x, y) on page, only the anchor cell is known
+     */
+    at(page: number, x: number, y: number): InventoryItem | null;
+
+    equipped(bodyLocation: number): InventoryItem | null;
+
+    onPage(page: number): IterableIterator<InventoryItem>;
+  }
+}
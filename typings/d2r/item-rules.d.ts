@@ -0,0 +1,35 @@
+declare module 'd2r/item-rules' {
+  /**
+   * A value (equal), a list of values, an inclusive range or bit tests
+   */
+  export type ItemRuleCondition =
+    | number
+    | number[]
+    | { min?: number; max?: number; any?: number; all?: number; none?: number };
+
+  /**
+   * All conditions must hold. magicPrefix and magicSuffix hold if any of the item's three affixes matches.
+   */
+  export interface ItemRule {
+    name?: string;
+    classId?: ItemRuleCondition;
+    mode?: ItemRuleCondition;
+    quality?: ItemRuleCondition;
+    flags?: ItemRuleCondition;
+    itemFormat?: ItemRuleCondition;
+    itemLevel?: ItemRuleCondition;
+    rarePrefix?: ItemRuleCondition;
+    rareSuffix?: ItemRuleCondition;
+    autoAffix?: ItemRuleCondition;
+    magicPrefix?: ItemRuleCondition;
+    magicSuffix?: ItemRuleCondition;
+  }
+
+  export const ItemRuleFields: { readonly [field: string]: number };
+
+  /**
+   * Compile up to 32 rules into the program evaluated by the native item rule engine
+   * @returns The program for setItemRules() and the rule names by match bit
+   */
+  export function compileItemRules(rules: ItemRule[]): { program: Uint32Array; names: string[] };
+}
@@ -5,5 +5,12 @@ declare module 'd2r/item' {
     readonly isOnGround: boolean;
     readonly isEquipped: boolean;
     readonly isInBelt: boolean;
+
+    /**
+     * Bitmask of the ObjectManager item rules this item matches
+     */
+    readonly ruleMask: number;
+
+    matchesRule(index: number): boolean;
   }
 }
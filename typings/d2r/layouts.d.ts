@@ -0,0 +1,320 @@
+// Generated by tools/structgen/generate.js from tools/structgen/schema.js, do not edit.
+
+declare module 'd2r/layouts' {
+  export interface StructLayout<T> {
+    readonly size: number;
+    readonly offsets: Readonly<Record<string, number>>;
+    /** A zeroed object, always the same shape */
+    create(): T;
+    /** Fill |target| (or a new object) from |view| at |offset| */
+    decode(view: DataView, offset: number, target?: T | null): T;
+  }
+
+  export interface SeedStruct {
+    low: number;
+    high: number;
+  }
+
+  export interface D2FP16Struct {
+    xOff: number;
+    x: number;
+    yOff: number;
+    y: number;
+  }
+
+  export interface D2FP32Struct {
+    x: number;
+    y: number;
+  }
+
+  export interface D2FP32_16Struct {
+    fp16: D2FP16Struct;
+    fp32: D2FP32Struct;
+  }
+
+  export interface PathPointStruct {
+    x: number;
+    y: number;
+  }
+
+  export interface DrlgCoordsStruct {
+    subtileX: number;
+    subtileY: number;
+    subtileWidth: number;
+    subtileHeight: number;
+    tileX: number;
+    tileY: number;
+    tileWidth: number;
+    tileHeight: number;
+  }
+
+  export interface DrlgCoordStruct {
+    backCornerTileX: number;
+    backCornerTileY: number;
+    sizeTileX: number;
+    sizeTileY: number;
+  }
+
+  export interface DrlgRoomStruct {
+    initSeed: number;
+    seed: SeedStruct;
+    statusNext: bigint;
+    maze: bigint;
+    drlgRoomNext: bigint;
+    flags: number;
+    handleRoom: bigint;
+    roomCoords: DrlgCoordStruct;
+    roomStatus: number;
+    type: number;
+    roomTiles: bigint;
+    dt1Mask: number;
+    _levelAddress: bigint;
+    readonly level: DrlgLevelStruct | null;
+    presetUnits: bigint;
+    statusPrev: bigint;
+    uniqueID: bigint;
+  }
+
+  export interface ActiveRoomStruct {
+    roomList: bigint;
+    roomTiles: bigint;
+    _drlgRoomAddress: bigint;
+    readonly drlgRoom: DrlgRoomStruct | null;
+    collisionGrid: bigint;
+    roomCount: number;
+    unitCount: number;
+    drlgAct: bigint;
+    flags: number;
+    coords: DrlgCoordsStruct;
+    seed: SeedStruct;
+    unitFirst: bigint;
+    roomNext: bigint;
+  }
+
+  export interface DrlgLevelStruct {
+    drlgType: number;
+    flags: number;
+    roomCount: number;
+    roomFirst: bigint;
+    maze: bigint;
+    coords: DrlgCoordStruct;
+    nextLevel: bigint;
+    currentMap: bigint;
+    drlg: bigint;
+    levelType: number;
+    seed: SeedStruct;
+    id: number;
+    roomCenterWarpX: number[];
+    roomCenterWarpY: number[];
+    centerWarpCount: number;
+  }
+
+  export interface DrlgStruct {
+    seed: SeedStruct;
+    allocatedRooms: number;
+    flags: number;
+    warp: bigint;
+    staffLevelOffset: number;
+    game: bigint;
+    statusRoomsList: DrlgRoomStruct[];
+    difficulty: number;
+    pfnAutomap: bigint;
+    initSeed: number;
+    jungleInterlink: number;
+    drlgRoom: bigint;
+    act: bigint;
+    startSeed: number;
+    level: bigint;
+    actNo: number;
+    bossLevelOffset: number;
+    pfnTownAutomap: bigint;
+  }
+
+  export interface DrlgActStruct {
+    update: number;
+    environment: bigint;
+    initSeed: SeedStruct;
+    _roomAddress: bigint;
+    readonly room: ActiveRoomStruct | null;
+    actId: number;
+    tileData: bigint;
+    _drlgAddress: bigint;
+    readonly drlg: DrlgStruct | null;
+    actCallback: bigint;
+  }
+
+  export interface DynamicPathStruct {
+    gameCoords: D2FP32_16Struct;
+    clientCoordX: number;
+    clientCoordY: number;
+    targetCoord: PathPointStruct;
+    prevTargetCoord: PathPointStruct;
+    finalTargetCoord: PathPointStruct;
+    _roomAddress: bigint;
+    readonly room: ActiveRoomStruct | null;
+    previousRoom: bigint;
+    currentPointIndex: number;
+    pathPointCount: number;
+    unit: bigint;
+    flags: number;
+    pathType: number;
+    prevPathType: number;
+    unitSize: number;
+    collisionPattern: number;
+    footprintCollisionMask: number;
+    moveTestCollisionMask: number;
+    targetUnit: bigint;
+    targetType: number;
+    targetId: number;
+    velocity: number;
+    previousVelocity: number;
+    maxVelocity: number;
+    pathPoints: PathPointStruct[];
+    savedStepCount: number;
+    savedSteps: PathPointStruct[];
+  }
+
+  export interface SkillStruct {
+    skillsTxt: bigint;
+    _nextAddress: bigint;
+    readonly next: SkillStruct | null;
+    mode: number;
+    flags: number;
+    baseLevel: number;
+    quantity: number;
+    ownerId: number;
+    charges: number;
+  }
+
+  export interface SkillListStruct {
+    _firstAddress: bigint;
+    readonly first: SkillStruct | null;
+    _leftAddress: bigint;
+    readonly left: SkillStruct | null;
+    _rightAddress: bigint;
+    readonly right: SkillStruct | null;
+    _usedAddress: bigint;
+    readonly used: SkillStruct | null;
+  }
+
+  export interface PlayerDataStruct {
+    name: string;
+    questBuffers: bigint[];
+    waypointBuffers: bigint[];
+    portalFlags: number;
+  }
+
+  export interface MonsterDataStruct {
+    txtRecord: bigint;
+    nameSeed: number;
+    typeFlag: number;
+    lastAnimMode: number;
+    durielFlag: number;
+    monUMod: number[];
+    uniqueId: number;
+    ownerType: number;
+    ownerId: number;
+  }
+
+  export interface GameObjectDataStruct {
+    txtRecord: bigint;
+    type: number;
+  }
+
+  export interface InventoryStruct {
+    signature: number;
+    owner: bigint;
+    firstItem: bigint;
+    lastItem: bigint;
+    grids: bigint;
+    gridCount: number;
+    weaponId: number;
+    cursorItem: bigint;
+    ownerId: number;
+    itemCount: number;
+  }
+
+  export interface ItemDataStruct {
+    quality: number;
+    seed: SeedStruct;
+    ownerId: number;
+    flags: number;
+    itemLevel: number;
+    itemFormat: number;
+    rarePrefix: number;
+    rareSuffix: number;
+    autoAffix: number;
+    magicPrefix: number[];
+    magicSuffix: number[];
+    bodyLocation: number;
+    inventoryPage: number;
+    ownerInventory: bigint;
+    _itemPrevAddress: bigint;
+    readonly itemPrev: UnitStruct | null;
+    _itemNextAddress: bigint;
+    readonly itemNext: UnitStruct | null;
+    nodePos: number;
+    nodePosEx: number;
+  }
+
+  export interface UnitStruct {
+    type: number;
+    classId: number;
+    id: number;
+    mode: number;
+    data: { playerData: bigint; monsterData: bigint; itemData: bigint; gameObjectData: bigint };
+    actId: bigint;
+    _drlgActAddress: bigint;
+    readonly drlgAct: DrlgActStruct | null;
+    seed: SeedStruct;
+    initSeed: SeedStruct;
+    _pathAddress: bigint;
+    readonly path: DynamicPathStruct | null;
+    animSeqFrame: number;
+    animSeqFrame2: number;
+    animSeqFrameCount: number;
+    animSpeed: number;
+    animData: bigint;
+    gfxData: bigint;
+    statListEx: bigint;
+    inventory: bigint;
+    packetList: bigint;
+    posX: number;
+    posY: number;
+    resourceId: bigint;
+    _skillsAddress: bigint;
+    readonly skills: SkillListStruct | null;
+    flags: number;
+    flagsEx: number;
+    changeNextUnit: bigint;
+    unitNext: bigint;
+    roomUnitNext: bigint;
+    collisionUnitType: number;
+    collisionUnitClassId: number;
+    collisionUnitSizeX: number;
+    collisionUnitSizeY: number;
+    dataTblsIndex: number;
+  }
+
+  export const SeedLayout: StructLayout<SeedStruct>;
+  export const D2FP16Layout: StructLayout<D2FP16Struct>;
+  export const D2FP32Layout: StructLayout<D2FP32Struct>;
+  export const D2FP32_16Layout: StructLayout<D2FP32_16Struct>;
+  export const PathPointLayout: StructLayout<PathPointStruct>;
+  export const DrlgCoordsLayout: StructLayout<DrlgCoordsStruct>;
+  export const DrlgCoordLayout: StructLayout<DrlgCoordStruct>;
+  export const DrlgRoomLayout: StructLayout<DrlgRoomStruct>;
+  export const ActiveRoomLayout: StructLayout<ActiveRoomStruct>;
+  export const DrlgLevelLayout: StructLayout<DrlgLevelStruct>;
+  export const DrlgLayout: StructLayout<DrlgStruct>;
+  export const DrlgActLayout: StructLayout<DrlgActStruct>;
+  export const DynamicPathLayout: StructLayout<DynamicPathStruct>;
+  export const SkillLayout: StructLayout<SkillStruct>;
+  export const SkillListLayout: StructLayout<SkillListStruct>;
+  export const PlayerDataLayout: StructLayout<PlayerDataStruct>;
+  export const MonsterDataLayout: StructLayout<MonsterDataStruct>;
+  export const GameObjectDataLayout: StructLayout<GameObjectDataStruct>;
+  export const InventoryLayout: StructLayout<InventoryStruct>;
+  export const ItemDataLayout: StructLayout<ItemDataStruct>;
+  export const UnitLayout: StructLayout<UnitStruct>;
+}
@@ -10,8 +10,16 @@ declare module 'd2r/models' {
   export const ActiveRoomModel: MemoryModel;
   export const DrlgActModel: MemoryModel;
   export const PathPointModel: MemoryModel;
+  export const D2FP16Model: MemoryModel;
+  export const D2FP32Model: MemoryModel;
+  export const D2FP32_16Model: MemoryModel;
   export const DynamicPathModel: MemoryModel;
   export const UnitModel: MemoryModel;
   export const SkillModel: MemoryModel;
   export const SkillListModel: MemoryModel;
+  export const PlayerDataModel: MemoryModel;
+  export const MonsterDataModel: MemoryModel;
+  export const GameObjectDataModel: MemoryModel;
+  export const InventoryModel: MemoryModel;
+  export const ItemDataModel: MemoryModel;
 }
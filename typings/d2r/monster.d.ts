@@ -5,5 +5,10 @@ declare module 'd2r/monster' {
     readonly isAlive: boolean;
     readonly isAttacking: boolean;
     readonly isNeutral: boolean;
+
+    /**
+     * Row of the monster's txt record in the monstats table, -1 if the table is not resolved
+     */
+    readonly monStatsIndex: number;
   }
 }
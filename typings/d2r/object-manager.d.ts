@@ -2,10 +2,39 @@ declare module 'd2r/object-manager' {
   import { EventEmitter } from 'events';
   import { Unit } from 'd2r/unit';
   import { Player, LocalPlayer } from 'd2r/player';
+  import { UnitCollection } from 'd2r/unit-store';
+  import { UnitBatch } from 'd2r/unit-batch';
+  import { Inventory } from 'd2r/inventory';
+  import { ItemRule } from 'd2r/item-rules';
+  import { CollisionMap } from 'd2r/collision-map';
+
+  export interface SnapshotSource {
+    binding: any;
+    tryWithGameLock<T>(fn: () => T): T | undefined;
+  }
+
+  export interface PathMotion {
+    /** Number of units in units */
+    count: number;
+    /** Players, monsters and missiles of the last tick */
+    units: Unit[];
+    /** Client coordinates of units[i] at 2 * i (x) and 2 * i + 1 (y), see worldToAutomap */
+    positions: Int32Array;
+  }
 
   export class ObjectManager extends EventEmitter {
+    /**
+     * @param source Replaces the live game, e.g. a SessionReplay
+     */
+    constructor(source?: SnapshotSource);
+
     me: LocalPlayer | null;
 
+    /**
+     * Occupied player slots as of the last tick
+     */
+    readonly party: { index: number; id: number; unit: Player | null }[];
+
     /**
      * Reset the object manager state
      */
@@ -15,7 +44,94 @@ declare module 'd2r/object-manager' {
      * Get all units of a specific type
      * @param type Unit type (0=Player, 1=Monster, 2=Object, 3=Missile, 4=Item, 5=Tile)
      */
-    getUnits(type: number): Map<number, Unit>;
+    getUnits(type: number): UnitCollection;
+
+    /**
+     * Subscribe to field changes
+     * @param fields UnitFields mask, the listener fires when one of these fields changed since the previous tick
+     * @param listener Called with the unit, its type and the full change mask
+     * @param types Optional list of unit types to restrict the subscription to
+     */
+    onChange(
+        fields: number,
+        listener: (unit: Unit, type: number, changed: number) => void,
+        types?: Iterable<number>,
+    ): this;
+
+    /**
+     * Keep the unit's inventory up to date from the native inventory reader. The Inventory is refreshed every tick
+     * and 'inventoryChanged' is emitted when items were added, moved, changed or removed.
+     */
+    watchInventory(unit: Unit): Inventory;
+
+    unwatchInventory(inventory: Inventory): this;
+
+    /**
+     * Remove a listener registered with onChange()
+     */
+    offChange(listener: (unit: Unit, type: number, changed: number) => void): this;
+
+    /**
+     * Walk units of a type at most every ms milliseconds (0 = every tick), units of a type that is not due keep the
+     * state of its last walk. Defaults: objects and tiles 500, items 250, everything else 0. All types are walked
+     * again when the local player enters another room.
+     */
+    setUpdatePeriod(type: number, ms: number): this;
+
+    getUpdatePeriod(type: number): number;
+
+    /**
+     * Only track units in the local player's room and the rooms up to radius hops away (0 = the player's room),
+     * null tracks every unit in the unit tables. Units outside the radius and items in inventories are removed.
+     */
+    setRoomRadius(radius: number | null): this;
+
+    readonly roomRadius: number | null;
+
+    /**
+     * Match, place and diff the unit records on a native worker thread instead of the script thread. Ticks then
+     * dispatch the events of the previous capture, so units are one tick behind. Switching forgets the tracked units
+     * without 'unitRemoved' events.
+     * @returns false if the source has no worker (SessionReplay)
+     */
+    setPipelined(enabled: boolean): boolean;
+
+    readonly pipelined: boolean;
+
+    /**
+     * Keep the dynamic paths of the players, monsters and missiles of every tick for extrapolate()
+     */
+    setExtrapolation(enabled: boolean): this;
+
+    readonly extrapolation: boolean;
+
+    /**
+     * Positions of the units with a dynamic path at timeNs (highResolutionTime() clock, now by default), moved along
+     * their paths from the last tick's snapshot. The result is reused by the next call.
+     */
+    extrapolate(timeNs?: number): PathMotion;
+
+    /**
+     * Evaluate rules natively for every item that is added or changes, bit i of Item.ruleMask is rules[i]
+     * @returns false if the compiled program was rejected
+     */
+    setItemRules(rules: ItemRule[]): boolean;
+
+    /** Names of the current item rules by match bit */
+    readonly itemRuleNames: string[];
+
+    /**
+     * Merge the collision grids of loaded rooms into per-level walkability maps keyed by seed, difficulty and level,
+     * persisted to path (collision.d2rc in the module directory by default) whenever the local player leaves a level
+     * @returns the path
+     */
+    enableCollisionMaps(path?: string): string | undefined;
+
+    /** Walkability map of the local player's level, null until enabled and the player is in a level */
+    readonly collisionMap: CollisionMap | null;
+
+    /** Map of another level of the local player's seed and difficulty, null if it was never seen */
+    getCollisionMap(levelId: number): CollisionMap | null;
 
     /**
      * Update the object manager state by scanning the game's unit tables
@@ -35,7 +151,13 @@ declare module 'd2r/object-manager' {
 
     // Event emitter methods
     on(event: 'unitAdded', listener: (unit: Unit, type: number) => void): this;
+    on(event: 'unitUpdated', listener: (unit: Unit, type: number) => void): this;
     on(event: 'unitRemoved', listener: (unit: Unit, type: number) => void): this;
+    /** Once per tick with every unit added in it, after the per-unit events */
+    on(event: 'unitsAdded', listener: (batch: UnitBatch) => void): this;
+    /** Once per tick with the ids of every unit removed in it, emitted before 'unitsAdded' */
+    on(event: 'unitsRemoved', listener: (batch: UnitBatch) => void): this;
+    on(event: 'inventoryChanged', listener: (inventory: Inventory) => void): this;
     on(event: string, listener: (...args: any[]) => void): this;
   }
 }
@@ -0,0 +1,27 @@
+declare module 'd2r/session-replay' {
+  export const BlobKinds: {
+    readonly ActiveRoom: 1;
+    readonly DrlgRoom: 2;
+    readonly DrlgLevel: 3;
+  };
+
+  /**
+   * Plays back a session file written by sessionRecordStart(). Every ObjectManager tick advances one frame.
+   */
+  export class SessionReplay {
+    constructor(buffer: ArrayBuffer | Uint8Array);
+
+    readonly binding: any;
+    readonly frameIndex: number;
+    readonly timestampNs: bigint;
+    readonly done: boolean;
+
+    rewind(): void;
+    tryWithGameLock<T>(fn: () => T): T;
+
+    /**
+     * Bytes of a recorded room or level struct containing address, null if it was not captured in this frame
+     */
+    readMemory(address: bigint, size: number): DataView | null;
+  }
+}
@@ -0,0 +1,27 @@
+declare module 'd2r/stat-list' {
+  export interface StatEntry {
+    statId: number;
+    layer: number;
+    value: number;
+  }
+
+  /**
+   * Base and full (after items, states and auras) stats of one unit. Values are raw, life, mana and stamina are
+   * fixed point (>> 8). Missing stats read as 0.
+   */
+  export class StatList {
+    /** Native copy version this list was decoded from */
+    readonly version: number;
+    readonly baseCount: number;
+    readonly count: number;
+
+    get(statId: number, layer?: number): number;
+    getBase(statId: number, layer?: number): number;
+    has(statId: number, layer?: number): boolean;
+
+    /**
+     * Every full stat, or every base stat if base is true
+     */
+    entries(base?: boolean): IterableIterator<StatEntry>;
+  }
+}
@@ -59,4 +59,94 @@ declare module 'd2r/types' {
     readonly Dropping: 5;
     readonly Socketed: 6;
   };
+
+  export const ItemQuality: {
+    readonly Inferior: 1;
+    readonly Normal: 2;
+    readonly Superior: 3;
+    readonly Magic: 4;
+    readonly Set: 5;
+    readonly Rare: 6;
+    readonly Unique: 7;
+    readonly Crafted: 8;
+    readonly Tempered: 9;
+  };
+
+  export const ItemFlags: {
+    readonly NewItem: 0x1;
+    readonly Identified: 0x10;
+    readonly Broken: 0x100;
+    readonly Socketed: 0x800;
+    readonly Ear: 0x10000;
+    readonly StarterItem: 0x20000;
+    readonly Simple: 0x200000;
+    readonly Ethereal: 0x400000;
+    readonly Personalized: 0x1000000;
+    readonly Runeword: 0x4000000;
+  };
+
+  export const UnitFields: {
+    readonly Position: 1;
+    readonly Mode: 2;
+    readonly Flags: 4;
+    readonly Data: 8;
+    readonly PathTarget: 16;
+    readonly Automap: 256;
+    readonly Added: 0x80000000;
+    readonly All: 0xFFFFFFFF;
+  };
+
+  export const InventoryChanges: {
+    readonly Placement: 1;
+    readonly Flags: 2;
+    readonly Added: 0x80000000;
+    readonly All: 0xFFFFFFFF;
+  };
+
+  /**
+   * Stat ids of ItemStatCost.txt
+   */
+  export const Stats: {
+    readonly Strength: 0;
+    readonly Energy: 1;
+    readonly Dexterity: 2;
+    readonly Vitality: 3;
+    readonly StatPoints: 4;
+    readonly SkillPoints: 5;
+    readonly Life: 6;
+    readonly MaxLife: 7;
+    readonly Mana: 8;
+    readonly MaxMana: 9;
+    readonly Stamina: 10;
+    readonly MaxStamina: 11;
+    readonly Level: 12;
+    readonly Experience: 13;
+    readonly Gold: 14;
+    readonly GoldBank: 15;
+    readonly Defense: 31;
+    readonly DamageResist: 36;
+    readonly MagicResist: 37;
+    readonly FireResist: 39;
+    readonly MaxFireResist: 40;
+    readonly LightningResist: 41;
+    readonly MaxLightningResist: 42;
+    readonly ColdResist: 43;
+    readonly MaxColdResist: 44;
+    readonly PoisonResist: 45;
+    readonly MaxPoisonResist: 46;
+    readonly Velocity: 67;
+    readonly Quantity: 70;
+    readonly Durability: 72;
+    readonly MaxDurability: 73;
+    readonly MagicFind: 80;
+    readonly ItemLevelRequire: 92;
+    readonly FasterRunWalk: 96;
+    readonly FasterHitRecovery: 99;
+    readonly FasterBlockRate: 102;
+    readonly FasterCastRate: 105;
+    readonly SingleSkill: 107;
+    readonly AllSkills: 127;
+    readonly SkillTab: 188;
+    readonly Sockets: 194;
+  };
 }
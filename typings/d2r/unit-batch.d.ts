@@ -0,0 +1,21 @@
+declare module 'd2r/unit-batch' {
+  import { Unit } from 'd2r/unit';
+
+  /**
+   * Units added or removed during one tick, grouped by unit type. The batch is reused every tick, copy what has to
+   * outlive the event.
+   */
+  export class UnitBatch {
+    /** Number of units of each type in the batch, indexed by UnitTypes */
+    readonly counts: Uint32Array;
+
+    /** Number of units of all types in the batch */
+    readonly size: number;
+
+    /** Unit ids of `type`, only valid during the event */
+    ids(type: number): Uint32Array;
+
+    /** Units of `type` in ids() order, empty for removed units */
+    units(type: number): readonly Unit[];
+  }
+}
@@ -0,0 +1,57 @@
+declare module 'd2r/unit-store' {
+  import { Unit } from 'd2r/unit';
+
+  export const SLOT_LIMIT: number;
+
+  /**
+   * Read-only Map-like view over the units of one type
+   */
+  export class UnitCollection<T extends Unit = Unit> implements Iterable<[number, T]> {
+    readonly size: number;
+    has(id: number): boolean;
+    get(id: number): T | undefined;
+    keys(): IterableIterator<number>;
+    values(): IterableIterator<T>;
+    entries(): IterableIterator<[number, T]>;
+    [Symbol.iterator](): IterableIterator<[number, T]>;
+    forEach(fn: (unit: T, id: number, collection: UnitCollection<T>) => void, thisArg?: any): void;
+  }
+
+  /**
+   * Structure-of-arrays unit storage, hot fields are kept in typed array columns indexed by slot
+   */
+  export class UnitStore {
+    constructor(capacity?: number);
+
+    readonly capacity: number;
+    readonly tick: number;
+    readonly view: DataView | null;
+    readonly units: (Unit | undefined)[];
+    readonly collections: UnitCollection[];
+
+    readonly generation: Uint32Array;
+    readonly alive: Uint8Array;
+    readonly type: Uint8Array;
+    readonly id: Uint32Array;
+    readonly classId: Uint32Array;
+    readonly mode: Uint32Array;
+    readonly flags: Uint32Array;
+    readonly flagsEx: Uint32Array;
+    readonly posX: Int32Array;
+    readonly posY: Int32Array;
+    readonly automapX: Float64Array;
+    readonly automapY: Float64Array;
+    readonly record: Int32Array;
+    readonly seenTick: Uint32Array;
+    readonly address: BigUint64Array;
+
+    alloc(type: number, id: number, createView: (store: UnitStore, slot: number) => Unit): number;
+    free(slot: number): void;
+    find(type: number, id: number): number;
+    handle(slot: number): number;
+    isValid(handle: number): boolean;
+    resolve(handle: number): Unit | null;
+    sweep(onRemove: (unit: Unit, type: number) => void, typeMask?: number): void;
+    clear(): void;
+  }
+}
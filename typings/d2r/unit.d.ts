@@ -1,40 +1,66 @@
 declare module 'd2r/unit' {
+  import { DynamicPath } from 'd2r/dynamic-path';
+  import { DrlgActStruct, SkillListStruct } from 'd2r/layouts';
+  import { StatList } from 'd2r/stat-list';
+
+  import { UnitStore } from 'd2r/unit-store';
+
+  /**
+   * View over one UnitStore slot. Fields read as their defaults once the unit was removed.
+   */
   export class Unit {
+    constructor(store: UnitStore, slot: number);
+
     // UnitModel fields
-    type: number;
-    classId: number;
-    id: number;
-    mode: number;
-    data: bigint;
-    actId: bigint;
-    drlgAct: any;
-    seed: any;
-    initSeed: any;
-    path: any;
-    animSeqFrame: number;
-    animSeqFrame2: number;
-    animSeqFrameCount: number;
-    animSpeed: number;
-    animData: bigint;
-    gfxData: bigint;
-    statListEx: bigint;
-    inventory: bigint;
-    packetList: bigint;
-    posX: number;
-    posY: number;
-    skills: any;
-    flags: number;
-    flagsEx: number;
-    changeNextUnit: bigint;
-    unitNext: bigint;
-    roomUnitNext: bigint;
-    collisionUnitType: number;
-    collisionUnitClassId: number;
-    collisionUnitSizeX: number;
-    collisionUnitSizeY: number;
-    _address: bigint;
+    readonly type: number;
+    readonly classId: number;
+    readonly id: number;
+    readonly mode: number;
+    readonly data: bigint;
+    readonly actId: bigint;
+    readonly drlgAct: DrlgActStruct | null;
+    readonly seed: any;
+    readonly initSeed: any;
+    readonly path: DynamicPath | null;
+    readonly animSeqFrame: number;
+    readonly animSeqFrame2: number;
+    readonly animSeqFrameCount: number;
+    readonly animSpeed: number;
+    readonly animData: bigint;
+    readonly gfxData: bigint;
+    readonly statListEx: bigint;
+    /**
+     * Decoded stat lists, re-read from the game only when they changed
+     */
+    readonly stats: StatList | null;
+    readonly inventory: bigint;
+    readonly packetList: bigint;
+    readonly posX: number;
+    readonly posY: number;
+    readonly skills: SkillListStruct | null;
+    readonly flags: number;
+    readonly flagsEx: number;
+    readonly changeNextUnit: bigint;
+    readonly unitNext: bigint;
+    readonly roomUnitNext: bigint;
+    readonly collisionUnitType: number;
+    readonly collisionUnitClassId: number;
+    readonly collisionUnitSizeX: number;
+    readonly collisionUnitSizeY: number;
+    readonly dataTblsIndex: number;
+    readonly _address: bigint;
 
     // Unit methods
     readonly isValid: boolean;
+
+    /**
+     * Generation-checked handle, resolve it with UnitStore.resolve()
+     */
+    readonly handle: number;
+
+    /**
+     * Column and record fields as of the current tick, for JSON.stringify
+     */
+    toJSON(): Record<string, unknown>;
   }
 }
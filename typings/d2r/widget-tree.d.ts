@@ -0,0 +1,68 @@
+declare module 'd2r/widget-tree' {
+  export const WidgetFlags: {
+    readonly Visible: 0x1;
+    readonly Enabled: 0x2;
+    /** Visible along with every ancestor */
+    readonly Shown: 0x4;
+  };
+
+  /** Absolute widget rect in screen pixels */
+  export interface WidgetRect {
+    x: number;
+    y: number;
+    width: number;
+    height: number;
+  }
+
+  /**
+   * FNV-1a of the lowercased widget name, as used for WidgetTree.nameHash
+   */
+  export function widgetNameHash(name: string): number;
+
+  /**
+   * The game's UI flattened into depth-first entries (a widget's subtree follows it), index 0 is the PanelManager
+   */
+  export class WidgetTree {
+    /** Native snapshot version this was decoded from */
+    readonly version: number;
+    readonly count: number;
+    /** Entry index of the hovered panel / widget, -1 if none */
+    readonly hoverPanel: number;
+    readonly hoverWidget: number;
+
+    /**
+     * Refresh from the game, copies the native snapshot only when something changed
+     * @returns true if anything changed since the last update
+     */
+    update(): boolean;
+
+    name(index: number): string;
+    nameHash(index: number): number;
+    /** Parent entry index, -1 for the root */
+    parent(index: number): number;
+    flags(index: number): number;
+    depth(index: number): number;
+    childCount(index: number): number;
+    isVisible(index: number): boolean;
+    isEnabled(index: number): boolean;
+    /** Visible along with every ancestor */
+    isShown(index: number): boolean;
+    rect(index: number): WidgetRect;
+
+    /**
+     * Index of the first widget named name (case-insensitive), -1 if none
+     */
+    find(name: string): number;
+
+    /**
+     * Rects of the shown widgets up to maxDepth below the root (default 1, the top-level panels) that cover some
+     * area
+     */
+    visibleRects(maxDepth?: number): WidgetRect[];
+
+    /**
+     * true if the screen point lies under one of visibleRects(maxDepth)
+     */
+    isCovered(x: number, y: number, maxDepth?: number): boolean;
+  }
+}